@@ -0,0 +1,18 @@
+const b = require('benny')
+const { featuresSync, featuresNextAsync, featuresBatchAsync, featuresAsyncIterator } = require('./features.common')
+
+module.exports = b.suite(
+  'LayerFeatures',
+
+  b.add('LayerFeatures.next()',
+    async () => featuresSync('/vsimem/features.gpkg')),
+  b.add('LayerFeatures.nextAsync()',
+    async () => featuresNextAsync('/vsimem/features.gpkg')),
+  b.add('LayerFeatures.nextBatchAsync()',
+    async () => featuresBatchAsync('/vsimem/features.gpkg', 1000)),
+  b.add('LayerFeatures w/async iterator',
+    async () => featuresAsyncIterator('/vsimem/features.gpkg')),
+
+  b.cycle(),
+  b.complete()
+)
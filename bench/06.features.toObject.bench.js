@@ -0,0 +1,14 @@
+const b = require('benny')
+const { featuresToObject, featuresGetByName } = require('./features.common')
+
+module.exports = b.suite(
+  'FeatureFields',
+
+  b.add('FeatureFields.toObject() w/50 fields',
+    async () => featuresToObject()),
+  b.add('FeatureFields.get(name) w/50 fields',
+    async () => featuresGetByName()),
+
+  b.cycle(),
+  b.complete()
+)
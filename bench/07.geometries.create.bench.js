@@ -0,0 +1,16 @@
+const b = require('benny')
+const { geometriesCreate, geometriesFromFeatures, geometriesFromPoints } = require('./geometries.common')
+
+module.exports = b.suite(
+  'Geometry wrappers',
+
+  b.add('new gdal.Point() x100000',
+    async () => geometriesCreate()),
+  b.add('Feature.getGeometry() x100000',
+    async () => geometriesFromFeatures()),
+  b.add('LineStringPoints.get() x100000',
+    async () => geometriesFromPoints()),
+
+  b.cycle(),
+  b.complete()
+)
@@ -0,0 +1,134 @@
+const assert = require('assert')
+
+const gdal = require('..')
+
+const featureCount = 20000
+
+const initTest = (() => {
+  let initDone = false
+  return async function () {
+    // See streams.common.js, benny runs the initialization of all tests in parallel
+    if (initDone) return initDone
+    let resolve, reject
+    initDone = new Promise((res, rej) => {
+      resolve = res
+      reject = rej
+    })
+
+    try {
+      const ds = await gdal.openAsync('/vsimem/features.gpkg', 'w', 'GPKG')
+      const layer = await ds.layers.createAsync('features', gdal.SpatialReference.fromEPSG(4326), gdal.Point)
+      layer.fields.add(new gdal.FieldDefn('id', gdal.OFTInteger))
+      layer.fields.add(new gdal.FieldDefn('name', gdal.OFTString))
+      ds.executeSQL('BEGIN')
+      for (let i = 0; i < featureCount; i++) {
+        const feature = new gdal.Feature(layer)
+        feature.fields.set({ id: i, name: `feature ${i}` })
+        feature.setGeometry(new gdal.Point(i % 360 - 180, i % 180 - 90))
+        layer.features.add(feature)
+      }
+      ds.executeSQL('COMMIT')
+      ds.close()
+      resolve()
+    } catch (e) {
+      reject(e)
+    }
+  }
+})()
+
+async function featuresSync(file) {
+  await initTest()
+  const ds = gdal.open(file)
+  const layer = ds.layers.get(0)
+  let count = 0
+  for (let feature = layer.features.first(); feature; feature = layer.features.next()) count++
+  assert(count == featureCount)
+  ds.close()
+}
+
+async function featuresNextAsync(file) {
+  await initTest()
+  const ds = await gdal.openAsync(file)
+  const layer = await ds.layers.getAsync(0)
+  let count = 0
+  for (let feature = await layer.features.firstAsync(); feature; feature = await layer.features.nextAsync()) {
+    count++
+  }
+  assert(count == featureCount)
+  ds.close()
+}
+
+async function featuresBatchAsync(file, batchSize) {
+  await initTest()
+  const ds = await gdal.openAsync(file)
+  const layer = await ds.layers.getAsync(0)
+  let count = 0
+  for (let batch = await layer.features.nextBatchAsync(batchSize); batch.length;
+    batch = await layer.features.nextBatchAsync(batchSize)) {
+    count += batch.length
+  }
+  assert(count == featureCount)
+  ds.close()
+}
+
+async function featuresAsyncIterator(file) {
+  await initTest()
+  const ds = await gdal.openAsync(file)
+  const layer = await ds.layers.getAsync(0)
+  let count = 0
+  for await (const feature of layer.features) if (feature) count++
+  assert(count == featureCount)
+  ds.close()
+}
+
+const wideFieldCount = 50
+const wideFeatureCount = 5000
+
+// A Memory layer with 50 fields, the cost of converting the features
+// is dominated by the field names
+const wideLayer = (() => {
+  let layer
+  return function () {
+    if (layer) return layer
+    const ds = gdal.open('wide', 'w', 'Memory')
+    layer = ds.layers.create('wide', null, gdal.Point)
+    for (let i = 0; i < wideFieldCount; i++) {
+      layer.fields.add(new gdal.FieldDefn(`field_${i}`, i % 2 ? gdal.OFTReal : gdal.OFTInteger))
+    }
+    for (let i = 0; i < wideFeatureCount; i++) {
+      const feature = new gdal.Feature(layer)
+      feature.fields.set(Array.from({ length: wideFieldCount }, (_, j) => j % 2 ? i / j : i + j))
+      layer.features.add(feature)
+    }
+    return layer
+  }
+})()
+
+async function featuresToObject() {
+  const layer = wideLayer()
+  let count = 0
+  for (let feature = layer.features.first(); feature; feature = layer.features.next()) {
+    const obj = feature.fields.toObject()
+    if (obj.field_0 !== undefined) count++
+  }
+  assert(count == wideFeatureCount)
+}
+
+async function featuresGetByName() {
+  const layer = wideLayer()
+  let count = 0
+  for (let feature = layer.features.first(); feature; feature = layer.features.next()) {
+    const value = feature.fields.get(`field_${wideFieldCount - 1}`)
+    if (value !== undefined) count++
+  }
+  assert(count == wideFeatureCount)
+}
+
+module.exports = {
+  featuresSync,
+  featuresNextAsync,
+  featuresBatchAsync,
+  featuresAsyncIterator,
+  featuresToObject,
+  featuresGetByName
+}
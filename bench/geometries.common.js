@@ -0,0 +1,65 @@
+const assert = require('assert')
+
+const gdal = require('..')
+
+const geometryCount = 100000
+
+// A Memory layer of points, every feature.getGeometry() creates a new wrapper
+const pointLayer = (() => {
+  let layer
+  return function () {
+    if (layer) return layer
+    const ds = gdal.open('points', 'w', 'Memory')
+    layer = ds.layers.create('points', null, gdal.Point)
+    for (let i = 0; i < geometryCount; i++) {
+      const feature = new gdal.Feature(layer)
+      feature.setGeometry(new gdal.Point(i % 360 - 180, i % 180 - 90))
+      layer.features.add(feature)
+    }
+    return layer
+  }
+})()
+
+// A single LineString, every points.get() creates a new wrapper
+const line = (() => {
+  let line
+  return function () {
+    if (line) return line
+    line = new gdal.LineString()
+    for (let i = 0; i < geometryCount; i++) line.points.add(i, i)
+    return line
+  }
+})()
+
+async function geometriesCreate() {
+  let count = 0
+  for (let i = 0; i < geometryCount; i++) {
+    const point = new gdal.Point(i, i)
+    if (point.x === i) count++
+  }
+  assert(count == geometryCount)
+}
+
+async function geometriesFromFeatures() {
+  const layer = pointLayer()
+  let count = 0
+  for (let feature = layer.features.first(); feature; feature = layer.features.next()) {
+    if (feature.getGeometry()) count++
+  }
+  assert(count == geometryCount)
+}
+
+async function geometriesFromPoints() {
+  const points = line().points
+  let count = 0
+  for (let i = 0; i < geometryCount; i++) {
+    if (points.get(i).x === i) count++
+  }
+  assert(count == geometryCount)
+}
+
+module.exports = {
+  geometriesCreate,
+  geometriesFromFeatures,
+  geometriesFromPoints
+}
@@ -14,6 +14,18 @@
 				"src/utils/number_list.cpp",
 				"src/utils/warp_options.cpp",
 				"src/utils/ptr_manager.cpp",
+				"src/utils/layer_columns.cpp",
+				"src/utils/field_names.cpp",
+				"src/utils/geojson_writer.cpp",
+				"src/utils/rtree.cpp",
+				"src/utils/prepared_geometry.cpp",
+				"src/utils/flat_coordinates.cpp",
+				"src/utils/geometry_object.cpp",
+				"src/utils/spatial_join.cpp",
+				"src/utils/vector_tile_writer.cpp",
+				"src/utils/union_all.cpp",
+				"src/utils/srs_cache.cpp",
+				"src/utils/approx_transformer.cpp",
 				"src/node_gdal.cpp",
 				"src/async.cpp",
 				"src/gdal_common.cpp",
@@ -26,6 +38,7 @@
 				"src/gdal_attribute.cpp",
 				"src/gdal_majorobject.cpp",
 				"src/gdal_feature.cpp",
+				"src/gdal_feature_view.cpp",
 				"src/gdal_feature_defn.cpp",
 				"src/gdal_field_defn.cpp",
 				"src/geometry/gdal_geometry.cpp",
@@ -44,6 +57,9 @@
 				"src/gdal_layer.cpp",
 				"src/gdal_coordinate_transformation.cpp",
 				"src/gdal_spatial_reference.cpp",
+				"src/gdal_spatial_index.cpp",
+				"src/gdal_prepared_geometry.cpp",
+				"src/gdal_approx_transformer.cpp",
 				"src/gdal_warper.cpp",
 				"src/gdal_algorithms.cpp",
 				"src/gdal_memfile.cpp",
@@ -133,12 +133,15 @@ gdal.Layer.prototype.getExtent = function () {
 const readStream = require('./readable.js')
 const writeStream = require('./writable.js')
 const muxStream = require('./multiplexer.js')
+const geoJSONStream = require('./geojson.js')
 gdal.RasterBandPixels.prototype.createReadStream = readStream.createReadStream
 gdal.RasterReadStream = readStream.RasterReadStream
 gdal.RasterBandPixels.prototype.createWriteStream = writeStream.createWriteStream
 gdal.RasterWriteStream = writeStream.RasterWriteStream
 gdal.RasterMuxStream = muxStream.RasterMuxStream
 gdal.RasterTransform = muxStream.RasterTransform
+gdal.Layer.prototype.createGeoJSONStream = geoJSONStream.createGeoJSONStream
+gdal.LayerGeoJSONStream = geoJSONStream.LayerGeoJSONStream
 
 gdal.calcAsync = require('./calc')(gdal)
 
@@ -616,10 +619,20 @@ const mangleRead = (args) => {
     options.line_space,
     options.resampling,
     options.progress_cb,
-    options.offset
+    options.offset,
+    options.shared,
+    options.external ? (options.alignment === undefined ? 64 : options.alignment) : undefined,
+    options.withMask
   ]
 }
 
+const mangleWritev = (args) => {
+  if (Array.isArray(args[4])) {
+    for (const data of args[4]) if (data) data._gdal_type = getTypedArrayType(data)
+  }
+  return args
+}
+
 const mangleBlock = (args) => {
   if (args[2]) args[2]._gdal_type = getTypedArrayType(args[2])
   return args
@@ -632,6 +645,18 @@ const mangleMDArray = (args) => {
   return args
 }
 
+const mangleEncode = (args) => {
+  if (args[0]) args[0]._gdal_type = getTypedArrayType(args[0])
+  return args
+}
+
+gdal.encode = (function () {
+  const encode = gdal.encode
+  return function () {
+    return encode.apply(this, mangleEncode(arguments))
+  }
+})()
+
 gdal.RasterBandPixels.prototype.read = (function () {
   const read = gdal.RasterBandPixels.prototype.read
   return function () {
@@ -639,6 +664,52 @@ gdal.RasterBandPixels.prototype.read = (function () {
   }
 })()
 
+/**
+ * Reads a region of pixels and the matching region of the mask band in one operation.
+ *
+ * When all pixels are valid or when the mask can be derived from the NoData value,
+ * the mask band is not read at all.
+ *
+ * @for gdal.RasterBandPixels
+ * @method readWithMask
+ * @throws Error
+ * @param {number} x
+ * @param {number} y
+ * @param {number} width
+ * @param {number} height
+ * @param {TypedArray} [data] The TypedArray (https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses) to put the data in. A new array is created if not given.
+ * @param {ReadOptions} [options]
+ * @return {MaskedData}
+ */
+gdal.RasterBandPixels.prototype.readWithMask = function (x, y, width, height, data, options) {
+  return this.read(x, y, width, height, data, Object.assign({}, options, { withMask: true }))
+}
+
+/**
+ * Reads a region of pixels and the matching region of the mask band in one operation.
+ * {{{async}}}
+ *
+ * When all pixels are valid or when the mask can be derived from the NoData value,
+ * the mask band is not read at all.
+ *
+ * @for gdal.RasterBandPixels
+ * @method readWithMaskAsync
+ * @param {number} x
+ * @param {number} y
+ * @param {number} width
+ * @param {number} height
+ * @param {TypedArray} [data] The TypedArray (https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses) to put the data in. A new array is created if not given.
+ * @param {ReadOptions} [options]
+ * @param {callback<MaskedData>} [callback=undefined] {{{cb}}}
+ * @return {Promise<MaskedData>}
+ */
+gdal.RasterBandPixels.prototype.readWithMaskAsync = function () {
+  const args = Array.prototype.slice.call(arguments)
+  const callback = typeof args[args.length - 1] === 'function' ? args.pop() : undefined
+  const [ x, y, width, height, data, options ] = args
+  return this.readAsync(x, y, width, height, data, Object.assign({}, options, { withMask: true }), callback)
+}
+
 gdal.RasterBandPixels.prototype.write = (function () {
   const write = gdal.RasterBandPixels.prototype.write
   return function () {
@@ -646,6 +717,13 @@ gdal.RasterBandPixels.prototype.write = (function () {
   }
 })()
 
+gdal.RasterBandPixels.prototype.writev = (function () {
+  const writev = gdal.RasterBandPixels.prototype.writev
+  return function () {
+    return writev.apply(this, mangleWritev(arguments))
+  }
+})()
+
 gdal.RasterBandPixels.prototype.readBlock = (function () {
   const readBlock = gdal.RasterBandPixels.prototype.readBlock
   return function (x, y, data) {
@@ -687,11 +765,16 @@ const promisifiables = {
     flushAsync: 0,
     buildOverviewsAsync: 4,
     executeSQLAsync: 3,
+    releaseResultSetAsync: 1,
     getMetadataAsync: 1,
-    setMetadataAsync: 2
+    setMetadataAsync: 2,
+    startTransactionAsync: 1,
+    commitAsync: 0,
+    rollbackAsync: 0
   },
   Layer: {
-    flushAsync: 0
+    flushAsync: 0,
+    readColumnsAsync: 1
   },
   RasterBand: {
     flushAsync: 0,
@@ -701,8 +784,9 @@ const promisifiables = {
     setMetadataAsync: 2
   },
   RasterBandPixels: {
-    readAsync: 13,
+    readAsync: 16,
     writeAsync: 11,
+    writevAsync: 6,
     readBlockAsync: 3,
     writeBlockAsync: 3,
     clampBlockAsync: 2,
@@ -721,7 +805,11 @@ const promisifiables = {
     setAsync: 2,
     firstAsync: 0,
     nextAsync: 0,
+    nextBatchAsync: 1,
+    nextViewsAsync: 2,
+    nextGeoJSONAsync: 1,
     addAsync: 1,
+    addManyAsync: 2,
     countAsync: 1,
     removeAsync: 1
   },
@@ -740,6 +828,10 @@ const promisifiables = {
     $fromWKBAsync: 2,
     $fromGeoJsonAsync: 1,
     $fromGeoJsonBufferAsync: 1,
+    $fromWKBArrayAsync: 2,
+    $toWKBArrayAsync: 2,
+    $toObjectArrayAsync: 2,
+    $fromObjectArrayAsync: 2,
     toKMLAsync: 0,
     toGMLAsync: 0,
     toWKTAsync: 0,
@@ -778,6 +870,22 @@ const promisifiables = {
     transformAsync: 1,
     transformToAsync: 1
   },
+  PreparedGeometry: {
+    intersectsManyAsync: 2,
+    containsManyAsync: 2
+  },
+  CoordinateTransformation: {
+    transformPointsAsync: 4
+  },
+  ApproxTransformer: {
+    transformGridAsync: 4
+  },
+  SpatialIndex: {
+    $fromLayerAsync: 2,
+    $fromGeometriesAsync: 2,
+    searchAsync: 1,
+    intersectsAsync: 1
+  },
   SpatialReference: {
     $fromURLAsync: 1,
     $fromCRSURLAsync: 1,
@@ -802,12 +910,21 @@ const promisifiables = {
     $sieveFilterAsync: 1,
     $checksumImageAsync: 5,
     $polygonizeAsync: 1,
+    $spatialJoinAsync: 3,
+    $renderVectorTileAsync: 2,
+    $unionAllAsync: 2,
+    $bufferManyAsync: 3,
+    $simplifyManyAsync: 3,
+    $makeValidManyAsync: 2,
     $reprojectImageAsync: 1,
     $suggestedWarpOutputAsync: 1,
     $translateAsync: 4,
     $vectorTranslateAsync: 4,
     $infoAsync: 2,
     $warpAsync: 5,
+    $renderTileAsync: 2,
+    $encodeAsync: 2,
+    $decodeAsync: 2,
     $_acquireLocksAsync: 3
   }
 }
@@ -816,11 +933,15 @@ const argMangle = {
   RasterBandPixels: {
     readAsync: mangleRead,
     writeAsync: mangleWrite,
+    writevAsync: mangleWritev,
     readBlockAsync: mangleBlock,
     writeBlockAsync: mangleBlock
   },
   MDArray: {
     readAsync: mangleMDArray
+  },
+  $: {
+    $encodeAsync: mangleEncode
   }
 }
 
@@ -0,0 +1,110 @@
+const { Readable } = require('stream')
+
+const debug = process.env.NODE_DEBUG && process.env.NODE_DEBUG.match(/gdal_geojson|gdal([^_]|$)/) ?
+  console.debug.bind(console, 'LayerGeoJSONStream:') :
+  () => undefined
+
+/**
+ * create a Readable stream of GeoJSON from a layer
+ *
+ * @for gdal.Layer
+ * @method createGeoJSONStream
+ * @param {GeoJSONStreamOptions} [options]
+ * @param {string[]} [options.fields] Fields to include, all the fields by default
+ * @param {number} [options.precision] Maximum number of decimals of the coordinates, 7 with `rfc7946`, 15 otherwise
+ * @param {boolean} [options.rfc7946=false] Reproject to WGS84 and apply the right-hand rule to polygons
+ * @param {boolean} [options.newlineDelimited=false] Produce newline-delimited GeoJSON (GeoJSONSeq / NDJSON) instead of a `FeatureCollection`
+ * @param {number} [options.chunkSize=65536] Approximate size of the produced `Buffer`s
+ * @returns {LayerGeoJSONStream}
+ */
+function createGeoJSONStream(options) {
+  return new LayerGeoJSONStream({ ...options || {}, layer: this })
+}
+
+/**
+ * Class implementing {{#crossLink "gdal.Layer"}}Layer{{/crossLink}} reading as a stream of GeoJSON text
+ *
+ * The features are serialized in a background thread directly from GDAL
+ * to `Buffer` chunks without creating any JS objects, the attribute and
+ * the spatial filters of the layer are applied.
+ *
+ * The stream starts by resetting the reading of the layer and then uses its
+ * current reading position, the layer features should not be iterated while it is
+ * flowing.
+ *
+ * @example
+ * ```
+ * layer.setAttributeFilter('population > 1000000');
+ * layer.createGeoJSONStream({ fields: [ 'name' ], rfc7946: true }).pipe(res);
+ * ```
+ *
+ * @class gdal.LayerGeoJSONStream
+ * @extends stream.Readable
+ * @constructor
+ * @param {GeoJSONStreamOptions} [options]
+ * @param {Layer} options.layer Layer to use
+ * @param {string[]} [options.fields] Fields to include, all the fields by default
+ * @param {number} [options.precision] Maximum number of decimals of the coordinates, 7 with `rfc7946`, 15 otherwise
+ * @param {boolean} [options.rfc7946=false] Reproject to WGS84 and apply the right-hand rule to polygons
+ * @param {boolean} [options.newlineDelimited=false] Produce newline-delimited GeoJSON (GeoJSONSeq / NDJSON) instead of a `FeatureCollection`
+ * @param {number} [options.chunkSize=65536] Approximate size of the produced `Buffer`s
+ */
+class LayerGeoJSONStream extends Readable {
+  constructor(options) {
+    super(options)
+    if (!options || !options.layer || !options.layer.features) {
+      throw new TypeError('"layer" must be a gdal.Layer')
+    }
+    this.layer = options.layer
+    this.newlineDelimited = !!options.newlineDelimited
+    this.readOptions = { newlineDelimited: this.newlineDelimited }
+    for (const opt of [ 'fields', 'precision', 'rfc7946', 'chunkSize' ]) {
+      if (options[opt] !== undefined) this.readOptions[opt] = options[opt]
+    }
+    this.readingInProgress = false
+    this.started = false
+    this.hasFeatures = false
+    this.layerEnded = false
+  }
+}
+
+LayerGeoJSONStream.prototype._readNext = function () {
+  if (this.readingInProgress || this.layerEnded) return
+  this.readingInProgress = true
+  const reset = !this.started
+  this.started = true
+  debug('reading next chunk', reset)
+  this.layer.features.nextGeoJSONAsync({ ...this.readOptions, reset })
+    .then((data) => {
+      this.readingInProgress = false
+      if (reset && !this.newlineDelimited) this.push('{"type":"FeatureCollection","features":[\n')
+      if (data === null) {
+        debug('layer ended')
+        this.layerEnded = true
+        if (!this.newlineDelimited) this.push('\n]}\n')
+        this.push(null)
+        return
+      }
+      if (this.hasFeatures && !this.newlineDelimited) this.push(',\n')
+      this.hasFeatures = true
+      debug('adding a new chunk', data.length)
+      if (this.push(data)) {
+        this._readNext()
+      } else {
+        debug('push buffer is full')
+      }
+    })
+    .catch((e) => {
+      debug('emitting error', e)
+      this.destroy(e)
+    })
+}
+
+LayerGeoJSONStream.prototype._read = function () {
+  this._readNext()
+}
+
+module.exports = {
+  createGeoJSONStream,
+  LayerGeoJSONStream
+}
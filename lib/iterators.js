@@ -1,3 +1,6 @@
+// Number of features fetched in a single background job by the async iterator
+const asyncIteratorBatchSize = 256
+
 module.exports = function (gdal) {
 
   /**
@@ -128,6 +131,9 @@ module.exports = function (gdal) {
   /**
  * Iterates through all features using an async iterator
  *
+ * The features are fetched in batches using `nextBatchAsync()`,
+ * a single background job is executed for each batch.
+ *
  * @example
  * ```
  * for await (const feature of layer.features) {
@@ -139,20 +145,266 @@ module.exports = function (gdal) {
  */
   if (Symbol.asyncIterator) {
     gdal.LayerFeatures.prototype[Symbol.asyncIterator] = function () {
-      let feature
+      let batch = null
+      let idx = 0
+      let exhausted = false
+
+      // The first batch is a single feature: firstAsync() resets the reading
+      const fetch = () => (batch === null ?
+        this.firstAsync().then((feature) => (feature ? [ feature ] : [])) :
+        this.nextBatchAsync(asyncIteratorBatchSize).then((features) => {
+          exhausted = features.length < asyncIteratorBatchSize
+          return features
+        }))
 
       return {
         next: () => {
-          feature = feature ? this.nextAsync() : this.firstAsync()
-          return feature.then((value) => ({
-            done: !value,
-            value
-          }))
+          if (batch !== null && idx < batch.length) {
+            return Promise.resolve({ done: false, value: batch[idx++] })
+          }
+          if (exhausted || (batch !== null && batch.length === 0)) {
+            return Promise.resolve({ done: true, value: null })
+          }
+          return fetch().then((features) => {
+            batch = features
+            idx = 0
+            if (!batch.length) return { done: true, value: null }
+            return { done: false, value: batch[idx++] }
+          })
         }
       }
     }
   }
 
+  /**
+ * Iterates through all features using an async iterator that reads ahead
+ *
+ * The features are read in batches of `batchSize` in background jobs,
+ * while the caller is processing the current batch, up to `prefetch` batches
+ * are read in advance so that the decoding in GDAL overlaps with the
+ * processing in JS. The reading pauses when the queue is full and it
+ * resumes as soon as a batch is consumed.
+ *
+ * The reading starts immediately, it is reset at the beginning and then
+ * uses the current reading position of the layer, the features should not be
+ * read by other means while iterating.
+ *
+ * Breaking out of a `for await` loop (or calling `return()`) stops the
+ * reading, the batches already read are released.
+ *
+ * With `view` set, the iterator returns read-only
+ * {{#crossLink "gdal.FeatureView"}}FeatureView{{/crossLink}}s instead of features,
+ * they decode the fields and copy the geometry only when accessed. Every view
+ * is released when the iterator advances, `toFeature()` returns a copy that
+ * can be kept.
+ *
+ * @example
+ * ```
+ * for await (const feature of layer.features.iterate({ prefetch: 4, batchSize: 1024 })) {
+ * }
+ *
+ * for await (const view of layer.features.iterate({ view: true })) {
+ *   if (view.get('kind') === 'river') rivers.push(view.toFeature())
+ * }```
+ *
+ * @for gdal.LayerFeatures
+ * @method iterate
+ * @param {LayerIterateOptions} [options]
+ * @param {number} [options.prefetch=2] Maximum number of batches read in advance
+ * @param {number} [options.batchSize=256] Number of features read in a single background job
+ * @param {boolean} [options.view=false] Return FeatureViews that are valid until the iterator advances
+ * @return {AsyncIterableIterator<gdal.Feature|gdal.FeatureView>}
+ */
+  gdal.LayerFeatures.prototype.iterate = function (options) {
+    const { prefetch, batchSize, view } = {
+      prefetch: 2,
+      batchSize: asyncIteratorBatchSize,
+      view: false,
+      ...options || {}
+    }
+    if (!Number.isInteger(prefetch) || prefetch < 1) {
+      throw new RangeError('prefetch must be a positive integer')
+    }
+    if (!Number.isInteger(batchSize) || batchSize < 1) {
+      throw new RangeError('batchSize must be a positive integer')
+    }
+
+    // Batches read in advance, never more than prefetch
+    const queue = []
+    let batch = []
+    let idx = 0
+    let reading = null
+    let started = false
+    let exhausted = false
+    let closed = false
+    let error = null
+    // The view returned last, released on the next call
+    let current = null
+
+    const release = (views) => {
+      if (view) views.forEach((v) => v && v.release())
+    }
+
+    // There is never more than one job in flight, they would compete for the
+    // dataset lock and the batches could arrive out of order
+    const readAhead = () => {
+      if (reading || exhausted || closed || error || queue.length >= prefetch) return
+      // The first batch is a single feature: firstAsync() resets the reading
+      const size = started || view ? batchSize : 1
+      let job
+      if (view) job = this.nextViewsAsync(batchSize, { reset: !started })
+      else if (started) job = this.nextBatchAsync(batchSize)
+      else job = this.firstAsync().then((feature) => (feature ? [ feature ] : []))
+      started = true
+      reading = job.then((features) => {
+        reading = null
+        if (closed) {
+          release(features)
+          return
+        }
+        exhausted = features.length < size
+        if (features.length) queue.push(features)
+        readAhead()
+      }, (e) => {
+        reading = null
+        error = e
+      })
+    }
+
+    const iterator = {
+      next: () => {
+        if (current) {
+          current.release()
+          current = null
+        }
+        if (idx >= batch.length && queue.length) {
+          batch = queue.shift()
+          idx = 0
+        }
+        if (idx < batch.length) {
+          const value = batch[idx]
+          batch[idx++] = undefined
+          if (view) current = value
+          readAhead()
+          return Promise.resolve({ done: false, value })
+        }
+        if (error) {
+          const e = error
+          iterator.return()
+          return Promise.reject(e)
+        }
+        readAhead()
+        if (!reading) return Promise.resolve({ done: true, value: null })
+        return reading.then(() => iterator.next())
+      },
+      return: () => {
+        closed = true
+        if (current) current.release()
+        current = null
+        release(batch)
+        queue.forEach(release)
+        queue.length = 0
+        batch = []
+        idx = 0
+        return Promise.resolve({ done: true, value: null })
+      },
+      [Symbol.asyncIterator]: () => iterator
+    }
+
+    readAhead()
+    return iterator
+  }
+
+  /**
+ * Executes an SQL statement and iterates through the results in batches
+ * of features using an async iterator
+ *
+ * The statement is executed in a background job on the first call of `next()`,
+ * the result set is never exposed and it is released explicitly in a
+ * background job as soon as it is exhausted or the iteration is abandoned,
+ * its lifetime does not depend on the garbage collector.
+ *
+ * @example
+ * ```
+ * const query = ds.querySQLAsync('SELECT name, SUM(area) FROM parcels GROUP BY name', { batchSize: 1024 });
+ * for await (const features of query) {
+ * }```
+ *
+ * @for gdal.Dataset
+ * @method querySQLAsync
+ * @param {string} statement SQL statement to execute
+ * @param {QuerySQLOptions} [options]
+ * @param {string} [options.dialect] SQL dialect, see `executeSQL`
+ * @param {gdal.Geometry} [options.spatialFilter] Geometry which represents a spatial filter
+ * @param {number} [options.batchSize=256] Number of features read in a single background job
+ * @return {AsyncIterableIterator<gdal.Feature[]>}
+ */
+  gdal.Dataset.prototype.querySQLAsync = function (statement, options) {
+    const { dialect, spatialFilter, batchSize } = { batchSize: asyncIteratorBatchSize, ...options || {} }
+    if (typeof statement !== 'string') {
+      throw new TypeError('statement must be a string')
+    }
+    if (!Number.isInteger(batchSize) || batchSize < 1) {
+      throw new RangeError('batchSize must be a positive integer')
+    }
+
+    let results = null
+    let pending = null
+    let done = false
+
+    const release = () => {
+      if (!results) return Promise.resolve()
+      const layer = results
+      results = null
+      return this.releaseResultSetAsync(layer)
+    }
+
+    const read = () => (results ?
+      Promise.resolve(results) :
+      this.executeSQLAsync(statement, spatialFilter || null, dialect || null).then((layer) => {
+        results = layer
+        return layer
+      }))
+      .then((layer) => layer.features.nextBatchAsync(batchSize))
+      .then((features) => {
+        if (features.length < batchSize) {
+          done = true
+          return release().then(() => (features.length ?
+            { done: false, value: features } :
+            { done: true, value: null }))
+        }
+        return { done: false, value: features }
+      }, (e) => {
+        done = true
+        // The original error is more relevant
+        return release().catch(() => undefined).then(() => {
+          throw e
+        })
+      })
+
+    const iterator = {
+      next: () => {
+        // Every call waits for the previous one, otherwise the statement
+        // could be executed twice and the batches returned out of order
+        pending = (pending || Promise.resolve())
+          .catch(() => undefined)
+          .then(() => (done ? { done: true, value: null } : read()))
+        return pending
+      },
+      return: () => {
+        done = true
+        // A statement can still be executing
+        return (pending || Promise.resolve())
+          .catch(() => undefined)
+          .then(() => release())
+          .then(() => ({ done: true, value: null }))
+      },
+      [Symbol.asyncIterator]: () => iterator
+    }
+
+    return iterator
+  }
+
   /**
  * Iterates through all fields using a callback function.
  *
@@ -182,16 +434,5 @@ module.exports = function (gdal) {
     return JSON.stringify(this.toObject())
   }
 
-  /**
- * Converts the geometry to a GeoJSON object representation.
- *
- * @for gdal.Geometry
- * @method toObject
- * @return {object} GeoJSON
- */
-  gdal.Geometry.prototype.toObject = function () {
-    return JSON.parse(this.toJSON())
-  }
-
   require('./default_iterators.js')(gdal)
 }
@@ -4,6 +4,8 @@ const debug = process.env.NODE_DEBUG && process.env.NODE_DEBUG.match(/gdal_write
   console.debug.bind(console, 'RasterWriteStream:') :
   () => undefined
 
+const defaultMemoryLimit = 16 * 1024 * 1024
+
 /**
  * create a Writable stream from a raster band
  *
@@ -12,6 +14,7 @@ const debug = process.env.NODE_DEBUG && process.env.NODE_DEBUG.match(/gdal_write
  * @param {RasterWritableOptions} [options]
  * @param {boolean} [options.blockOptimize=true] Write by file blocks when possible (when rasterSize.x == blockSize.x)
  * @param {boolean} [options.convertNoData=true] Automatically convert `NaN` to `gdal.RasterBand.noDataValue` if it is set
+ * @param {number} [options.memoryLimit=16777216] Maximum amount of memory in bytes used for write-behind buffering
  * @returns {RasterWriteStream}
  */
 function createWriteStream(options) {
@@ -26,8 +29,13 @@ function createWriteStream(options) {
  * Writing is buffered and it is aligned on the underlying
  * compression blocks for maximum efficiency when possible
  *
- * When piping between rasters using identical blocks,
- * the transfer is zero-copy
+ * Writing is write-behind: incoming chunks of any size are copied
+ * to block-aligned staging buffers and the writer is signaled immediately,
+ * the full blocks are then written in the background, several blocks
+ * at a time, while the writer is producing the next chunks.
+ * When more than `memoryLimit` bytes are waiting to be written,
+ * the writer is signaled only when enough blocks have been written,
+ * producing backpressure through the normal `stream.Writable` protocol
  *
  * The input stream must be in row-major order
  *
@@ -35,10 +43,6 @@ function createWriteStream(options) {
  * of the file, GDAL will automatically convert. Mixing data types
  * across chunks is not supported, all chunks must have the same type.
  *
- * Writing is zero-copy when writing chunks that are exact
- * multiples of the underlying stream block size as returned
- * by `gdal.RasterBandPixels.blockSize`
- *
  * Block are written only when full, so the stream must
  * receive exactly `width * height` pixels to write the last block
  *
@@ -49,15 +53,26 @@ function createWriteStream(options) {
  * @param {RasterBand} options.band RasterBand to use
  * @param {boolean} [options.blockOptimize=true] Write by file blocks when possible (when rasterSize.x == blockSize.x)
  * @param {boolean} [options.convertNoData=false] Automatically convert `NaN` to `gdal.RasterBand.noDataValue` if it is set when the stream is constructed
+ * @param {number} [options.memoryLimit=16777216] Maximum amount of memory in bytes used for write-behind buffering
  */
 class RasterWriteStream extends Writable {
   constructor(options) {
     super({ ...options, objectMode: true })
     this.band = options.band
-    this.buffers = []
-    this.buffered = 0
-    this.writingPos = 0
-    this.blockPos = 0
+    this.memoryLimit = options.memoryLimit !== undefined ? options.memoryLimit : defaultMemoryLimit
+    // the block currently being filled
+    this.stage = null
+    this.stagePos = 0
+    // the lines already assigned to a staging block
+    this.stagedLines = 0
+    // full blocks waiting to be written
+    this.ready = []
+    this.readyBytes = 0
+    // the blocks being written
+    this.writing = null
+    this.writingBytes = 0
+    this.error = null
+    this.waiting = null
 
     if (!options.band.pixels) {
       throw new TypeError('"band" must be a gdal.RasterBand')
@@ -66,21 +81,20 @@ class RasterWriteStream extends Writable {
     this.initQ = Promise.all([ this.band.blockSizeAsync, this.band.sizeAsync, this.band.noDataValueAsync ])
       .then(([ blockSize, rasterSize, noDataValue ]) => {
         this.blockSize = blockSize
-        this.blockLen = blockSize.x * blockSize.y
         this.rasterSize = rasterSize
         if (options.convertNoData && noDataValue !== null) {
           this._convertNoData = this._doConvertNoData.bind(this, noDataValue)
         } else {
           this._convertNoData = () => undefined
         }
+        // When the file blocks span whole lines, the staging blocks are exactly the file blocks
         if (blockSize.x == rasterSize.x && options.blockOptimize !== false) {
           debug('init done, optimized block write', blockSize, rasterSize)
-          this._writeNextBuffer = RasterWriteStream.prototype._writeNextBlock
+          this.stageLines = blockSize.y
           return
         }
         debug('init done, line by line write', blockSize, rasterSize)
-        this.blockLen = this.rasterSize.x
-        this._writeNextBuffer = RasterWriteStream.prototype._writeNextLine
+        this.stageLines = 1
       })
   }
 }
@@ -91,96 +105,119 @@ RasterWriteStream.prototype._doConvertNoData = function (noData, buffer) {
   }
 }
 
-RasterWriteStream.prototype._writeNextBlock = function (buffer) {
-  const q = this.band.pixels.writeBlockAsync(0, this.blockPos, buffer)
-  this.blockPos++
-  this.writingPos += this.blockSize.y
-  if (this.writingPos + this.blockSize.y > this.rasterSize.y) {
-    // the next block will be an edge block
-    this._writeNextBuffer = RasterWriteStream.prototype._writeNextLine
-    this.blockLen = this.rasterSize.x
-    debug('next block will be an edge block of size', this.blockLen)
-  }
-  return q
+RasterWriteStream.prototype._pendingBytes = function () {
+  return (this.stage ? this.stage.byteLength : 0) + this.readyBytes + this.writingBytes
 }
 
-RasterWriteStream.prototype._writeNextLine = function (buffer) {
-  const q = this.band.pixels.writeAsync(0, this.writingPos, this.rasterSize.x, 1, buffer)
-  this.blockPos++
-  this.writingPos++
-  return q
+// A single block larger than the limit must not block the writer forever
+RasterWriteStream.prototype._overLimit = function () {
+  return (this.writing || this.ready.length > 0) && this._pendingBytes() > this.memoryLimit
 }
 
-RasterWriteStream.prototype._writeNext = function (cb) {
-  const q = []
-  while (this.buffered >= this.blockLen) {
-    // We have enough for one block
-    let buffer
-    if (this.buffers[0].length == this.blockLen) {
-      debug('writing full block in zero-copy mode', this.buffered, this.blockLen)
-      // zero-copy piping when:
-      // source.blockSize == target.blockSize && target.blockSize.x = target.rasterSize.x
-      buffer = this.buffers[0]
-      this.buffers.shift()
-    } else {
-      debug('writing full block in block consolidation mode', this.buffered, this.blockLen, this.buffers.map((buf) => buf.length))
-      // block writing with in-memory copying (no gdal.RasterBand.pixels.writev)
-      // source.blockSize != target.blockSize && target.blockSize.x = target.rasterSize.x
-      buffer = new this.buffers[0].constructor(this.blockLen)
-      let len = 0
-      while (len + this.buffers[0].length < this.blockLen) {
-        buffer.set(this.buffers[0], len)
-        len += this.buffers[0].length
-        this.buffers.shift()
-      }
-      buffer.set(this.buffers[0].subarray(0, this.blockLen - len), len)
-      if (this.blockLen - len < this.buffers[0].length) {
-        this.buffers[0] = this.buffers[0].subarray(this.blockLen - len)
-      } else {
-        this.buffers.shift()
-      }
-    }
+// Resolves when all full blocks have been written
+RasterWriteStream.prototype._idle = function () {
+  return this.writing ? this.writing.then(() => this._idle()) : Promise.resolve()
+}
 
-    debug('writing', this.blockPos, this.writingPos, buffer.length)
-    this._convertNoData(buffer)
-    q.push(this._writeNextBuffer(buffer))
-    this.buffered -= buffer.length
-    if (this.writingPos == this.rasterSize.y) {
-      debug('raster finished')
-      // We just wrote the last block
-      this.rasterFinished = true
+// Copy a chunk to the staging blocks, returns the number of elements that did not fit in the raster
+RasterWriteStream.prototype._stageChunk = function (chunk) {
+  let pos = 0
+  while (pos < chunk.length) {
+    if (!this.stage) {
+      if (this.stagedLines == this.rasterSize.y) break
+      // the last block can be an edge block
+      const lines = Math.min(this.stageLines, this.rasterSize.y - this.stagedLines)
+      this.stage = new chunk.constructor(lines * this.rasterSize.x)
+      this.stageY = this.stagedLines
+      this.stagePos = 0
+      this.stagedLines += lines
     }
-
-    if (this.writingPos > this.rasterSize.y ||
-          this.rasterFinished && this.buffers[0] && this.buffers[0].length > 0) {
-      debug('emit write beyond end error')
-      cb(new RangeError('Writing beyond the end of the raster, ' +
-        `${this.buffered + (this.writingPos - this.rasterSize.y) * this.rasterSize.x} extra element(s)`))
-      return
+    const len = Math.min(chunk.length - pos, this.stage.length - this.stagePos)
+    this.stage.set(len == chunk.length ? chunk : chunk.subarray(pos, pos + len), this.stagePos)
+    this.stagePos += len
+    pos += len
+    if (this.stagePos == this.stage.length) {
+      this._convertNoData(this.stage)
+      this.ready.push({ y: this.stageY, data: this.stage })
+      this.readyBytes += this.stage.byteLength
+      this.stage = null
     }
   }
+  return chunk.length - pos
+}
 
-  if (q.length) {
-    // We were actually writing
-    // Signal the writer only when all blocks are written
-    Promise.all(q)
-      .then((r) => {
-        debug('signal when writing', r.length)
-        try {
-          cb()
-        } catch (e) {
-          // Exceptions in the user callback are tricky
-          this.destroy(e)
-        }
-      })
-      .catch((err) => {
-        debug('re-emitting error', err)
-        cb(err)
-      })
+// Write all full blocks in the background, one operation at a time
+RasterWriteStream.prototype._flush = function () {
+  if (this.writing || this.error || !this.ready.length) return
+
+  const blocks = this.ready
+  this.ready = []
+  this.writingBytes = this.readyBytes
+  this.readyBytes = 0
+  const y = blocks[0].y
+  const lines = blocks.reduce((a, b) => a + b.data.length, 0) / this.rasterSize.x
+  debug('writing', y, lines, blocks.length)
+
+  this.writing = this.band.pixels.writevAsync(0, y, this.rasterSize.x, lines, blocks.map((b) => b.data))
+    .catch((err) => {
+      debug('write error', err)
+      this.error = err
+    })
+    .then(() => {
+      this.writing = null
+      this.writingBytes = 0
+      this._flush()
+      this._release()
+    })
+}
+
+RasterWriteStream.prototype._signal = function (cb, err) {
+  try {
+    cb(err)
+  } catch (e) {
+    // Exceptions in the user callback are tricky
+    this.destroy(e)
+  }
+}
+
+// Signal the writer if it has been waiting for the memory to be released
+RasterWriteStream.prototype._release = function () {
+  if (!this.waiting) return
+  if (this.error || !this._overLimit()) {
+    const cb = this.waiting
+    this.waiting = null
+    debug('signal after waiting')
+    this._signal(cb, this.error)
+  }
+}
+
+RasterWriteStream.prototype._writeChunk = function (chunk, cb) {
+  if (this.error) {
+    cb(this.error)
+    return
+  }
+  const extra = this._stageChunk(chunk)
+  if (extra > 0) {
+    debug('emit write beyond end error')
+    cb(new RangeError(`Writing beyond the end of the raster, ${extra} extra element(s)`))
+    return
+  }
+  this._flush()
+
+  if (this.stagedLines == this.rasterSize.y && !this.stage) {
+    debug('raster finished')
+    this.rasterFinished = true
+    // The last chunk is signaled only when the whole raster has been written
+    this._idle().then(() => this._signal(cb, this.error))
     return
   }
 
-  // We are block-buffering for now so tell the writer to continue
+  if (this._overLimit()) {
+    // Exert backpressure until enough blocks have been written
+    debug('memory limit reached, waiting', this._pendingBytes())
+    this.waiting = cb
+    return
+  }
   debug('signal when buffering')
   cb()
 }
@@ -190,24 +227,26 @@ RasterWriteStream.prototype._write = function (chunk, _, callback) {
 
   let err
   if (!chunk.length || !chunk.BYTES_PER_ELEMENT) err = new TypeError('Only TypedArrays are supported')
-  if (this.buffers.length > 0 && this.buffers[0].constructor !== chunk.constructor) err = TypeError('Type mixing is not supported')
+  if (this.type && this.type !== chunk.constructor) err = TypeError('Type mixing is not supported')
   if (this.rasterFinished) err = new RangeError('Writing beyond the end of the raster')
   if (err) {
     debug('emit error', err)
     callback(err)
     return
   }
+  this.type = chunk.constructor
 
-  this.buffers.push(chunk)
-  this.buffered += chunk.length
-
-  this.initQ.then(() => this._writeNext(callback))
+  this.initQ.then(() => this._writeChunk(chunk, callback))
 }
 
 RasterWriteStream.prototype._final = function (cb) {
-  if (this.buffered > 0) return cb('Stream finished with pending data')
+  if (this.stage) return cb('Stream finished with pending data')
   if (!this.rasterFinished) return cb('Stream finished before filling the raster')
-  this.band.ds.flushAsync()
+  this._idle()
+    .then(() => {
+      if (this.error) throw this.error
+      return this.band.ds.flushAsync()
+    })
     .catch((e) => ({ err: e }))
     .then((r) => {
       if (r && r.err) {
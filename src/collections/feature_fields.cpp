@@ -155,24 +155,22 @@ NAN_METHOD(FeatureFields::set) {
 
       n = f->get()->GetFieldCount();
       n_fields_set = 0;
+      FieldNames *names = FieldNames::get(f->get()->GetDefnRef());
 
       for (i = 0; i < n; i++) {
         // iterate through field names from field defn,
         // grabbing values from passed object, if not undefined
 
-        OGRFieldDefn *field_def = f->get()->GetFieldDefnRef(i);
+        Local<String> field_name = names->name(i);
+        if (field_name.IsEmpty()) continue;
 
-        const char *field_name = field_def->GetNameRef();
-
-        field_index = f->get()->GetFieldIndex(field_name);
+        field_index = names->firstIndex(i);
 
         // skip value if field name doesnt exist
         // both in the feature definition and the passed object
-        if (field_index == -1 || !Nan::HasOwnProperty(values, Nan::New(field_name).ToLocalChecked()).FromMaybe(false)) {
-          continue;
-        }
+        if (field_index == -1 || !Nan::HasOwnProperty(values, field_name).FromMaybe(false)) { continue; }
 
-        Local<Value> val = Nan::Get(values, Nan::New(field_name).ToLocalChecked()).ToLocalChecked();
+        Local<Value> val = Nan::Get(values, field_name).ToLocalChecked();
         if (setField(f->get(), field_index, val)) {
           Nan::ThrowError("Unsupported type of field value");
           return;
@@ -244,19 +242,19 @@ NAN_METHOD(FeatureFields::reset) {
   }
 
   Local<Object> values = info[0].As<Object>();
+  FieldNames *names = FieldNames::get(f->get()->GetDefnRef());
 
   for (i = 0; i < n; i++) {
     // iterate through field names from field defn,
     // grabbing values from passed object
 
-    OGRFieldDefn *field_def = f->get()->GetFieldDefnRef(i);
-
-    const char *field_name = field_def->GetNameRef();
+    Local<String> field_name = names->name(i);
+    if (field_name.IsEmpty()) continue;
 
-    field_index = f->get()->GetFieldIndex(field_name);
+    field_index = names->firstIndex(i);
     if (field_index == -1) continue;
 
-    Local<Value> val = Nan::Get(values, Nan::New(field_name).ToLocalChecked()).ToLocalChecked();
+    Local<Value> val = Nan::Get(values, field_name).ToLocalChecked();
     if (setField(f->get(), field_index, val)) {
       Nan::ThrowError("Unsupported type of field value");
       return;
@@ -336,12 +334,12 @@ NAN_METHOD(FeatureFields::toObject) {
   Local<Object> obj = Nan::New<Object>();
 
   int n = f->get()->GetFieldCount();
+  FieldNames *names = FieldNames::get(f->get()->GetDefnRef());
   for (int i = 0; i < n; i++) {
 
     // get field name
-    OGRFieldDefn *field_def = f->get()->GetFieldDefnRef(i);
-    const char *key = field_def->GetNameRef();
-    if (!key) {
+    Local<String> key = names->name(i);
+    if (key.IsEmpty()) {
       Nan::ThrowError("Error getting field name");
       return;
     }
@@ -349,7 +347,7 @@ NAN_METHOD(FeatureFields::toObject) {
     // get field value
     try {
       Local<Value> val = FeatureFields::get(f->get(), i);
-      Nan::Set(obj, Nan::New(key).ToLocalChecked(), val);
+      Nan::Set(obj, key, val);
     } catch (const char *err) {
       Nan::ThrowError(err);
       return;
@@ -473,17 +471,17 @@ NAN_METHOD(FeatureFields::getNames) {
 
   int n = f->get()->GetFieldCount();
   Local<Array> result = Nan::New<Array>(n);
+  FieldNames *names = FieldNames::get(f->get()->GetDefnRef());
 
   for (int i = 0; i < n; i++) {
 
     // get field name
-    OGRFieldDefn *field_def = f->get()->GetFieldDefnRef(i);
-    const char *field_name = field_def->GetNameRef();
-    if (!field_name) {
+    Local<String> field_name = names->name(i);
+    if (field_name.IsEmpty()) {
       Nan::ThrowError("Error getting field name");
       return;
     }
-    Nan::Set(result, i, Nan::New(field_name).ToLocalChecked());
+    Nan::Set(result, i, field_name);
   }
 
   info.GetReturnValue().Set(result);
@@ -2,6 +2,7 @@
 #include "../gdal_common.hpp"
 #include "../geometry/gdal_geometry.hpp"
 #include "../geometry/gdal_geometrycollection.hpp"
+#include "../utils/flat_coordinates.hpp"
 
 namespace node_gdal {
 
@@ -19,6 +20,8 @@ void GeometryCollectionChildren::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "get", get);
   Nan::SetPrototypeMethod(lcons, "remove", remove);
   Nan::SetPrototypeMethod(lcons, "add", add);
+  Nan::SetPrototypeMethod(lcons, "toFlatArray", toFlatArray);
+  Nan::SetPrototypeMethod(lcons, "fromFlatArray", fromFlatArray);
 
   Nan::Set(target, Nan::New("GeometryCollectionChildren").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
 
@@ -200,4 +203,84 @@ NAN_METHOD(GeometryCollectionChildren::add) {
   return;
 }
 
+/**
+ * Returns the coordinates of all the geometries of a `MultiPoint`,
+ * `MultiLineString` or `MultiPolygon` as a single `Float64Array` of
+ * interleaved coordinates and GeoArrow-style `Uint32Array` offsets:
+ * none for a `MultiPoint`, the line offsets for a `MultiLineString`,
+ * the polygon offsets into the rings followed by the ring offsets
+ * for a `MultiPolygon`.
+ *
+ * The default number of dimensions is 2, 3 for geometries with Z and 4
+ * (XYZM) for measured geometries, missing Z and M values are returned as 0.
+ *
+ * @example
+ * ```
+ * const { coordinates, offsets } = multiPolygon.children.toFlatArray();
+ * const [ polygons, rings ] = offsets;```
+ *
+ * @method toFlatArray
+ * @throws Error
+ * @param {FlatCoordinatesOptions} [options]
+ * @param {number} [options.dims] 2 for XY, 3 for XYZ, 4 for XYZM
+ * @return {FlatCoordinates}
+ */
+NAN_METHOD(GeometryCollectionChildren::toFlatArray) {
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  GeometryCollection *geom = Nan::ObjectWrap::Unwrap<GeometryCollection>(parent);
+
+  int dims = FlatCoordinates::Dims(geom->get());
+  if (!FlatCoordinates::ParseDims(info[0], dims)) return;
+
+  FlatCoordinates flat(dims);
+  try {
+    flat.add(geom->get());
+  } catch (const char *err) {
+    Nan::ThrowError(err);
+    return;
+  }
+  info.GetReturnValue().Set(flat.ToObject());
+}
+
+/**
+ * Replaces all the geometries of a `MultiPoint`, `MultiLineString` or
+ * `MultiPolygon` with the ones from a `Float64Array` of interleaved
+ * coordinates and `Uint32Array` offsets in the same format as the one returned
+ * by `toFlatArray()`, the collection gets the dimensions of the array.
+ *
+ * This is much faster than building the geometries one point at a time.
+ *
+ * @example
+ * ```
+ * const flat = multiPolygon.children.toFlatArray();
+ * other.children.fromFlatArray(flat.coordinates, flat.offsets, { dims: flat.dims });```
+ *
+ * @method fromFlatArray
+ * @throws Error
+ * @param {Float64Array} coordinates
+ * @param {Uint32Array[]} offsets
+ * @param {FlatCoordinatesOptions} [options]
+ * @param {number} [options.dims=2] 2 for XY, 3 for XYZ, 4 for XYZM
+ */
+NAN_METHOD(GeometryCollectionChildren::fromFlatArray) {
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  GeometryCollection *geom = Nan::ObjectWrap::Unwrap<GeometryCollection>(parent);
+
+  int dims = 2;
+  const double *xy;
+  size_t count;
+  std::vector<std::vector<uint32_t>> offsets;
+  if (!FlatCoordinates::ParseDims(info[2], dims)) return;
+  if (!FlatCoordinates::ParseCoordinates(info[0], dims, xy, count)) return;
+  if (!FlatCoordinates::ParseOffsets(info[1], offsets)) return;
+
+  try {
+    FlatCoordinates::Import(geom->get(), dims, xy, count, offsets);
+  } catch (const char *err) { Nan::ThrowError(err); }
+}
+
 } // namespace node_gdal
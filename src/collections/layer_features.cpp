@@ -1,7 +1,12 @@
 #include "layer_features.hpp"
 #include "../gdal_common.hpp"
 #include "../gdal_feature.hpp"
+#include "../gdal_feature_view.hpp"
 #include "../gdal_layer.hpp"
+#include "../utils/layer_columns.hpp"
+#include "../utils/geojson_writer.hpp"
+
+#include <memory>
 
 namespace node_gdal {
 
@@ -17,10 +22,14 @@ void LayerFeatures::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "toString", toString);
   Nan__SetPrototypeAsyncableMethod(lcons, "count", count);
   Nan__SetPrototypeAsyncableMethod(lcons, "add", add);
+  Nan__SetPrototypeAsyncableMethod(lcons, "addMany", addMany);
   Nan__SetPrototypeAsyncableMethod(lcons, "get", get);
   Nan__SetPrototypeAsyncableMethod(lcons, "set", set);
   Nan__SetPrototypeAsyncableMethod(lcons, "first", first);
   Nan__SetPrototypeAsyncableMethod(lcons, "next", next);
+  Nan__SetPrototypeAsyncableMethod(lcons, "nextBatch", nextBatch);
+  Nan__SetPrototypeAsyncableMethod(lcons, "nextViews", nextViews);
+  Nan__SetPrototypeAsyncableMethod(lcons, "nextGeoJSON", nextGeoJSON);
   Nan__SetPrototypeAsyncableMethod(lcons, "remove", remove);
 
   ATTR_DONT_ENUM(lcons, "layer", layerGetter, READ_ONLY_SETTER);
@@ -213,6 +222,250 @@ GDAL_ASYNCABLE_DEFINE(LayerFeatures::next) {
   job.run(info, async, 0);
 }
 
+/**
+ * Returns up to `count` next features in the layer.
+ * Returns an empty array if no more features.
+ *
+ * @example
+ * ```
+ * let batch;
+ * while ((batch = layer.features.nextBatch(1000)).length) { ... }```
+ *
+ * @method nextBatch
+ * @param {number} count maximum number of features to return
+ * @return {gdal.Feature[]}
+ */
+
+/**
+ * Returns up to `count` next features in the layer.
+ * Returns an empty array if no more features.
+ * {{{async}}}
+ *
+ * All features are read in a single background job and are wrapped on the main thread
+ * in a single pass, this is much faster than calling `nextAsync()` for each feature.
+ *
+ * @example
+ * ```
+ * let batch;
+ * while ((batch = await layer.features.nextBatchAsync(1000)).length) { ... }```
+ *
+ * @method nextBatchAsync
+ * @param {number} count maximum number of features to return
+ * @param {callback<gdal.Feature[]>} [callback=undefined] {{{cb}}}
+ * @return {Promise<gdal.Feature[]>}
+ */
+GDAL_ASYNCABLE_DEFINE(LayerFeatures::nextBatch) {
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(parent);
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object already destroyed");
+    return;
+  }
+
+  int count;
+  NODE_ARG_INT(0, "count", count);
+  if (count <= 0) {
+    Nan::ThrowRangeError("count must be a positive integer");
+    return;
+  }
+
+  OGRLayer *gdal_layer = layer->get();
+  GDALAsyncableJob<std::vector<OGRFeature *>> job(layer->parent_uid);
+  job.persist(layer->handle());
+  job.main = [gdal_layer, count](const GDALExecutionProgress &) {
+    std::vector<OGRFeature *> features;
+    while (features.size() < static_cast<size_t>(count)) {
+      OGRFeature *feature = gdal_layer->GetNextFeature();
+      if (feature == nullptr) break;
+      features.push_back(feature);
+    }
+    return features;
+  };
+  job.rval = [](std::vector<OGRFeature *> features, const GetFromPersistentFunc &) {
+    Nan::EscapableHandleScope scope;
+    Local<Array> result = Nan::New<Array>(features.size());
+    for (size_t i = 0; i < features.size(); i++) Nan::Set(result, i, Feature::New(features[i]));
+    return scope.Escape(result.As<Value>());
+  };
+  job.run(info, async, 1);
+}
+
+/**
+ * Returns up to `count` next features in the layer as
+ * {{#crossLink "gdal.FeatureView"}}FeatureView{{/crossLink}}s.
+ * Returns an empty array if no more features.
+ *
+ * The views share the features read from the layer without copying them,
+ * they should be released when they are not needed anymore.
+ *
+ * @method nextViews
+ * @param {number} count maximum number of features to return
+ * @param {NextViewsOptions} [options]
+ * @param {boolean} [options.reset=false] Reset the reading before reading the features
+ * @return {gdal.FeatureView[]}
+ */
+
+/**
+ * Returns up to `count` next features in the layer as
+ * {{#crossLink "gdal.FeatureView"}}FeatureView{{/crossLink}}s.
+ * Returns an empty array if no more features.
+ * {{{async}}}
+ *
+ * This is the primitive used by `iterate({ view: true })`.
+ *
+ * @method nextViewsAsync
+ * @param {number} count maximum number of features to return
+ * @param {NextViewsOptions} [options]
+ * @param {boolean} [options.reset=false] Reset the reading before reading the features
+ * @param {callback<gdal.FeatureView[]>} [callback=undefined] {{{cb}}}
+ * @return {Promise<gdal.FeatureView[]>}
+ */
+GDAL_ASYNCABLE_DEFINE(LayerFeatures::nextViews) {
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(parent);
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object already destroyed");
+    return;
+  }
+
+  int count;
+  Local<Object> options;
+  bool reset = false;
+  NODE_ARG_INT(0, "count", count);
+  NODE_ARG_OBJECT_OPT(1, "options", options);
+  if (!options.IsEmpty()) { NODE_BOOL_FROM_OBJ_OPT(options, "reset", reset); }
+  if (count <= 0) {
+    Nan::ThrowRangeError("count must be a positive integer");
+    return;
+  }
+
+  OGRLayer *gdal_layer = layer->get();
+  GDALAsyncableJob<std::vector<OGRFeature *>> job(layer->parent_uid);
+  job.persist(layer->handle());
+  job.main = [gdal_layer, count, reset](const GDALExecutionProgress &) {
+    std::vector<OGRFeature *> features;
+    if (reset) gdal_layer->ResetReading();
+    while (features.size() < static_cast<size_t>(count)) {
+      OGRFeature *feature = gdal_layer->GetNextFeature();
+      if (feature == nullptr) break;
+      features.push_back(feature);
+    }
+    return features;
+  };
+  job.rval = [](std::vector<OGRFeature *> features, const GetFromPersistentFunc &) {
+    Nan::EscapableHandleScope scope;
+    Local<Array> result = Nan::New<Array>(features.size());
+    for (size_t i = 0; i < features.size(); i++) Nan::Set(result, i, FeatureView::New(features[i]));
+    return scope.Escape(result.As<Value>());
+  };
+  job.run(info, async, 2);
+}
+
+/**
+ * Serializes the next features of the layer to GeoJSON in a single `Buffer`.
+ * Returns null if no more features.
+ *
+ * Features are read until the `Buffer` reaches `chunkSize` bytes.
+ * They are separated by `,\n` or by `\n` when `newlineDelimited` is set,
+ * the `FeatureCollection` header is not included.
+ *
+ * This is the primitive used by {{#crossLink "gdal.LayerGeoJSONStream"}}LayerGeoJSONStream{{/crossLink}}.
+ *
+ * @method nextGeoJSON
+ * @param {GeoJSONOptions} [options]
+ * @param {string[]} [options.fields] Fields to include, all the fields by default
+ * @param {number} [options.precision] Maximum number of decimals of the coordinates, 7 with `rfc7946`, 15 otherwise
+ * @param {boolean} [options.rfc7946=false] Reproject to WGS84 and apply the right-hand rule to polygons
+ * @param {boolean} [options.newlineDelimited=false] Separate the features with newlines only (GeoJSONSeq / NDJSON)
+ * @param {number} [options.chunkSize=65536] Approximate size of the returned `Buffer`
+ * @param {boolean} [options.reset=false] Reset the reading before serializing the features
+ * @return {Buffer|null}
+ */
+
+/**
+ * Serializes the next features of the layer to GeoJSON in a single `Buffer`.
+ * Returns null if no more features.
+ * {{{async}}}
+ *
+ * @method nextGeoJSONAsync
+ * @param {GeoJSONOptions} [options]
+ * @param {string[]} [options.fields] Fields to include, all the fields by default
+ * @param {number} [options.precision] Maximum number of decimals of the coordinates, 7 with `rfc7946`, 15 otherwise
+ * @param {boolean} [options.rfc7946=false] Reproject to WGS84 and apply the right-hand rule to polygons
+ * @param {boolean} [options.newlineDelimited=false] Separate the features with newlines only (GeoJSONSeq / NDJSON)
+ * @param {number} [options.chunkSize=65536] Approximate size of the returned `Buffer`
+ * @param {boolean} [options.reset=false] Reset the reading before serializing the features
+ * @param {callback<Buffer|null>} [callback=undefined] {{{cb}}}
+ * @return {Promise<Buffer|null>}
+ */
+GDAL_ASYNCABLE_DEFINE(LayerFeatures::nextGeoJSON) {
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(parent);
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object already destroyed");
+    return;
+  }
+
+  Local<Object> options;
+  Local<Array> fieldsArray;
+  GeoJSONOptions opts;
+  int precision = -1;
+  int chunkSize = 65536;
+  opts.rfc7946 = false;
+  opts.newlineDelimited = false;
+  opts.reset = false;
+
+  NODE_ARG_OBJECT_OPT(0, "options", options);
+  if (!options.IsEmpty()) {
+    NODE_ARRAY_FROM_OBJ_OPT(options, "fields", fieldsArray);
+    NODE_INT_FROM_OBJ_OPT(options, "precision", precision);
+    NODE_BOOL_FROM_OBJ_OPT(options, "rfc7946", opts.rfc7946);
+    NODE_BOOL_FROM_OBJ_OPT(options, "newlineDelimited", opts.newlineDelimited);
+    NODE_INT_FROM_OBJ_OPT(options, "chunkSize", chunkSize);
+    NODE_BOOL_FROM_OBJ_OPT(options, "reset", opts.reset);
+  }
+
+  opts.allFields = fieldsArray.IsEmpty();
+  if (!opts.allFields) {
+    for (unsigned i = 0; i < fieldsArray->Length(); i++) {
+      Local<Value> name = Nan::Get(fieldsArray, i).ToLocalChecked();
+      if (!name->IsString()) {
+        Nan::ThrowTypeError("fields must be an array of strings");
+        return;
+      }
+      opts.fields.push_back(*Nan::Utf8String(name));
+    }
+  }
+  if (precision > 17) {
+    Nan::ThrowRangeError("precision must be between 0 and 17");
+    return;
+  }
+  if (chunkSize <= 0) {
+    Nan::ThrowRangeError("chunkSize must be a positive integer");
+    return;
+  }
+  opts.precision = precision;
+  opts.chunkSize = static_cast<size_t>(chunkSize);
+
+  OGRLayer *gdal_layer = layer->get();
+  GDALAsyncableJob<std::shared_ptr<GeoJSONWriter>> job(layer->parent_uid);
+  job.persist(layer->handle());
+  job.main = [gdal_layer, opts](const GDALExecutionProgress &) {
+    std::shared_ptr<GeoJSONWriter> writer = std::make_shared<GeoJSONWriter>(opts);
+    CPLErrorReset();
+    writer->read(gdal_layer);
+    return writer;
+  };
+  job.rval = [](std::shared_ptr<GeoJSONWriter> writer, const GetFromPersistentFunc &) { return writer->ToBuffer(); };
+  job.run(info, async, 1);
+}
+
 /**
  * Adds a feature to the layer. The feature should be created using the current
  * layer as the definition.
@@ -274,6 +527,157 @@ GDAL_ASYNCABLE_DEFINE(LayerFeatures::add) {
   job.run(info, async, 1);
 }
 
+/**
+ * Adds many features to the layer in a single operation.
+ *
+ * The features can be given either as an array of `gdal.Feature` or in the columnar
+ * format returned by `gdal.Layer.readColumns()`: an object with a `fields` property
+ * containing an `Int32Array`, `BigInt64Array` or `Float64Array` or a column object
+ * with `data`, `offsets` and `validity` per field name and an optional `geometry`
+ * property with WKB `data` and `offsets` or point `x` and `y` coordinates.
+ * The `fid` column is ignored.
+ *
+ * The features are inserted in transactions of `transactionSize` features
+ * when the dataset supports transactions, or in a single transaction when `transactionSize`
+ * is not specified. If a transaction is already active, no new transaction is started.
+ * When an error occurs, the current transaction is rolled back and the
+ * previously committed features remain in the layer.
+ *
+ * @example
+ * ```
+ * layer.features.addMany(otherLayer.readColumns(), { transactionSize: 10000 });
+ * layer.features.addMany({
+ *   fields: { id: new Int32Array([ 1, 2 ]) },
+ *   geometry: { x: new Float64Array([ 10, 20 ]), y: new Float64Array([ 45, 46 ]) }
+ * });
+ * ```
+ *
+ * @method addMany
+ * @throws Error
+ * @param {gdal.Feature[]|ColumnarFeatures} features
+ * @param {AddManyOptions} [options]
+ * @param {number} [options.transactionSize] Number of features per transaction
+ */
+
+/**
+ * Adds many features to the layer in a single operation.
+ * {{{async}}}
+ *
+ * The features can be given either as an array of `gdal.Feature` or in the columnar
+ * format returned by `gdal.Layer.readColumns()`, see `addMany()`.
+ *
+ * @method addManyAsync
+ * @throws Error
+ * @param {gdal.Feature[]|ColumnarFeatures} features
+ * @param {AddManyOptions} [options]
+ * @param {number} [options.transactionSize] Number of features per transaction
+ * @param {callback<void>} [callback=undefined] {{{cb}}}
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(LayerFeatures::addMany) {
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(parent);
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object already destroyed");
+    return;
+  }
+
+  Local<Object> input;
+  Local<Object> options;
+  int transactionSize = 0;
+  NODE_ARG_OBJECT(0, "features", input);
+  NODE_ARG_OBJECT_OPT(1, "options", options);
+  if (!options.IsEmpty()) NODE_INT_FROM_OBJ_OPT(options, "transactionSize", transactionSize);
+  if (transactionSize < 0) {
+    Nan::ThrowRangeError("transactionSize must be a positive integer");
+    return;
+  }
+
+  std::vector<OGRFeature *> features;
+  std::shared_ptr<ColumnarFeatures> columns;
+  std::vector<Local<Object>> objects;
+  if (input->IsArray()) {
+    Local<Array> array = input.As<Array>();
+    for (unsigned i = 0; i < array->Length(); i++) {
+      Local<Value> val = Nan::Get(array, i).ToLocalChecked();
+      if (!val->IsObject() || !Nan::New(Feature::constructor)->HasInstance(val)) {
+        Nan::ThrowTypeError("features must be an array of Feature objects");
+        return;
+      }
+      Feature *f = Nan::ObjectWrap::Unwrap<Feature>(val.As<Object>());
+      if (!f->isAlive()) {
+        Nan::ThrowError("Feature object already destroyed");
+        return;
+      }
+      features.push_back(f->get());
+      objects.push_back(val.As<Object>());
+    }
+  } else {
+    columns = std::make_shared<ColumnarFeatures>();
+    try {
+      columns->parse(input, objects);
+    } catch (const char *err) {
+      Nan::ThrowError(err);
+      return;
+    }
+  }
+
+  OGRLayer *gdal_layer = layer->get();
+  GDALDataset *gdal_ds = layer->getParent();
+  GDALAsyncableJob<int> job(layer->parent_uid);
+  job.persist(layer->handle());
+  job.persist(objects);
+  job.main = [gdal_layer, gdal_ds, features, columns, transactionSize](const GDALExecutionProgress &) {
+    OGRFeatureDefn *defn = gdal_layer->GetLayerDefn();
+    size_t count = columns ? columns->count : features.size();
+    if (columns) columns->resolve(defn);
+
+    // A failure here usually means that there is already an active transaction
+    bool transaction = false;
+    auto start = [gdal_ds, &transaction]() {
+      if (gdal_ds == nullptr) return;
+      CPLPushErrorHandler(CPLQuietErrorHandler);
+      transaction = gdal_ds->StartTransaction() == OGRERR_NONE;
+      CPLPopErrorHandler();
+      CPLErrorReset();
+    };
+    auto commit = [gdal_ds, &transaction]() {
+      if (!transaction) return;
+      transaction = false;
+      OGRErr err = gdal_ds->CommitTransaction();
+      if (err != OGRERR_NONE) throw getOGRErrMsg(err);
+    };
+
+    start();
+    try {
+      for (size_t i = 0; i < count; i++) {
+        OGRErr err;
+        if (columns) {
+          std::unique_ptr<OGRFeature, void (*)(OGRFeature *)> feature(
+            columns->build(defn, i), OGRFeature::DestroyFeature);
+          err = gdal_layer->CreateFeature(feature.get());
+        } else {
+          err = gdal_layer->CreateFeature(features[i]);
+        }
+        if (err != OGRERR_NONE) throw getOGRErrMsg(err);
+        if (transactionSize > 0 && (i + 1) % transactionSize == 0 && transaction) {
+          commit();
+          start();
+        }
+      }
+      commit();
+    } catch (const char *) {
+      if (transaction) gdal_ds->RollbackTransaction();
+      throw;
+    }
+    return 0;
+  };
+  job.rval = [](int, const GetFromPersistentFunc &) { return Nan::Undefined().As<Value>(); };
+  job.run(info, async, 2);
+}
+
 /**
  * Returns the number of features in the layer.
  *
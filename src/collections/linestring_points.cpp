@@ -3,6 +3,8 @@
 #include "../geometry/gdal_geometry.hpp"
 #include "../geometry/gdal_linestring.hpp"
 #include "../geometry/gdal_point.hpp"
+#include "../utils/flat_coordinates.hpp"
+#include "../utils/typed_array.hpp"
 
 namespace node_gdal {
 
@@ -22,6 +24,8 @@ void LineStringPoints::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "add", add);
   Nan::SetPrototypeMethod(lcons, "reverse", reverse);
   Nan::SetPrototypeMethod(lcons, "resize", resize);
+  Nan::SetPrototypeMethod(lcons, "toFlatArray", toFlatArray);
+  Nan::SetPrototypeMethod(lcons, "fromFlatArray", fromFlatArray);
 
   Nan::Set(target, Nan::New("LineStringPoints").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
 
@@ -378,4 +382,75 @@ NAN_METHOD(LineStringPoints::add) {
   return;
 }
 
+/**
+ * Returns all the points as a single `Float64Array` of interleaved
+ * coordinates, `[x0, y0, x1, y1, ...]` for 2 dimensions.
+ *
+ * The default number of dimensions is 2, 3 for geometries with Z and 4
+ * (XYZM) for measured geometries, missing Z and M values are returned as 0.
+ *
+ * @example
+ * ```
+ * const xy = lineString.points.toFlatArray({ dims: 2 });```
+ *
+ * @method toFlatArray
+ * @throws Error
+ * @param {FlatCoordinatesOptions} [options]
+ * @param {number} [options.dims] 2 for XY, 3 for XYZ, 4 for XYZM
+ * @return {Float64Array}
+ */
+NAN_METHOD(LineStringPoints::toFlatArray) {
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  LineString *geom = Nan::ObjectWrap::Unwrap<LineString>(parent);
+
+  int dims = FlatCoordinates::Dims(geom->get());
+  if (!FlatCoordinates::ParseDims(info[0], dims)) return;
+
+  FlatCoordinates flat(dims);
+  try {
+    flat.addCurve(geom->get());
+  } catch (const char *err) {
+    Nan::ThrowError(err);
+    return;
+  }
+  size_t length = flat.coordinates.size / sizeof(double);
+  info.GetReturnValue().Set(TypedArray::Adopt(GDT_Float64, flat.coordinates.release(), static_cast<unsigned int>(length)));
+}
+
+/**
+ * Replaces all the points with the ones from a `Float64Array` of interleaved
+ * coordinates, the geometry gets the dimensions of the array.
+ *
+ * This is much faster than adding the points one by one.
+ *
+ * @example
+ * ```
+ * lineString.points.fromFlatArray(new Float64Array([ 0, 0, 10, 0, 10, 10 ]));
+ * lineString.points.fromFlatArray(new Float64Array([ 0, 0, 100, 10, 0, 120 ]), { dims: 3 });```
+ *
+ * @method fromFlatArray
+ * @throws Error
+ * @param {Float64Array} coordinates
+ * @param {FlatCoordinatesOptions} [options]
+ * @param {number} [options.dims=2] 2 for XY, 3 for XYZ, 4 for XYZM
+ */
+NAN_METHOD(LineStringPoints::fromFlatArray) {
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  LineString *geom = Nan::ObjectWrap::Unwrap<LineString>(parent);
+
+  int dims = 2;
+  const double *xy;
+  size_t count;
+  if (!FlatCoordinates::ParseDims(info[1], dims)) return;
+  if (!FlatCoordinates::ParseCoordinates(info[0], dims, xy, count)) return;
+
+  try {
+    FlatCoordinates::Import(geom->get(), dims, xy, count);
+  } catch (const char *err) { Nan::ThrowError(err); }
+}
+
 } // namespace node_gdal
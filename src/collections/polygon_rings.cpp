@@ -3,6 +3,7 @@
 #include "../geometry/gdal_geometry.hpp"
 #include "../geometry/gdal_linearring.hpp"
 #include "../geometry/gdal_polygon.hpp"
+#include "../utils/flat_coordinates.hpp"
 
 namespace node_gdal {
 
@@ -19,6 +20,8 @@ void PolygonRings::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "count", count);
   Nan::SetPrototypeMethod(lcons, "get", get);
   Nan::SetPrototypeMethod(lcons, "add", add);
+  Nan::SetPrototypeMethod(lcons, "toFlatArray", toFlatArray);
+  Nan::SetPrototypeMethod(lcons, "fromFlatArray", fromFlatArray);
 
   Nan::Set(target, Nan::New("PolygonRings").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
 
@@ -193,4 +196,81 @@ NAN_METHOD(PolygonRings::add) {
   return;
 }
 
+/**
+ * Returns the coordinates of all the rings as a single `Float64Array` of
+ * interleaved coordinates and an `Uint32Array` with the offset of the first
+ * point of each ring, followed by the total number of points.
+ *
+ * The default number of dimensions is 2, 3 for geometries with Z and 4
+ * (XYZM) for measured geometries, missing Z and M values are returned as 0.
+ *
+ * @example
+ * ```
+ * const { coordinates, offsets, dims } = polygon.rings.toFlatArray();
+ * // offsets[0] = [ 0, 5, 10 ] for a polygon with two rings of 5 points```
+ *
+ * @method toFlatArray
+ * @throws Error
+ * @param {FlatCoordinatesOptions} [options]
+ * @param {number} [options.dims] 2 for XY, 3 for XYZ, 4 for XYZM
+ * @return {FlatCoordinates}
+ */
+NAN_METHOD(PolygonRings::toFlatArray) {
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  Polygon *geom = Nan::ObjectWrap::Unwrap<Polygon>(parent);
+
+  int dims = FlatCoordinates::Dims(geom->get());
+  if (!FlatCoordinates::ParseDims(info[0], dims)) return;
+
+  FlatCoordinates flat(dims);
+  try {
+    flat.add(geom->get());
+  } catch (const char *err) {
+    Nan::ThrowError(err);
+    return;
+  }
+  info.GetReturnValue().Set(flat.ToObject());
+}
+
+/**
+ * Replaces all the rings with the ones from a `Float64Array` of interleaved
+ * coordinates and an `Uint32Array` of ring offsets in the same format as
+ * the one returned by `toFlatArray()`, the polygon gets the dimensions of the array.
+ *
+ * This is much faster than building the geometries one point at a time.
+ *
+ * @example
+ * ```
+ * polygon.rings.fromFlatArray(
+ *   new Float64Array([ 0, 0, 10, 0, 10, 10, 0, 0 ]),
+ *   [ new Uint32Array([ 0, 4 ]) ]);```
+ *
+ * @method fromFlatArray
+ * @throws Error
+ * @param {Float64Array} coordinates
+ * @param {Uint32Array[]} offsets
+ * @param {FlatCoordinatesOptions} [options]
+ * @param {number} [options.dims=2] 2 for XY, 3 for XYZ, 4 for XYZM
+ */
+NAN_METHOD(PolygonRings::fromFlatArray) {
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  Polygon *geom = Nan::ObjectWrap::Unwrap<Polygon>(parent);
+
+  int dims = 2;
+  const double *xy;
+  size_t count;
+  std::vector<std::vector<uint32_t>> offsets;
+  if (!FlatCoordinates::ParseDims(info[2], dims)) return;
+  if (!FlatCoordinates::ParseCoordinates(info[0], dims, xy, count)) return;
+  if (!FlatCoordinates::ParseOffsets(info[1], offsets)) return;
+
+  try {
+    FlatCoordinates::Import(geom->get(), dims, xy, count, offsets);
+  } catch (const char *err) { Nan::ThrowError(err); }
+}
+
 } // namespace node_gdal
@@ -30,6 +30,8 @@ class PolygonRings : public Nan::ObjectWrap {
   static NAN_METHOD(get);
   static NAN_METHOD(count);
   static NAN_METHOD(add);
+  static NAN_METHOD(toFlatArray);
+  static NAN_METHOD(fromFlatArray);
   static NAN_METHOD(remove);
 
   PolygonRings();
@@ -22,6 +22,7 @@ void RasterBandPixels::Initialize(Local<Object> target) {
   Nan__SetPrototypeAsyncableMethod(lcons, "set", set);
   Nan__SetPrototypeAsyncableMethod(lcons, "read", read);
   Nan__SetPrototypeAsyncableMethod(lcons, "write", write);
+  Nan__SetPrototypeAsyncableMethod(lcons, "writev", writev);
   Nan__SetPrototypeAsyncableMethod(lcons, "readBlock", readBlock);
   Nan__SetPrototypeAsyncableMethod(lcons, "writeBlock", writeBlock);
   Nan__SetPrototypeAsyncableMethod(lcons, "clampBlock", clampBlock);
@@ -247,6 +248,73 @@ static inline int findHighest(int w, int h, int px, int ln, int offset) {
   return offset + (x * px + y * ln);
 }
 
+/*
+ * Derive the mask from the NoData value of an already read buffer
+ * Returns false when this is not possible and the mask band must be read
+ */
+static bool deriveNoDataMask(
+  GDALRasterBand *gdal_band,
+  void *data,
+  GDALDataType type,
+  int buffer_w,
+  int buffer_h,
+  int pixel_space,
+  int line_space,
+  GByte *mask) {
+  if (type != gdal_band->GetRasterDataType()) return false;
+
+  int hasNoData = 0;
+  double nodata = gdal_band->GetNoDataValue(&hasNoData);
+  if (!hasNoData) return false;
+
+  // Same rules as GDALNoDataMaskBand: floating point values are compared
+  // in the precision of the data type with a tolerance, integer NoData values
+  // that cannot be represented in the data type match no pixels
+  GDALDataType compare = GDT_Unknown;
+  if (type == GDT_Float32 || type == GDT_CFloat32)
+    compare = GDT_Float32;
+  else if (GDALDataTypeIsFloating(type))
+    compare = GDT_Float64;
+  else {
+    GByte typed_nodata[16];
+    double representable;
+    GDALCopyWords(&nodata, GDT_Float64, 0, typed_nodata, type, 0, 1);
+    GDALCopyWords(typed_nodata, type, 0, &representable, GDT_Float64, 0, 1);
+    if (representable != nodata) {
+      memset(mask, 255, static_cast<size_t>(buffer_w) * buffer_h);
+      return true;
+    }
+  }
+  bool nan = CPLIsNan(nodata);
+  float fnodata = static_cast<float>(nodata);
+
+  std::unique_ptr<double[]> line(new double[buffer_w]);
+  for (int y = 0; y < buffer_h; y++) {
+    GDALCopyWords(
+      static_cast<GByte *>(data) + static_cast<GPtrDiff_t>(y) * line_space,
+      type,
+      pixel_space,
+      line.get(),
+      GDT_Float64,
+      sizeof(double),
+      buffer_w);
+    GByte *mask_line = mask + static_cast<size_t>(y) * buffer_w;
+    for (int x = 0; x < buffer_w; x++) {
+      bool invalid;
+      if (nan)
+        invalid = CPLIsNan(line[x]);
+      else if (compare == GDT_Float32)
+        invalid = ARE_REAL_EQUAL(static_cast<float>(line[x]), fnodata);
+      else if (compare == GDT_Float64)
+        invalid = ARE_REAL_EQUAL(line[x], nodata);
+      else
+        invalid = line[x] == nodata;
+      mask_line[x] = invalid ? 0 : 255;
+    }
+  }
+  return true;
+}
+
 /**
  * Reads a region of pixels.
  *
@@ -265,6 +333,10 @@ static inline int findHighest(int w, int h, int px, int ln, int offset) {
  * @param {number} [options.line_space]
  * @param {string} [options.resampling] Resampling algorithm ({{#crossLink "Constants (GRA)"}}available options{{/crossLink}})
  * @param {ProgressCb} [options.progress_cb] {{{progress_cb}}}
+ * @param {boolean} [options.shared=false] Allocate the new array in a `SharedArrayBuffer` that can be passed to worker threads without copying
+ * @param {boolean} [options.external=false] Allocate the new array in external memory with the requested alignment
+ * @param {number} [options.alignment=64] Alignment in bytes of the external memory, must be a power of 2
+ * @param {boolean} [options.withMask=false] Also read the mask band in the same operation and return `{ data, mask }`, the mask is a packed `buffer_width x buffer_height` `Uint8Array` where `0` is an invalid pixel and `255` is a valid pixel, {{#crossLink "gdal.RasterBandPixels/readWithMask:method"}}readWithMask{{/crossLink}} is the typed version
  * @return {TypedArray} A TypedArray (https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses) of values.
  */
 
@@ -286,6 +358,10 @@ static inline int findHighest(int w, int h, int px, int ln, int offset) {
  * @param {number} [options.line_space]
  * @param {string} [options.resampling] Resampling algorithm ({{#crossLink "Constants (GRA)"}}available options{{/crossLink}})
  * @param {ProgressCb} [options.progress_cb] {{{progress_cb}}}
+ * @param {boolean} [options.shared=false] Allocate the new array in a `SharedArrayBuffer` that can be passed to worker threads without copying
+ * @param {boolean} [options.external=false] Allocate the new array in external memory with the requested alignment
+ * @param {number} [options.alignment=64] Alignment in bytes of the external memory, must be a power of 2
+ * @param {boolean} [options.withMask=false] Also read the mask band in the same operation and return `{ data, mask }`, see {{#crossLink "gdal.RasterBandPixels/readWithMask:method"}}readWithMask{{/crossLink}}
  * @param {callback<TypedArray>} [callback=undefined] {{{cb}}}
  * @return {Promise<TypedArray>} A TypedArray (https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses) of values.
  */
@@ -344,6 +420,22 @@ GDAL_ASYNCABLE_DEFINE(RasterBandPixels::read) {
   }
   offset = 0;
   NODE_ARG_INT_OPT(12, "offset", offset);
+  bool shared = false;
+  NODE_ARG_BOOL_OPT(13, "shared", shared);
+  // The alignment is passed only for the external arrays
+  const bool external = info.Length() > 14 && !info[14]->IsUndefined() && !info[14]->IsNull();
+  int alignment = 0;
+  NODE_ARG_INT_OPT(14, "alignment", alignment);
+  if (shared && external) {
+    Nan::ThrowError("Array cannot be both shared and external");
+    return;
+  }
+  if (external && !TypedArray::ValidateAlignment(alignment)) {
+    Nan::ThrowRangeError("Alignment must be a power of 2 and a multiple of the pointer size");
+    return;
+  }
+  bool withMask = false;
+  NODE_ARG_BOOL_OPT(15, "withMask", withMask);
 
   if (findLowest(buffer_w, buffer_h, pixel_space, line_space, offset) < 0) {
     Nan::ThrowError("has to write before the start of the TypedArray");
@@ -355,7 +447,10 @@ GDAL_ASYNCABLE_DEFINE(RasterBandPixels::read) {
 
   // create array if no array was passed
   if (obj.IsEmpty()) {
-    array = TypedArray::New(type, length);
+    if (external)
+      array = TypedArray::NewExternal(type, length, alignment);
+    else
+      array = TypedArray::New(type, length, shared);
     if (array.IsEmpty() || !array->IsObject()) {
       return; // TypedArray::New threw an error
     }
@@ -367,14 +462,29 @@ GDAL_ASYNCABLE_DEFINE(RasterBandPixels::read) {
     return; // TypedArray::Validate threw an error
   }
 
+  GByte *mask = nullptr;
+  Local<Object> mask_obj;
+  if (withMask) {
+    Local<Value> mask_array = TypedArray::New(GDT_Byte, buffer_w * buffer_h);
+    if (mask_array.IsEmpty() || !mask_array->IsObject()) {
+      return; // TypedArray::New threw an error
+    }
+    mask_obj = mask_array.As<Object>();
+    mask = static_cast<GByte *>(TypedArray::Validate(mask_obj, GDT_Byte, buffer_w * buffer_h));
+    if (!mask) {
+      return; // TypedArray::Validate threw an error
+    }
+  }
+
   GDALRasterBand *gdal_band = band->get();
   GDALAsyncableJob<CPLErr> job(band->parent_uid);
   job.persist("array", obj);
+  if (withMask) job.persist("mask", mask_obj);
   job.persist(band->handle());
   job.progress = cb;
 
   data = (uint8_t *)data + offset * bytes_per_pixel;
-  job.main = [gdal_band, x, y, w, h, data, buffer_w, buffer_h, type, pixel_space, line_space, resampling, cb](
+  job.main = [gdal_band, x, y, w, h, data, buffer_w, buffer_h, type, pixel_space, line_space, resampling, cb, mask](
                const GDALExecutionProgress &progress) {
     std::shared_ptr<GDALRasterIOExtraArg> extra(new GDALRasterIOExtraArg);
     INIT_RASTERIO_EXTRA_ARG(*extra);
@@ -388,12 +498,40 @@ GDAL_ASYNCABLE_DEFINE(RasterBandPixels::read) {
     CPLErr err =
       gdal_band->RasterIO(GF_Read, x, y, w, h, data, buffer_w, buffer_h, type, pixel_space, line_space, extra.get());
 
+    if (err != CE_None) throw CPLGetLastErrorMsg();
+    if (mask == nullptr) return err;
+
+    // All the mask bands besides the NoData mask can be expensive to read, check the flags first
+    int flags = gdal_band->GetMaskFlags();
+    if (flags & GMF_ALL_VALID) {
+      memset(mask, 255, static_cast<size_t>(buffer_w) * buffer_h);
+      return err;
+    }
+    bool sameGrid = resampling == GRIORA_NearestNeighbour || (buffer_w == w && buffer_h == h);
+    if (flags == GMF_NODATA && sameGrid &&
+        deriveNoDataMask(gdal_band, data, type, buffer_w, buffer_h, pixel_space, line_space, mask))
+      return err;
+
+    // The mask is always read with nearest neighbour resampling to remain binary
+    GDALRasterBand *gdal_mask = gdal_band->GetMaskBand();
+    if (gdal_mask == nullptr) throw CPLGetLastErrorMsg();
+    err = gdal_mask->RasterIO(GF_Read, x, y, w, h, mask, buffer_w, buffer_h, GDT_Byte, 1, buffer_w, nullptr);
     if (err != CE_None) throw CPLGetLastErrorMsg();
     return err;
   };
 
-  job.rval = [](CPLErr err, const GetFromPersistentFunc &getter) { return getter("array"); };
-  job.run(info, async, 13);
+  if (withMask) {
+    job.rval = [](CPLErr err, const GetFromPersistentFunc &getter) {
+      Nan::EscapableHandleScope scope;
+      Local<Object> result = Nan::New<Object>();
+      Nan::Set(result, Nan::New("data").ToLocalChecked(), getter("array"));
+      Nan::Set(result, Nan::New("mask").ToLocalChecked(), getter("mask"));
+      return scope.Escape(result.As<Value>());
+    };
+  } else {
+    job.rval = [](CPLErr err, const GetFromPersistentFunc &getter) { return getter("array"); };
+  }
+  job.run(info, async, 16);
 }
 
 /**
@@ -517,6 +655,152 @@ GDAL_ASYNCABLE_DEFINE(RasterBandPixels::write) {
   job.run(info, async, 11);
 }
 
+/**
+ * Writes a region of pixels from a list of arrays.
+ *
+ * The arrays are consumed in row-major order as if they were concatenated,
+ * lines that are entirely contained in an array are written without copying.
+ * All arrays must have the same type.
+ *
+ * @method writev
+ * @throws Error
+ * @param {number} x
+ * @param {number} y
+ * @param {number} width
+ * @param {number} height
+ * @param {TypedArray[]} data The TypedArrays (https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses) to write to the band.
+ * @param {number} [offset=0] The element offset in the first array
+ */
+
+/**
+ * Writes a region of pixels from a list of arrays.
+ * {{{async}}}
+ *
+ * The arrays are consumed in row-major order as if they were concatenated,
+ * lines that are entirely contained in an array are written without copying.
+ * All arrays must have the same type.
+ *
+ * @method writevAsync
+ * @throws Error
+ * @param {number} x
+ * @param {number} y
+ * @param {number} width
+ * @param {number} height
+ * @param {TypedArray[]} data The TypedArrays (https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses) to write to the band.
+ * @param {number} [offset=0] The element offset in the first array
+ * @param {callback<void>} [callback=undefined] {{{cb}}}
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(RasterBandPixels::writev) {
+
+  RasterBand *band;
+  if ((band = parent(info)) == nullptr) return;
+
+  int x, y, w, h;
+  int offset = 0;
+  Local<Array> arrays;
+
+  NODE_ARG_INT(0, "x_offset", x);
+  NODE_ARG_INT(1, "y_offset", y);
+  NODE_ARG_INT(2, "x_size", w);
+  NODE_ARG_INT(3, "y_size", h);
+  NODE_ARG_ARRAY(4, "data", arrays);
+  NODE_ARG_INT_OPT(5, "offset", offset);
+
+  if (w <= 0 || h <= 0 || offset < 0) {
+    Nan::ThrowRangeError("Invalid region");
+    return;
+  }
+
+  GDALDataType type = GDT_Unknown;
+  std::vector<Local<Object>> objs;
+  std::vector<std::pair<uint8_t *, size_t>> chunks;
+  size_t available = 0;
+  for (unsigned i = 0; i < arrays->Length(); i++) {
+    Local<Value> val = Nan::Get(arrays, i).ToLocalChecked();
+    if (!val->IsTypedArray()) {
+      Nan::ThrowTypeError("data must be an array of TypedArrays");
+      return;
+    }
+    Local<Object> obj = val.As<Object>();
+    GDALDataType chunk_type = TypedArray::Identify(obj);
+    if (chunk_type == GDT_Unknown) {
+      Nan::ThrowError("Invalid array");
+      return;
+    }
+    if (type != GDT_Unknown && chunk_type != type) {
+      Nan::ThrowTypeError("All arrays must have the same type");
+      return;
+    }
+    type = chunk_type;
+    void *data = TypedArray::Validate(obj, type, 0);
+    if (data == nullptr) return; // TypedArray::Validate threw an error
+    size_t length = val.As<v8::TypedArray>()->Length();
+    objs.push_back(obj);
+    chunks.push_back({static_cast<uint8_t *>(data), length});
+    available += length;
+  }
+  if (chunks.empty() || static_cast<size_t>(offset) > chunks[0].second) {
+    Nan::ThrowRangeError("offset must be within the first array");
+    return;
+  }
+  if (available < static_cast<size_t>(offset) + static_cast<size_t>(w) * h) {
+    Nan::ThrowRangeError("Not enough data to fill the region");
+    return;
+  }
+
+  GDALRasterBand *gdal_band = band->get();
+  GDALAsyncableJob<CPLErr> job(band->parent_uid);
+  job.persist(objs);
+  job.persist(band->handle());
+
+  job.main = [gdal_band, x, y, w, h, type, chunks, offset](const GDALExecutionProgress &) {
+    const size_t bytes_per_pixel = GDALGetDataTypeSize(type) / 8;
+    std::vector<uint8_t> staging;
+    size_t c = 0, pos = offset;
+    int line = 0;
+
+    CPLErrorReset();
+    while (line < h) {
+      while (pos == chunks[c].second) {
+        c++;
+        pos = 0;
+      }
+      size_t available = chunks[c].second - pos;
+      CPLErr err;
+      if (available >= static_cast<size_t>(w)) {
+        // a run of whole lines inside the same array is written in place
+        int run = static_cast<int>(std::min(static_cast<size_t>(h - line), available / w));
+        err = gdal_band->RasterIO(
+          GF_Write, x, y + line, w, run, chunks[c].first + pos * bytes_per_pixel, w, run, type, 0, 0, nullptr);
+        line += run;
+        pos += static_cast<size_t>(run) * w;
+      } else {
+        // a line that spans several arrays is assembled in the staging buffer
+        staging.resize(w * bytes_per_pixel);
+        size_t filled = 0;
+        while (filled < static_cast<size_t>(w)) {
+          while (pos == chunks[c].second) {
+            c++;
+            pos = 0;
+          }
+          size_t n = std::min(static_cast<size_t>(w) - filled, chunks[c].second - pos);
+          memcpy(&staging[filled * bytes_per_pixel], chunks[c].first + pos * bytes_per_pixel, n * bytes_per_pixel);
+          filled += n;
+          pos += n;
+        }
+        err = gdal_band->RasterIO(GF_Write, x, y + line, w, 1, staging.data(), w, 1, type, 0, 0, nullptr);
+        line++;
+      }
+      if (err != CE_None) throw CPLGetLastErrorMsg();
+    }
+    return CE_None;
+  };
+  job.rval = [](CPLErr, const GetFromPersistentFunc &) { return Nan::Undefined(); };
+
+  job.run(info, async, 6);
+}
+
 /**
  * Reads a block of pixels.
  *
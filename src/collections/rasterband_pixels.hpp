@@ -32,6 +32,7 @@ class RasterBandPixels : public Nan::ObjectWrap {
   GDAL_ASYNCABLE_DECLARE(set);
   GDAL_ASYNCABLE_DECLARE(read);
   GDAL_ASYNCABLE_DECLARE(write);
+  GDAL_ASYNCABLE_DECLARE(writev);
   GDAL_ASYNCABLE_DECLARE(readBlock);
   GDAL_ASYNCABLE_DECLARE(writeBlock);
   GDAL_ASYNCABLE_DECLARE(clampBlock);
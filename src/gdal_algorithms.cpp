@@ -3,7 +3,14 @@
 #include "gdal_dataset.hpp"
 #include "gdal_layer.hpp"
 #include "gdal_rasterband.hpp"
+#include "geometry/gdal_geometry.hpp"
 #include "utils/number_list.hpp"
+#include "utils/parallel.hpp"
+#include "utils/spatial_join.hpp"
+#include "utils/union_all.hpp"
+#include "utils/vector_tile_writer.hpp"
+
+#include <functional>
 
 namespace node_gdal {
 
@@ -13,6 +20,14 @@ void Algorithms::Initialize(Local<Object> target) {
   Nan__SetAsyncableMethod(target, "sieveFilter", sieveFilter);
   Nan__SetAsyncableMethod(target, "checksumImage", checksumImage);
   Nan__SetAsyncableMethod(target, "polygonize", polygonize);
+  Nan__SetAsyncableMethod(target, "spatialJoin", spatialJoin);
+  Nan__SetAsyncableMethod(target, "renderVectorTile", renderVectorTile);
+  Nan__SetAsyncableMethod(target, "unionAll", unionAll);
+  Nan__SetAsyncableMethod(target, "bufferMany", bufferMany);
+  Nan__SetAsyncableMethod(target, "simplifyMany", simplifyMany);
+#if GDAL_VERSION_MAJOR >= 3
+  Nan__SetAsyncableMethod(target, "makeValidMany", makeValidMany);
+#endif
   Nan__SetAsyncableMethod(target, "_acquireLocks", _acquireLocks);
 }
 
@@ -487,6 +502,658 @@ GDAL_ASYNCABLE_DEFINE(Algorithms::polygonize) {
   job.run(info, async, 1);
 }
 
+/**
+ * Joins two layers on a spatial predicate.
+ *
+ * The right layer is read into an in-memory spatial index with its geometries,
+ * then the left layer is read in chunks that are matched, optionally on several
+ * threads, using GEOS prepared geometries. The attribute and spatial filters of both layers apply.
+ *
+ * Without `dst`, the matching pairs are returned as two `Float64Array`s of FIDs,
+ * `left[i]` matching `right[i]`.
+ *
+ * With `dst`, a feature is written for every matching pair with the geometry and
+ * the fields of the left feature, copied by name when the destination layer has them,
+ * and the `fields` of the right feature. Wrapping the operation in a transaction
+ * is recommended for drivers that support them.
+ *
+ * The pairs are in the reading order of the left layer, then of the right layer.
+ *
+ * @example
+ * ```
+ * // Assign the polygon attributes to the points
+ * const { left, right } = await gdal.spatialJoinAsync(points, polygons, { predicate: 'within' });
+ * ```
+ *
+ * @throws Error
+ * @method spatialJoin
+ * @static
+ * @for gdal
+ * @param {gdal.Layer} left
+ * @param {gdal.Layer} right
+ * @param {SpatialJoinOptions} [options]
+ * @param {string} [options.predicate='intersects'] `intersects`, `within` (left within right) or `contains` (left contains right)
+ * @param {string[]} [options.fields] Fields of the right layer to copy to `dst`
+ * @param {number} [options.threads=1] Number of threads
+ * @param {gdal.Layer} [options.dst] Destination layer
+ * @return {SpatialJoinResult}
+ */
+
+/**
+ * Joins two layers on a spatial predicate.
+ * {{{async}}}
+ *
+ * The right layer is read into an in-memory spatial index with its geometries,
+ * then the left layer is read in chunks that are matched, optionally on several
+ * threads, using GEOS prepared geometries. The attribute and spatial filters of both layers apply.
+ *
+ * Without `dst`, the matching pairs are returned as two `Float64Array`s of FIDs,
+ * `left[i]` matching `right[i]`.
+ *
+ * With `dst`, a feature is written for every matching pair with the geometry and
+ * the fields of the left feature, copied by name when the destination layer has them,
+ * and the `fields` of the right feature. Wrapping the operation in a transaction
+ * is recommended for drivers that support them.
+ *
+ * The pairs are in the reading order of the left layer, then of the right layer.
+ *
+ * @example
+ * ```
+ * // Assign the polygon attributes to the points
+ * const { left, right } = await gdal.spatialJoinAsync(points, polygons, { predicate: 'within' });
+ * ```
+ *
+ * @throws Error
+ * @method spatialJoinAsync
+ * @static
+ * @for gdal
+ * @param {gdal.Layer} left
+ * @param {gdal.Layer} right
+ * @param {SpatialJoinOptions} [options]
+ * @param {string} [options.predicate='intersects'] `intersects`, `within` (left within right) or `contains` (left contains right)
+ * @param {string[]} [options.fields] Fields of the right layer to copy to `dst`
+ * @param {number} [options.threads=1] Number of threads
+ * @param {gdal.Layer} [options.dst] Destination layer
+ * @param {callback<SpatialJoinResult>} [callback=undefined] {{{cb}}}
+ * @return {Promise<SpatialJoinResult>}
+ */
+GDAL_ASYNCABLE_DEFINE(Algorithms::spatialJoin) {
+  Layer *left;
+  Layer *right;
+  Layer *dst = nullptr;
+  Local<Object> options;
+  Local<Array> fieldsArray;
+  std::string predicate_name = "intersects";
+  int threads = 1;
+
+  NODE_ARG_WRAPPED(0, "left", Layer, left);
+  NODE_ARG_WRAPPED(1, "right", Layer, right);
+  NODE_ARG_OBJECT_OPT(2, "options", options);
+  if (!options.IsEmpty()) {
+    NODE_STR_FROM_OBJ_OPT(options, "predicate", predicate_name);
+    NODE_ARRAY_FROM_OBJ_OPT(options, "fields", fieldsArray);
+    NODE_INT_FROM_OBJ_OPT(options, "threads", threads);
+    NODE_WRAPPED_FROM_OBJ_OPT(options, "dst", Layer, dst);
+  }
+
+  SpatialJoin::Predicate predicate;
+  if (predicate_name == "intersects")
+    predicate = SpatialJoin::INTERSECTS;
+  else if (predicate_name == "contains")
+    predicate = SpatialJoin::CONTAINS;
+  else if (predicate_name == "within")
+    predicate = SpatialJoin::WITHIN;
+  else {
+    Nan::ThrowError("predicate must be one of intersects, contains or within");
+    return;
+  }
+  if (threads < 1) {
+    Nan::ThrowRangeError("threads must be a positive integer");
+    return;
+  }
+
+  std::vector<std::string> fields;
+  if (!fieldsArray.IsEmpty()) {
+    if (dst == nullptr) {
+      Nan::ThrowError("fields can be copied only to a dst layer");
+      return;
+    }
+    for (unsigned i = 0; i < fieldsArray->Length(); i++) {
+      Local<Value> name = Nan::Get(fieldsArray, i).ToLocalChecked();
+      if (!name->IsString()) {
+        Nan::ThrowTypeError("fields must be an array of strings");
+        return;
+      }
+      fields.push_back(*Nan::Utf8String(name));
+    }
+  }
+
+  OGRLayer *gdal_left = left->get();
+  OGRLayer *gdal_right = right->get();
+  OGRLayer *gdal_dst = dst ? dst->get() : nullptr;
+
+  std::vector<long> ds_uids = {left->parent_uid, right->parent_uid};
+  if (dst) ds_uids.push_back(dst->parent_uid);
+
+  GDALAsyncableJob<std::shared_ptr<SpatialJoin>> job(ds_uids);
+  job.persist(left->handle(), right->handle());
+  if (dst) job.persist(dst->handle());
+  job.main = [gdal_left, gdal_right, gdal_dst, predicate, threads, fields](const GDALExecutionProgress &) {
+    std::shared_ptr<SpatialJoin> join = std::make_shared<SpatialJoin>(predicate, threads);
+    CPLErrorReset();
+    join->indexRight(gdal_right, fields);
+    join->join(gdal_left, gdal_dst);
+    return join;
+  };
+  job.rval = [](std::shared_ptr<SpatialJoin> join, const GetFromPersistentFunc &) { return join->ToObject(); };
+  job.run(info, async, 3);
+}
+
+/**
+ * Renders a WebMercator (EPSG:3857) XYZ tile from one or more layers and encodes
+ * it as a Mapbox Vector Tile (MVT) in a single operation.
+ *
+ * Every layer is read with a spatial filter on the tile, including the buffer,
+ * which temporarily replaces its own spatial filter, its attribute filter applies.
+ * The geometries are reprojected (the coordinate transformation is cached between
+ * calls), converted to tile coordinates, clipped to the buffered tile, simplified
+ * and quantized. Layers without a spatial reference are assumed to be in WebMercator.
+ *
+ * The layers without any features in the tile are omitted, the returned `Buffer`
+ * is empty when the tile is empty.
+ *
+ * @example
+ * ```
+ * const tile = await gdal.renderVectorTileAsync([ roads, buildings ], { z: 14, x: 8514, y: 5816 });
+ * ```
+ *
+ * @throws Error
+ * @method renderVectorTile
+ * @static
+ * @for gdal
+ * @param {gdal.Layer[]} layers Layers, named after `layer.name`
+ * @param {VectorTileOptions} options
+ * @param {number} options.z Zoom level
+ * @param {number} options.x Tile column
+ * @param {number} options.y Tile row (from the top)
+ * @param {number} [options.extent=4096] Size of the tile in tile units
+ * @param {number} [options.buffer=64] Size of the buffer around the tile in tile units
+ * @param {number} [options.simplify=0] Simplification tolerance in tile units, requires GEOS
+ * @param {string[]} [options.fields] Fields to include, all the fields by default, the fields missing from a layer are ignored
+ * @return {Buffer}
+ */
+
+/**
+ * Renders a WebMercator (EPSG:3857) XYZ tile from one or more layers and encodes
+ * it as a Mapbox Vector Tile (MVT) in a single operation.
+ * {{{async}}}
+ *
+ * Every layer is read with a spatial filter on the tile, including the buffer,
+ * which temporarily replaces its own spatial filter, its attribute filter applies.
+ * The geometries are reprojected (the coordinate transformation is cached between
+ * calls), converted to tile coordinates, clipped to the buffered tile, simplified
+ * and quantized. Layers without a spatial reference are assumed to be in WebMercator.
+ *
+ * The layers without any features in the tile are omitted, the returned `Buffer`
+ * is empty when the tile is empty.
+ *
+ * @example
+ * ```
+ * const tile = await gdal.renderVectorTileAsync([ roads, buildings ], { z: 14, x: 8514, y: 5816 });
+ * ```
+ *
+ * @throws Error
+ * @method renderVectorTileAsync
+ * @static
+ * @for gdal
+ * @param {gdal.Layer[]} layers Layers, named after `layer.name`
+ * @param {VectorTileOptions} options
+ * @param {number} options.z Zoom level
+ * @param {number} options.x Tile column
+ * @param {number} options.y Tile row (from the top)
+ * @param {number} [options.extent=4096] Size of the tile in tile units
+ * @param {number} [options.buffer=64] Size of the buffer around the tile in tile units
+ * @param {number} [options.simplify=0] Simplification tolerance in tile units, requires GEOS
+ * @param {string[]} [options.fields] Fields to include, all the fields by default, the fields missing from a layer are ignored
+ * @param {callback<Buffer>} [callback=undefined] {{{cb}}}
+ * @return {Promise<Buffer>}
+ */
+
+GDAL_ASYNCABLE_DEFINE(Algorithms::renderVectorTile) {
+  Local<Array> layersArray;
+  Local<Object> obj;
+  Local<Array> fieldsArray;
+  VectorTileOptions opts;
+
+  NODE_ARG_ARRAY(0, "layers", layersArray);
+  NODE_ARG_OBJECT(1, "options", obj);
+
+  opts.extent = 4096;
+  opts.buffer = 64;
+  opts.simplify = 0;
+  NODE_INT_FROM_OBJ(obj, "z", opts.z);
+  NODE_INT_FROM_OBJ(obj, "x", opts.x);
+  NODE_INT_FROM_OBJ(obj, "y", opts.y);
+  NODE_INT_FROM_OBJ_OPT(obj, "extent", opts.extent);
+  NODE_INT_FROM_OBJ_OPT(obj, "buffer", opts.buffer);
+  NODE_DOUBLE_FROM_OBJ_OPT(obj, "simplify", opts.simplify);
+  NODE_ARRAY_FROM_OBJ_OPT(obj, "fields", fieldsArray);
+
+  if (opts.z < 0 || opts.z > 30) {
+    Nan::ThrowRangeError("z must be between 0 and 30");
+    return;
+  }
+  if (opts.x < 0 || opts.y < 0 || opts.x >= (1 << opts.z) || opts.y >= (1 << opts.z)) {
+    Nan::ThrowRangeError("Tile coordinates out of range");
+    return;
+  }
+  if (opts.extent <= 0) {
+    Nan::ThrowRangeError("extent must be a positive integer");
+    return;
+  }
+  if (opts.buffer < 0 || opts.buffer > opts.extent) {
+    Nan::ThrowRangeError("buffer must be between 0 and extent");
+    return;
+  }
+  if (opts.simplify < 0) {
+    Nan::ThrowRangeError("simplify must not be negative");
+    return;
+  }
+
+  opts.allFields = fieldsArray.IsEmpty();
+  if (!opts.allFields) {
+    for (unsigned i = 0; i < fieldsArray->Length(); i++) {
+      Local<Value> name = Nan::Get(fieldsArray, i).ToLocalChecked();
+      if (!name->IsString()) {
+        Nan::ThrowTypeError("fields must be an array of strings");
+        return;
+      }
+      opts.fields.push_back(*Nan::Utf8String(name));
+    }
+  }
+
+  std::vector<OGRLayer *> gdal_layers;
+  std::vector<long> ds_uids;
+  std::vector<Local<Object>> handles;
+  for (unsigned i = 0; i < layersArray->Length(); i++) {
+    Local<Value> v = Nan::Get(layersArray, i).ToLocalChecked();
+    if (!v->IsObject() || !Nan::New(Layer::constructor)->HasInstance(v)) {
+      Nan::ThrowTypeError("layers must be an array of Layer");
+      return;
+    }
+    Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(v.As<Object>());
+    if (!layer->isAlive()) {
+      Nan::ThrowError("Layer object already destroyed");
+      return;
+    }
+    gdal_layers.push_back(layer->get());
+    ds_uids.push_back(layer->parent_uid);
+    handles.push_back(v.As<Object>());
+  }
+  if (gdal_layers.empty()) {
+    Nan::ThrowError("layers must contain at least one Layer");
+    return;
+  }
+
+  GDALAsyncableJob<std::shared_ptr<VectorTileWriter>> job(ds_uids);
+  for (const Local<Object> &handle : handles) job.persist(handle);
+  job.main = [gdal_layers, opts](const GDALExecutionProgress &) {
+    std::shared_ptr<VectorTileWriter> writer = std::make_shared<VectorTileWriter>(opts);
+    CPLErrorReset();
+    for (OGRLayer *layer : gdal_layers) writer->addLayer(layer);
+    return writer;
+  };
+  job.rval = [](std::shared_ptr<VectorTileWriter> writer, const GetFromPersistentFunc &) {
+    return writer->ToBuffer();
+  };
+  job.run(info, async, 2);
+}
+
+/**
+ * Computes the union of many geometries, optionally grouped by a key, this is
+ * the equivalent of a dissolve.
+ *
+ * The polygons are merged with a GEOS cascaded union which is much faster than
+ * chaining `Geometry.union()`, the other geometries with a balanced tree of
+ * pairwise unions. The input is split in chunks unioned on several threads
+ * before merging the partial results, when there are at least as many groups as
+ * threads, the groups are unioned in parallel instead.
+ *
+ * With a layer, its attribute and spatial filters apply and `groupBy` is the name
+ * of a field, the features where it is null go in the `''` group.
+ * With an array of geometries, `groupBy` is an array of keys of the same length.
+ * `null` and empty geometries are ignored.
+ *
+ * @example
+ * ```
+ * const all = await gdal.unionAllAsync(parcels.features.map((f) => f.getGeometry()));
+ * const byDistrict = await gdal.unionAllAsync(parcels, { groupBy: 'district' });
+ * ```
+ *
+ * @throws Error
+ * @method unionAll
+ * @static
+ * @for gdal
+ * @param {gdal.Geometry[]|gdal.Layer} geometries
+ * @param {UnionAllOptions} [options]
+ * @param {string|Array<string|number>} [options.groupBy] Field name for a layer, array of keys for an array
+ * @param {number} [options.threads=1] Number of threads
+ * @return {gdal.Geometry|null|Record<string, gdal.Geometry|null>} The union or with `groupBy` an object with the union of every group
+ */
+
+/**
+ * Computes the union of many geometries, optionally grouped by a key, this is
+ * the equivalent of a dissolve.
+ * {{{async}}}
+ *
+ * The polygons are merged with a GEOS cascaded union which is much faster than
+ * chaining `Geometry.union()`, the other geometries with a balanced tree of
+ * pairwise unions. The input is split in chunks unioned on several threads
+ * before merging the partial results, when there are at least as many groups as
+ * threads, the groups are unioned in parallel instead.
+ *
+ * With a layer, its attribute and spatial filters apply and `groupBy` is the name
+ * of a field, the features where it is null go in the `''` group.
+ * With an array of geometries, `groupBy` is an array of keys of the same length.
+ * `null` and empty geometries are ignored.
+ *
+ * @example
+ * ```
+ * const all = await gdal.unionAllAsync(parcels.features.map((f) => f.getGeometry()));
+ * const byDistrict = await gdal.unionAllAsync(parcels, { groupBy: 'district' });
+ * ```
+ *
+ * @throws Error
+ * @method unionAllAsync
+ * @static
+ * @for gdal
+ * @param {gdal.Geometry[]|gdal.Layer} geometries
+ * @param {UnionAllOptions} [options]
+ * @param {string|Array<string|number>} [options.groupBy] Field name for a layer, array of keys for an array
+ * @param {number} [options.threads=1] Number of threads
+ * @param {callback<gdal.Geometry|null|Record<string, gdal.Geometry|null>>} [callback=undefined] {{{cb}}}
+ * @return {Promise<gdal.Geometry|null|Record<string, gdal.Geometry|null>>} The union or with `groupBy` an object with the union of every group
+ */
+GDAL_ASYNCABLE_DEFINE(Algorithms::unionAll) {
+  Local<Object> options;
+  Local<Value> groupBy = Nan::Undefined();
+  int threads = 1;
+
+  if (info.Length() < 1 || !(info[0]->IsArray() || Nan::New(Layer::constructor)->HasInstance(info[0]))) {
+    Nan::ThrowTypeError("geometries must be an array of Geometry objects or a Layer");
+    return;
+  }
+  NODE_ARG_OBJECT_OPT(1, "options", options);
+  if (!options.IsEmpty()) {
+    groupBy = Nan::Get(options, Nan::New("groupBy").ToLocalChecked()).ToLocalChecked();
+    NODE_INT_FROM_OBJ_OPT(options, "threads", threads);
+  }
+  if (threads < 1) {
+    Nan::ThrowRangeError("threads must be a positive integer");
+    return;
+  }
+  const bool grouped = !groupBy->IsUndefined() && !groupBy->IsNull();
+
+  std::shared_ptr<UnionAll> unionAll = std::make_shared<UnionAll>(threads);
+  std::vector<LockedGeometry> geoms;
+  std::vector<std::string> keys;
+  std::vector<Local<Object>> handles;
+  OGRLayer *gdal_layer = nullptr;
+  std::string field;
+  long uid = 0;
+  if (info[0]->IsArray()) {
+    if (!Geometry::FromArray(
+          info[0].As<Array>(), "All array elements must be Geometry objects or null", geoms, handles))
+      return;
+    if (grouped && (!groupBy->IsArray() || groupBy.As<Array>()->Length() != geoms.size())) {
+      Nan::ThrowTypeError("groupBy must be an array with one key per geometry");
+      return;
+    }
+    keys.resize(geoms.size());
+    if (grouped) {
+      for (size_t i = 0; i < geoms.size(); i++)
+        keys[i] = *Nan::Utf8String(Nan::Get(groupBy.As<Array>(), i).ToLocalChecked());
+    }
+  } else {
+    Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(info[0].As<Object>());
+    if (!layer->isAlive()) {
+      Nan::ThrowError("Layer object already destroyed");
+      return;
+    }
+    if (grouped && !groupBy->IsString()) {
+      Nan::ThrowTypeError("groupBy must be a field name");
+      return;
+    }
+    if (grouped) field = *Nan::Utf8String(groupBy);
+    gdal_layer = layer->get();
+    uid = layer->parent_uid;
+    handles.push_back(info[0].As<Object>());
+  }
+
+  GDALAsyncableJob<std::shared_ptr<UnionAll>> job(uid);
+  // Keep the layer or the geometries alive even if the array is modified
+  job.persist(handles);
+  job.main = [unionAll, geoms, keys, gdal_layer, field](const GDALExecutionProgress &) {
+    CPLErrorReset();
+    // The geometries are copied as the union needs them all at once
+    for (size_t i = 0; i < geoms.size(); i++) unionAll->add(keys[i], geoms[i]);
+    if (gdal_layer != nullptr) unionAll->addLayer(gdal_layer, field);
+    unionAll->run();
+    return unionAll;
+  };
+  job.rval = [grouped](std::shared_ptr<UnionAll> unionAll, const GetFromPersistentFunc &) {
+    return unionAll->ToValue(grouped);
+  };
+  job.run(info, async, 2);
+}
+
+typedef std::function<OGRGeometry *(OGRGeometry *)> GeometryOperation;
+
+// Applies an operation to every geometry of an array on several threads
+static void mapGeometries(
+  const Nan::FunctionCallbackInfo<v8::Value> &info,
+  bool async,
+  Local<Object> options,
+  const char *action,
+  GeometryOperation op,
+  int cbIndex) {
+  int threads = 1;
+
+  if (!options.IsEmpty()) { NODE_INT_FROM_OBJ_OPT(options, "threads", threads); }
+  if (threads < 1) {
+    Nan::ThrowRangeError("threads must be a positive integer");
+    return;
+  }
+  std::vector<LockedGeometry> geoms;
+  std::vector<Local<Object>> handles;
+  if (!Geometry::FromArray(info[0].As<Array>(), "All array elements must be Geometry objects or null", geoms, handles))
+    return;
+
+  std::string name = action;
+  GDALAsyncableJob<std::shared_ptr<std::vector<std::unique_ptr<OGRGeometry>>>> job(0);
+  // Keep the geometries alive even if the array is modified
+  job.persist(handles);
+  job.main = [geoms, op, threads, name](const GDALExecutionProgress &) {
+    auto results = std::make_shared<std::vector<std::unique_ptr<OGRGeometry>>>(geoms.size());
+    parallelFor(geoms.size(), threads, [&geoms, &results, &op, &name](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+        if (geoms[i].geom == nullptr) continue;
+        CPLErrorReset();
+        OGRGeometry *r;
+        {
+          GeometryGuard guard(geoms[i]);
+          r = op(geoms[i].geom);
+        }
+        if (r == nullptr) {
+          std::string err = CPLGetLastErrorMsg();
+          CPLError(
+            CE_Failure, CPLE_AppDefined, "Failed %s the geometry at index %d: %s", name.c_str(), (int)i, err.c_str());
+          throw CPLGetLastErrorMsg();
+        }
+        (*results)[i].reset(r);
+      }
+    });
+    return results;
+  };
+  job.rval = [](std::shared_ptr<std::vector<std::unique_ptr<OGRGeometry>>> results, const GetFromPersistentFunc &) {
+    Nan::EscapableHandleScope scope;
+    Local<Array> array = Nan::New<Array>(static_cast<int>(results->size()));
+    for (size_t i = 0; i < results->size(); i++) {
+      if ((*results)[i])
+        Nan::Set(array, i, Geometry::New((*results)[i].release(), true));
+      else
+        Nan::Set(array, i, Nan::Null());
+    }
+    return scope.Escape(array.As<Value>());
+  };
+  job.run(info, async, cbIndex);
+}
+
+/**
+ * Buffers every geometry of an array, `null` elements remain `null`.
+ *
+ * @throws Error
+ * @method bufferMany
+ * @static
+ * @for gdal
+ * @param {gdal.Geometry[]} geometries
+ * @param {number} distance
+ * @param {BufferManyOptions} [options]
+ * @param {number} [options.segments=30] Number of segments used to approximate a 90 degree (quadrant) of curvature
+ * @param {number} [options.threads=1] Number of threads
+ * @return {Array<gdal.Geometry|null>}
+ */
+
+/**
+ * Buffers every geometry of an array, `null` elements remain `null`.
+ * {{{async}}}
+ *
+ * @throws Error
+ * @method bufferManyAsync
+ * @static
+ * @for gdal
+ * @param {gdal.Geometry[]} geometries
+ * @param {number} distance
+ * @param {BufferManyOptions} [options]
+ * @param {number} [options.segments=30] Number of segments used to approximate a 90 degree (quadrant) of curvature
+ * @param {number} [options.threads=1] Number of threads
+ * @param {callback<Array<gdal.Geometry|null>>} [callback=undefined] {{{cb}}}
+ * @return {Promise<Array<gdal.Geometry|null>>}
+ */
+GDAL_ASYNCABLE_DEFINE(Algorithms::bufferMany) {
+  Local<Array> array;
+  double distance;
+  Local<Object> options;
+  int segments = 30;
+
+  NODE_ARG_ARRAY(0, "geometries", array);
+  NODE_ARG_DOUBLE(1, "distance", distance);
+  NODE_ARG_OBJECT_OPT(2, "options", options);
+  if (!options.IsEmpty()) { NODE_INT_FROM_OBJ_OPT(options, "segments", segments); }
+
+  mapGeometries(
+    info,
+    async,
+    options,
+    "buffering",
+    [distance, segments](OGRGeometry *geom) { return geom->Buffer(distance, segments); },
+    3);
+}
+
+/**
+ * Simplifies every geometry of an array, `null` elements remain `null`.
+ *
+ * @throws Error
+ * @method simplifyMany
+ * @static
+ * @for gdal
+ * @param {gdal.Geometry[]} geometries
+ * @param {number} tolerance
+ * @param {SimplifyManyOptions} [options]
+ * @param {boolean} [options.preserveTopology=false] Use `simplifyPreserveTopology()`
+ * @param {number} [options.threads=1] Number of threads
+ * @return {Array<gdal.Geometry|null>}
+ */
+
+/**
+ * Simplifies every geometry of an array, `null` elements remain `null`.
+ * {{{async}}}
+ *
+ * @throws Error
+ * @method simplifyManyAsync
+ * @static
+ * @for gdal
+ * @param {gdal.Geometry[]} geometries
+ * @param {number} tolerance
+ * @param {SimplifyManyOptions} [options]
+ * @param {boolean} [options.preserveTopology=false] Use `simplifyPreserveTopology()`
+ * @param {number} [options.threads=1] Number of threads
+ * @param {callback<Array<gdal.Geometry|null>>} [callback=undefined] {{{cb}}}
+ * @return {Promise<Array<gdal.Geometry|null>>}
+ */
+GDAL_ASYNCABLE_DEFINE(Algorithms::simplifyMany) {
+  Local<Array> array;
+  double tolerance;
+  Local<Object> options;
+  bool preserveTopology = false;
+
+  NODE_ARG_ARRAY(0, "geometries", array);
+  NODE_ARG_DOUBLE(1, "tolerance", tolerance);
+  NODE_ARG_OBJECT_OPT(2, "options", options);
+  if (!options.IsEmpty()) { NODE_BOOL_FROM_OBJ_OPT(options, "preserveTopology", preserveTopology); }
+
+  mapGeometries(
+    info,
+    async,
+    options,
+    "simplifying",
+    [tolerance, preserveTopology](OGRGeometry *geom) {
+      return preserveTopology ? geom->SimplifyPreserveTopology(tolerance) : geom->Simplify(tolerance);
+    },
+    3);
+}
+
+#if GDAL_VERSION_MAJOR >= 3
+/**
+ * Makes valid every geometry of an array, `null` elements remain `null`.
+ * Requires GDAL 3.0
+ *
+ * @throws Error
+ * @method makeValidMany
+ * @static
+ * @for gdal
+ * @param {gdal.Geometry[]} geometries
+ * @param {MakeValidManyOptions} [options]
+ * @param {number} [options.threads=1] Number of threads
+ * @return {Array<gdal.Geometry|null>}
+ */
+
+/**
+ * Makes valid every geometry of an array, `null` elements remain `null`.
+ * Requires GDAL 3.0
+ * {{{async}}}
+ *
+ * @throws Error
+ * @method makeValidManyAsync
+ * @static
+ * @for gdal
+ * @param {gdal.Geometry[]} geometries
+ * @param {MakeValidManyOptions} [options]
+ * @param {number} [options.threads=1] Number of threads
+ * @param {callback<Array<gdal.Geometry|null>>} [callback=undefined] {{{cb}}}
+ * @return {Promise<Array<gdal.Geometry|null>>}
+ */
+GDAL_ASYNCABLE_DEFINE(Algorithms::makeValidMany) {
+  Local<Array> array;
+  Local<Object> options;
+
+  NODE_ARG_ARRAY(0, "geometries", array);
+  NODE_ARG_OBJECT_OPT(1, "options", options);
+
+  mapGeometries(info, async, options, "making valid", [](OGRGeometry *geom) { return geom->MakeValid(); }, 2);
+}
+#endif
+
 // This is used for stress-testing the locking mechanism
 // it doesn't do anything but sollicit locks
 GDAL_ASYNCABLE_DEFINE(Algorithms::_acquireLocks) {
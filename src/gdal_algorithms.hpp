@@ -33,6 +33,14 @@ GDAL_ASYNCABLE_GLOBAL(contourGenerate);
 GDAL_ASYNCABLE_GLOBAL(sieveFilter);
 GDAL_ASYNCABLE_GLOBAL(checksumImage);
 GDAL_ASYNCABLE_GLOBAL(polygonize);
+GDAL_ASYNCABLE_GLOBAL(spatialJoin);
+GDAL_ASYNCABLE_GLOBAL(renderVectorTile);
+GDAL_ASYNCABLE_GLOBAL(unionAll);
+GDAL_ASYNCABLE_GLOBAL(bufferMany);
+GDAL_ASYNCABLE_GLOBAL(simplifyMany);
+#if GDAL_VERSION_MAJOR >= 3
+GDAL_ASYNCABLE_GLOBAL(makeValidMany);
+#endif
 GDAL_ASYNCABLE_GLOBAL(_acquireLocks);
 } // namespace Algorithms
 } // namespace node_gdal
@@ -0,0 +1,263 @@
+#include "gdal_approx_transformer.hpp"
+#include "gdal_common.hpp"
+#include "gdal_spatial_reference.hpp"
+#include "utils/layer_columns.hpp"
+#include "utils/typed_array.hpp"
+
+#include <limits>
+
+namespace node_gdal {
+
+Nan::Persistent<FunctionTemplate> ApproxTransformer::constructor;
+
+void ApproxTransformer::Initialize(Local<Object> target) {
+  Nan::HandleScope scope;
+
+  Local<FunctionTemplate> lcons = Nan::New<FunctionTemplate>(ApproxTransformer::New);
+  lcons->InstanceTemplate()->SetInternalFieldCount(1);
+  lcons->SetClassName(Nan::New("ApproxTransformer").ToLocalChecked());
+
+  Nan::SetPrototypeMethod(lcons, "toString", toString);
+  Nan__SetPrototypeAsyncableMethod(lcons, "transformGrid", transformGrid);
+
+  ATTR(lcons, "maxError", maxErrorGetter, READ_ONLY_SETTER);
+
+  Nan::SetMethod(target, "createApproxTransformer", create);
+  Nan::Set(target, Nan::New("ApproxTransformer").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
+
+  constructor.Reset(lcons);
+}
+
+ApproxTransformer::ApproxTransformer(std::shared_ptr<SharedApproxTransformer> transformer)
+  : Nan::ObjectWrap(), this_(transformer) {
+  LOG("Created ApproxTransformer [%p]", transformer.get());
+}
+
+ApproxTransformer::ApproxTransformer() : Nan::ObjectWrap(), this_(nullptr) {
+}
+
+ApproxTransformer::~ApproxTransformer() {
+  LOG("Disposing ApproxTransformer [%p]", this_.get());
+}
+
+/**
+ * An approximate transformation between two spatial references for
+ * reprojecting dense regular grids, created with `gdal.createApproxTransformer()`.
+ *
+ * This is the transformer used by `gdalwarp`: every row of the grid is
+ * reprojected exactly only at a few points and linearly interpolated in between,
+ * the row being split until the interpolation error is below `maxError`. It is
+ * usually an order of magnitude faster than transforming every point.
+ *
+ * The transformer is not tied to its spatial references and can be used by any
+ * number of concurrent asynchronous operations.
+ *
+ * @example
+ * ```
+ * const transformer = gdal.createApproxTransformer(
+ *   ds.srs, gdal.SpatialReference.fromEPSG(3857), { maxError: 0.01 });
+ * const { xs, ys } = await transformer.transformGridAsync(ds.geoTransform, ds.rasterSize.x, ds.rasterSize.y);
+ * ```
+ *
+ * @class gdal.ApproxTransformer
+ */
+NAN_METHOD(ApproxTransformer::New) {
+  if (!info.IsConstructCall()) {
+    Nan::ThrowError("Cannot call constructor as function, you need to use 'new' keyword");
+    return;
+  }
+
+  if (info[0]->IsExternal()) {
+    Local<External> ext = info[0].As<External>();
+    void *ptr = ext->Value();
+    ApproxTransformer *f = static_cast<ApproxTransformer *>(ptr);
+    f->Wrap(info.This());
+    info.GetReturnValue().Set(info.This());
+    return;
+  }
+
+  Nan::ThrowError("Cannot create ApproxTransformer directly, use gdal.createApproxTransformer()");
+}
+
+Local<Value> ApproxTransformer::New(std::shared_ptr<SharedApproxTransformer> transformer) {
+  Nan::EscapableHandleScope scope;
+
+  ApproxTransformer *wrapped = new ApproxTransformer(transformer);
+
+  Local<Value> ext = Nan::New<External>(wrapped);
+  Local<Object> obj =
+    Nan::NewInstance(Nan::GetFunction(Nan::New(ApproxTransformer::constructor)).ToLocalChecked(), 1, &ext)
+      .ToLocalChecked();
+
+  return scope.Escape(obj);
+}
+
+NAN_METHOD(ApproxTransformer::toString) {
+  info.GetReturnValue().Set(Nan::New("ApproxTransformer").ToLocalChecked());
+}
+
+/**
+ * Creates an approximate transformation between two spatial references.
+ *
+ * `maxError` is the maximum error of the interpolation in the units of the
+ * target spatial reference, 0 transforms every point exactly.
+ *
+ * @for gdal
+ * @static
+ * @method createApproxTransformer
+ * @throws Error
+ * @param {gdal.SpatialReference} source
+ * @param {gdal.SpatialReference} target
+ * @param {ApproxTransformerOptions} options
+ * @param {number} options.maxError Maximum error in target units
+ * @return {gdal.ApproxTransformer}
+ */
+NAN_METHOD(ApproxTransformer::create) {
+  SpatialReference *source, *target;
+  Local<Object> options;
+  double maxError = -1;
+
+  NODE_ARG_WRAPPED(0, "source", SpatialReference, source);
+  NODE_ARG_WRAPPED(1, "target", SpatialReference, target);
+  NODE_ARG_OBJECT(2, "options", options);
+  NODE_DOUBLE_FROM_OBJ_OPT(options, "maxError", maxError);
+  if (!(maxError >= 0)) {
+    Nan::ThrowRangeError("maxError must be a non-negative number");
+    return;
+  }
+
+  try {
+    std::shared_ptr<SharedApproxTransformer> transformer =
+      std::make_shared<SharedApproxTransformer>(source->get(), target->get(), maxError);
+    info.GetReturnValue().Set(ApproxTransformer::New(transformer));
+  } catch (const char *err) { Nan::ThrowError(err); }
+}
+
+/**
+ * @readOnly
+ * @attribute maxError
+ * @type {number}
+ */
+NAN_GETTER(ApproxTransformer::maxErrorGetter) {
+  ApproxTransformer *transformer = Nan::ObjectWrap::Unwrap<ApproxTransformer>(info.This());
+  info.GetReturnValue().Set(Nan::New<Number>(transformer->get()->maxError));
+}
+
+struct TransformedGrid {
+  ColumnBuffer xs, ys, success;
+};
+
+/**
+ * Transforms the pixel grid of a geotransform.
+ *
+ * Returns the transformed coordinates of the `width` x `height` points of the
+ * grid, row by row, and an `Uint8Array` with 1 for every point that was
+ * transformed and 0 for those that failed. The points are the pixel centers,
+ * or with `center: false` the top-left corners of the pixels, use
+ * `width + 1` x `height + 1` to get all the corners.
+ *
+ * @example
+ * ```
+ * const { xs, ys, success } = transformer.transformGrid(ds.geoTransform, ds.rasterSize.x, ds.rasterSize.y);
+ * ```
+ *
+ * @method transformGrid
+ * @throws Error
+ * @param {number[]} geoTransform
+ * @param {number} width
+ * @param {number} height
+ * @param {TransformGridOptions} [options]
+ * @param {boolean} [options.center=true] Transform the pixel centers instead of the corners
+ * @param {number} [options.threads=1] Number of threads
+ * @return {TransformedGrid}
+ */
+
+/**
+ * Transforms the pixel grid of a geotransform.
+ * {{{async}}}
+ *
+ * Returns the transformed coordinates of the `width` x `height` points of the
+ * grid, row by row, and an `Uint8Array` with 1 for every point that was
+ * transformed and 0 for those that failed. The points are the pixel centers,
+ * or with `center: false` the top-left corners of the pixels, use
+ * `width + 1` x `height + 1` to get all the corners.
+ *
+ * @method transformGridAsync
+ * @throws Error
+ * @param {number[]} geoTransform
+ * @param {number} width
+ * @param {number} height
+ * @param {TransformGridOptions} [options]
+ * @param {boolean} [options.center=true] Transform the pixel centers instead of the corners
+ * @param {number} [options.threads=1] Number of threads
+ * @param {callback<TransformedGrid>} [callback=undefined] {{{cb}}}
+ * @return {Promise<TransformedGrid>}
+ */
+GDAL_ASYNCABLE_DEFINE(ApproxTransformer::transformGrid) {
+  ApproxTransformer *transformer = Nan::ObjectWrap::Unwrap<ApproxTransformer>(info.This());
+  Local<Array> geoTransform;
+  int width, height;
+  Local<Object> options;
+  bool center = true;
+  int threads = 1;
+
+  NODE_ARG_ARRAY(0, "geoTransform", geoTransform);
+  NODE_ARG_INT(1, "width", width);
+  NODE_ARG_INT(2, "height", height);
+  NODE_ARG_OBJECT_OPT(3, "options", options);
+  if (!options.IsEmpty()) {
+    NODE_BOOL_FROM_OBJ_OPT(options, "center", center);
+    NODE_INT_FROM_OBJ_OPT(options, "threads", threads);
+  }
+
+  if (geoTransform->Length() != 6) {
+    Nan::ThrowError("Transform array must have 6 elements");
+    return;
+  }
+  std::vector<double> gt(6);
+  for (int i = 0; i < 6; i++) {
+    Local<Value> val = Nan::Get(geoTransform, i).ToLocalChecked();
+    if (!val->IsNumber()) {
+      Nan::ThrowError("Transform array must only contain numbers");
+      return;
+    }
+    gt[i] = Nan::To<double>(val).ToChecked();
+  }
+  if (width < 1 || height < 1) {
+    Nan::ThrowRangeError("width and height must be positive integers");
+    return;
+  }
+  if (static_cast<uint64_t>(width) * height > std::numeric_limits<unsigned int>::max()) {
+    Nan::ThrowRangeError("Too many points");
+    return;
+  }
+  if (threads < 1) {
+    Nan::ThrowRangeError("threads must be a positive integer");
+    return;
+  }
+
+  std::shared_ptr<SharedApproxTransformer> shared = transformer->get();
+  GDALAsyncableJob<std::shared_ptr<TransformedGrid>> job(0);
+  job.main = [shared, gt, width, height, center, threads](const GDALExecutionProgress &) {
+    std::shared_ptr<TransformedGrid> grid = std::make_shared<TransformedGrid>();
+    const size_t count = static_cast<size_t>(width) * height;
+    double *xs = reinterpret_cast<double *>(grid->xs.grow(count * sizeof(double)));
+    double *ys = reinterpret_cast<double *>(grid->ys.grow(count * sizeof(double)));
+    GByte *success = grid->success.grow(count);
+    shared->transformGrid(gt.data(), width, height, center, xs, ys, success, threads);
+    return grid;
+  };
+  job.rval = [](std::shared_ptr<TransformedGrid> grid, const GetFromPersistentFunc &) {
+    Nan::EscapableHandleScope scope;
+    const unsigned int count = static_cast<unsigned int>(grid->success.size);
+    Local<Object> result = Nan::New<Object>();
+    Nan::Set(result, Nan::New("xs").ToLocalChecked(), TypedArray::Adopt(GDT_Float64, grid->xs.release(), count));
+    Nan::Set(result, Nan::New("ys").ToLocalChecked(), TypedArray::Adopt(GDT_Float64, grid->ys.release(), count));
+    Nan::Set(
+      result, Nan::New("success").ToLocalChecked(), TypedArray::Adopt(GDT_Byte, grid->success.release(), count));
+    return scope.Escape(result);
+  };
+  job.run(info, async, 4);
+}
+
+} // namespace node_gdal
@@ -0,0 +1,45 @@
+#ifndef __NODE_GDAL_APPROX_TRANSFORMER_WRAP_H__
+#define __NODE_GDAL_APPROX_TRANSFORMER_WRAP_H__
+
+// node
+#include <node.h>
+#include <node_object_wrap.h>
+
+// nan
+#include "nan-wrapper.h"
+
+#include <memory>
+
+#include "async.hpp"
+#include "utils/approx_transformer.hpp"
+
+using namespace v8;
+using namespace node;
+
+namespace node_gdal {
+
+class ApproxTransformer : public Nan::ObjectWrap {
+    public:
+  static Nan::Persistent<FunctionTemplate> constructor;
+  static void Initialize(Local<Object> target);
+  static NAN_METHOD(New);
+  static Local<Value> New(std::shared_ptr<SharedApproxTransformer> transformer);
+  static NAN_METHOD(create);
+  static NAN_METHOD(toString);
+  static NAN_GETTER(maxErrorGetter);
+  GDAL_ASYNCABLE_DECLARE(transformGrid);
+
+  ApproxTransformer();
+  ApproxTransformer(std::shared_ptr<SharedApproxTransformer> transformer);
+  // The transformers are pooled and can be shared with worker threads
+  inline std::shared_ptr<SharedApproxTransformer> get() {
+    return this_;
+  }
+
+    private:
+  ~ApproxTransformer();
+  std::shared_ptr<SharedApproxTransformer> this_;
+};
+
+} // namespace node_gdal
+#endif
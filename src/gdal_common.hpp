@@ -9,6 +9,7 @@
 #include "nan-wrapper.h"
 
 #include "utils/ptr_manager.hpp"
+#include "utils/field_names.hpp"
 
 #if GDAL_VERSION_MAJOR < 2 || (GDAL_VERSION_MAJOR == 2 && GDAL_VERSION_MINOR < 1)
 #error gdal-async now requires GDAL >= 2.1, downgrade to gdal-async@3.2.x for earlier versions
@@ -310,6 +311,19 @@ NAN_SETTER(READ_ONLY_SETTER);
     }                                                                                                                  \
   }
 
+#define NODE_BOOL_FROM_OBJ_OPT(obj, key, var)                                                                          \
+  {                                                                                                                    \
+    Local<String> sym = Nan::New(key).ToLocalChecked();                                                                \
+    if (Nan::HasOwnProperty(obj, sym).FromMaybe(false)) {                                                              \
+      Local<Value> val = Nan::Get(obj, sym).ToLocalChecked();                                                          \
+      if (!val->IsBoolean() && !val->IsUndefined()) {                                                                  \
+        Nan::ThrowTypeError("Property \"" key "\" must be a boolean");                                                 \
+        return;                                                                                                        \
+      }                                                                                                                \
+      if (val->IsBoolean()) var = Nan::To<bool>(val).ToChecked();                                                      \
+    }                                                                                                                  \
+  }
+
 #define NODE_CB_FROM_OBJ_OPT(obj, key, var)                                                                            \
   {                                                                                                                    \
     var = nullptr;                                                                                                     \
@@ -334,7 +348,7 @@ NAN_SETTER(READ_ONLY_SETTER);
   {                                                                                                                    \
     if (info[num]->IsString()) {                                                                                       \
       std::string field_name = *Nan::Utf8String(info[num]);                                                            \
-      var = f->GetFieldIndex(field_name.c_str());                                                                      \
+      var = FieldNames::getFieldIndex(f, field_name.c_str());                                                          \
       if (field_index == -1) {                                                                                         \
         Nan::ThrowError("Specified field name does not exist");                                                        \
         return;                                                                                                        \
@@ -3,6 +3,17 @@
 #include "gdal_common.hpp"
 #include "gdal_dataset.hpp"
 #include "gdal_spatial_reference.hpp"
+#include "utils/layer_columns.hpp"
+#include "utils/parallel.hpp"
+#include "utils/srs_cache.hpp"
+#include "utils/typed_array.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
 
 namespace node_gdal {
 
@@ -17,6 +28,7 @@ void CoordinateTransformation::Initialize(Local<Object> target) {
 
   Nan::SetPrototypeMethod(lcons, "toString", toString);
   Nan::SetPrototypeMethod(lcons, "transformPoint", transformPoint);
+  Nan__SetPrototypeAsyncableMethod(lcons, "transformPoints", transformPoints);
 
   Nan::Set(target, Nan::New("CoordinateTransformation").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
 
@@ -79,7 +91,7 @@ NAN_METHOD(CoordinateTransformation::New) {
       // srs -> srs
       NODE_ARG_WRAPPED(1, "target", SpatialReference, target);
 
-      OGRCoordinateTransformation *transform = OGRCreateCoordinateTransformation(source->get(), target->get());
+      OGRCoordinateTransformation *transform = CachedCoordinateTransformation(source->get(), target->get());
       if (!transform) {
         NODE_THROW_LAST_CPLERR;
         return;
@@ -210,4 +222,213 @@ NAN_METHOD(CoordinateTransformation::transformPoint) {
   info.GetReturnValue().Set(result);
 }
 
+static void DestroyTransformation(OGRCoordinateTransformation *ct) {
+  if (ct != nullptr) OGRCoordinateTransformation::DestroyCT(ct);
+}
+
+// Returns nullptr on error, before GDAL 3.1 only the transformations between
+// two spatial references and to the pixel coordinates of a Dataset can be copied
+static OGRCoordinateTransformation *cloneTransformation(OGRCoordinateTransformation *ct) {
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 1)
+  return ct->Clone();
+#else
+  GeoTransformTransformer *geoTransform = dynamic_cast<GeoTransformTransformer *>(ct);
+  if (geoTransform != nullptr) return geoTransform->Clone();
+  if (ct->GetSourceCS() == nullptr || ct->GetTargetCS() == nullptr) return nullptr;
+  return OGRCreateCoordinateTransformation(ct->GetSourceCS(), ct->GetTargetCS());
+#endif
+}
+
+// Returns false after throwing an exception, a missing optional array is nullptr
+static bool coordinateArray(Local<Value> val, const char *name, bool optional, size_t length, double *&data) {
+  if (optional && (val->IsUndefined() || val->IsNull())) {
+    data = nullptr;
+    return true;
+  }
+  if (!val->IsFloat64Array()) {
+    Nan::ThrowTypeError((std::string(name) + " must be a Float64Array").c_str());
+    return false;
+  }
+  Nan::TypedArrayContents<double> contents(val);
+  if (contents.length() != length) {
+    Nan::ThrowRangeError((std::string(name) + " must have the same length as xs").c_str());
+    return false;
+  }
+  data = *contents;
+  return true;
+}
+
+/**
+ * Transforms arrays of coordinates from source to destination space.
+ *
+ * The points are transformed in place or, with `output`, written to other
+ * arrays. The transformation is done with one call per block of points, the
+ * blocks can be split across several threads. Without `zs`, Z is assumed to
+ * be 0.
+ *
+ * Returns an `Uint8Array` with 1 for every point that was transformed and 0
+ * for those that failed, the coordinates of the failed points are undefined.
+ *
+ * @example
+ * ```
+ * const ok = ct.transformPoints(xs, ys, null, { threads: 4 });
+ * ```
+ *
+ * @method transformPoints
+ * @throws Error
+ * @param {Float64Array} xs
+ * @param {Float64Array} ys
+ * @param {Float64Array|null} [zs]
+ * @param {TransformPointsOptions} [options]
+ * @param {TransformPointsOutput} [options.output] Output arrays, the input is left untouched
+ * @param {number} [options.threads=1] Number of threads
+ * @return {Uint8Array}
+ */
+
+/**
+ * Transforms arrays of coordinates from source to destination space.
+ * {{{async}}}
+ *
+ * The points are transformed in place or, with `output`, written to other
+ * arrays. The transformation is done with one call per block of points, the
+ * blocks can be split across several threads. Without `zs`, Z is assumed to
+ * be 0.
+ *
+ * Resolves to an `Uint8Array` with 1 for every point that was transformed and 0
+ * for those that failed, the coordinates of the failed points are undefined.
+ *
+ * @example
+ * ```
+ * const ok = await ct.transformPointsAsync(xs, ys, null, { threads: 4 });
+ * ```
+ *
+ * @method transformPointsAsync
+ * @throws Error
+ * @param {Float64Array} xs
+ * @param {Float64Array} ys
+ * @param {Float64Array|null} [zs]
+ * @param {TransformPointsOptions} [options]
+ * @param {TransformPointsOutput} [options.output] Output arrays, the input is left untouched
+ * @param {number} [options.threads=1] Number of threads
+ * @param {callback<Uint8Array>} [callback=undefined] {{{cb}}}
+ * @return {Promise<Uint8Array>}
+ */
+GDAL_ASYNCABLE_DEFINE(CoordinateTransformation::transformPoints) {
+  CoordinateTransformation *transform = Nan::ObjectWrap::Unwrap<CoordinateTransformation>(info.This());
+  Local<Object> options;
+  Local<Object> output;
+  int threads = 1;
+
+  if (info.Length() < 2 || !info[0]->IsFloat64Array()) {
+    Nan::ThrowTypeError("xs must be a Float64Array");
+    return;
+  }
+  const size_t count = Nan::TypedArrayContents<double>(info[0]).length();
+  if (count > std::numeric_limits<unsigned int>::max()) {
+    Nan::ThrowRangeError("Too many points");
+    return;
+  }
+  double *xs, *ys, *zs;
+  if (!coordinateArray(info[0], "xs", false, count, xs)) return;
+  if (!coordinateArray(info[1], "ys", false, count, ys)) return;
+  if (!coordinateArray(info[2], "zs", true, count, zs)) return;
+  NODE_ARG_OBJECT_OPT(3, "options", options);
+  if (!options.IsEmpty()) {
+    NODE_INT_FROM_OBJ_OPT(options, "threads", threads);
+    Local<Value> val = Nan::Get(options, Nan::New("output").ToLocalChecked()).ToLocalChecked();
+    if (val->IsObject()) {
+      output = val.As<Object>();
+    } else if (!val->IsUndefined() && !val->IsNull()) {
+      Nan::ThrowTypeError("output must be an object");
+      return;
+    }
+  }
+  if (threads < 1) {
+    Nan::ThrowRangeError("threads must be a positive integer");
+    return;
+  }
+
+  // The input is copied to the output arrays which are then transformed in place
+  const double *src[3] = {xs, ys, zs};
+  double *dst[3] = {xs, ys, zs};
+  if (!output.IsEmpty()) {
+    Local<Value> outXs = Nan::Get(output, Nan::New("xs").ToLocalChecked()).ToLocalChecked();
+    Local<Value> outYs = Nan::Get(output, Nan::New("ys").ToLocalChecked()).ToLocalChecked();
+    Local<Value> outZs = Nan::Get(output, Nan::New("zs").ToLocalChecked()).ToLocalChecked();
+    if (!coordinateArray(outXs, "output.xs", false, count, dst[0])) return;
+    if (!coordinateArray(outYs, "output.ys", false, count, dst[1])) return;
+    if (!coordinateArray(outZs, "output.zs", true, count, dst[2])) return;
+    if (zs != nullptr && dst[2] == nullptr) {
+      Nan::ThrowError("output.zs is required when transforming zs");
+      return;
+    }
+  }
+
+  // The transformation is not reentrant, the job works on its own copy
+  // and the extra threads on copies of it
+  std::shared_ptr<OGRCoordinateTransformation> ct(cloneTransformation(transform->this_), DestroyTransformation);
+  if (ct == nullptr) {
+    Nan::ThrowError("Failed cloning the transformation");
+    return;
+  }
+#if GDAL_VERSION_MAJOR < 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR < 1)
+  // Transformations cannot be cloned on the worker threads
+  threads = 1;
+#endif
+
+  std::vector<double *> arrays = {dst[0], dst[1], dst[2]};
+  GDALAsyncableJob<std::shared_ptr<ColumnBuffer>> job(0);
+  job.persist(info.This());
+  job.persist(info[0].As<Object>(), info[1].As<Object>());
+  if (zs != nullptr) job.persist(info[2].As<Object>());
+  if (!output.IsEmpty()) {
+    // The arrays and not only the object holding them
+    for (const char *key : {"xs", "ys", "zs"}) {
+      Local<Value> array = Nan::Get(output, Nan::New(key).ToLocalChecked()).ToLocalChecked();
+      if (array->IsObject()) job.persist(array.As<Object>());
+    }
+  }
+  job.main = [ct, src, arrays, count, threads](const GDALExecutionProgress &) {
+    std::shared_ptr<ColumnBuffer> mask = std::make_shared<ColumnBuffer>();
+    GByte *out = mask->grow(count);
+    std::mutex cloneLock;
+    parallelFor(count, threads, [ct, src, arrays, threads, out, &cloneLock](size_t begin, size_t end) {
+      // Every thread needs its own copy of the transformation
+      std::unique_ptr<OGRCoordinateTransformation, void (*)(OGRCoordinateTransformation *)> clone(
+        nullptr, DestroyTransformation);
+      if (threads > 1) {
+        std::lock_guard<std::mutex> guard(cloneLock);
+        clone.reset(cloneTransformation(ct.get()));
+        if (clone == nullptr) throw "Failed cloning the transformation";
+      }
+      OGRCoordinateTransformation *local = clone ? clone.get() : ct.get();
+
+      const size_t blockSize = 65536;
+      std::vector<int> success(std::min(blockSize, end - begin));
+      for (size_t b = begin; b < end; b += blockSize) {
+        const int n = static_cast<int>(std::min(blockSize, end - b));
+        double *x = arrays[0] + b, *y = arrays[1] + b, *z = arrays[2] ? arrays[2] + b : nullptr;
+        if (x != src[0] + b) memcpy(x, src[0] + b, n * sizeof(double));
+        if (y != src[1] + b) memcpy(y, src[1] + b, n * sizeof(double));
+        if (z != nullptr && src[2] == nullptr)
+          std::fill(z, z + n, 0.0);
+        else if (z != nullptr && z != src[2] + b)
+          memcpy(z, src[2] + b, n * sizeof(double));
+#if GDAL_VERSION_MAJOR >= 3
+        local->Transform(n, x, y, z, nullptr, success.data());
+#else
+        local->TransformEx(n, x, y, z, success.data());
+#endif
+        for (int i = 0; i < n; i++) out[b + i] = success[i] ? 1 : 0;
+      }
+    });
+    return mask;
+  };
+  job.rval = [](std::shared_ptr<ColumnBuffer> mask, const GetFromPersistentFunc &) {
+    size_t length = mask->size;
+    return TypedArray::Adopt(GDT_Byte, mask->release(), static_cast<unsigned int>(length));
+  };
+  job.run(info, async, 4);
+}
+
 } // namespace node_gdal
@@ -14,6 +14,8 @@
 // gdal
 #include <gdalwarper.h>
 
+#include "async.hpp"
+
 using namespace v8;
 using namespace node;
 
@@ -29,6 +31,7 @@ class CoordinateTransformation : public Nan::ObjectWrap {
   static Local<Value> New(OGRCoordinateTransformation *transform);
   static NAN_METHOD(toString);
   static NAN_METHOD(transformPoint);
+  GDAL_ASYNCABLE_DECLARE(transformPoints);
 
   CoordinateTransformation();
   CoordinateTransformation(OGRCoordinateTransformation *srs);
@@ -94,7 +97,14 @@ class GeoTransformTransformer : public OGRCoordinateTransformation {
     override
 #endif
   {
-    return new GeoTransformTransformer(*this);
+    // The underlying transformer cannot be shared
+    GeoTransformTransformer *r = new GeoTransformTransformer();
+    r->hSrcImageTransformer = GDALCreateSimilarTransformer(hSrcImageTransformer, 1, 1);
+    if (r->hSrcImageTransformer == nullptr) {
+      delete r;
+      return nullptr;
+    }
+    return r;
   }
 
   ~GeoTransformTransformer() {
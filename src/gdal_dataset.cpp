@@ -28,11 +28,15 @@ void Dataset::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "getGCPProjection", getGCPProjection);
   Nan::SetPrototypeMethod(lcons, "getFileList", getFileList);
   Nan__SetPrototypeAsyncableMethod(lcons, "flush", flush);
+  Nan__SetPrototypeAsyncableMethod(lcons, "startTransaction", startTransaction);
+  Nan__SetPrototypeAsyncableMethod(lcons, "commit", commitTransaction);
+  Nan__SetPrototypeAsyncableMethod(lcons, "rollback", rollbackTransaction);
   Nan::SetPrototypeMethod(lcons, "close", close);
   Nan__SetPrototypeAsyncableMethod(lcons, "getMetadata", getMetadata);
   Nan__SetPrototypeAsyncableMethod(lcons, "setMetadata", setMetadata);
   Nan::SetPrototypeMethod(lcons, "testCapability", testCapability);
   Nan__SetPrototypeAsyncableMethod(lcons, "executeSQL", executeSQL);
+  Nan__SetPrototypeAsyncableMethod(lcons, "releaseResultSet", releaseResultSet);
   Nan__SetPrototypeAsyncableMethod(lcons, "buildOverviews", buildOverviews);
 
   ATTR_DONT_ENUM(lcons, "_uid", uidGetter, READ_ONLY_SETTER);
@@ -333,6 +337,109 @@ GDAL_ASYNCABLE_DEFINE(Dataset::flush) {
   return;
 }
 
+/**
+ * Starts a transaction on a vector dataset.
+ *
+ * Only one transaction can be active at a time. When the driver does not
+ * support transactions (see `gdal.ODsCTransactions`), `force` allows to
+ * use an emulation based on a copy of the dataset (see `gdal.ODsCEmulatedTransactions`).
+ *
+ * @throws Error
+ * @method startTransaction
+ * @param {boolean} [force=false] Allow emulated transactions
+ */
+
+/**
+ * Starts a transaction on a vector dataset.
+ * {{{async}}}
+ *
+ * Only one transaction can be active at a time. When the driver does not
+ * support transactions (see `gdal.ODsCTransactions`), `force` allows to
+ * use an emulation based on a copy of the dataset (see `gdal.ODsCEmulatedTransactions`).
+ *
+ * @throws Error
+ * @method startTransactionAsync
+ * @param {boolean} [force=false] Allow emulated transactions
+ * @param {callback<void>} [callback=undefined] {{{cb}}}
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Dataset::startTransaction) {
+  NODE_UNWRAP_CHECK(Dataset, info.This(), ds);
+  GDAL_RAW_CHECK(GDALDataset *, ds, raw);
+
+  bool force = false;
+  NODE_ARG_BOOL_OPT(0, "force", force);
+
+  GDALAsyncableJob<OGRErr> job(ds->uid);
+  job.main = [raw, force](const GDALExecutionProgress &) {
+    OGRErr err = raw->StartTransaction(force);
+    if (err) throw getOGRErrMsg(err);
+    return err;
+  };
+  job.rval = [](OGRErr, const GetFromPersistentFunc &) { return Nan::Undefined().As<Value>(); };
+  job.run(info, async, 1);
+}
+
+/**
+ * Commits the current transaction.
+ *
+ * @throws Error
+ * @method commit
+ */
+
+/**
+ * Commits the current transaction.
+ * {{{async}}}
+ *
+ * @throws Error
+ * @method commitAsync
+ * @param {callback<void>} [callback=undefined] {{{cb}}}
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Dataset::commitTransaction) {
+  NODE_UNWRAP_CHECK(Dataset, info.This(), ds);
+  GDAL_RAW_CHECK(GDALDataset *, ds, raw);
+
+  GDALAsyncableJob<OGRErr> job(ds->uid);
+  job.main = [raw](const GDALExecutionProgress &) {
+    OGRErr err = raw->CommitTransaction();
+    if (err) throw getOGRErrMsg(err);
+    return err;
+  };
+  job.rval = [](OGRErr, const GetFromPersistentFunc &) { return Nan::Undefined().As<Value>(); };
+  job.run(info, async, 0);
+}
+
+/**
+ * Rolls back the current transaction.
+ *
+ * @throws Error
+ * @method rollback
+ */
+
+/**
+ * Rolls back the current transaction.
+ * {{{async}}}
+ *
+ * @throws Error
+ * @method rollbackAsync
+ * @param {callback<void>} [callback=undefined] {{{cb}}}
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Dataset::rollbackTransaction) {
+  NODE_UNWRAP_CHECK(Dataset, info.This(), ds);
+  GDAL_RAW_CHECK(GDALDataset *, ds, raw);
+
+  GDALAsyncableJob<OGRErr> job(ds->uid);
+  job.main = [raw](const GDALExecutionProgress &) {
+    OGRErr err = raw->RollbackTransaction();
+    if (err) throw getOGRErrMsg(err);
+    return err;
+  };
+  job.rval = [](OGRErr, const GetFromPersistentFunc &) { return Nan::Undefined().As<Value>(); };
+  job.run(info, async, 0);
+}
+
 /**
  * Execute an SQL statement against the data store.
  *
@@ -397,6 +504,52 @@ GDAL_ASYNCABLE_DEFINE(Dataset::executeSQL) {
   job.run(info, async, 3);
 }
 
+/**
+ * Releases an SQL result set returned by `executeSQL`.
+ *
+ * The result sets are otherwise released by the garbage collector which may have
+ * to block the event loop while waiting for the dataset if it is in use by an
+ * asynchronous operation. The layer cannot be used afterwards.
+ *
+ * @throws Error
+ * @method releaseResultSet
+ * @param {gdal.Layer} layer SQL result set
+ */
+
+/**
+ * Releases an SQL result set returned by `executeSQL`.
+ * {{{async}}}
+ *
+ * The result sets are otherwise released by the garbage collector which may have
+ * to block the event loop while waiting for the dataset if it is in use by an
+ * asynchronous operation. The layer cannot be used afterwards.
+ *
+ * @throws Error
+ * @method releaseResultSetAsync
+ * @param {gdal.Layer} layer SQL result set
+ * @param {callback<void>} [callback=undefined] {{{cb}}}
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Dataset::releaseResultSet) {
+  NODE_UNWRAP_CHECK(Dataset, info.This(), ds);
+  Layer *layer;
+  NODE_ARG_WRAPPED(0, "layer", Layer, layer);
+  if (layer->parent_uid != ds->uid) {
+    Nan::ThrowError("Layer does not belong to this Dataset");
+    return;
+  }
+
+  long uid = layer->uid;
+  GDALAsyncableJob<bool> job(ds->uid);
+  job.persist(layer->handle());
+  job.main = [uid](const GDALExecutionProgress &) {
+    object_store.releaseResultSet(uid);
+    return true;
+  };
+  job.rval = [](bool, const GetFromPersistentFunc &) { return Nan::Undefined().As<Value>(); };
+  job.run(info, async, 1);
+}
+
 /**
  * Fetch files forming dataset.
  *
@@ -40,6 +40,10 @@ class Dataset : public Nan::ObjectWrap {
   static NAN_METHOD(getGCPs);
   static NAN_METHOD(setGCPs);
   GDAL_ASYNCABLE_DECLARE(executeSQL);
+  GDAL_ASYNCABLE_DECLARE(releaseResultSet);
+  GDAL_ASYNCABLE_DECLARE(startTransaction);
+  GDAL_ASYNCABLE_DECLARE(commitTransaction);
+  GDAL_ASYNCABLE_DECLARE(rollbackTransaction);
   static NAN_METHOD(testCapability);
   GDAL_ASYNCABLE_DECLARE(buildOverviews);
   static NAN_METHOD(close);
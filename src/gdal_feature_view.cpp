@@ -0,0 +1,226 @@
+#include "gdal_feature_view.hpp"
+#include "collections/feature_fields.hpp"
+#include "gdal_common.hpp"
+#include "gdal_feature.hpp"
+#include "geometry/gdal_geometry.hpp"
+
+namespace node_gdal {
+
+Nan::Persistent<FunctionTemplate> FeatureView::constructor;
+
+void FeatureView::Initialize(Local<Object> target) {
+  Nan::HandleScope scope;
+
+  Local<FunctionTemplate> lcons = Nan::New<FunctionTemplate>(FeatureView::New);
+  lcons->InstanceTemplate()->SetInternalFieldCount(1);
+  lcons->SetClassName(Nan::New("FeatureView").ToLocalChecked());
+
+  Nan::SetPrototypeMethod(lcons, "toString", toString);
+  Nan::SetPrototypeMethod(lcons, "get", get);
+  Nan::SetPrototypeMethod(lcons, "getGeometry", getGeometry);
+  Nan::SetPrototypeMethod(lcons, "toObject", toObject);
+  Nan::SetPrototypeMethod(lcons, "toFeature", toFeature);
+  Nan::SetPrototypeMethod(lcons, "release", release);
+
+  ATTR(lcons, "fid", fidGetter, READ_ONLY_SETTER);
+  ATTR(lcons, "valid", validGetter, READ_ONLY_SETTER);
+
+  Nan::Set(target, Nan::New("FeatureView").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
+
+  constructor.Reset(lcons);
+}
+
+FeatureView::FeatureView(OGRFeature *feature) : Nan::ObjectWrap(), this_(feature) {
+  LOG("Created FeatureView [%p]", feature);
+}
+
+FeatureView::FeatureView() : Nan::ObjectWrap(), this_(nullptr) {
+}
+
+FeatureView::~FeatureView() {
+  dispose();
+}
+
+void FeatureView::dispose() {
+  if (this_) {
+    LOG("Disposing FeatureView [%p]", this_);
+    OGRFeature::DestroyFeature(this_);
+    this_ = nullptr;
+  }
+}
+
+#define NODE_UNWRAP_VIEW(obj, var)                                                                                     \
+  FeatureView *var = Nan::ObjectWrap::Unwrap<FeatureView>(obj);                                                        \
+  if (!var->isAlive()) {                                                                                               \
+    Nan::ThrowError("FeatureView is no longer valid, the iterator has advanced");                                      \
+    return;                                                                                                            \
+  }
+
+/**
+ * A lightweight read-only view of a feature returned by the iterators.
+ *
+ * Unlike a {{#crossLink "gdal.Feature"}}Feature{{/crossLink}}, a view does not
+ * create any collection objects, the fields are decoded only when they are
+ * accessed and the geometry is copied only when `getGeometry()` is called.
+ *
+ * A view is valid only until the iterator that produced it advances, the
+ * underlying feature is then freed and any further access throws.
+ * `toFeature()` returns an independent copy that can be kept.
+ *
+ * @example
+ * ```
+ * for await (const view of layer.features.iterate({ view: true })) {
+ *   total += view.get('population');
+ * }```
+ *
+ * @class gdal.FeatureView
+ */
+NAN_METHOD(FeatureView::New) {
+  if (!info.IsConstructCall()) {
+    Nan::ThrowError("Cannot call constructor as function, you need to use 'new' keyword");
+    return;
+  }
+
+  if (info[0]->IsExternal()) {
+    Local<External> ext = info[0].As<External>();
+    void *ptr = ext->Value();
+    FeatureView *f = static_cast<FeatureView *>(ptr);
+    f->Wrap(info.This());
+    info.GetReturnValue().Set(info.This());
+    return;
+  }
+
+  Nan::ThrowError("Cannot create FeatureView directly, use LayerFeatures.iterate() or LayerFeatures.nextViews()");
+}
+
+Local<Value> FeatureView::New(OGRFeature *feature) {
+  Nan::EscapableHandleScope scope;
+
+  if (!feature) { return scope.Escape(Nan::Null()); }
+
+  FeatureView *wrapped = new FeatureView(feature);
+  Local<Value> ext = Nan::New<External>(wrapped);
+  Local<Object> obj =
+    Nan::NewInstance(Nan::GetFunction(Nan::New(FeatureView::constructor)).ToLocalChecked(), 1, &ext).ToLocalChecked();
+  return scope.Escape(obj);
+}
+
+NAN_METHOD(FeatureView::toString) {
+  info.GetReturnValue().Set(Nan::New("FeatureView").ToLocalChecked());
+}
+
+/**
+ * Returns a field's value.
+ *
+ * @method get
+ * @throws Error
+ * @param {string|number} key Field name or index
+ * @return {any}
+ */
+NAN_METHOD(FeatureView::get) {
+  NODE_UNWRAP_VIEW(info.This(), view);
+
+  if (info.Length() < 1) {
+    Nan::ThrowError("Field index or name must be given");
+    return;
+  }
+
+  int field_index;
+  ARG_FIELD_ID(0, view->this_, field_index);
+
+  try {
+    info.GetReturnValue().Set(FeatureFields::get(view->this_, field_index));
+  } catch (const char *err) { Nan::ThrowError(err); }
+}
+
+/**
+ * Returns a copy of the geometry of the feature.
+ *
+ * @method getGeometry
+ * @throws Error
+ * @return {gdal.Geometry|null}
+ */
+NAN_METHOD(FeatureView::getGeometry) {
+  NODE_UNWRAP_VIEW(info.This(), view);
+
+  OGRGeometry *geom = view->this_->GetGeometryRef();
+  if (!geom) {
+    info.GetReturnValue().Set(Nan::Null());
+    return;
+  }
+
+  info.GetReturnValue().Set(Geometry::New(geom, false));
+}
+
+/**
+ * Returns the field values as a JS object.
+ *
+ * @method toObject
+ * @throws Error
+ * @return {any}
+ */
+NAN_METHOD(FeatureView::toObject) {
+  NODE_UNWRAP_VIEW(info.This(), view);
+
+  OGRFeature *f = view->this_;
+  Local<Object> obj = Nan::New<Object>();
+  FieldNames *names = FieldNames::get(f->GetDefnRef());
+  for (int i = 0; i < f->GetFieldCount(); i++) {
+    try {
+      Nan::Set(obj, names->name(i), FeatureFields::get(f, i));
+    } catch (const char *err) {
+      Nan::ThrowError(err);
+      return;
+    }
+  }
+  info.GetReturnValue().Set(obj);
+}
+
+/**
+ * Returns an independent copy of the feature that remains valid
+ * after the iterator has advanced.
+ *
+ * @method toFeature
+ * @throws Error
+ * @return {gdal.Feature}
+ */
+NAN_METHOD(FeatureView::toFeature) {
+  NODE_UNWRAP_VIEW(info.This(), view);
+  info.GetReturnValue().Set(Feature::New(view->this_->Clone()));
+}
+
+/**
+ * Frees the underlying feature, the view cannot be used afterwards.
+ *
+ * This is called by the iterators when they advance.
+ *
+ * @method release
+ */
+NAN_METHOD(FeatureView::release) {
+  FeatureView *view = Nan::ObjectWrap::Unwrap<FeatureView>(info.This());
+  view->dispose();
+}
+
+/**
+ * @readOnly
+ * @attribute fid
+ * @type {number}
+ */
+NAN_GETTER(FeatureView::fidGetter) {
+  NODE_UNWRAP_VIEW(info.This(), view);
+  info.GetReturnValue().Set(Nan::New<Number>(view->this_->GetFID()));
+}
+
+/**
+ * `false` once the iterator has advanced.
+ *
+ * @readOnly
+ * @attribute valid
+ * @type {boolean}
+ */
+NAN_GETTER(FeatureView::validGetter) {
+  FeatureView *view = Nan::ObjectWrap::Unwrap<FeatureView>(info.This());
+  info.GetReturnValue().Set(Nan::New<Boolean>(view->isAlive()));
+}
+
+} // namespace node_gdal
@@ -0,0 +1,52 @@
+#ifndef __NODE_OGR_FEATURE_VIEW_H__
+#define __NODE_OGR_FEATURE_VIEW_H__
+
+// node
+#include <node.h>
+#include <node_object_wrap.h>
+
+// nan
+#include "nan-wrapper.h"
+
+// ogr
+#include <ogrsf_frmts.h>
+
+using namespace v8;
+using namespace node;
+
+namespace node_gdal {
+
+class FeatureView : public Nan::ObjectWrap {
+    public:
+  static Nan::Persistent<FunctionTemplate> constructor;
+  static void Initialize(Local<Object> target);
+  static NAN_METHOD(New);
+  // Takes ownership of the feature
+  static Local<Value> New(OGRFeature *feature);
+  static NAN_METHOD(toString);
+  static NAN_METHOD(get);
+  static NAN_METHOD(getGeometry);
+  static NAN_METHOD(toObject);
+  static NAN_METHOD(toFeature);
+  static NAN_METHOD(release);
+
+  static NAN_GETTER(fidGetter);
+  static NAN_GETTER(validGetter);
+
+  FeatureView();
+  FeatureView(OGRFeature *feature);
+  inline OGRFeature *get() {
+    return this_;
+  }
+  inline bool isAlive() {
+    return this_;
+  }
+  void dispose();
+
+    private:
+  ~FeatureView();
+  OGRFeature *this_;
+};
+
+} // namespace node_gdal
+#endif
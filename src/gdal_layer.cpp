@@ -9,6 +9,7 @@
 #include "gdal_field_defn.hpp"
 #include "geometry/gdal_geometry.hpp"
 #include "gdal_spatial_reference.hpp"
+#include "utils/layer_columns.hpp"
 
 #include <sstream>
 #include <stdlib.h>
@@ -31,6 +32,7 @@ void Layer::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "getSpatialFilter", getSpatialFilter);
   Nan::SetPrototypeMethod(lcons, "testCapability", testCapability);
   Nan__SetPrototypeAsyncableMethod(lcons, "flush", syncToDisk);
+  Nan__SetPrototypeAsyncableMethod(lcons, "readColumns", readColumns);
 
   ATTR_DONT_ENUM(lcons, "ds", dsGetter, READ_ONLY_SETTER);
   ATTR_DONT_ENUM(lcons, "_uid", uidGetter, READ_ONLY_SETTER);
@@ -178,6 +180,123 @@ NAN_METHOD(Layer::toString) {
  */
 NODE_WRAPPED_ASYNC_METHOD_WITH_OGRERR_RESULT_LOCKED(Layer, syncToDisk, SyncToDisk);
 
+/**
+ * Reads all the features of the layer, respecting the attribute and the spatial filters,
+ * in a columnar format.
+ *
+ * Each field is returned as a single `TypedArray`:
+ * * `integer` fields as `Int32Array`
+ * * `integer64` fields as `BigInt64Array`
+ * * `real` fields as `Float64Array`
+ * * `date` and `dateTime` fields as `Float64Array` of milliseconds since the epoch
+ * * `time` fields as `Float64Array` of milliseconds since midnight
+ * * `string` fields as an `Uint8Array` of concatenated UTF-8 data and an `Int32Array`
+ * of `count + 1` offsets, the value of the row `i` is `data.subarray(offsets[i], offsets[i + 1])`
+ * * `binary` fields in the same format as the `string` fields
+ *
+ * Null values are signaled by a bit set to 0 in the `validity` bitmap (least significant bit first),
+ * `validity` is `null` when a column does not contain any null values. This is the format used by Apache Arrow.
+ *
+ * The geometries can be returned as ISO WKB using the same format as the `binary` fields,
+ * or for point layers, as `x` and `y` `Float64Array`s.
+ *
+ * List fields are skipped unless explicitly requested, in which case an error is thrown.
+ *
+ * With GDAL 3.6 and later this method uses the Arrow C stream interface of the driver.
+ *
+ * @example
+ * ```
+ * const cols = layer.readColumns({ fields: [ 'name', 'population' ], geometry: 'xy' });
+ * const name = (i) => Buffer.from(cols.fields.name.data.buffer, cols.fields.name.data.byteOffset)
+ *     .toString('utf8', cols.fields.name.offsets[i], cols.fields.name.offsets[i + 1]);
+ * for (let i = 0; i < cols.count; i++)
+ *     console.log(name(i), cols.fields.population.data[i], cols.geometry.x[i], cols.geometry.y[i]);
+ * ```
+ *
+ * @throws Error
+ * @method readColumns
+ * @param {ReadColumnsOptions} [options]
+ * @param {string[]} [options.fields] Fields to read, all the fields by default
+ * @param {string} [options.geometry='wkb'] Geometry format, `wkb`, `xy` or `none`
+ * @param {number} [options.batchSize=65536] Number of features per Arrow batch
+ * @return {LayerColumns}
+ */
+
+/**
+ * Reads all the features of the layer, respecting the attribute and the spatial filters,
+ * in a columnar format.
+ * {{{async}}}
+ *
+ * @throws Error
+ * @method readColumnsAsync
+ * @param {ReadColumnsOptions} [options]
+ * @param {string[]} [options.fields] Fields to read, all the fields by default
+ * @param {string} [options.geometry='wkb'] Geometry format, `wkb`, `xy` or `none`
+ * @param {number} [options.batchSize=65536] Number of features per Arrow batch
+ * @param {callback<LayerColumns>} [callback=undefined] {{{cb}}}
+ * @return {Promise<LayerColumns>}
+ */
+GDAL_ASYNCABLE_DEFINE(Layer::readColumns) {
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(info.This());
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object has already been destroyed");
+    return;
+  }
+
+  Local<Object> options;
+  Local<Array> fieldsArray;
+  std::string geometry = "wkb";
+  int batchSize = 65536;
+
+  NODE_ARG_OBJECT_OPT(0, "options", options);
+  if (!options.IsEmpty()) {
+    NODE_ARRAY_FROM_OBJ_OPT(options, "fields", fieldsArray);
+    NODE_STR_FROM_OBJ_OPT(options, "geometry", geometry);
+    NODE_INT_FROM_OBJ_OPT(options, "batchSize", batchSize);
+  }
+
+  std::vector<std::string> fields;
+  bool allFields = fieldsArray.IsEmpty();
+  if (!allFields) {
+    for (unsigned i = 0; i < fieldsArray->Length(); i++) {
+      Local<Value> name = Nan::Get(fieldsArray, i).ToLocalChecked();
+      if (!name->IsString()) {
+        Nan::ThrowTypeError("fields must be an array of strings");
+        return;
+      }
+      fields.push_back(*Nan::Utf8String(name));
+    }
+  }
+
+  LayerColumns::GeometryMode mode;
+  if (geometry == "wkb")
+    mode = LayerColumns::WKB;
+  else if (geometry == "xy")
+    mode = LayerColumns::XY;
+  else if (geometry == "none")
+    mode = LayerColumns::NONE;
+  else {
+    Nan::ThrowError("geometry must be one of wkb, xy or none");
+    return;
+  }
+  if (batchSize <= 0) {
+    Nan::ThrowRangeError("batchSize must be a positive integer");
+    return;
+  }
+
+  OGRLayer *gdal_layer = layer->get();
+  GDALAsyncableJob<std::shared_ptr<LayerColumns>> job(layer->parent_uid);
+  job.persist(layer->handle());
+  job.main = [gdal_layer, fields, allFields, mode, batchSize](const GDALExecutionProgress &) {
+    std::shared_ptr<LayerColumns> columns = std::make_shared<LayerColumns>(mode);
+    CPLErrorReset();
+    columns->read(gdal_layer, fields, allFields, batchSize);
+    return columns;
+  };
+  job.rval = [](std::shared_ptr<LayerColumns> columns, const GetFromPersistentFunc &) { return columns->ToObject(); };
+  job.run(info, async, 1);
+}
+
 /**
  * Determines if the dataset supports the indicated operation.
  *
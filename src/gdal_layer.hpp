@@ -32,6 +32,7 @@ class Layer : public Nan::ObjectWrap {
   static NAN_METHOD(getSpatialFilter);
   static NAN_METHOD(testCapability);
   GDAL_ASYNCABLE_DECLARE(syncToDisk);
+  GDAL_ASYNCABLE_DECLARE(readColumns);
 
   static NAN_SETTER(dsSetter);
   static NAN_GETTER(dsGetter);
@@ -212,6 +212,9 @@ findHighest(int dimensions, std::shared_ptr<size_t> span, std::shared_ptr<GPtrDi
  * @param {number[]} [options.stride] An array of strides for the output array, mandatory if the array is specified
  * @param {string} [options.data_type] See {{#crossLink "Constants (GDT)"}}GDT constants{{/crossLink}}.
  * @param {TypedArray} [options.data] The TypedArray (https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses) to put the data in. A new array is created if not given.
+ * @param {boolean} [options.shared=false] Allocate the new array in a `SharedArrayBuffer` that can be passed to worker threads without copying
+ * @param {boolean} [options.external=false] Allocate the new array in external memory with the requested alignment
+ * @param {number} [options.alignment=64] Alignment in bytes of the external memory, must be a power of 2
  * @return {TypedArray}
  */
 
@@ -233,6 +236,9 @@ findHighest(int dimensions, std::shared_ptr<size_t> span, std::shared_ptr<GPtrDi
  * @param {number[]} [options.stride] An array of strides for the output array, mandatory if the array is specified
  * @param {string} [options.data_type] See {{#crossLink "Constants (GDT)"}}GDT constants{{/crossLink}}.
  * @param {TypedArray} [options.data] The TypedArray (https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses) to put the data in. A new array is created if not given.
+ * @param {boolean} [options.shared=false] Allocate the new array in a `SharedArrayBuffer` that can be passed to worker threads without copying
+ * @param {boolean} [options.external=false] Allocate the new array in external memory with the requested alignment
+ * @param {number} [options.alignment=64] Alignment in bytes of the external memory, must be a power of 2
  * @param {ProgressCb} [options.progress_cb] {{{progress_cb}}}
  * @param {callback<TypedArray>} [callback=undefined] {{{cb}}}
  * @return {Promise<TypedArray>} A TypedArray (https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses) of values.
@@ -254,6 +260,19 @@ GDAL_ASYNCABLE_DEFINE(MDArray::read) {
   NODE_STR_FROM_OBJ_OPT(options, "data_type", type_name);
   NODE_INT64_FROM_OBJ_OPT(options, "_offset", offset);
   if (!type_name.empty()) { type = GDALGetDataTypeByName(type_name.c_str()); }
+  bool shared = false, external = false;
+  int alignment = 64;
+  NODE_BOOL_FROM_OBJ_OPT(options, "shared", shared);
+  NODE_BOOL_FROM_OBJ_OPT(options, "external", external);
+  NODE_INT_FROM_OBJ_OPT(options, "alignment", alignment);
+  if (shared && external) {
+    Nan::ThrowError("Array cannot be both shared and external");
+    return;
+  }
+  if (!node_gdal::TypedArray::ValidateAlignment(alignment)) {
+    Nan::ThrowRangeError("Alignment must be a power of 2 and a multiple of the pointer size");
+    return;
+  }
 
   std::shared_ptr<GUInt64> gdal_origin;
   std::shared_ptr<size_t> gdal_span;
@@ -297,7 +316,10 @@ GDAL_ASYNCABLE_DEFINE(MDArray::read) {
       }
       type = exType.GetNumericDataType();
     }
-    data = node_gdal::TypedArray::New(type, length);
+    if (external)
+      data = node_gdal::TypedArray::NewExternal(type, length, alignment);
+    else
+      data = node_gdal::TypedArray::New(type, length, shared);
     if (data.IsEmpty() || !data->IsObject()) {
       Nan::ThrowError("Failed to allocate array");
       return; // TypedArray::New threw an error
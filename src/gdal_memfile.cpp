@@ -1,4 +1,9 @@
 #include "gdal_memfile.hpp"
+#include "gdal_spatial_reference.hpp"
+#include "utils/string_list.hpp"
+#include "utils/typed_array.hpp"
+
+#include <atomic>
 
 namespace node_gdal {
 
@@ -38,6 +43,9 @@ void Memfile::Initialize(Local<Object> target) {
   Nan::SetMethod(vsimem, "set", Memfile::vsimemSet);
   Nan::SetMethod(vsimem, "release", Memfile::vsimemRelease);
   Nan::SetMethod(vsimem, "copy", Memfile::vsimemCopy);
+
+  Nan__SetAsyncableMethod(target, "encode", Memfile::encode);
+  Nan__SetAsyncableMethod(target, "decode", Memfile::decode);
 }
 
 // Anonymous buffers are handled by the GC
@@ -218,23 +226,418 @@ NAN_METHOD(Memfile::vsimemRelease) {
   } else {
     // the file has been created by GDAL and the buffer is owned by GDAL
     // -> a new Buffer is constructed and GDAL has to relinquish control
-    // The GC will call the lambda at some point to free the backing storage
     VSIGetMemFileBuffer(filename.c_str(), &len, true);
-    // Alas we can't take the address of a capturing lambda
-    // so we fall back to doing this like it was back in the day
-    int *hint = new int{static_cast<int>(len)};
-    info.GetReturnValue().Set(Nan::NewBuffer(
-                                static_cast<char *>(data),
-                                static_cast<size_t>(len),
-                                [](char *data, void *hint) {
-                                  int *len = reinterpret_cast<int *>(hint);
-                                  Nan::AdjustExternalMemory(-(*len));
-                                  delete len;
-                                  CPLFree(data);
-                                },
-                                hint)
-                                .ToLocalChecked());
+    info.GetReturnValue().Set(Memfile::NewBuffer(static_cast<GByte *>(data), static_cast<size_t>(len)));
+  }
+}
+
+// Wraps a buffer allocated by GDAL in a Buffer without copying it
+Local<Object> Memfile::NewBuffer(GByte *data, size_t len) {
+  return TypedArray::NewExternalBuffer(data, len, VSIFree);
+}
+
+// Encodes a dataset to a temporary /vsimem/ file using a driver that supports CreateCopy
+// and takes the ownership of the resulting buffer, no JS objects are involved
+// so it can be called from a worker thread; returns nullptr leaving the CPLError set on failure
+GByte *Memfile::encodeDataset(GDALDataset *ds, GDALDriver *driver, char **options, vsi_l_offset *len) {
+  char _filename[48];
+  // The pointer makes for a perfect unique filename as long as the dataset is locked
+  snprintf(_filename, sizeof(_filename), "/vsimem/_encode_%p", ds);
+  std::string filename = _filename;
+  const char *ext = driver->GetMetadataItem(GDAL_DMD_EXTENSION);
+  if (ext != nullptr && *ext) filename += std::string(".") + ext;
+
+  GDALDataset *encoded = driver->CreateCopy(filename.c_str(), ds, FALSE, options, nullptr, nullptr);
+  if (encoded == nullptr) {
+    VSIUnlink(filename.c_str());
+    return nullptr;
+  }
+  GDALClose(encoded);
+
+  GByte *data = VSIGetMemFileBuffer(filename.c_str(), len, true);
+  // Some drivers produce a PAM sidecar file that is never needed
+  VSIUnlink((filename + ".aux.xml").c_str());
+  if (data == nullptr) CPLError(CE_Failure, CPLE_FileIO, "Failed retrieving the encoded data");
+  return data;
+}
+
+// Returns the pixel, line and band offsets of a pixel-interleaved or a band-sequential buffer
+static void interleaveOffsets(
+  bool pixelInterleaved,
+  int width,
+  int height,
+  int bands,
+  int typeSize,
+  GSpacing *pixel,
+  GSpacing *line,
+  GSpacing *band) {
+  if (pixelInterleaved) {
+    *pixel = static_cast<GSpacing>(typeSize) * bands;
+    *line = *pixel * width;
+    *band = typeSize;
+  } else {
+    *pixel = typeSize;
+    *line = *pixel * width;
+    *band = *line * height;
+  }
+}
+
+/**
+ * Encodes raw pixel data to an image file format in memory.
+ *
+ * The data is used in place through a `MEM` dataset and the encoded file
+ * is returned as a `Buffer` without going through a named `/vsimem/` file.
+ *
+ * @throws Error
+ * @method encode
+ * @static
+ * @for gdal
+ * @param {TypedArray} data Pixel data, its length must be `width * height * bands`
+ * @param {EncodeOptions} options
+ * @param {number} options.width
+ * @param {number} options.height
+ * @param {number} [options.bands=1]
+ * @param {string} [options.driver=PNG] Any driver that supports `CreateCopy`
+ * @param {string} [options.interleave=pixel] `pixel` for pixel-interleaved data (`RGBRGB...`), `band` for band-sequential data (`RR...GG...BB...`)
+ * @param {string[]|object} [options.options] Driver creation options
+ * @param {number[]} [options.geoTransform]
+ * @param {gdal.SpatialReference} [options.srs]
+ * @return {Buffer}
+ */
+
+/**
+ * Encodes raw pixel data to an image file format in memory.
+ * {{{async}}}
+ *
+ * The data is used in place through a `MEM` dataset and the encoded file
+ * is returned as a `Buffer` without going through a named `/vsimem/` file.
+ *
+ * @throws Error
+ * @method encodeAsync
+ * @static
+ * @for gdal
+ * @param {TypedArray} data Pixel data, its length must be `width * height * bands`
+ * @param {EncodeOptions} options
+ * @param {number} options.width
+ * @param {number} options.height
+ * @param {number} [options.bands=1]
+ * @param {string} [options.driver=PNG] Any driver that supports `CreateCopy`
+ * @param {string} [options.interleave=pixel] `pixel` for pixel-interleaved data (`RGBRGB...`), `band` for band-sequential data (`RR...GG...BB...`)
+ * @param {string[]|object} [options.options] Driver creation options
+ * @param {number[]} [options.geoTransform]
+ * @param {gdal.SpatialReference} [options.srs]
+ * @param {callback<Buffer>} [callback=undefined] {{{cb}}}
+ * @return {Promise<Buffer>}
+ */
+GDAL_ASYNCABLE_DEFINE(Memfile::encode) {
+  Local<Object> array;
+  Local<Object> options;
+  Local<Array> geoTransform;
+  SpatialReference *srs = nullptr;
+  int width, height, bands = 1;
+  std::string driverName = "PNG";
+  std::string interleave = "pixel";
+
+  NODE_ARG_OBJECT(0, "data", array);
+  NODE_ARG_OBJECT(1, "options", options);
+  NODE_INT_FROM_OBJ(options, "width", width);
+  NODE_INT_FROM_OBJ(options, "height", height);
+  NODE_INT_FROM_OBJ_OPT(options, "bands", bands);
+  NODE_STR_FROM_OBJ_OPT(options, "driver", driverName);
+  NODE_ARRAY_FROM_OBJ_OPT(options, "geoTransform", geoTransform);
+  NODE_WRAPPED_FROM_OBJ_OPT(options, "srs", SpatialReference, srs);
+  NODE_STR_FROM_OBJ_OPT(options, "interleave", interleave);
+
+  if (interleave != "pixel" && interleave != "band") {
+    Nan::ThrowError("interleave must be either pixel or band");
+    return;
+  }
+  bool pixelInterleaved = interleave == "pixel";
+
+  if (width <= 0 || height <= 0 || bands <= 0) {
+    Nan::ThrowRangeError("width, height and bands must be positive numbers");
+    return;
+  }
+
+  GDALDataType type = TypedArray::Identify(array);
+  if (type == GDT_Unknown) {
+    Nan::ThrowTypeError("Unable to identify GDAL datatype of passed array object");
+    return;
+  }
+  void *data = TypedArray::Validate(array, type, width * height * bands);
+  if (data == nullptr) return;
+
+  GDALDriver *driver = GetGDALDriverManager()->GetDriverByName(driverName.c_str());
+  if (driver == nullptr) {
+    Nan::ThrowError((driverName + " driver is not available").c_str());
+    return;
+  }
+
+  std::vector<double> gt;
+  if (!geoTransform.IsEmpty()) {
+    if (geoTransform->Length() != 6) {
+      Nan::ThrowError("geoTransform must be an array of 6 numbers");
+      return;
+    }
+    for (unsigned i = 0; i < 6; i++)
+      gt.push_back(Nan::To<double>(Nan::Get(geoTransform, i).ToLocalChecked()).FromMaybe(0));
+  }
+  std::string wkt;
+  if (srs != nullptr) {
+    char *raw;
+    if (srs->get()->exportToWkt(&raw)) {
+      Nan::ThrowError("Error converting srs to WKT");
+      return;
+    }
+    wkt = raw;
+    CPLFree(raw);
+  }
+
+  auto creationOptions = std::make_shared<StringList>();
+  if (Nan::HasOwnProperty(options, Nan::New("options").ToLocalChecked()).FromMaybe(false) &&
+      creationOptions->parse(Nan::Get(options, Nan::New("options").ToLocalChecked()).ToLocalChecked())) {
+    return; // error parsing string list
+  }
+
+  struct encodeResult {
+    GByte *data;
+    vsi_l_offset len;
+  };
+
+  GDALAsyncableJob<encodeResult> job(0);
+  job.persist(array);
+  job.main = [data, type, width, height, bands, pixelInterleaved, driver, gt, wkt, creationOptions](
+               const GDALExecutionProgress &) {
+    GDALDriver *mem = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (mem == nullptr) throw "MEM driver not available";
+
+    CPLErrorReset();
+    GDALDataset *ds = mem->Create("", width, height, 0, type, nullptr);
+    if (ds == nullptr) throw CPLGetLastErrorMsg();
+
+    // The bands of the MEM dataset point directly to the TypedArray
+    GSpacing pixelOffset, lineOffset, bandOffset;
+    interleaveOffsets(
+      pixelInterleaved,
+      width,
+      height,
+      bands,
+      GDALGetDataTypeSize(type) / 8,
+      &pixelOffset,
+      &lineOffset,
+      &bandOffset);
+    for (int b = 0; b < bands; b++) {
+      char ptr[64];
+      int ptrLen = CPLPrintPointer(ptr, static_cast<GByte *>(data) + b * bandOffset, sizeof(ptr));
+      ptr[ptrLen] = 0;
+      char **bandOptions = CSLSetNameValue(nullptr, "DATAPOINTER", ptr);
+      bandOptions = CSLSetNameValue(bandOptions, "PIXELOFFSET", CPLSPrintf(CPL_FRMT_GIB, pixelOffset));
+      bandOptions = CSLSetNameValue(bandOptions, "LINEOFFSET", CPLSPrintf(CPL_FRMT_GIB, lineOffset));
+      CPLErr err = ds->AddBand(type, bandOptions);
+      CSLDestroy(bandOptions);
+      if (err != CE_None) {
+        GDALClose(ds);
+        throw CPLGetLastErrorMsg();
+      }
+    }
+    if (!gt.empty()) ds->SetGeoTransform(const_cast<double *>(gt.data()));
+    if (!wkt.empty()) ds->SetProjection(wkt.c_str());
+
+    encodeResult r;
+    r.data = Memfile::encodeDataset(ds, driver, creationOptions->get(), &r.len);
+    GDALClose(ds);
+    if (r.data == nullptr) throw CPLGetLastErrorMsg();
+    return r;
+  };
+  job.rval = [](encodeResult r, const GetFromPersistentFunc &) {
+    return Memfile::NewBuffer(r.data, static_cast<size_t>(r.len));
+  };
+  job.run(info, async, 2);
+}
+
+/**
+ * Decodes an image file held in a `Buffer` to raw pixel data.
+ *
+ * The `Buffer` is read in place and no named `/vsimem/` file is created.
+ * All bands are read in a single `TypedArray` of the data type of the first band,
+ * which must be `Byte`, `Int16`, `UInt16`, `Int32`, `UInt32`, `Float32` or `Float64`.
+ *
+ * @throws Error
+ * @method decode
+ * @static
+ * @for gdal
+ * @param {Buffer} buffer
+ * @param {DecodeOptions} [options]
+ * @param {string} [options.interleave=pixel] `pixel` for pixel-interleaved data (`RGBRGB...`), `band` for band-sequential data (`RR...GG...BB...`)
+ * @return {DecodedData}
+ */
+
+/**
+ * Decodes an image file held in a `Buffer` to raw pixel data.
+ * {{{async}}}
+ *
+ * The `Buffer` is read in place and no named `/vsimem/` file is created.
+ * All bands are read in a single `TypedArray` of the data type of the first band,
+ * which must be `Byte`, `Int16`, `UInt16`, `Int32`, `UInt32`, `Float32` or `Float64`.
+ *
+ * @throws Error
+ * @method decodeAsync
+ * @static
+ * @for gdal
+ * @param {Buffer} buffer
+ * @param {DecodeOptions} [options]
+ * @param {string} [options.interleave=pixel] `pixel` for pixel-interleaved data (`RGBRGB...`), `band` for band-sequential data (`RR...GG...BB...`)
+ * @param {callback<DecodedData>} [callback=undefined] {{{cb}}}
+ * @return {Promise<DecodedData>}
+ */
+GDAL_ASYNCABLE_DEFINE(Memfile::decode) {
+  Local<Object> buffer;
+  Local<Object> options;
+  std::string interleave = "pixel";
+
+  NODE_ARG_OBJECT(0, "buffer", buffer);
+  NODE_ARG_OBJECT_OPT(1, "options", options);
+  if (!options.IsEmpty()) NODE_STR_FROM_OBJ_OPT(options, "interleave", interleave);
+
+  if (!Buffer::HasInstance(buffer)) {
+    Nan::ThrowTypeError("buffer must be a Buffer");
+    return;
+  }
+  if (interleave != "pixel" && interleave != "band") {
+    Nan::ThrowError("interleave must be either pixel or band");
+    return;
   }
+  bool pixelInterleaved = interleave == "pixel";
+
+  GByte *bufferData = reinterpret_cast<GByte *>(Buffer::Data(buffer));
+  size_t bufferLen = Buffer::Length(buffer);
+
+  struct decodeResult {
+    void *data;
+    GDALDataType type;
+    int width, height, bands;
+    bool hasGeoTransform;
+    double geoTransform[6];
+    std::string wkt;
+    std::string driver;
+  };
+
+  GDALAsyncableJob<decodeResult> job(0);
+  job.persist(buffer);
+  job.main = [bufferData, bufferLen, pixelInterleaved](const GDALExecutionProgress &) {
+    static std::atomic<unsigned long> serial(0);
+    // The Buffer is protected from the GC for the duration of the job
+    std::string filename = "/vsimem/_decode_" + std::to_string(serial++);
+    VSILFILE *vsi = VSIFileFromMemBuffer(filename.c_str(), bufferData, bufferLen, FALSE);
+    if (vsi == nullptr) throw "Failed creating in-memory file";
+    VSIFCloseL(vsi);
+
+    CPLErrorReset();
+    GDALDataset *ds = static_cast<GDALDataset *>(
+      GDALOpenEx(filename.c_str(), GDAL_OF_RASTER | GDAL_OF_READONLY, nullptr, nullptr, nullptr));
+    if (ds == nullptr) {
+      VSIUnlink(filename.c_str());
+      throw CPLGetLastErrorMsg();
+    }
+
+    decodeResult r;
+    r.width = ds->GetRasterXSize();
+    r.height = ds->GetRasterYSize();
+    r.bands = ds->GetRasterCount();
+    r.type = r.bands > 0 ? ds->GetRasterBand(1)->GetRasterDataType() : GDT_Unknown;
+    r.hasGeoTransform = ds->GetGeoTransform(r.geoTransform) == CE_None;
+    const char *wkt = ds->GetProjectionRef();
+    r.wkt = wkt != nullptr ? wkt : "";
+    r.driver = ds->GetDriver() != nullptr ? ds->GetDriver()->GetDescription() : "";
+    r.data = nullptr;
+
+    // Closing the dataset can overwrite the last error message
+    bool failed = true;
+    std::string error;
+    // Int8, Int64, UInt64 and the complex types are rejected before reading anything
+    if (r.type == GDT_Unknown) {
+      error = "The raster has no bands";
+    } else if (!TypedArray::IsSupported(r.type)) {
+      CPLError(
+        CE_Failure,
+        CPLE_AppDefined,
+        "Unsupported raster data type %s, only Byte, Int16, UInt16, Int32, UInt32, Float32 and Float64 can be decoded",
+        GDALGetDataTypeName(r.type));
+      error = CPLGetLastErrorMsg();
+    } else {
+      const int typeSize = GDALGetDataTypeSize(r.type) / 8;
+      r.data = VSIMalloc3(static_cast<size_t>(r.width) * r.height, r.bands, typeSize);
+      if (r.data == nullptr) {
+        error = "Failed allocating memory";
+      } else {
+        GSpacing pixelOffset, lineOffset, bandOffset;
+        interleaveOffsets(
+          pixelInterleaved, r.width, r.height, r.bands, typeSize, &pixelOffset, &lineOffset, &bandOffset);
+        CPLErr err = ds->RasterIO(
+          GF_Read,
+          0,
+          0,
+          r.width,
+          r.height,
+          r.data,
+          r.width,
+          r.height,
+          r.type,
+          r.bands,
+          nullptr,
+          pixelOffset,
+          lineOffset,
+          bandOffset,
+          nullptr);
+        if (err != CE_None)
+          error = CPLGetLastErrorMsg();
+        else
+          failed = false;
+      }
+    }
+
+    GDALClose(ds);
+    VSIUnlink(filename.c_str());
+    if (failed) {
+      VSIFree(r.data);
+      static thread_local std::string message;
+      message = error;
+      throw message.c_str();
+    }
+    return r;
+  };
+  job.rval = [](decodeResult r, const GetFromPersistentFunc &) {
+    Nan::EscapableHandleScope scope;
+    Local<Object> result = Nan::New<Object>();
+
+    Nan::Set(
+      result,
+      Nan::New("data").ToLocalChecked(),
+      TypedArray::Adopt(r.type, r.data, static_cast<unsigned int>(r.width) * r.height * r.bands));
+    Nan::Set(result, Nan::New("width").ToLocalChecked(), Nan::New<Integer>(r.width));
+    Nan::Set(result, Nan::New("height").ToLocalChecked(), Nan::New<Integer>(r.height));
+    Nan::Set(result, Nan::New("bands").ToLocalChecked(), Nan::New<Integer>(r.bands));
+    Nan::Set(result, Nan::New("type").ToLocalChecked(), SafeString::New(GDALGetDataTypeName(r.type)));
+    Nan::Set(result, Nan::New("driver").ToLocalChecked(), SafeString::New(r.driver.c_str()));
+    if (r.hasGeoTransform) {
+      Local<Array> geoTransform = Nan::New<Array>(6);
+      for (int i = 0; i < 6; i++) Nan::Set(geoTransform, i, Nan::New<Number>(r.geoTransform[i]));
+      Nan::Set(result, Nan::New("geoTransform").ToLocalChecked(), geoTransform);
+    } else {
+      Nan::Set(result, Nan::New("geoTransform").ToLocalChecked(), Nan::Null());
+    }
+    if (!r.wkt.empty()) {
+      Nan::Set(
+        result,
+        Nan::New("srs").ToLocalChecked(),
+        SpatialReference::New(new OGRSpatialReference(r.wkt.c_str()), true));
+    } else {
+      Nan::Set(result, Nan::New("srs").ToLocalChecked(), Nan::Null());
+    }
+
+    return scope.Escape(result);
+  };
+  job.run(info, async, 2);
 }
 
 } // namespace node_gdal
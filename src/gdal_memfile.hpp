@@ -13,6 +13,7 @@
 #include <gdal_priv.h>
 
 #include "gdal_common.hpp"
+#include "async.hpp"
 
 using namespace v8;
 using namespace node;
@@ -35,12 +36,17 @@ class Memfile {
   static Memfile *get(Local<Object>, const std::string &filename);
   static bool copy(Local<Object>, const std::string &filename);
   static std::map<void *, Memfile *> memfile_collection;
+  static Local<Object> NewBuffer(GByte *data, size_t len);
+  static GByte *encodeDataset(GDALDataset *ds, GDALDriver *driver, char **options, vsi_l_offset *len);
 
   static void Initialize(Local<Object> target);
   static NAN_METHOD(vsimemSet);
   static NAN_METHOD(vsimemAnonymous);
   static NAN_METHOD(vsimemRelease);
   static NAN_METHOD(vsimemCopy);
+
+  GDAL_ASYNCABLE_DECLARE(encode);
+  GDAL_ASYNCABLE_DECLARE(decode);
 };
 } // namespace node_gdal
 #endif
@@ -0,0 +1,265 @@
+#include "gdal_prepared_geometry.hpp"
+#include "gdal_common.hpp"
+#include "geometry/gdal_geometry.hpp"
+#include "utils/layer_columns.hpp"
+#include "utils/typed_array.hpp"
+
+#include <limits>
+
+namespace node_gdal {
+
+Nan::Persistent<FunctionTemplate> PreparedGeometry::constructor;
+
+void PreparedGeometry::Initialize(Local<Object> target) {
+  Nan::HandleScope scope;
+
+  Local<FunctionTemplate> lcons = Nan::New<FunctionTemplate>(PreparedGeometry::New);
+  lcons->InstanceTemplate()->SetInternalFieldCount(1);
+  lcons->SetClassName(Nan::New("PreparedGeometry").ToLocalChecked());
+
+  Nan::SetPrototypeMethod(lcons, "toString", toString);
+  Nan::SetPrototypeMethod(lcons, "intersects", intersects);
+  Nan::SetPrototypeMethod(lcons, "contains", contains);
+  Nan__SetPrototypeAsyncableMethod(lcons, "intersectsMany", intersectsMany);
+  Nan__SetPrototypeAsyncableMethod(lcons, "containsMany", containsMany);
+
+  Nan::Set(target, Nan::New("PreparedGeometry").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
+
+  constructor.Reset(lcons);
+}
+
+PreparedGeometry::PreparedGeometry(std::shared_ptr<SharedPreparedGeometry> prepared)
+  : Nan::ObjectWrap(), this_(prepared) {
+  LOG("Created PreparedGeometry [%p]", prepared.get());
+}
+
+PreparedGeometry::PreparedGeometry() : Nan::ObjectWrap(), this_(nullptr) {
+}
+
+PreparedGeometry::~PreparedGeometry() {
+  LOG("Disposing PreparedGeometry [%p]", this_.get());
+}
+
+/**
+ * A geometry prepared for testing it against many other geometries.
+ *
+ * The geometry is copied and its GEOS prepared version is built on first use
+ * and reused by all the following tests, this is much faster than calling
+ * `Geometry.intersects()` or `Geometry.contains()` in a loop.
+ *
+ * The batch methods return an `Uint8Array` with 1 for every geometry that
+ * matches and 0 for those that do not, they accept an array of geometries or
+ * a `Float64Array` of interleaved XY coordinates and they can split the work
+ * across several threads. The prepared geometry is not tied to its source and
+ * can be used by any number of concurrent asynchronous operations.
+ *
+ * @example
+ * ```
+ * const prepared = new gdal.PreparedGeometry(polygon);
+ * const inside = await prepared.containsManyAsync(new Float64Array([ x0, y0, x1, y1 ]), { threads: 4 });
+ * ```
+ *
+ * @constructor
+ * @class gdal.PreparedGeometry
+ * @param {gdal.Geometry} geometry
+ */
+NAN_METHOD(PreparedGeometry::New) {
+  if (!info.IsConstructCall()) {
+    Nan::ThrowError("Cannot call constructor as function, you need to use 'new' keyword");
+    return;
+  }
+
+  if (info[0]->IsExternal()) {
+    Local<External> ext = info[0].As<External>();
+    void *ptr = ext->Value();
+    PreparedGeometry *f = static_cast<PreparedGeometry *>(ptr);
+    f->Wrap(info.This());
+    info.GetReturnValue().Set(info.This());
+    return;
+  }
+
+  Geometry *geom;
+  NODE_ARG_WRAPPED(0, "geometry", Geometry, geom);
+  if (geom->get()->IsEmpty()) {
+    Nan::ThrowError("Cannot prepare an empty geometry");
+    return;
+  }
+
+  PreparedGeometry *f = new PreparedGeometry(std::make_shared<SharedPreparedGeometry>(geom->get()->clone()));
+  f->Wrap(info.This());
+  info.GetReturnValue().Set(info.This());
+}
+
+NAN_METHOD(PreparedGeometry::toString) {
+  info.GetReturnValue().Set(Nan::New("PreparedGeometry").ToLocalChecked());
+}
+
+void PreparedGeometry::test(
+  const Nan::FunctionCallbackInfo<v8::Value> &info, SharedPreparedGeometry::Predicate predicate) {
+  PreparedGeometry *prepared = Nan::ObjectWrap::Unwrap<PreparedGeometry>(info.This());
+  Geometry *geom;
+
+  NODE_ARG_WRAPPED(0, "geometry", Geometry, geom);
+
+  GByte r;
+  {
+    GeometryGuard guard({geom->get(), geom->asyncLock()});
+    prepared->get()->test(predicate, geom->get(), &r);
+  }
+  info.GetReturnValue().Set(Nan::New<Boolean>(r != 0));
+}
+
+/**
+ * Determines if the two geometries intersect.
+ *
+ * @method intersects
+ * @param {gdal.Geometry} geometry
+ * @return {boolean}
+ */
+NAN_METHOD(PreparedGeometry::intersects) {
+  test(info, SharedPreparedGeometry::INTERSECTS);
+}
+
+/**
+ * Determines if the prepared geometry contains the given geometry.
+ *
+ * @method contains
+ * @param {gdal.Geometry} geometry
+ * @return {boolean}
+ */
+NAN_METHOD(PreparedGeometry::contains) {
+  test(info, SharedPreparedGeometry::CONTAINS);
+}
+
+void PreparedGeometry::testMany(
+  const Nan::FunctionCallbackInfo<v8::Value> &info, bool async, SharedPreparedGeometry::Predicate predicate) {
+  PreparedGeometry *prepared = Nan::ObjectWrap::Unwrap<PreparedGeometry>(info.This());
+  Local<Object> options;
+  int threads = 1;
+
+  if (info.Length() < 1 || !(info[0]->IsArray() || info[0]->IsFloat64Array())) {
+    Nan::ThrowTypeError("geometries must be an array of Geometry objects or a Float64Array");
+    return;
+  }
+  NODE_ARG_OBJECT_OPT(1, "options", options);
+  if (!options.IsEmpty()) { NODE_INT_FROM_OBJ_OPT(options, "threads", threads); }
+  if (threads < 1) {
+    Nan::ThrowRangeError("threads must be a positive integer");
+    return;
+  }
+
+  std::vector<LockedGeometry> geometries;
+  std::vector<Local<Object>> handles;
+  const double *xy = nullptr;
+  size_t count;
+  if (info[0]->IsFloat64Array()) {
+    Nan::TypedArrayContents<double> contents(info[0]);
+    if (contents.length() % 2 != 0) {
+      Nan::ThrowRangeError("The Float64Array must contain XY pairs");
+      return;
+    }
+    xy = *contents;
+    count = contents.length() / 2;
+    handles.push_back(info[0].As<Object>());
+  } else {
+    if (!Geometry::FromArray(
+          info[0].As<Array>(),
+          "geometries must be an array of Geometry objects or a Float64Array",
+          geometries,
+          handles))
+      return;
+    count = geometries.size();
+  }
+  if (count > std::numeric_limits<unsigned int>::max()) {
+    Nan::ThrowRangeError("Too many geometries");
+    return;
+  }
+
+  std::shared_ptr<SharedPreparedGeometry> shared = prepared->get();
+  GDALAsyncableJob<std::shared_ptr<ColumnBuffer>> job(0);
+  // The handles keep the geometries or the coordinates alive even if
+  // the array is modified before the job runs
+  job.persist(handles);
+  job.main = [shared, predicate, geometries, xy, count, threads](const GDALExecutionProgress &) {
+    std::shared_ptr<ColumnBuffer> mask = std::make_shared<ColumnBuffer>();
+    GByte *out = mask->grow(count);
+    if (xy != nullptr)
+      shared->test(predicate, xy, count, out, threads);
+    else
+      shared->test(predicate, geometries, out, threads);
+    return mask;
+  };
+  job.rval = [](std::shared_ptr<ColumnBuffer> mask, const GetFromPersistentFunc &) {
+    size_t length = mask->size;
+    return TypedArray::Adopt(GDT_Byte, mask->release(), static_cast<unsigned int>(length));
+  };
+  job.run(info, async, 2);
+}
+
+/**
+ * Tests the intersection with every geometry of an array or with every point of
+ * a `Float64Array` of interleaved XY coordinates.
+ *
+ * `null` and empty geometries never intersect.
+ *
+ * @method intersectsMany
+ * @throws Error
+ * @param {gdal.Geometry[]|Float64Array} geometries
+ * @param {PreparedGeometryOptions} [options]
+ * @param {number} [options.threads=1] Number of threads
+ * @return {Uint8Array} 1 for every geometry that intersects, 0 otherwise
+ */
+
+/**
+ * Tests the intersection with every geometry of an array or with every point of
+ * a `Float64Array` of interleaved XY coordinates.
+ * {{{async}}}
+ *
+ * `null` and empty geometries never intersect.
+ *
+ * @method intersectsManyAsync
+ * @throws Error
+ * @param {gdal.Geometry[]|Float64Array} geometries
+ * @param {PreparedGeometryOptions} [options]
+ * @param {number} [options.threads=1] Number of threads
+ * @param {callback<Uint8Array>} [callback=undefined] {{{cb}}}
+ * @return {Promise<Uint8Array>} 1 for every geometry that intersects, 0 otherwise
+ */
+GDAL_ASYNCABLE_DEFINE(PreparedGeometry::intersectsMany) {
+  testMany(info, async, SharedPreparedGeometry::INTERSECTS);
+}
+
+/**
+ * Tests if the prepared geometry contains every geometry of an array or every
+ * point of a `Float64Array` of interleaved XY coordinates.
+ *
+ * `null` and empty geometries are never contained.
+ *
+ * @method containsMany
+ * @throws Error
+ * @param {gdal.Geometry[]|Float64Array} geometries
+ * @param {PreparedGeometryOptions} [options]
+ * @param {number} [options.threads=1] Number of threads
+ * @return {Uint8Array} 1 for every geometry that is contained, 0 otherwise
+ */
+
+/**
+ * Tests if the prepared geometry contains every geometry of an array or every
+ * point of a `Float64Array` of interleaved XY coordinates.
+ * {{{async}}}
+ *
+ * `null` and empty geometries are never contained.
+ *
+ * @method containsManyAsync
+ * @throws Error
+ * @param {gdal.Geometry[]|Float64Array} geometries
+ * @param {PreparedGeometryOptions} [options]
+ * @param {number} [options.threads=1] Number of threads
+ * @param {callback<Uint8Array>} [callback=undefined] {{{cb}}}
+ * @return {Promise<Uint8Array>} 1 for every geometry that is contained, 0 otherwise
+ */
+GDAL_ASYNCABLE_DEFINE(PreparedGeometry::containsMany) {
+  testMany(info, async, SharedPreparedGeometry::CONTAINS);
+}
+
+} // namespace node_gdal
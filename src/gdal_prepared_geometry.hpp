@@ -0,0 +1,51 @@
+#ifndef __NODE_GDAL_PREPARED_GEOMETRY_WRAP_H__
+#define __NODE_GDAL_PREPARED_GEOMETRY_WRAP_H__
+
+// node
+#include <node.h>
+#include <node_object_wrap.h>
+
+// nan
+#include "nan-wrapper.h"
+
+// ogr
+#include <ogrsf_frmts.h>
+
+#include <memory>
+
+#include "async.hpp"
+#include "utils/prepared_geometry.hpp"
+
+using namespace v8;
+using namespace node;
+
+namespace node_gdal {
+
+class PreparedGeometry : public Nan::ObjectWrap {
+    public:
+  static Nan::Persistent<FunctionTemplate> constructor;
+  static void Initialize(Local<Object> target);
+  static NAN_METHOD(New);
+  static NAN_METHOD(toString);
+  static NAN_METHOD(intersects);
+  static NAN_METHOD(contains);
+  GDAL_ASYNCABLE_DECLARE(intersectsMany);
+  GDAL_ASYNCABLE_DECLARE(containsMany);
+
+  PreparedGeometry();
+  PreparedGeometry(std::shared_ptr<SharedPreparedGeometry> prepared);
+  // The geometry is immutable and can be shared with worker threads
+  inline std::shared_ptr<SharedPreparedGeometry> get() {
+    return this_;
+  }
+
+    private:
+  ~PreparedGeometry();
+  static void test(const Nan::FunctionCallbackInfo<v8::Value> &info, SharedPreparedGeometry::Predicate predicate);
+  static void testMany(
+    const Nan::FunctionCallbackInfo<v8::Value> &info, bool async, SharedPreparedGeometry::Predicate predicate);
+  std::shared_ptr<SharedPreparedGeometry> this_;
+};
+
+} // namespace node_gdal
+#endif
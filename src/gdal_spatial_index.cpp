@@ -0,0 +1,385 @@
+#include "gdal_spatial_index.hpp"
+#include "gdal_common.hpp"
+#include "gdal_layer.hpp"
+#include "geometry/gdal_geometry.hpp"
+#include "utils/layer_columns.hpp"
+#include "utils/typed_array.hpp"
+
+#include <limits>
+
+namespace node_gdal {
+
+Nan::Persistent<FunctionTemplate> SpatialIndex::constructor;
+
+void SpatialIndex::Initialize(Local<Object> target) {
+  Nan::HandleScope scope;
+
+  Local<FunctionTemplate> lcons = Nan::New<FunctionTemplate>(SpatialIndex::New);
+  lcons->InstanceTemplate()->SetInternalFieldCount(1);
+  lcons->SetClassName(Nan::New("SpatialIndex").ToLocalChecked());
+
+  Nan__SetAsyncableMethod(lcons, "fromLayer", fromLayer);
+  Nan__SetAsyncableMethod(lcons, "fromGeometries", fromGeometries);
+
+  Nan::SetPrototypeMethod(lcons, "toString", toString);
+  Nan__SetPrototypeAsyncableMethod(lcons, "search", search);
+  Nan__SetPrototypeAsyncableMethod(lcons, "intersects", intersects);
+
+  ATTR(lcons, "count", countGetter, READ_ONLY_SETTER);
+  ATTR(lcons, "geometry", geometryGetter, READ_ONLY_SETTER);
+
+  Nan::Set(target, Nan::New("SpatialIndex").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
+
+  constructor.Reset(lcons);
+}
+
+SpatialIndex::SpatialIndex(std::shared_ptr<PackedRTree> tree) : Nan::ObjectWrap(), this_(tree) {
+  LOG("Created SpatialIndex [%p]", tree.get());
+}
+
+SpatialIndex::SpatialIndex() : Nan::ObjectWrap(), this_(nullptr) {
+}
+
+SpatialIndex::~SpatialIndex() {
+  LOG("Disposing SpatialIndex [%p]", this_.get());
+}
+
+/**
+ * A static in-memory spatial index (packed Hilbert R-tree).
+ *
+ * The index is built in a single operation from a layer or from an array
+ * of geometries and cannot be modified. It is not tied to its source and it
+ * can be queried from any number of concurrent asynchronous operations.
+ *
+ * The index can keep only the envelopes or the full geometries, in which case
+ * `intersects` performs an exact intersection test on the candidates.
+ *
+ * The results are returned as `Int32Array`s of FIDs (or of array indices
+ * when built from an array of geometries).
+ *
+ * @example
+ * ```
+ * const index = await gdal.SpatialIndex.fromLayerAsync(layer, { geometry: 'full' });
+ * const fids = await index.intersectsAsync(polygon);
+ * ```
+ *
+ * @class gdal.SpatialIndex
+ */
+NAN_METHOD(SpatialIndex::New) {
+  if (!info.IsConstructCall()) {
+    Nan::ThrowError("Cannot call constructor as function, you need to use 'new' keyword");
+    return;
+  }
+
+  if (info[0]->IsExternal()) {
+    Local<External> ext = info[0].As<External>();
+    void *ptr = ext->Value();
+    SpatialIndex *f = static_cast<SpatialIndex *>(ptr);
+    f->Wrap(info.This());
+    info.GetReturnValue().Set(info.This());
+    return;
+  }
+
+  Nan::ThrowError("Cannot create SpatialIndex directly, use SpatialIndex.fromLayer() or SpatialIndex.fromGeometries()");
+}
+
+Local<Value> SpatialIndex::New(std::shared_ptr<PackedRTree> tree) {
+  Nan::EscapableHandleScope scope;
+
+  SpatialIndex *wrapped = new SpatialIndex(tree);
+
+  Local<Value> ext = Nan::New<External>(wrapped);
+  Local<Object> obj =
+    Nan::NewInstance(Nan::GetFunction(Nan::New(SpatialIndex::constructor)).ToLocalChecked(), 1, &ext).ToLocalChecked();
+
+  return scope.Escape(obj);
+}
+
+NAN_METHOD(SpatialIndex::toString) {
+  info.GetReturnValue().Set(Nan::New("SpatialIndex").ToLocalChecked());
+}
+
+// Parses the { geometry: 'envelope'|'full' } option, throws on error
+static bool withGeometries(Local<Object> options) {
+  if (options.IsEmpty()) return false;
+  Local<Value> val = Nan::Get(options, Nan::New("geometry").ToLocalChecked()).ToLocalChecked();
+  if (val->IsUndefined() || val->IsNull()) return false;
+  std::string mode = *Nan::Utf8String(val);
+  if (mode == "envelope") return false;
+  if (mode == "full") return true;
+  throw "geometry must be one of envelope or full";
+}
+
+/**
+ * Builds a spatial index from the features of a layer, respecting the attribute and the spatial filters.
+ *
+ * The reading of the layer is reset and the features without geometries are skipped.
+ * The FIDs must fit in 32 bits.
+ *
+ * @static
+ * @method fromLayer
+ * @throws Error
+ * @param {gdal.Layer} layer
+ * @param {SpatialIndexOptions} [options]
+ * @param {string} [options.geometry='envelope'] Keep only the envelopes (`envelope`) or the full geometries (`full`)
+ * @return {gdal.SpatialIndex}
+ */
+
+/**
+ * Builds a spatial index from the features of a layer, respecting the attribute and the spatial filters.
+ * {{{async}}}
+ *
+ * The reading of the layer is reset and the features without geometries are skipped.
+ * The FIDs must fit in 32 bits.
+ *
+ * @static
+ * @method fromLayerAsync
+ * @throws Error
+ * @param {gdal.Layer} layer
+ * @param {SpatialIndexOptions} [options]
+ * @param {string} [options.geometry='envelope'] Keep only the envelopes (`envelope`) or the full geometries (`full`)
+ * @param {callback<gdal.SpatialIndex>} [callback=undefined] {{{cb}}}
+ * @return {Promise<gdal.SpatialIndex>}
+ */
+GDAL_ASYNCABLE_DEFINE(SpatialIndex::fromLayer) {
+  Layer *layer;
+  Local<Object> options;
+  bool full;
+
+  NODE_ARG_WRAPPED(0, "layer", Layer, layer);
+  NODE_ARG_OBJECT_OPT(1, "options", options);
+  try {
+    full = withGeometries(options);
+  } catch (const char *err) {
+    Nan::ThrowError(err);
+    return;
+  }
+
+  OGRLayer *gdal_layer = layer->get();
+  GDALAsyncableJob<std::shared_ptr<PackedRTree>> job(layer->parent_uid);
+  job.persist(layer->handle());
+  job.main = [gdal_layer, full](const GDALExecutionProgress &) {
+    std::shared_ptr<PackedRTree> tree = std::make_shared<PackedRTree>(full);
+    gdal_layer->ResetReading();
+    OGRFeature *feature;
+    while ((feature = gdal_layer->GetNextFeature()) != nullptr) {
+      GIntBig fid = feature->GetFID();
+      OGRGeometry *geom = feature->GetGeometryRef();
+      if (fid < std::numeric_limits<int32_t>::min() || fid > std::numeric_limits<int32_t>::max()) {
+        OGRFeature::DestroyFeature(feature);
+        throw "FID does not fit in 32 bits";
+      }
+      if (geom != nullptr && !geom->IsEmpty()) {
+        OGREnvelope envelope;
+        geom->getEnvelope(&envelope);
+        tree->add(static_cast<int32_t>(fid), envelope, full ? feature->StealGeometry() : nullptr);
+      }
+      OGRFeature::DestroyFeature(feature);
+    }
+    tree->finish();
+    return tree;
+  };
+  job.rval = [](std::shared_ptr<PackedRTree> tree, const GetFromPersistentFunc &) { return SpatialIndex::New(tree); };
+  job.run(info, async, 2);
+}
+
+/**
+ * Builds a spatial index from an array of geometries.
+ *
+ * The ids returned by the queries are the indices in the array,
+ * the `null` and the empty geometries are skipped.
+ *
+ * @static
+ * @method fromGeometries
+ * @throws Error
+ * @param {gdal.Geometry[]} geometries
+ * @param {SpatialIndexOptions} [options]
+ * @param {string} [options.geometry='envelope'] Keep the envelopes (`envelope`) or copies of the geometries (`full`)
+ * @return {gdal.SpatialIndex}
+ */
+
+/**
+ * Builds a spatial index from an array of geometries.
+ * {{{async}}}
+ *
+ * The ids returned by the queries are the indices in the array,
+ * the `null` and the empty geometries are skipped.
+ *
+ * @static
+ * @method fromGeometriesAsync
+ * @throws Error
+ * @param {gdal.Geometry[]} geometries
+ * @param {SpatialIndexOptions} [options]
+ * @param {string} [options.geometry='envelope'] Keep the envelopes (`envelope`) or copies of the geometries (`full`)
+ * @param {callback<gdal.SpatialIndex>} [callback=undefined] {{{cb}}}
+ * @return {Promise<gdal.SpatialIndex>}
+ */
+GDAL_ASYNCABLE_DEFINE(SpatialIndex::fromGeometries) {
+  Local<Array> array;
+  Local<Object> options;
+  bool full;
+
+  NODE_ARG_ARRAY(0, "geometries", array);
+  NODE_ARG_OBJECT_OPT(1, "options", options);
+  try {
+    full = withGeometries(options);
+  } catch (const char *err) {
+    Nan::ThrowError(err);
+    return;
+  }
+  if (array->Length() > static_cast<uint32_t>(std::numeric_limits<int32_t>::max())) {
+    Nan::ThrowRangeError("Too many geometries");
+    return;
+  }
+
+  std::vector<LockedGeometry> geometries;
+  std::vector<Local<Object>> handles;
+  if (!Geometry::FromArray(array, "geometries must be an array of Geometry objects", geometries, handles)) return;
+
+  GDALAsyncableJob<std::shared_ptr<PackedRTree>> job(0);
+  // The handles keep the geometries alive even if the array is modified
+  job.persist(handles);
+  job.main = [geometries, full](const GDALExecutionProgress &) {
+    std::shared_ptr<PackedRTree> tree = std::make_shared<PackedRTree>(full);
+    for (size_t i = 0; i < geometries.size(); i++) {
+      OGRGeometry *geom = geometries[i].geom;
+      if (geom == nullptr) continue;
+      OGREnvelope envelope;
+      OGRGeometry *copy = nullptr;
+      {
+        GeometryGuard guard(geometries[i]);
+        if (geom->IsEmpty()) continue;
+        geom->getEnvelope(&envelope);
+        if (full) copy = geom->clone();
+      }
+      tree->add(static_cast<int32_t>(i), envelope, copy);
+    }
+    tree->finish();
+    return tree;
+  };
+  job.rval = [](std::shared_ptr<PackedRTree> tree, const GetFromPersistentFunc &) { return SpatialIndex::New(tree); };
+  job.run(info, async, 2);
+}
+
+static Local<Value> toInt32Array(std::shared_ptr<ColumnBuffer> ids) {
+  size_t length = ids->size / sizeof(int32_t);
+  return TypedArray::Adopt(GDT_Int32, ids->release(), static_cast<unsigned int>(length));
+}
+
+/**
+ * Returns the ids of all the items whose envelopes intersect the given envelope.
+ *
+ * @method search
+ * @throws Error
+ * @param {SpatialIndexBounds} envelope A `gdal.Envelope` or any object with `minX`, `minY`, `maxX` and `maxY`
+ * @return {Int32Array}
+ */
+
+/**
+ * Returns the ids of all the items whose envelopes intersect the given envelope.
+ * {{{async}}}
+ *
+ * @method searchAsync
+ * @throws Error
+ * @param {SpatialIndexBounds} envelope A `gdal.Envelope` or any object with `minX`, `minY`, `maxX` and `maxY`
+ * @param {callback<Int32Array>} [callback=undefined] {{{cb}}}
+ * @return {Promise<Int32Array>}
+ */
+GDAL_ASYNCABLE_DEFINE(SpatialIndex::search) {
+  SpatialIndex *index = Nan::ObjectWrap::Unwrap<SpatialIndex>(info.This());
+  Local<Object> obj;
+  OGREnvelope envelope;
+
+  NODE_ARG_OBJECT(0, "envelope", obj);
+  NODE_DOUBLE_FROM_OBJ(obj, "minX", envelope.MinX);
+  NODE_DOUBLE_FROM_OBJ(obj, "minY", envelope.MinY);
+  NODE_DOUBLE_FROM_OBJ(obj, "maxX", envelope.MaxX);
+  NODE_DOUBLE_FROM_OBJ(obj, "maxY", envelope.MaxY);
+
+  std::shared_ptr<PackedRTree> tree = index->get();
+  GDALAsyncableJob<std::shared_ptr<ColumnBuffer>> job(0);
+  job.main = [tree, envelope](const GDALExecutionProgress &) {
+    std::shared_ptr<ColumnBuffer> ids = std::make_shared<ColumnBuffer>();
+    tree->search(envelope, [&tree, &ids](size_t item) {
+      ids->push<int32_t>(tree->id(item));
+      return true;
+    });
+    return ids;
+  };
+  job.rval = [](std::shared_ptr<ColumnBuffer> ids, const GetFromPersistentFunc &) { return toInt32Array(ids); };
+  job.run(info, async, 1);
+}
+
+/**
+ * Returns the ids of all the items that intersect the given geometry.
+ *
+ * When the index has been built with `geometry: 'full'`, the candidates are tested
+ * using GEOS prepared geometries, otherwise only the envelopes are compared.
+ *
+ * @method intersects
+ * @throws Error
+ * @param {gdal.Geometry} geometry
+ * @return {Int32Array}
+ */
+
+/**
+ * Returns the ids of all the items that intersect the given geometry.
+ * {{{async}}}
+ *
+ * When the index has been built with `geometry: 'full'`, the candidates are tested
+ * using GEOS prepared geometries, otherwise only the envelopes are compared.
+ *
+ * @method intersectsAsync
+ * @throws Error
+ * @param {gdal.Geometry} geometry
+ * @param {callback<Int32Array>} [callback=undefined] {{{cb}}}
+ * @return {Promise<Int32Array>}
+ */
+GDAL_ASYNCABLE_DEFINE(SpatialIndex::intersects) {
+  SpatialIndex *index = Nan::ObjectWrap::Unwrap<SpatialIndex>(info.This());
+  Geometry *geom;
+
+  NODE_ARG_WRAPPED(0, "geometry", Geometry, geom);
+
+  std::shared_ptr<PackedRTree> tree = index->get();
+  LockedGeometry locked = {geom->get(), geom->asyncLock()};
+  GDALAsyncableJob<std::shared_ptr<ColumnBuffer>> job(0);
+  job.persist(info[0].As<Object>());
+  job.main = [tree, locked](const GDALExecutionProgress &) {
+    std::shared_ptr<ColumnBuffer> ids = std::make_shared<ColumnBuffer>();
+    GeometryGuard guard(locked);
+    tree->intersects(locked.geom, [&tree, &ids](size_t item) {
+      ids->push<int32_t>(tree->id(item));
+      return true;
+    });
+    return ids;
+  };
+  job.rval = [](std::shared_ptr<ColumnBuffer> ids, const GetFromPersistentFunc &) { return toInt32Array(ids); };
+  job.run(info, async, 1);
+}
+
+/**
+ * Number of items in the index.
+ *
+ * @readOnly
+ * @attribute count
+ * @type {number}
+ */
+NAN_GETTER(SpatialIndex::countGetter) {
+  SpatialIndex *index = Nan::ObjectWrap::Unwrap<SpatialIndex>(info.This());
+  info.GetReturnValue().Set(Nan::New<Number>(static_cast<double>(index->get()->size())));
+}
+
+/**
+ * Indexing mode, `envelope` or `full`.
+ *
+ * @readOnly
+ * @attribute geometry
+ * @type {string}
+ */
+NAN_GETTER(SpatialIndex::geometryGetter) {
+  SpatialIndex *index = Nan::ObjectWrap::Unwrap<SpatialIndex>(info.This());
+  info.GetReturnValue().Set(Nan::New(index->get()->hasGeometries() ? "full" : "envelope").ToLocalChecked());
+}
+
+} // namespace node_gdal
@@ -0,0 +1,52 @@
+#ifndef __NODE_GDAL_SPATIAL_INDEX_H__
+#define __NODE_GDAL_SPATIAL_INDEX_H__
+
+// node
+#include <node.h>
+#include <node_object_wrap.h>
+
+// nan
+#include "nan-wrapper.h"
+
+// ogr
+#include <ogrsf_frmts.h>
+
+#include <memory>
+
+#include "async.hpp"
+#include "utils/rtree.hpp"
+
+using namespace v8;
+using namespace node;
+
+namespace node_gdal {
+
+class SpatialIndex : public Nan::ObjectWrap {
+    public:
+  static Nan::Persistent<FunctionTemplate> constructor;
+  static void Initialize(Local<Object> target);
+  static NAN_METHOD(New);
+  static Local<Value> New(std::shared_ptr<PackedRTree> tree);
+  static NAN_METHOD(toString);
+  GDAL_ASYNCABLE_DECLARE(fromLayer);
+  GDAL_ASYNCABLE_DECLARE(fromGeometries);
+  GDAL_ASYNCABLE_DECLARE(search);
+  GDAL_ASYNCABLE_DECLARE(intersects);
+
+  static NAN_GETTER(countGetter);
+  static NAN_GETTER(geometryGetter);
+
+  SpatialIndex();
+  SpatialIndex(std::shared_ptr<PackedRTree> tree);
+  // The tree is immutable and can be shared with worker threads
+  inline std::shared_ptr<PackedRTree> get() {
+    return this_;
+  }
+
+    private:
+  ~SpatialIndex();
+  std::shared_ptr<PackedRTree> this_;
+};
+
+} // namespace node_gdal
+#endif
@@ -1,6 +1,7 @@
 
 #include "gdal_spatial_reference.hpp"
 #include "gdal_common.hpp"
+#include "utils/srs_cache.hpp"
 #include "utils/string_list.hpp"
 #include "async.hpp"
 
@@ -502,12 +503,13 @@ NAN_METHOD(SpatialReference::fromWKT) {
 
   std::string wkt("");
   NODE_ARG_STR(0, "wkt", wkt);
-  OGRChar *str = (OGRChar *)wkt.c_str();
 
-  OGRSpatialReference *srs = new OGRSpatialReference();
-  int err = srs->importFromWkt(&str);
+  OGRSpatialReference *srs;
+  int err = CachedSpatialReference("WKT:" + wkt, [&wkt](OGRSpatialReference *ref) {
+    OGRChar *str = (OGRChar *)wkt.c_str();
+    return ref->importFromWkt(&str);
+  }, srs);
   if (err) {
-    delete srs;
     NODE_THROW_OGRERR(err);
     return;
   }
@@ -529,10 +531,10 @@ NAN_METHOD(SpatialReference::fromProj4) {
   std::string input("");
   NODE_ARG_STR(0, "input", input);
 
-  OGRSpatialReference *srs = new OGRSpatialReference();
-  int err = srs->importFromProj4(input.c_str());
+  OGRSpatialReference *srs;
+  int err = CachedSpatialReference(
+    "PROJ4:" + input, [&input](OGRSpatialReference *ref) { return ref->importFromProj4(input.c_str()); }, srs);
   if (err) {
-    delete srs;
     NODE_THROW_OGRERR(err);
     return;
   }
@@ -782,12 +784,14 @@ GDAL_ASYNCABLE_DEFINE(SpatialReference::fromUserInput) {
   GDALAsyncableJob<OGRSpatialReference *> job(0);
 
   job.main = [input](const GDALExecutionProgress &progress) {
-    OGRSpatialReference *srs = new OGRSpatialReference();
-    int err = srs->SetFromUserInput(input.c_str());
-    if (err) {
-      delete srs;
-      throw getOGRErrMsg(err);
-    }
+    OGRSpatialReference *srs;
+    // Files and URLs can change, they are read every time
+    VSIStatBufL stat;
+    std::string key;
+    if (input.find("://") == std::string::npos && VSIStatL(input.c_str(), &stat) != 0) key = "INPUT:" + input;
+    int err = CachedSpatialReference(
+      key, [&input](OGRSpatialReference *ref) { return ref->SetFromUserInput(input.c_str()); }, srs);
+    if (err) throw getOGRErrMsg(err);
     return srs;
   };
   job.rval = [](OGRSpatialReference *srs, const GetFromPersistentFunc &) { return SpatialReference::New(srs, true); };
@@ -812,10 +816,10 @@ NAN_METHOD(SpatialReference::fromEPSG) {
   int epsg;
   NODE_ARG_INT(0, "epsg", epsg);
 
-  OGRSpatialReference *srs = new OGRSpatialReference();
-  int err = srs->importFromEPSG(epsg);
+  OGRSpatialReference *srs;
+  int err = CachedSpatialReference(
+    "EPSG:" + std::to_string(epsg), [epsg](OGRSpatialReference *ref) { return ref->importFromEPSG(epsg); }, srs);
   if (err) {
-    delete srs;
     NODE_THROW_OGRERR(err);
     return;
   }
@@ -847,10 +851,10 @@ NAN_METHOD(SpatialReference::fromEPSGA) {
   int epsg;
   NODE_ARG_INT(0, "epsg", epsg);
 
-  OGRSpatialReference *srs = new OGRSpatialReference();
-  int err = srs->importFromEPSGA(epsg);
+  OGRSpatialReference *srs;
+  int err = CachedSpatialReference(
+    "EPSGA:" + std::to_string(epsg), [epsg](OGRSpatialReference *ref) { return ref->importFromEPSGA(epsg); }, srs);
   if (err) {
-    delete srs;
     NODE_THROW_OGRERR(err);
     return;
   }
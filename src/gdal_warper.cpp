@@ -1,14 +1,22 @@
 #include "gdal_warper.hpp"
 #include "gdal_common.hpp"
 #include "gdal_dataset.hpp"
+#include "gdal_memfile.hpp"
 #include "gdal_spatial_reference.hpp"
+#include "collections/colortable.hpp"
 #include "utils/warp_options.hpp"
 
+#include <cmath>
+#include <limits>
+#include <list>
+#include <mutex>
+
 namespace node_gdal {
 
 void Warper::Initialize(Local<Object> target) {
   Nan__SetAsyncableMethod(target, "reprojectImage", reprojectImage);
   Nan__SetAsyncableMethod(target, "suggestedWarpOutput", suggestedWarpOutput);
+  Nan__SetAsyncableMethod(target, "renderTile", renderTile);
 }
 
 /*
@@ -461,4 +469,545 @@ GDAL_ASYNCABLE_DEFINE(Warper::suggestedWarpOutput) {
   job.run(info, async, 1);
 }
 
+// Half of the circumference of the WGS84 ellipsoid at the equator
+static const double webMercatorOrigin = 20037508.342789244;
+
+static const std::string &webMercatorWKT() {
+  static const std::string wkt = []() {
+    OGRSpatialReference srs;
+    char *raw = nullptr;
+    std::string r;
+    if (srs.importFromEPSG(3857) == OGRERR_NONE && srs.exportToWkt(&raw) == OGRERR_NONE) r = raw;
+    CPLFree(raw);
+    return r;
+  }();
+  return wkt;
+}
+
+/*
+ * Creating a GenImgProj transformer requires instantiating a PROJ pipeline
+ * which is by far the most expensive part of rendering a small tile.
+ * Idle transformers are kept in a small LRU pool keyed by the source
+ * SRS and geotransform. As transformers are not reentrant, they are removed
+ * from the pool while being used and returned to it afterwards.
+ * The pool is cleared along with the SRS caches, the transformers in use
+ * at that moment are destroyed when they are released.
+ */
+static std::mutex tileTransformerMutex;
+static std::list<std::pair<std::string, void *>> tileTransformerPool;
+static const size_t tileTransformerPoolSize = 16;
+static unsigned tileTransformerGeneration = 0;
+
+void Warper::ClearTransformerCache() {
+  std::lock_guard<std::mutex> lock(tileTransformerMutex);
+  for (auto &entry : tileTransformerPool) GDALDestroyGenImgProjTransformer(entry.second);
+  tileTransformerPool.clear();
+  tileTransformerGeneration++;
+}
+
+static void *tileTransformerAcquire(GDALDataset *src, std::string &key, unsigned &generation) {
+  double gt[6];
+  const char *wkt = src->GetProjectionRef();
+  key.clear();
+  {
+    std::lock_guard<std::mutex> lock(tileTransformerMutex);
+    generation = tileTransformerGeneration;
+  }
+  if (src->GetGeoTransform(gt) == CE_None && wkt != nullptr && *wkt) {
+    key = wkt;
+    // Exact, std::to_string() keeps only 6 decimals
+    for (int i = 0; i < 6; i++) key += CPLSPrintf("|%.17g", gt[i]);
+
+    std::lock_guard<std::mutex> lock(tileTransformerMutex);
+    for (auto it = tileTransformerPool.begin(); it != tileTransformerPool.end(); it++) {
+      if (it->first == key) {
+        void *hTransformArg = it->second;
+        tileTransformerPool.erase(it);
+        return hTransformArg;
+      }
+    }
+  }
+
+  char **options = CSLSetNameValue(nullptr, "DST_SRS", webMercatorWKT().c_str());
+#if GDAL_VERSION_MAJOR == 2 && GDAL_VERSION_MINOR < 3
+  void *hTransformArg = GDALCreateGenImgProjTransformer2(static_cast<GDALDatasetH>(src), nullptr, options);
+#else
+  void *hTransformArg = GDALCreateGenImgProjTransformer2(GDALDataset::ToHandle(src), nullptr, options);
+#endif
+  CSLDestroy(options);
+  return hTransformArg;
+}
+
+static void tileTransformerRelease(const std::string &key, unsigned generation, void *hTransformArg) {
+  std::unique_lock<std::mutex> lock(tileTransformerMutex);
+  // Datasets without a geotransform (GCPs, RPCs...) are never cached
+  if (key.empty() || generation != tileTransformerGeneration) {
+    lock.unlock();
+    GDALDestroyGenImgProjTransformer(hTransformArg);
+    return;
+  }
+  tileTransformerPool.emplace_front(key, hTransformArg);
+  if (tileTransformerPool.size() > tileTransformerPoolSize) {
+    GDALDestroyGenImgProjTransformer(tileTransformerPool.back().second);
+    tileTransformerPool.pop_back();
+  }
+}
+
+struct tileOptions {
+  int z, x, y, size;
+  std::vector<int> bands;
+  GDALResampleAlg resampling;
+  // min/max pairs, one per band
+  std::vector<double> scale;
+  std::vector<GDALColorEntry> palette;
+  GDALDriver *driver;
+  bool alpha;
+  std::shared_ptr<StringList> creationOptions;
+};
+
+struct tileResult {
+  GByte *data;
+  vsi_l_offset len;
+};
+
+// Selects the overview to warp from like gdalwarp -ovr AUTO: the lowest
+// resolution one that is still finer than the tile, hTransformArg must already
+// target the tile, returns nullptr for the full resolution
+static GDALDataset *tileOverview(GDALDataset *src, void *hTransformArg, const tileOptions &opts) {
+#if GDAL_VERSION_MAJOR > 2 || (GDAL_VERSION_MAJOR == 2 && GDAL_VERSION_MINOR >= 2)
+  GDALRasterBand *band = src->GetRasterBand(opts.bands[0]);
+  const int count = band->GetOverviewCount();
+  if (count == 0) return nullptr;
+
+  // Number of source pixels per tile pixel
+  const int dim = 21;
+  std::vector<double> x(dim * dim), y(dim * dim), z(dim * dim);
+  std::vector<int> success(dim * dim);
+  for (int i = 0; i < dim; i++) {
+    for (int j = 0; j < dim; j++) {
+      x[i * dim + j] = opts.size * static_cast<double>(i) / (dim - 1);
+      y[i * dim + j] = opts.size * static_cast<double>(j) / (dim - 1);
+    }
+  }
+  if (!GDALGenImgProjTransform(hTransformArg, TRUE, dim * dim, x.data(), y.data(), z.data(), success.data()))
+    return nullptr;
+  double minX = std::numeric_limits<double>::infinity();
+  double maxX = -std::numeric_limits<double>::infinity();
+  for (int i = 0; i < dim * dim; i++) {
+    if (!success[i]) continue;
+    minX = std::min(minX, x[i]);
+    maxX = std::max(maxX, x[i]);
+  }
+  if (!(maxX > minX)) return nullptr;
+  const double ratio = (maxX - minX) / opts.size;
+  if (ratio <= 1) return nullptr;
+
+  int level = -1;
+  for (; level < count - 1; level++) {
+    GDALRasterBand *next = band->GetOverview(level + 1);
+    if (next == nullptr) break;
+    const double width = src->GetRasterXSize();
+    const double current = level < 0 ? 1.0 : width / band->GetOverview(level)->GetXSize();
+    const double coarser = width / next->GetXSize();
+    if (current < ratio && coarser > ratio) break;
+    if (std::fabs(current - ratio) < 1e-1) break;
+  }
+  if (level < 0) return nullptr;
+  return GDALCreateOverviewDataset(src, level, FALSE);
+#else
+  return nullptr;
+#endif
+}
+
+// Warps the tile to a MEM dataset in WebMercator with an alpha band as the last band
+static GDALDataset *tileWarp(GDALDataset *src, const tileOptions &opts) {
+  const int n = static_cast<int>(opts.bands.size());
+  GDALDriver *mem = GetGDALDriverManager()->GetDriverByName("MEM");
+  if (mem == nullptr) throw "MEM driver not available";
+
+  GDALDataType type = src->GetRasterBand(opts.bands[0])->GetRasterDataType();
+  GDALDataset *warped = mem->Create("", opts.size, opts.size, n + 1, type, nullptr);
+  if (warped == nullptr) throw CPLGetLastErrorMsg();
+
+  const double tileSpan = 2 * webMercatorOrigin / (1 << opts.z);
+  const double res = tileSpan / opts.size;
+  double gt[6] = {-webMercatorOrigin + opts.x * tileSpan, res, 0, webMercatorOrigin - opts.y * tileSpan, 0, -res};
+  warped->SetGeoTransform(gt);
+  warped->SetProjection(webMercatorWKT().c_str());
+
+  std::string key;
+  unsigned generation;
+  void *hTransformArg = tileTransformerAcquire(src, key, generation);
+  if (hTransformArg == nullptr) {
+    GDALClose(warped);
+    throw CPLGetLastErrorMsg();
+  }
+  GDALSetGenImgProjTransformerDstGeoTransform(hTransformArg, gt);
+
+  // The transformer of an overview works in its own pixel coordinates
+  GDALDataset *ovr = tileOverview(src, hTransformArg, opts);
+  if (ovr != nullptr) {
+    tileTransformerRelease(key, generation, hTransformArg);
+    hTransformArg = tileTransformerAcquire(ovr, key, generation);
+    if (hTransformArg == nullptr) {
+      GDALClose(ovr);
+      GDALClose(warped);
+      throw CPLGetLastErrorMsg();
+    }
+    GDALSetGenImgProjTransformerDstGeoTransform(hTransformArg, gt);
+    src = ovr;
+  }
+  void *hApproxArg = GDALCreateApproxTransformer(GDALGenImgProjTransform, hTransformArg, 0.125);
+
+  GDALWarpOptions *psWOptions = GDALCreateWarpOptions();
+#if GDAL_VERSION_MAJOR == 2 && GDAL_VERSION_MINOR < 3
+  psWOptions->hSrcDS = static_cast<GDALDatasetH>(src);
+  psWOptions->hDstDS = static_cast<GDALDatasetH>(warped);
+#else
+  psWOptions->hSrcDS = GDALDataset::ToHandle(src);
+  psWOptions->hDstDS = GDALDataset::ToHandle(warped);
+#endif
+  psWOptions->eResampleAlg = opts.resampling;
+  psWOptions->eWorkingDataType = type;
+  psWOptions->pfnTransformer = GDALApproxTransform;
+  psWOptions->pTransformerArg = hApproxArg;
+  psWOptions->nBandCount = n;
+  psWOptions->panSrcBands = static_cast<int *>(CPLMalloc(sizeof(int) * n));
+  psWOptions->panDstBands = static_cast<int *>(CPLMalloc(sizeof(int) * n));
+  psWOptions->nDstAlphaBand = n + 1;
+  psWOptions->papszWarpOptions = CSLSetNameValue(psWOptions->papszWarpOptions, "INIT_DEST", "0");
+  psWOptions->papszWarpOptions = CSLSetNameValue(psWOptions->papszWarpOptions, "DST_ALPHA_MAX", "255");
+  for (int i = 0; i < n; i++) {
+    GDALRasterBand *band = src->GetRasterBand(opts.bands[i]);
+    psWOptions->panSrcBands[i] = opts.bands[i];
+    psWOptions->panDstBands[i] = i + 1;
+
+    int hasNoData = FALSE;
+    double noData = band->GetNoDataValue(&hasNoData);
+    if (hasNoData) {
+      if (psWOptions->padfSrcNoDataReal == nullptr) {
+        psWOptions->padfSrcNoDataReal = static_cast<double *>(CPLMalloc(sizeof(double) * n));
+        for (int j = 0; j < n; j++) psWOptions->padfSrcNoDataReal[j] = -1.1e20;
+      }
+      psWOptions->padfSrcNoDataReal[i] = noData;
+    }
+  }
+  for (int i = 1; i <= src->GetRasterCount(); i++) {
+    if (src->GetRasterBand(i)->GetColorInterpretation() == GCI_AlphaBand) {
+      psWOptions->nSrcAlphaBand = i;
+      break;
+    }
+  }
+
+  GDALWarpOperation oWarper;
+  CPLErr err = oWarper.Initialize(psWOptions);
+  if (err == CE_None) err = oWarper.ChunkAndWarpImage(0, 0, opts.size, opts.size);
+
+  // The transformers are not owned by the warp options
+  GDALDestroyWarpOptions(psWOptions);
+  GDALDestroyApproxTransformer(hApproxArg);
+  tileTransformerRelease(key, generation, hTransformArg);
+  if (ovr != nullptr) GDALClose(ovr);
+
+  if (err != CE_None) {
+    GDALClose(warped);
+    throw CPLGetLastErrorMsg();
+  }
+  return warped;
+}
+
+// Converts the warped data to a Byte dataset applying the scaling or the color table
+static GDALDataset *tileColorize(GDALDataset *warped, const tileOptions &opts) {
+  const int n = static_cast<int>(opts.bands.size());
+  const size_t pixels = static_cast<size_t>(opts.size) * opts.size;
+  // WEBP supports only RGB and RGBA
+  const bool expandGray =
+    n == 1 && opts.palette.empty() && opts.driver == GetGDALDriverManager()->GetDriverByName("WEBP");
+  const int channels = (opts.palette.empty() && !expandGray) ? n : 3;
+  const int outBands = channels + (opts.alpha ? 1 : 0);
+
+  GDALDataset *out =
+    GetGDALDriverManager()->GetDriverByName("MEM")->Create("", opts.size, opts.size, outBands, GDT_Byte, nullptr);
+  if (out == nullptr) throw CPLGetLastErrorMsg();
+
+  std::vector<GByte> alpha(pixels);
+  std::vector<GByte> pixel(pixels);
+  CPLErr err = warped->GetRasterBand(n + 1)->RasterIO(
+    GF_Read, 0, 0, opts.size, opts.size, alpha.data(), opts.size, opts.size, GDT_Byte, 0, 0, nullptr);
+
+  if (err == CE_None && !opts.palette.empty()) {
+    std::vector<int> index(pixels);
+    err = warped->GetRasterBand(1)->RasterIO(
+      GF_Read, 0, 0, opts.size, opts.size, index.data(), opts.size, opts.size, GDT_Int32, 0, 0, nullptr);
+    const GDALColorEntry transparent = {0, 0, 0, 0};
+    for (int c = 0; err == CE_None && c < channels; c++) {
+      for (size_t i = 0; i < pixels; i++) {
+        const GDALColorEntry &color = index[i] >= 0 && static_cast<size_t>(index[i]) < opts.palette.size()
+          ? opts.palette[index[i]]
+          : transparent;
+        pixel[i] = static_cast<GByte>(c == 0 ? color.c1 : c == 1 ? color.c2 : color.c3);
+        if (c == 0 && color.c4 < alpha[i]) alpha[i] = static_cast<GByte>(color.c4);
+      }
+      err = out->GetRasterBand(c + 1)->RasterIO(
+        GF_Write, 0, 0, opts.size, opts.size, pixel.data(), opts.size, opts.size, GDT_Byte, 0, 0, nullptr);
+    }
+  } else if (err == CE_None && !opts.scale.empty()) {
+    std::vector<double> value(pixels);
+    for (int c = 0; err == CE_None && c < channels; c++) {
+      const int b = expandGray ? 0 : c;
+      err = warped->GetRasterBand(b + 1)->RasterIO(
+        GF_Read, 0, 0, opts.size, opts.size, value.data(), opts.size, opts.size, GDT_Float64, 0, 0, nullptr);
+      const double min = opts.scale[b * 2];
+      const double ratio = 255.0 / (opts.scale[b * 2 + 1] - min);
+      for (size_t i = 0; i < pixels; i++) {
+        const double v = (value[i] - min) * ratio + 0.5;
+        pixel[i] = v <= 0 ? 0 : v >= 255 ? 255 : static_cast<GByte>(v);
+      }
+      if (err == CE_None)
+        err = out->GetRasterBand(c + 1)->RasterIO(
+          GF_Write, 0, 0, opts.size, opts.size, pixel.data(), opts.size, opts.size, GDT_Byte, 0, 0, nullptr);
+    }
+  } else {
+    // GDAL clamps the values when converting to Byte
+    for (int c = 0; err == CE_None && c < channels; c++) {
+      err = warped->GetRasterBand((expandGray ? 0 : c) + 1)->RasterIO(
+        GF_Read, 0, 0, opts.size, opts.size, pixel.data(), opts.size, opts.size, GDT_Byte, 0, 0, nullptr);
+      if (err == CE_None)
+        err = out->GetRasterBand(c + 1)->RasterIO(
+          GF_Write, 0, 0, opts.size, opts.size, pixel.data(), opts.size, opts.size, GDT_Byte, 0, 0, nullptr);
+    }
+  }
+
+  if (err == CE_None && opts.alpha) {
+    out->GetRasterBand(outBands)->SetColorInterpretation(GCI_AlphaBand);
+    err = out->GetRasterBand(outBands)->RasterIO(
+      GF_Write, 0, 0, opts.size, opts.size, alpha.data(), opts.size, opts.size, GDT_Byte, 0, 0, nullptr);
+  }
+
+  if (err != CE_None) {
+    GDALClose(out);
+    throw CPLGetLastErrorMsg();
+  }
+  return out;
+}
+
+/**
+ * Renders a WebMercator (EPSG:3857) XYZ tile from a dataset and encodes it
+ * as an image in a single operation.
+ *
+ * The dataset is warped directly to memory (the coordinate transformation
+ * is cached between calls) from the overview closest to the resolution of
+ * the tile like `gdalwarp -ovr AUTO`, the data is then scaled to 8 bits or mapped
+ * through a color table and encoded. Areas outside the dataset or equal
+ * to the NoData value are transparent unless the format is JPEG.
+ *
+ * @throws Error
+ * @method renderTile
+ * @static
+ * @for gdal
+ * @param {gdal.Dataset} src
+ * @param {TileOptions} options
+ * @param {number} options.z Zoom level
+ * @param {number} options.x Tile column
+ * @param {number} options.y Tile row (from the top)
+ * @param {number} [options.tileSize=256]
+ * @param {number[]} [options.bands] One or three bands, defaults to the first three bands if the dataset has at least three bands or to the first band otherwise
+ * @param {string} [options.resampling=NearestNeighbor] Resampling algorithm ({{#crossLink "Constants (GRA)"}}available options{{/crossLink}})
+ * @param {gdal.ColorTable} [options.colorTable] Color table used to map the values of a single band, requires the `NearestNeighbor` resampling
+ * @param {number[]|number[][]} [options.scale] `[min, max]` range mapped to `[0, 255]`, either one for all bands or one per band
+ * @param {string} [options.format=png] `png`, `jpeg` or `webp`, depends on the drivers included in GDAL
+ * @param {string[]|object} [options.creationOptions] Driver creation options
+ * @return {Buffer}
+ */
+
+/**
+ * Renders a WebMercator (EPSG:3857) XYZ tile from a dataset and encodes it
+ * as an image in a single operation.
+ * {{{async}}}
+ *
+ * The dataset is warped directly to memory (the coordinate transformation
+ * is cached between calls) from the overview closest to the resolution of
+ * the tile like `gdalwarp -ovr AUTO`, the data is then scaled to 8 bits or mapped
+ * through a color table and encoded. Areas outside the dataset or equal
+ * to the NoData value are transparent unless the format is JPEG.
+ *
+ * @throws Error
+ * @method renderTileAsync
+ * @static
+ * @for gdal
+ * @param {gdal.Dataset} src
+ * @param {TileOptions} options
+ * @param {number} options.z Zoom level
+ * @param {number} options.x Tile column
+ * @param {number} options.y Tile row (from the top)
+ * @param {number} [options.tileSize=256]
+ * @param {number[]} [options.bands] One or three bands, defaults to the first three bands if the dataset has at least three bands or to the first band otherwise
+ * @param {string} [options.resampling=NearestNeighbor] Resampling algorithm ({{#crossLink "Constants (GRA)"}}available options{{/crossLink}})
+ * @param {gdal.ColorTable} [options.colorTable] Color table used to map the values of a single band, requires the `NearestNeighbor` resampling
+ * @param {number[]|number[][]} [options.scale] `[min, max]` range mapped to `[0, 255]`, either one for all bands or one per band
+ * @param {string} [options.format=png] `png`, `jpeg` or `webp`, depends on the drivers included in GDAL
+ * @param {string[]|object} [options.creationOptions] Driver creation options
+ * @param {callback<Buffer>} [callback=undefined] {{{cb}}}
+ * @return {Promise<Buffer>}
+ */
+GDAL_ASYNCABLE_DEFINE(Warper::renderTile) {
+  Dataset *ds;
+  Local<Object> obj;
+  Local<Array> bands;
+  Local<Array> scale;
+  ColorTable *ct = nullptr;
+  std::string format = "png";
+  tileOptions opts;
+
+  NODE_ARG_WRAPPED(0, "src", Dataset, ds);
+  NODE_ARG_OBJECT(1, "options", obj);
+
+  GDALDataset *gdal_ds = ds->get();
+  if (!gdal_ds) {
+    Nan::ThrowError("Dataset object has already been destroyed");
+    return;
+  }
+
+  opts.size = 256;
+  NODE_INT_FROM_OBJ(obj, "z", opts.z);
+  NODE_INT_FROM_OBJ(obj, "x", opts.x);
+  NODE_INT_FROM_OBJ(obj, "y", opts.y);
+  NODE_INT_FROM_OBJ_OPT(obj, "tileSize", opts.size);
+  NODE_ARRAY_FROM_OBJ_OPT(obj, "bands", bands);
+  NODE_ARRAY_FROM_OBJ_OPT(obj, "scale", scale);
+  NODE_WRAPPED_FROM_OBJ_OPT(obj, "colorTable", ColorTable, ct);
+  NODE_STR_FROM_OBJ_OPT(obj, "format", format);
+
+  if (opts.z < 0 || opts.z > 30) {
+    Nan::ThrowRangeError("z must be between 0 and 30");
+    return;
+  }
+  if (opts.x < 0 || opts.y < 0 || opts.x >= (1 << opts.z) || opts.y >= (1 << opts.z)) {
+    Nan::ThrowRangeError("Tile coordinates out of range");
+    return;
+  }
+  if (opts.size <= 0) {
+    Nan::ThrowRangeError("tileSize must be a positive number");
+    return;
+  }
+
+  WarpOptions resampling;
+  if (resampling.parseResamplingAlg(Nan::Get(obj, Nan::New("resampling").ToLocalChecked()).ToLocalChecked())) return;
+  opts.resampling = resampling.get()->eResampleAlg;
+
+  if (!bands.IsEmpty()) {
+    for (unsigned i = 0; i < bands->Length(); i++) {
+      Local<Value> band = Nan::Get(bands, i).ToLocalChecked();
+      if (!band->IsNumber()) {
+        Nan::ThrowTypeError("bands must be an array of numbers");
+        return;
+      }
+      opts.bands.push_back(Nan::To<int32_t>(band).ToChecked());
+    }
+    if (opts.bands.size() != 1 && opts.bands.size() != 3) {
+      Nan::ThrowRangeError("bands must contain one or three band numbers");
+      return;
+    }
+  }
+
+  if (ct != nullptr) {
+    if (!scale.IsEmpty()) {
+      Nan::ThrowError("colorTable and scale are mutually exclusive");
+      return;
+    }
+    if (opts.bands.size() > 1) {
+      Nan::ThrowError("colorTable can be used only with a single band");
+      return;
+    }
+    // The color indices cannot be interpolated
+    if (opts.resampling != GRA_NearestNeighbour) {
+      Nan::ThrowError("colorTable can be used only with the NearestNeighbor resampling");
+      return;
+    }
+    GDALColorTable *raw = ct->get();
+    for (int i = 0; i < raw->GetColorEntryCount(); i++) opts.palette.push_back(*raw->GetColorEntry(i));
+  }
+
+  // scale is validated once the number of bands is known
+  std::vector<double> scaleValues;
+  if (!scale.IsEmpty()) {
+    for (unsigned i = 0; i < scale->Length(); i++) {
+      Local<Value> v = Nan::Get(scale, i).ToLocalChecked();
+      if (v->IsArray() && v.As<Array>()->Length() == 2) {
+        scaleValues.push_back(Nan::To<double>(Nan::Get(v.As<Array>(), 0).ToLocalChecked()).FromMaybe(0));
+        scaleValues.push_back(Nan::To<double>(Nan::Get(v.As<Array>(), 1).ToLocalChecked()).FromMaybe(0));
+      } else if (v->IsNumber() && scale->Length() == 2) {
+        scaleValues.push_back(Nan::To<double>(v).ToChecked());
+      } else {
+        Nan::ThrowTypeError("scale must be a [min, max] array or an array of [min, max] arrays");
+        return;
+      }
+    }
+  }
+
+  const char *driverName = format == "png"                       ? "PNG"
+                           : format == "jpeg" || format == "jpg" ? "JPEG"
+                           : format == "webp"                    ? "WEBP"
+                                                                 : nullptr;
+  if (driverName == nullptr) {
+    Nan::ThrowError("format must be one of png, jpeg or webp");
+    return;
+  }
+  opts.driver = GetGDALDriverManager()->GetDriverByName(driverName);
+  if (opts.driver == nullptr) {
+    Nan::ThrowError((std::string(driverName) + " driver is not available").c_str());
+    return;
+  }
+  opts.alpha = format != "jpeg" && format != "jpg";
+
+  opts.creationOptions = std::make_shared<StringList>();
+  if (Nan::HasOwnProperty(obj, Nan::New("creationOptions").ToLocalChecked()).FromMaybe(false) &&
+      opts.creationOptions->parse(Nan::Get(obj, Nan::New("creationOptions").ToLocalChecked()).ToLocalChecked())) {
+    return; // error parsing string list
+  }
+
+  GDALAsyncableJob<tileResult> job(ds->uid);
+  job.main = [gdal_ds, opts, scaleValues](const GDALExecutionProgress &) mutable {
+    if (opts.bands.empty()) {
+      opts.bands.push_back(1);
+      if (gdal_ds->GetRasterCount() >= 3 && opts.palette.empty()) {
+        opts.bands.push_back(2);
+        opts.bands.push_back(3);
+      }
+    }
+    for (int b : opts.bands)
+      if (b < 1 || b > gdal_ds->GetRasterCount()) throw "Invalid band number";
+    if (!scaleValues.empty()) {
+      if (scaleValues.size() == 2)
+        for (size_t i = 0; i < opts.bands.size(); i++)
+          opts.scale.insert(opts.scale.end(), {scaleValues[0], scaleValues[1]});
+      else if (scaleValues.size() == opts.bands.size() * 2)
+        opts.scale = scaleValues;
+      else
+        throw "scale must contain one [min, max] range per band";
+    }
+
+    CPLErrorReset();
+    GDALDataset *warped = tileWarp(gdal_ds, opts);
+    GDALDataset *colorized;
+    try {
+      colorized = tileColorize(warped, opts);
+    } catch (const char *) {
+      GDALClose(warped);
+      throw;
+    }
+    GDALClose(warped);
+
+    tileResult r;
+    r.data = Memfile::encodeDataset(colorized, opts.driver, opts.creationOptions->get(), &r.len);
+    GDALClose(colorized);
+    if (r.data == nullptr) throw CPLGetLastErrorMsg();
+    return r;
+  };
+  job.rval = [](tileResult r, const GetFromPersistentFunc &) {
+    return Memfile::NewBuffer(r.data, static_cast<size_t>(r.len));
+  };
+  job.run(info, async, 2);
+}
+
 } // namespace node_gdal
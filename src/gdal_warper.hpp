@@ -30,6 +30,11 @@ void Initialize(Local<Object> target);
 
 GDAL_ASYNCABLE_GLOBAL(reprojectImage);
 GDAL_ASYNCABLE_GLOBAL(suggestedWarpOutput);
+GDAL_ASYNCABLE_GLOBAL(renderTile);
+
+// Destroys the cached transformers of renderTile, they must be recreated
+// after a change of the PROJ configuration
+void ClearTransformerCache();
 
 } // namespace Warper
 } // namespace node_gdal
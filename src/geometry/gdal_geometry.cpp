@@ -14,10 +14,19 @@
 #include "gdal_point.hpp"
 #include "gdal_polygon.hpp"
 #include "../gdal_spatial_reference.hpp"
+#include "../gdal_feature.hpp"
+#include "../gdal_memfile.hpp"
+#include "../utils/geometry_object.hpp"
+#include "../utils/layer_columns.hpp"
+#include "../utils/parallel.hpp"
+#include "../utils/typed_array.hpp"
 
 #include <node_buffer.h>
 #include <ogr_core.h>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdlib.h>
 
@@ -37,6 +46,11 @@ void Geometry::Initialize(Local<Object> target) {
   Nan__SetAsyncableMethod(lcons, "fromWKB", Geometry::createFromWkb);
   Nan__SetAsyncableMethod(lcons, "fromGeoJson", Geometry::createFromGeoJson);
   Nan__SetAsyncableMethod(lcons, "fromGeoJsonBuffer", Geometry::createFromGeoJsonBuffer);
+  Nan__SetAsyncableMethod(lcons, "fromWKBArray", Geometry::createFromWkbArray);
+  Nan__SetAsyncableMethod(lcons, "toWKBArray", Geometry::exportToWkbArray);
+  Nan::SetMethod(lcons, "fromObject", Geometry::createFromObject);
+  Nan__SetAsyncableMethod(lcons, "toObjectArray", Geometry::exportToObjectArray);
+  Nan__SetAsyncableMethod(lcons, "fromObjectArray", Geometry::createFromObjectArray);
   Nan::SetMethod(lcons, "getName", Geometry::getName);
   Nan::SetMethod(lcons, "getConstructor", Geometry::getConstructor);
 
@@ -44,6 +58,7 @@ void Geometry::Initialize(Local<Object> target) {
   Nan__SetPrototypeAsyncableMethod(lcons, "toKML", exportToKML);
   Nan__SetPrototypeAsyncableMethod(lcons, "toGML", exportToGML);
   Nan__SetPrototypeAsyncableMethod(lcons, "toJSON", exportToJSON);
+  Nan::SetPrototypeMethod(lcons, "toObject", exportToObject);
   Nan__SetPrototypeAsyncableMethod(lcons, "toWKT", exportToWKT);
   Nan__SetPrototypeAsyncableMethod(lcons, "toWKB", exportToWKB);
   Nan__SetPrototypeAsyncableMethod(lcons, "isEmpty", isEmpty);
@@ -167,6 +182,26 @@ OGRwkbGeometryType Geometry::getGeometryType_fixed(OGRGeometry *geom) {
   return type;
 }
 
+bool Geometry::FromArray(
+  Local<Array> array, const char *message, std::vector<LockedGeometry> &geoms, std::vector<Local<Object>> &handles) {
+  geoms.reserve(array->Length());
+  for (uint32_t i = 0; i < array->Length(); i++) {
+    Local<Value> val = Nan::Get(array, i).ToLocalChecked();
+    if (val->IsNull() || val->IsUndefined()) {
+      geoms.push_back({nullptr, nullptr});
+      continue;
+    }
+    if (!val->IsObject() || !Nan::New(Geometry::constructor)->HasInstance(val)) {
+      Nan::ThrowTypeError(message);
+      return false;
+    }
+    Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(val.As<Object>());
+    geoms.push_back({geom->this_, geom->asyncLock()});
+    handles.push_back(val.As<Object>());
+  }
+  return true;
+}
+
 NAN_METHOD(Geometry::toString) {
   Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(info.This());
   std::ostringstream ss;
@@ -969,7 +1004,7 @@ GDAL_ASYNCABLE_DEFINE(Geometry::exportToWKT) {
   Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(info.This());
 
   OGRGeometry *gdal_geom = geom->this_;
-  uv_sem_t *async_lock = geom->async_lock;
+  uv_sem_t *async_lock = geom->asyncLock();
   GDALAsyncableJob<char *> job(0);
   job.main = [async_lock, gdal_geom](const GDALExecutionProgress &) {
     char *text = NULL;
@@ -1057,7 +1092,7 @@ GDAL_ASYNCABLE_DEFINE(Geometry::exportToWKB) {
   }
 
   OGRGeometry *gdal_geom = geom->this_;
-  uv_sem_t *async_lock = geom->async_lock;
+  uv_sem_t *async_lock = geom->asyncLock();
   GDALAsyncableJob<unsigned char *> job(0);
   job.main = [async_lock, gdal_geom, data, byte_order, wkb_variant](const GDALExecutionProgress &) {
     uv_sem_wait(async_lock);
@@ -1114,7 +1149,7 @@ GDAL_ASYNCABLE_DEFINE(Geometry::exportToKML) {
   Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(info.This());
 
   OGRGeometry *gdal_geom = geom->this_;
-  uv_sem_t *async_lock = geom->async_lock;
+  uv_sem_t *async_lock = geom->asyncLock();
   GDALAsyncableJob<char *> job(0);
   job.main = [async_lock, gdal_geom](const GDALExecutionProgress &) {
     CPLErrorReset();
@@ -1158,7 +1193,7 @@ GDAL_ASYNCABLE_DEFINE(Geometry::exportToGML) {
   Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(info.This());
 
   OGRGeometry *gdal_geom = geom->this_;
-  uv_sem_t *async_lock = geom->async_lock;
+  uv_sem_t *async_lock = geom->asyncLock();
   GDALAsyncableJob<char *> job(0);
   job.main = [async_lock, gdal_geom](const GDALExecutionProgress &) {
     CPLErrorReset();
@@ -1202,7 +1237,7 @@ GDAL_ASYNCABLE_DEFINE(Geometry::exportToJSON) {
   Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(info.This());
 
   OGRGeometry *gdal_geom = geom->this_;
-  uv_sem_t *async_lock = geom->async_lock;
+  uv_sem_t *async_lock = geom->asyncLock();
   GDALAsyncableJob<char *> job(0);
   job.main = [async_lock, gdal_geom](const GDALExecutionProgress &) {
     CPLErrorReset();
@@ -1250,7 +1285,7 @@ GDAL_ASYNCABLE_DEFINE(Geometry::centroid) {
   Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(info.This());
 
   OGRGeometry *gdal_geom = geom->this_;
-  uv_sem_t *async_lock = geom->async_lock;
+  uv_sem_t *async_lock = geom->asyncLock();
   GDALAsyncableJob<OGRPoint *> job(0);
   job.main = [async_lock, gdal_geom](const GDALExecutionProgress &) {
     OGRPoint *point = new OGRPoint();
@@ -1291,7 +1326,7 @@ GDAL_ASYNCABLE_DEFINE(Geometry::getEnvelope) {
   Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(info.This());
 
   OGRGeometry *gdal_geom = geom->this_;
-  uv_sem_t *async_lock = geom->async_lock;
+  uv_sem_t *async_lock = geom->asyncLock();
 
   GDALAsyncableJob<OGREnvelope *> job(0);
   job.main = [async_lock, gdal_geom](const GDALExecutionProgress &) {
@@ -1339,7 +1374,7 @@ GDAL_ASYNCABLE_DEFINE(Geometry::getEnvelope3D) {
   Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(info.This());
 
   OGRGeometry *gdal_geom = geom->this_;
-  uv_sem_t *async_lock = geom->async_lock;
+  uv_sem_t *async_lock = geom->asyncLock();
 
   GDALAsyncableJob<OGREnvelope3D *> job(0);
   job.main = [async_lock, gdal_geom](const GDALExecutionProgress &) {
@@ -1612,6 +1647,572 @@ GDAL_ASYNCABLE_DEFINE(Geometry::createFromGeoJsonBuffer) {
 #endif
 }
 
+/**
+ * Creates an array of Geometries from an array of WKB buffers or from a single
+ * buffer of concatenated WKBs with their offsets, as returned by `toWKBArray()`.
+ *
+ * The WKBs are parsed without creating any intermediate JS objects and the
+ * work can be split across several threads. `null` and zero-length WKBs
+ * produce `null`.
+ *
+ * @static
+ * @method fromWKBArray
+ * @throws Error
+ * @param {(Buffer|null)[]|WKBArray} wkbs
+ * @param {WKBArrayOptions} [options]
+ * @param {gdal.SpatialReference} [options.srs]
+ * @param {number} [options.threads=1] Number of threads
+ * @return {(gdal.Geometry|null)[]}
+ */
+
+/**
+ * Creates an array of Geometries from an array of WKB buffers or from a single
+ * buffer of concatenated WKBs with their offsets, as returned by `toWKBArray()`.
+ * {{{async}}}
+ *
+ * The WKBs are parsed without creating any intermediate JS objects and the
+ * work can be split across several threads. `null` and zero-length WKBs
+ * produce `null`.
+ *
+ * @example
+ * ```
+ * const { rows } = await pg.query('SELECT ST_AsBinary(geom) AS wkb FROM parcels');
+ * const geoms = await gdal.Geometry.fromWKBArrayAsync(rows.map((r) => r.wkb), { threads: 4 });```
+ *
+ * @static
+ * @method fromWKBArrayAsync
+ * @throws Error
+ * @param {(Buffer|null)[]|WKBArray} wkbs
+ * @param {WKBArrayOptions} [options]
+ * @param {gdal.SpatialReference} [options.srs]
+ * @param {number} [options.threads=1] Number of threads
+ * @param {callback<(gdal.Geometry|null)[]>} [callback=undefined] {{{cb}}}
+ * @return {Promise<(gdal.Geometry|null)[]>}
+ */
+GDAL_ASYNCABLE_DEFINE(Geometry::createFromWkbArray) {
+  Local<Object> options;
+  SpatialReference *srs = nullptr;
+  int threads = 1;
+
+  if (info.Length() < 1 || !info[0]->IsObject()) {
+    Nan::ThrowTypeError("wkbs must be an array of Buffers or an object with data and offsets");
+    return;
+  }
+  NODE_ARG_OBJECT_OPT(1, "options", options);
+  if (!options.IsEmpty()) {
+    NODE_WRAPPED_FROM_OBJ_OPT(options, "srs", SpatialReference, srs);
+    NODE_INT_FROM_OBJ_OPT(options, "threads", threads);
+  }
+  if (threads < 1) {
+    Nan::ThrowRangeError("threads must be a positive integer");
+    return;
+  }
+
+  // The data and the length of every WKB, nullptr for null
+  std::vector<std::pair<unsigned char *, size_t>> wkbs;
+  std::vector<Local<Object>> handles;
+  if (info[0]->IsArray()) {
+    Local<Array> array = info[0].As<Array>();
+    wkbs.reserve(array->Length());
+    for (uint32_t i = 0; i < array->Length(); i++) {
+      Local<Value> val = Nan::Get(array, i).ToLocalChecked();
+      if (val->IsNull() || val->IsUndefined()) {
+        wkbs.emplace_back(nullptr, 0);
+        continue;
+      }
+      if (!val->IsUint8Array()) {
+        Nan::ThrowTypeError("All array elements must be Buffers or null");
+        return;
+      }
+      size_t length = Buffer::Length(val);
+      wkbs.emplace_back(length > 0 ? reinterpret_cast<unsigned char *>(Buffer::Data(val)) : nullptr, length);
+      handles.push_back(val.As<Object>());
+    }
+  } else {
+    Local<Object> obj = info[0].As<Object>();
+    Local<Value> data = Nan::Get(obj, Nan::New("data").ToLocalChecked()).ToLocalChecked();
+    Local<Value> offsets = Nan::Get(obj, Nan::New("offsets").ToLocalChecked()).ToLocalChecked();
+    if (!data->IsUint8Array() || !offsets->IsUint32Array()) {
+      Nan::ThrowTypeError("wkbs must be an array of Buffers or an object with data and offsets");
+      return;
+    }
+    unsigned char *base = reinterpret_cast<unsigned char *>(Buffer::Data(data));
+    size_t length = Buffer::Length(data);
+    handles.push_back(data.As<Object>());
+    Nan::TypedArrayContents<uint32_t> offs(offsets);
+    if (offs.length() < 1) {
+      Nan::ThrowRangeError("offsets must have at least one element");
+      return;
+    }
+    wkbs.reserve(offs.length() - 1);
+    for (size_t i = 0; i + 1 < offs.length(); i++) {
+      uint32_t begin = (*offs)[i], end = (*offs)[i + 1];
+      if (begin > end || end > length) {
+        Nan::ThrowRangeError("Invalid offsets");
+        return;
+      }
+      wkbs.emplace_back(end > begin ? base + begin : nullptr, end - begin);
+    }
+  }
+
+  OGRSpatialReference *ogr_srs = nullptr;
+  GDALAsyncableJob<std::shared_ptr<std::vector<std::unique_ptr<OGRGeometry>>>> job(0);
+  // Keep the buffers alive even if the array or the object is modified
+  job.persist(handles);
+  if (srs) {
+    ogr_srs = srs->get();
+    job.persist(Nan::Get(options, Nan::New("srs").ToLocalChecked()).ToLocalChecked().As<Object>());
+  }
+
+  job.main = [wkbs, ogr_srs, threads](const GDALExecutionProgress &) {
+    auto geoms = std::make_shared<std::vector<std::unique_ptr<OGRGeometry>>>(wkbs.size());
+    parallelFor(wkbs.size(), threads, [&wkbs, &geoms, ogr_srs](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+        if (wkbs[i].first == nullptr) continue;
+        OGRGeometry *geom = nullptr;
+        OGRErr err = OGRGeometryFactory::createFromWkb(wkbs[i].first, ogr_srs, &geom, wkbs[i].second);
+        if (err) {
+          CPLError(CE_Failure, CPLE_AppDefined, "Failed parsing the WKB at index %d: %s", (int)i, getOGRErrMsg(err));
+          throw CPLGetLastErrorMsg();
+        }
+        (*geoms)[i].reset(geom);
+      }
+    });
+    return geoms;
+  };
+  job.rval = [](std::shared_ptr<std::vector<std::unique_ptr<OGRGeometry>>> geoms, const GetFromPersistentFunc &) {
+    Nan::EscapableHandleScope scope;
+    Local<Array> result = Nan::New<Array>(static_cast<int>(geoms->size()));
+    for (size_t i = 0; i < geoms->size(); i++) {
+      if ((*geoms)[i])
+        Nan::Set(result, i, Geometry::New((*geoms)[i].release(), true));
+      else
+        Nan::Set(result, i, Nan::Null());
+    }
+    return scope.Escape(result);
+  };
+  job.run(info, async, 2);
+}
+
+/**
+ * Converts an array of Geometries to WKB, returning a single buffer with all
+ * the WKBs concatenated and an `Uint32Array` with the offset of every WKB
+ * followed by the total length.
+ *
+ * The work can be split across several threads. `null` elements produce
+ * zero-length WKBs.
+ *
+ * @static
+ * @method toWKBArray
+ * @throws Error
+ * @param {(gdal.Geometry|null)[]} geometries
+ * @param {WKBArrayOptions} [options]
+ * @param {string} [options.byteOrder="MSB"] ({{#crossLink "Constants
+ * (wkbByteOrder)"}}see options{{/crossLink}})
+ * @param {string} [options.variant="OGC"] ({{#crossLink "Constants
+ * (wkbVariant)"}}see options{{/crossLink}})
+ * @param {number} [options.threads=1] Number of threads
+ * @return {WKBArray}
+ */
+
+/**
+ * Converts an array of Geometries to WKB, returning a single buffer with all
+ * the WKBs concatenated and an `Uint32Array` with the offset of every WKB
+ * followed by the total length.
+ * {{{async}}}
+ *
+ * The work can be split across several threads. `null` elements produce
+ * zero-length WKBs.
+ *
+ * @static
+ * @method toWKBArrayAsync
+ * @throws Error
+ * @param {(gdal.Geometry|null)[]} geometries
+ * @param {WKBArrayOptions} [options]
+ * @param {string} [options.byteOrder="MSB"] ({{#crossLink "Constants
+ * (wkbByteOrder)"}}see options{{/crossLink}})
+ * @param {string} [options.variant="OGC"] ({{#crossLink "Constants
+ * (wkbVariant)"}}see options{{/crossLink}})
+ * @param {number} [options.threads=1] Number of threads
+ * @param {callback<WKBArray>} [callback=undefined] {{{cb}}}
+ * @return {Promise<WKBArray>}
+ */
+GDAL_ASYNCABLE_DEFINE(Geometry::exportToWkbArray) {
+  Local<Array> array;
+  Local<Object> options;
+  std::string order = "MSB";
+  std::string variant = "OGC";
+  int threads = 1;
+
+  NODE_ARG_ARRAY(0, "geometries", array);
+  NODE_ARG_OBJECT_OPT(1, "options", options);
+  if (!options.IsEmpty()) {
+    NODE_STR_FROM_OBJ_OPT(options, "byteOrder", order);
+    NODE_STR_FROM_OBJ_OPT(options, "variant", variant);
+    NODE_INT_FROM_OBJ_OPT(options, "threads", threads);
+  }
+
+  OGRwkbByteOrder byte_order;
+  if (order == "MSB") {
+    byte_order = wkbXDR;
+  } else if (order == "LSB") {
+    byte_order = wkbNDR;
+  } else {
+    Nan::ThrowError("byte order must be 'MSB' or 'LSB'");
+    return;
+  }
+  OGRwkbVariant wkb_variant;
+  if (variant == "OGC") {
+    wkb_variant = wkbVariantOldOgc;
+  } else if (variant == "ISO") {
+    wkb_variant = wkbVariantIso;
+  } else {
+    Nan::ThrowError("variant must be 'OGC' or 'ISO'");
+    return;
+  }
+  if (threads < 1) {
+    Nan::ThrowRangeError("threads must be a positive integer");
+    return;
+  }
+
+  std::vector<LockedGeometry> geoms;
+  std::vector<Local<Object>> handles;
+  if (!Geometry::FromArray(array, "All array elements must be Geometry objects or null", geoms, handles)) return;
+
+  typedef std::pair<std::shared_ptr<ColumnBuffer>, std::shared_ptr<ColumnBuffer>> WKBArray;
+  GDALAsyncableJob<WKBArray> job(0);
+  // Keep the geometries alive even if the array is modified
+  job.persist(handles);
+  job.main = [geoms, byte_order, wkb_variant, threads](const GDALExecutionProgress &) {
+    std::vector<size_t> sizes(geoms.size());
+    // Every thread writes its range to its own buffer, the buffers are then concatenated
+    std::map<size_t, ColumnBuffer> chunks;
+    std::mutex lock;
+    parallelFor(geoms.size(), threads, [&](size_t begin, size_t end) {
+      ColumnBuffer out;
+      for (size_t i = begin; i < end; i++) {
+        OGRGeometry *geom = geoms[i].geom;
+        if (geom == nullptr) continue;
+        size_t size;
+        OGRErr err;
+        {
+          GeometryGuard guard(geoms[i]);
+          size = geom->WkbSize();
+          err = geom->exportToWkb(byte_order, out.grow(size), wkb_variant);
+        }
+        if (err) {
+          CPLError(
+            CE_Failure, CPLE_AppDefined, "Failed exporting the geometry at index %d: %s", (int)i, getOGRErrMsg(err));
+          throw CPLGetLastErrorMsg();
+        }
+        sizes[i] = size;
+      }
+      std::lock_guard<std::mutex> guard(lock);
+      chunks.emplace(begin, std::move(out));
+    });
+
+    std::shared_ptr<ColumnBuffer> offsets = std::make_shared<ColumnBuffer>();
+    size_t total = 0;
+    offsets->push<uint32_t>(0);
+    for (size_t size : sizes) {
+      total += size;
+      if (total > std::numeric_limits<uint32_t>::max()) throw "The WKB data exceeds 4 GB";
+      offsets->push<uint32_t>(static_cast<uint32_t>(total));
+    }
+
+    std::shared_ptr<ColumnBuffer> data;
+    if (chunks.size() == 1) {
+      data = std::make_shared<ColumnBuffer>(std::move(chunks.begin()->second));
+    } else {
+      data = std::make_shared<ColumnBuffer>();
+      for (auto &chunk : chunks)
+        if (chunk.second.size > 0) memcpy(data->grow(chunk.second.size), chunk.second.get(), chunk.second.size);
+    }
+    return WKBArray(data, offsets);
+  };
+  job.rval = [](WKBArray r, const GetFromPersistentFunc &) {
+    Nan::EscapableHandleScope scope;
+    Local<Object> obj = Nan::New<Object>();
+    size_t length = r.first->size;
+    Nan::Set(
+      obj, Nan::New("data").ToLocalChecked(), Memfile::NewBuffer(static_cast<GByte *>(r.first->release()), length));
+    length = r.second->size / sizeof(uint32_t);
+    Nan::Set(
+      obj,
+      Nan::New("offsets").ToLocalChecked(),
+      TypedArray::Adopt(GDT_UInt32, r.second->release(), static_cast<unsigned int>(length)));
+    return scope.Escape(obj);
+  };
+  job.run(info, async, 2);
+}
+
+/**
+ * Converts the geometry to a GeoJSON object representation.
+ *
+ * The object is built directly from the coordinates without going through a
+ * JSON string, the curves are linearized, M is dropped and the empty points of
+ * a `MultiPoint` are skipped. With `flat`, the
+ * coordinates are returned as a single `Float64Array` with the same offsets
+ * as `gdal.LineStringPoints.toFlatArray()`, except for `GeometryCollection`
+ * that keeps its `geometries`.
+ *
+ * @method toObject
+ * @throws Error
+ * @param {GeometryObjectOptions} [options]
+ * @param {boolean} [options.flat=false] Return the coordinates as a `Float64Array`
+ * @return {object} GeoJSON
+ */
+NAN_METHOD(Geometry::exportToObject) {
+  Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(info.This());
+  Local<Object> options;
+  bool flat = false;
+
+  NODE_ARG_OBJECT_OPT(0, "options", options);
+  if (!options.IsEmpty()) { NODE_BOOL_FROM_OBJ_OPT(options, "flat", flat); }
+
+  try {
+    GeometryToObject obj(geom->this_);
+    info.GetReturnValue().Set(obj.ToObject(flat));
+  } catch (const char *err) { Nan::ThrowError(err); }
+}
+
+/**
+ * Creates a Geometry from a GeoJSON geometry object.
+ *
+ * Unlike `fromGeoJson()`, the object is read directly without serializing it
+ * to a JSON string. It also accepts the flat coordinates returned by
+ * `toObject({ flat: true })`.
+ *
+ * @static
+ * @method fromObject
+ * @throws Error
+ * @param {object} geojson
+ * @return {gdal.Geometry}
+ */
+NAN_METHOD(Geometry::createFromObject) {
+  if (info.Length() < 1) {
+    Nan::ThrowError("geojson must be given");
+    return;
+  }
+  std::unique_ptr<GeometryFromObject> parsed = GeometryFromObject::Parse(info[0]);
+  if (parsed == nullptr) return;
+
+  try {
+    info.GetReturnValue().Set(Geometry::New(parsed->Build(), true));
+  } catch (const char *err) { Nan::ThrowError(err); }
+}
+
+/**
+ * Converts an array of geometries or features to GeoJSON objects.
+ *
+ * The coordinates are extracted in the background, on several threads if
+ * requested, only the creation of the JS objects runs on the main thread.
+ * The features are converted to their geometry, `null` elements and features
+ * without a geometry give `null`.
+ *
+ * @static
+ * @method toObjectArray
+ * @throws Error
+ * @param {(gdal.Geometry|gdal.Feature|null)[]} geometries
+ * @param {GeometryObjectOptions} [options]
+ * @param {boolean} [options.flat=false] Return the coordinates as a `Float64Array`
+ * @param {number} [options.threads=1] Number of threads
+ * @return {(object|null)[]}
+ */
+
+/**
+ * Converts an array of geometries or features to GeoJSON objects.
+ * {{{async}}}
+ *
+ * The coordinates are extracted in the background, on several threads if
+ * requested, only the creation of the JS objects runs on the main thread.
+ * The features are converted to their geometry, `null` elements and features
+ * without a geometry give `null`.
+ *
+ * @static
+ * @method toObjectArrayAsync
+ * @throws Error
+ * @param {(gdal.Geometry|gdal.Feature|null)[]} geometries
+ * @param {GeometryObjectOptions} [options]
+ * @param {boolean} [options.flat=false] Return the coordinates as a `Float64Array`
+ * @param {number} [options.threads=1] Number of threads
+ * @param {callback<(object|null)[]>} [callback=undefined] {{{cb}}}
+ * @return {Promise<(object|null)[]>}
+ */
+GDAL_ASYNCABLE_DEFINE(Geometry::exportToObjectArray) {
+  Local<Array> array;
+  Local<Object> options;
+  bool flat = false;
+  int threads = 1;
+
+  NODE_ARG_ARRAY(0, "geometries", array);
+  NODE_ARG_OBJECT_OPT(1, "options", options);
+  if (!options.IsEmpty()) {
+    NODE_BOOL_FROM_OBJ_OPT(options, "flat", flat);
+    NODE_INT_FROM_OBJ_OPT(options, "threads", threads);
+  }
+  if (threads < 1) {
+    Nan::ThrowRangeError("threads must be a positive integer");
+    return;
+  }
+
+  // The geometries of the features can be replaced or freed from JS at any
+  // moment, they are copied here, the copies do not need a lock
+  std::vector<std::pair<OGRGeometry *, uv_sem_t *>> geoms;
+  std::shared_ptr<std::vector<std::unique_ptr<OGRGeometry>>> copies =
+    std::make_shared<std::vector<std::unique_ptr<OGRGeometry>>>();
+  std::vector<Local<Object>> handles;
+  geoms.reserve(array->Length());
+  for (uint32_t i = 0; i < array->Length(); i++) {
+    Local<Value> val = Nan::Get(array, i).ToLocalChecked();
+    if (val->IsNull() || val->IsUndefined()) {
+      geoms.emplace_back(nullptr, nullptr);
+    } else if (Nan::New(Geometry::constructor)->HasInstance(val)) {
+      Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(val.As<Object>());
+      geoms.emplace_back(geom->this_, geom->asyncLock());
+      handles.push_back(val.As<Object>());
+    } else if (Nan::New(Feature::constructor)->HasInstance(val)) {
+      Feature *feature = Nan::ObjectWrap::Unwrap<Feature>(val.As<Object>());
+      if (!feature->isAlive()) {
+        Nan::ThrowError("Feature object already destroyed");
+        return;
+      }
+      OGRGeometry *geom = feature->get()->GetGeometryRef();
+      if (geom != nullptr) {
+        copies->emplace_back(geom->clone());
+        geom = copies->back().get();
+      }
+      geoms.emplace_back(geom, nullptr);
+    } else {
+      Nan::ThrowTypeError("All array elements must be Geometry or Feature objects or null");
+      return;
+    }
+  }
+
+  typedef std::vector<std::unique_ptr<GeometryToObject>> ObjectArray;
+  GDALAsyncableJob<std::shared_ptr<ObjectArray>> job(0);
+  // The array can be modified from JS, its elements are persisted
+  job.persist(handles);
+  job.main = [geoms, copies, threads](const GDALExecutionProgress &) {
+    auto objs = std::make_shared<ObjectArray>(geoms.size());
+    parallelFor(geoms.size(), threads, [&geoms, &objs](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+        if (geoms[i].first == nullptr) continue;
+        if (geoms[i].second) uv_sem_wait(geoms[i].second);
+        try {
+          (*objs)[i].reset(new GeometryToObject(geoms[i].first));
+        } catch (const char *err) {
+          if (geoms[i].second) uv_sem_post(geoms[i].second);
+          CPLError(CE_Failure, CPLE_AppDefined, "Failed converting the geometry at index %d: %s", (int)i, err);
+          throw CPLGetLastErrorMsg();
+        }
+        if (geoms[i].second) uv_sem_post(geoms[i].second);
+      }
+    });
+    return objs;
+  };
+  job.rval = [flat](std::shared_ptr<ObjectArray> objs, const GetFromPersistentFunc &) {
+    Nan::EscapableHandleScope scope;
+    Local<Array> result = Nan::New<Array>(static_cast<int>(objs->size()));
+    for (size_t i = 0; i < objs->size(); i++) {
+      if ((*objs)[i])
+        Nan::Set(result, i, (*objs)[i]->ToObject(flat));
+      else
+        Nan::Set(result, i, Nan::Null());
+    }
+    return scope.Escape(result.As<Value>());
+  };
+  job.run(info, async, 2);
+}
+
+/**
+ * Creates Geometries from an array of GeoJSON geometry objects.
+ *
+ * The objects are read on the main thread, the geometries are built in the
+ * background, on several threads if requested. `null` elements give `null`.
+ *
+ * @static
+ * @method fromObjectArray
+ * @throws Error
+ * @param {(object|null)[]} geojsons
+ * @param {GeometryObjectOptions} [options]
+ * @param {number} [options.threads=1] Number of threads
+ * @return {(gdal.Geometry|null)[]}
+ */
+
+/**
+ * Creates Geometries from an array of GeoJSON geometry objects.
+ * {{{async}}}
+ *
+ * The objects are read on the main thread, the geometries are built in the
+ * background, on several threads if requested. `null` elements give `null`.
+ *
+ * @static
+ * @method fromObjectArrayAsync
+ * @throws Error
+ * @param {(object|null)[]} geojsons
+ * @param {GeometryObjectOptions} [options]
+ * @param {number} [options.threads=1] Number of threads
+ * @param {callback<(gdal.Geometry|null)[]>} [callback=undefined] {{{cb}}}
+ * @return {Promise<(gdal.Geometry|null)[]>}
+ */
+GDAL_ASYNCABLE_DEFINE(Geometry::createFromObjectArray) {
+  Local<Array> array;
+  Local<Object> options;
+  int threads = 1;
+
+  NODE_ARG_ARRAY(0, "geojsons", array);
+  NODE_ARG_OBJECT_OPT(1, "options", options);
+  if (!options.IsEmpty()) { NODE_INT_FROM_OBJ_OPT(options, "threads", threads); }
+  if (threads < 1) {
+    Nan::ThrowRangeError("threads must be a positive integer");
+    return;
+  }
+
+  typedef std::vector<std::unique_ptr<GeometryFromObject>> ParsedArray;
+  std::shared_ptr<ParsedArray> parsed = std::make_shared<ParsedArray>();
+  parsed->reserve(array->Length());
+  for (uint32_t i = 0; i < array->Length(); i++) {
+    Local<Value> val = Nan::Get(array, i).ToLocalChecked();
+    if (val->IsNull() || val->IsUndefined()) {
+      parsed->emplace_back(nullptr);
+      continue;
+    }
+    std::unique_ptr<GeometryFromObject> geom = GeometryFromObject::Parse(val);
+    if (geom == nullptr) return;
+    parsed->push_back(std::move(geom));
+  }
+
+  GDALAsyncableJob<std::shared_ptr<std::vector<std::unique_ptr<OGRGeometry>>>> job(0);
+  job.main = [parsed, threads](const GDALExecutionProgress &) {
+    auto geoms = std::make_shared<std::vector<std::unique_ptr<OGRGeometry>>>(parsed->size());
+    parallelFor(parsed->size(), threads, [&parsed, &geoms](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+        if ((*parsed)[i] == nullptr) continue;
+        try {
+          (*geoms)[i].reset((*parsed)[i]->Build());
+        } catch (const char *err) {
+          CPLError(CE_Failure, CPLE_AppDefined, "Failed building the geometry at index %d: %s", (int)i, err);
+          throw CPLGetLastErrorMsg();
+        }
+      }
+    });
+    return geoms;
+  };
+  job.rval = [](std::shared_ptr<std::vector<std::unique_ptr<OGRGeometry>>> geoms, const GetFromPersistentFunc &) {
+    Nan::EscapableHandleScope scope;
+    Local<Array> result = Nan::New<Array>(static_cast<int>(geoms->size()));
+    for (size_t i = 0; i < geoms->size(); i++) {
+      if ((*geoms)[i])
+        Nan::Set(result, i, Geometry::New((*geoms)[i].release(), true));
+      else
+        Nan::Set(result, i, Nan::Null());
+    }
+    return scope.Escape(result.As<Value>());
+  };
+  job.run(info, async, 2);
+}
+
 /**
  * Creates an empty Geometry from a WKB type.
  *
@@ -12,6 +12,7 @@
 #include <ogrsf_frmts.h>
 
 #include "../async.hpp"
+#include "../utils/geometry_lock.hpp"
 #include "gdal_geometrybase.hpp"
 
 using namespace v8;
@@ -40,6 +41,7 @@ class Geometry : public GeometryBase<Geometry, OGRGeometry> {
   GDAL_ASYNCABLE_DECLARE(exportToJSON);
   GDAL_ASYNCABLE_DECLARE(exportToWKT);
   GDAL_ASYNCABLE_DECLARE(exportToWKB);
+  static NAN_METHOD(exportToObject);
   GDAL_ASYNCABLE_DECLARE(closeRings);
   GDAL_ASYNCABLE_DECLARE(segmentize);
   GDAL_ASYNCABLE_DECLARE(intersects);
@@ -79,6 +81,11 @@ class Geometry : public GeometryBase<Geometry, OGRGeometry> {
   GDAL_ASYNCABLE_DECLARE(createFromWkb);
   GDAL_ASYNCABLE_DECLARE(createFromGeoJson);
   GDAL_ASYNCABLE_DECLARE(createFromGeoJsonBuffer);
+  GDAL_ASYNCABLE_DECLARE(createFromWkbArray);
+  GDAL_ASYNCABLE_DECLARE(exportToWkbArray);
+  static NAN_METHOD(createFromObject);
+  GDAL_ASYNCABLE_DECLARE(exportToObjectArray);
+  GDAL_ASYNCABLE_DECLARE(createFromObjectArray);
   static NAN_METHOD(getName);
   static NAN_METHOD(getConstructor);
 
@@ -94,6 +101,12 @@ class Geometry : public GeometryBase<Geometry, OGRGeometry> {
 
   static OGRwkbGeometryType getGeometryType_fixed(OGRGeometry *geom);
   static Local<Value> getConstructor(OGRwkbGeometryType type);
+
+  // Reads an array of Geometry objects, null and undefined give nullptr,
+  // the handles must be persisted by the job accessing the geometries,
+  // returns false after throwing a TypeError with message
+  static bool FromArray(
+    Local<Array> array, const char *message, std::vector<LockedGeometry> &geoms, std::vector<Local<Object>> &handles);
 };
 
 } // namespace node_gdal
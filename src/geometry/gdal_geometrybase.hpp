@@ -58,13 +58,34 @@ namespace node_gdal {
  * https://gdal.org/doxygen/classOGRGeometry.html
  */
 
+// The external memory is reported to V8 in batches of at least 1MB,
+// every adjustment can trigger a GC check which is expensive for
+// the many short-lived wrappers of points and feature geometries
+//
+// Main thread only
+inline void AdjustGeometryMemory(int64_t delta) {
+  static int64_t pending = 0;
+  pending += delta;
+  if (pending >= 1024 * 1024 || pending <= -1024 * 1024) {
+    Nan::AdjustExternalMemory(pending);
+    pending = 0;
+  }
+}
+
 #define UPDATE_AMOUNT_OF_GEOMETRY_MEMORY(geom)                                                                         \
   {                                                                                                                    \
     int new_size = geom->this_->WkbSize();                                                                             \
-    if (geom->owned_) Nan::AdjustExternalMemory(new_size - geom->size_);                                               \
+    if (geom->owned_) AdjustGeometryMemory(new_size - geom->size_);                                                    \
     geom->size_ = new_size;                                                                                            \
   }
 
+// Incremental version for the mutations that know their own size change
+#define ADJUST_AMOUNT_OF_GEOMETRY_MEMORY(geom, delta)                                                                  \
+  {                                                                                                                    \
+    if (geom->owned_) AdjustGeometryMemory(delta);                                                                     \
+    geom->size_ += (delta);                                                                                            \
+  }
+
 template <class T, class OGRT> class GeometryBase : public Nan::ObjectWrap {
     public:
   static Local<Value> New(OGRT *geom);
@@ -78,6 +99,18 @@ template <class T, class OGRT> class GeometryBase : public Nan::ObjectWrap {
   inline bool isAlive() {
     return this_;
   }
+  // The semaphore is created by the first asynchronous operation, most
+  // wrappers never need one - async operations are always launched from
+  // the main thread so this cannot race
+  // It must live outside the V8 memory management, otherwise it won't be
+  // accessible from the async threads
+  inline uv_sem_t *asyncLock() {
+    if (async_lock == nullptr) {
+      async_lock = new uv_sem_t;
+      uv_sem_init(async_lock, 1);
+    }
+    return async_lock;
+  }
 
     protected:
   ~GeometryBase();
@@ -118,18 +151,13 @@ template <class T, class OGRT> Local<Value> GeometryBase<T, OGRT>::New(OGRT *geo
 }
 
 template <class T, class OGRT>
-GeometryBase<T, OGRT>::GeometryBase(OGRT *geom) : Nan::ObjectWrap(), this_(geom), owned_(true), size_(0) {
+GeometryBase<T, OGRT>::GeometryBase(OGRT *geom)
+  : Nan::ObjectWrap(), this_(geom), owned_(true), size_(0), async_lock(nullptr) {
   LOG("Created Geometry %s [%p]", typeid(T).name(), geom);
-  // The async locks must live outside the V8 memory management,
-  // otherwise they won't be accessible from the async threads
-  async_lock = new uv_sem_t;
-  uv_sem_init(async_lock, 1);
 }
 
 template <class T, class OGRT>
-GeometryBase<T, OGRT>::GeometryBase() : Nan::ObjectWrap(), this_(NULL), owned_(true), size_(0) {
-  async_lock = new uv_sem_t;
-  uv_sem_init(async_lock, 1);
+GeometryBase<T, OGRT>::GeometryBase() : Nan::ObjectWrap(), this_(NULL), owned_(true), size_(0), async_lock(nullptr) {
 }
 
 template <class T, class OGRT> GeometryBase<T, OGRT>::~GeometryBase() {
@@ -137,13 +165,15 @@ template <class T, class OGRT> GeometryBase<T, OGRT>::~GeometryBase() {
     LOG("Disposing Geometry %s [%p] (%s)", typeid(T).name(), this_, owned_ ? "owned" : "unowned");
     if (owned_) {
       OGRGeometryFactory::destroyGeometry(this_);
-      Nan::AdjustExternalMemory(-size_);
+      AdjustGeometryMemory(-size_);
     }
     LOG("Disposed Geometry [%p]", this_)
     this_ = NULL;
   }
-  uv_sem_destroy(async_lock);
-  delete async_lock;
+  if (async_lock != nullptr) {
+    uv_sem_destroy(async_lock);
+    delete async_lock;
+  }
 }
 
 } // namespace node_gdal
@@ -119,9 +119,14 @@ NAN_METHOD(SimpleCurve::addSubLineString) {
     return;
   }
 
+  // The WKB size of the points, the other line can promote this one to 3D
+  auto pointsSize = [](OGRSimpleCurve *curve) {
+    return curve->getNumPoints() * 8 * (2 + (curve->Is3D() ? 1 : 0) + (curve->IsMeasured() ? 1 : 0));
+  };
+  int before = pointsSize(geom->this_);
   geom->this_->addSubLineString(other->get(), start, end);
 
-  UPDATE_AMOUNT_OF_GEOMETRY_MEMORY(geom);
+  ADJUST_AMOUNT_OF_GEOMETRY_MEMORY(geom, pointsSize(geom->this_) - before);
 
   return;
 }
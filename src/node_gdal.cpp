@@ -64,6 +64,7 @@
 
 #include "gdal_coordinate_transformation.hpp"
 #include "gdal_feature.hpp"
+#include "gdal_feature_view.hpp"
 #include "gdal_feature_defn.hpp"
 #include "gdal_field_defn.hpp"
 #include "geometry/gdal_geometry.hpp"
@@ -81,10 +82,14 @@
 #include "geometry/gdal_point.hpp"
 #include "geometry/gdal_polygon.hpp"
 #include "gdal_spatial_reference.hpp"
+#include "gdal_spatial_index.hpp"
+#include "gdal_prepared_geometry.hpp"
+#include "gdal_approx_transformer.hpp"
 #include "gdal_memfile.hpp"
 #include "gdal_fs.hpp"
 
 #include "utils/field_types.hpp"
+#include "utils/srs_cache.hpp"
 
 // collections
 #include "collections/dataset_bands.hpp"
@@ -298,6 +303,12 @@ static NAN_METHOD(setConfigOption) {
     Nan::ThrowError("value must be a string or null");
     return;
   }
+  // The cached objects may have been created with another value
+  if (IsSRSConfigOption(name)) {
+    srsCache.clear();
+    transformationCache.clear();
+    Warper::ClearTransformerCache();
+  }
 
   return;
 }
@@ -357,6 +368,64 @@ static NAN_METHOD(setPROJSearchPath) {
   const char *const paths[] = {path.c_str(), nullptr};
   OSRSetPROJSearchPaths(paths);
 #endif
+  // The cached objects may come from another database
+  srsCache.clear();
+  transformationCache.clear();
+  Warper::ClearTransformerCache();
+}
+
+/**
+ * Returns the statistics of the process-wide caches of spatial references and
+ * coordinate transformations.
+ *
+ * `gdal.SpatialReference.fromEPSG()`, `fromEPSGA()`, `fromProj4()`, `fromWKT()`,
+ * `fromUserInput{Async}()`, `new gdal.CoordinateTransformation(source, target)`
+ * and `gdal.renderVectorTile{Async}()` keep their results in two LRU caches shared by all threads, every call
+ * with the same definition returns a new private copy of the cached object
+ * instead of going through PROJ again.
+ *
+ * The transformations are cached only with GDAL 3.1 and later. Both caches
+ * are cleared, along with the transformers kept by `gdal.renderTile{Async}()`,
+ * when a config option affecting PROJ (`OSR_*`, `OGR_CT_*` or `PROJ_*`) is set
+ * with `gdal.config.set()`. `fromUserInput{Async}()` does not
+ * cache the definitions read from files or URLs.
+ *
+ * @for gdal
+ * @static
+ * @method getSRSCacheStats
+ * @return {SRSCacheStats}
+ */
+static NAN_METHOD(getSRSCacheStats) {
+  Local<Object> stats = Nan::New<Object>();
+  Nan::Set(stats, Nan::New("srs").ToLocalChecked(), srsCache.ToObject());
+  Nan::Set(stats, Nan::New("transformations").ToLocalChecked(), transformationCache.ToObject());
+  info.GetReturnValue().Set(stats);
+}
+
+/**
+ * Sets the maximum number of entries of the process-wide caches of spatial
+ * references and coordinate transformations, 0 empties and disables them.
+ *
+ * The default is 64 for each one.
+ *
+ * @for gdal
+ * @static
+ * @method setSRSCacheSize
+ * @param {number} srs
+ * @param {number} [transformations=srs]
+ */
+static NAN_METHOD(setSRSCacheSize) {
+  int srs;
+  NODE_ARG_INT(0, "srs", srs);
+  int transformations = srs;
+  NODE_ARG_INT_OPT(1, "transformations", transformations);
+  if (srs < 0 || transformations < 0) {
+    Nan::ThrowRangeError("The cache size cannot be negative");
+    return;
+  }
+
+  srsCache.setCapacity(srs);
+  transformationCache.setCapacity(transformations);
 }
 
 static NAN_METHOD(ThrowDummyCPLError) {
@@ -379,6 +448,8 @@ static void Init(Local<Object> target, Local<v8::Value>, void *) {
   Nan::SetMethod(target, "getConfigOption", getConfigOption);
   Nan::SetMethod(target, "decToDMS", decToDMS);
   Nan::SetMethod(target, "setPROJSearchPath", setPROJSearchPath);
+  Nan::SetMethod(target, "getSRSCacheStats", getSRSCacheStats);
+  Nan::SetMethod(target, "setSRSCacheSize", setSRSCacheSize);
   Nan::SetMethod(target, "_triggerCPLError", ThrowDummyCPLError); // for tests
   Nan::SetMethod(target, "_isAlive", isAlive);                    // for tests
 
@@ -397,6 +468,7 @@ static void Init(Local<Object> target, Local<v8::Value>, void *) {
 
   Layer::Initialize(target);
   Feature::Initialize(target);
+  FeatureView::Initialize(target);
   FeatureDefn::Initialize(target);
   FieldDefn::Initialize(target);
   Geometry::Initialize(target);
@@ -415,6 +487,9 @@ static void Init(Local<Object> target, Local<v8::Value>, void *) {
 
   SpatialReference::Initialize(target);
   CoordinateTransformation::Initialize(target);
+  SpatialIndex::Initialize(target);
+  PreparedGeometry::Initialize(target);
+  ApproxTransformer::Initialize(target);
   ColorTable::Initialize(target);
 
   DatasetBands::Initialize(target);
@@ -772,6 +847,21 @@ static void Init(Local<Object> target, Local<v8::Value>, void *) {
     Nan::New("ODsCCreateGeomFieldAfterCreateLayer").ToLocalChecked(),
     Nan::New(ODsCCreateGeomFieldAfterCreateLayer).ToLocalChecked());
 #endif
+  /**
+   * @final
+   * @property gdal.ODsCTransactions
+   * @type {string}
+   */
+  Nan::Set(target, Nan::New("ODsCTransactions").ToLocalChecked(), Nan::New(ODsCTransactions).ToLocalChecked());
+  /**
+   * @final
+   * @property gdal.ODsCEmulatedTransactions
+   * @type {string}
+   */
+  Nan::Set(
+    target,
+    Nan::New("ODsCEmulatedTransactions").ToLocalChecked(),
+    Nan::New(ODsCEmulatedTransactions).ToLocalChecked());
   /**
    * @final
    * @property gdal.ODrCCreateDataSource
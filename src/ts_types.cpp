@@ -33,6 +33,9 @@
  * @property {number[]} [stride]
  * @property {string} [data_type]
  * @property {TypedArray} [data]
+ * @property {boolean} [shared]
+ * @property {boolean} [external]
+ * @property {number} [alignment]
  * @property {number} [_offset]
  */
 
@@ -132,6 +135,273 @@
  * @property {number[]} geoTransform
  */
 
+/**
+ * @typedef TileOptions
+ * @property {number} z
+ * @property {number} x
+ * @property {number} y
+ * @property {number} [tileSize]
+ * @property {number[]} [bands]
+ * @property {string} [resampling]
+ * @property {gdal.ColorTable} [colorTable]
+ * @property {number[]|number[][]} [scale]
+ * @property {string} [format]
+ * @property {string[]|object} [creationOptions]
+ */
+
+/**
+ * @typedef VectorTileOptions
+ * @property {number} z
+ * @property {number} x
+ * @property {number} y
+ * @property {number} [extent]
+ * @property {number} [buffer]
+ * @property {number} [simplify]
+ * @property {string[]} [fields]
+ */
+
+/**
+ * @typedef EncodeOptions
+ * @property {number} width
+ * @property {number} height
+ * @property {number} [bands]
+ * @property {string} [driver]
+ * @property {string} [interleave]
+ * @property {string[]|object} [options]
+ * @property {number[]} [geoTransform]
+ * @property {gdal.SpatialReference} [srs]
+ */
+
+/**
+ * @typedef DecodeOptions
+ * @property {string} [interleave]
+ */
+
+/**
+ * @typedef DecodedData
+ * @property {TypedArray} data
+ * @property {number} width
+ * @property {number} height
+ * @property {number} bands
+ * @property {string} type
+ * @property {string} driver
+ * @property {number[]|null} geoTransform
+ * @property {gdal.SpatialReference|null} srs
+ */
+
+/**
+ * @typedef ReadColumnsOptions
+ * @property {string[]} [fields]
+ * @property {string} [geometry]
+ * @property {number} [batchSize]
+ */
+
+/**
+ * @typedef LayerColumn
+ * @property {string} type
+ * @property {Int32Array|BigInt64Array|Float64Array|Uint8Array} data
+ * @property {Int32Array} [offsets]
+ * @property {Uint8Array|null} validity
+ */
+
+/**
+ * @typedef LayerGeometryColumn
+ * @property {Uint8Array} [data]
+ * @property {Int32Array} [offsets]
+ * @property {Float64Array} [x]
+ * @property {Float64Array} [y]
+ * @property {Uint8Array|null} validity
+ */
+
+/**
+ * @typedef LayerColumns
+ * @property {number} count
+ * @property {Float64Array} fid
+ * @property {Record<string, LayerColumn>} fields
+ * @property {LayerGeometryColumn} [geometry]
+ */
+
+/**
+ * @typedef ColumnInput
+ * @property {Int32Array|BigInt64Array|Float64Array|Uint8Array} data
+ * @property {Int32Array} [offsets]
+ * @property {Uint8Array|null} [validity]
+ */
+
+/**
+ * @typedef ColumnarFeatures
+ * @property {number} [count]
+ * @property {Record<string, ColumnInput|Int32Array|BigInt64Array|Float64Array>} [fields]
+ * @property {LayerGeometryColumn} [geometry]
+ */
+
+/**
+ * @typedef AddManyOptions
+ * @property {number} [transactionSize]
+ */
+
+/**
+ * @typedef GeoJSONOptions
+ * @property {string[]} [fields]
+ * @property {number} [precision]
+ * @property {boolean} [rfc7946]
+ * @property {boolean} [newlineDelimited]
+ * @property {number} [chunkSize]
+ * @property {boolean} [reset]
+ */
+
+/**
+ * @typedef LayerIterateOptions
+ * @property {number} [prefetch]
+ * @property {number} [batchSize]
+ * @property {boolean} [view]
+ */
+
+/**
+ * @typedef NextViewsOptions
+ * @property {boolean} [reset]
+ */
+
+/**
+ * @typedef PreparedGeometryOptions
+ * @property {number} [threads]
+ */
+
+/**
+ * @typedef WKBArray
+ * @property {Buffer} data
+ * @property {Uint32Array} offsets
+ */
+
+/**
+ * @typedef WKBArrayOptions
+ * @property {gdal.SpatialReference} [srs]
+ * @property {string} [byteOrder]
+ * @property {string} [variant]
+ * @property {number} [threads]
+ */
+
+/**
+ * @typedef FlatCoordinatesOptions
+ * @property {number} [dims]
+ */
+
+/**
+ * @typedef FlatCoordinates
+ * @property {Float64Array} coordinates
+ * @property {Uint32Array[]} offsets
+ * @property {number} dims
+ */
+
+/**
+ * @typedef GeometryObjectOptions
+ * @property {boolean} [flat]
+ * @property {number} [threads]
+ */
+
+/**
+ * @typedef TransformPointsOutput
+ * @property {Float64Array} xs
+ * @property {Float64Array} ys
+ * @property {Float64Array} [zs]
+ */
+
+/**
+ * @typedef TransformPointsOptions
+ * @property {TransformPointsOutput} [output]
+ * @property {number} [threads]
+ */
+
+/**
+ * @typedef ObjectCacheStats
+ * @property {number} hits
+ * @property {number} misses
+ * @property {number} size
+ * @property {number} capacity
+ */
+
+/**
+ * @typedef ApproxTransformerOptions
+ * @property {number} maxError
+ */
+
+/**
+ * @typedef TransformGridOptions
+ * @property {boolean} [center]
+ * @property {number} [threads]
+ */
+
+/**
+ * @typedef TransformedGrid
+ * @property {Float64Array} xs
+ * @property {Float64Array} ys
+ * @property {Uint8Array} success
+ */
+
+/**
+ * @typedef SRSCacheStats
+ * @property {ObjectCacheStats} srs
+ * @property {ObjectCacheStats} transformations
+ */
+
+/**
+ * @typedef QuerySQLOptions
+ * @property {string} [dialect]
+ * @property {gdal.Geometry} [spatialFilter]
+ * @property {number} [batchSize]
+ */
+
+/**
+ * @typedef SpatialIndexBounds
+ * @property {number} minX
+ * @property {number} minY
+ * @property {number} maxX
+ * @property {number} maxY
+ */
+
+/**
+ * @typedef SpatialIndexOptions
+ * @property {string} [geometry]
+ */
+
+/**
+ * @typedef SpatialJoinOptions
+ * @property {string} [predicate]
+ * @property {string[]} [fields]
+ * @property {number} [threads]
+ * @property {gdal.Layer} [dst]
+ */
+
+/**
+ * @typedef SpatialJoinResult
+ * @property {number} count
+ * @property {Float64Array} [left]
+ * @property {Float64Array} [right]
+ */
+
+/**
+ * @typedef UnionAllOptions
+ * @property {string|Array<string|number>} [groupBy]
+ * @property {number} [threads=1]
+ */
+
+/**
+ * @typedef BufferManyOptions
+ * @property {number} [segments]
+ * @property {number} [threads]
+ */
+
+/**
+ * @typedef SimplifyManyOptions
+ * @property {boolean} [preserveTopology]
+ * @property {number} [threads]
+ */
+
+/**
+ * @typedef MakeValidManyOptions
+ * @property {number} [threads]
+ */
+
 /**
  * @typedef TypedArray Uint8Array | Int16Array | Uint16Array | Int32Array | Uint32Array | Float32Array | Float64Array
  */
@@ -146,6 +416,16 @@
  * @property {string} [resampling]
  * @property {ProgressCb} [progress_cb]
  * @property {number} [offset]
+ * @property {boolean} [shared]
+ * @property {boolean} [external]
+ * @property {number} [alignment]
+ * @property {boolean} [withMask]
+ */
+
+/**
+ * @typedef MaskedData
+ * @property {TypedArray} data
+ * @property {Uint8Array} mask
  */
 
 /**
@@ -191,6 +471,17 @@
  * @extends stream.WritableOptions
  * @property {boolean} [blockOptimize]
  * @property {boolean} [convertNoData]
+ * @property {number} [memoryLimit]
+ */
+
+/**
+ * @interface GeoJSONStreamOptions
+ * @extends stream.ReadableOptions
+ * @property {string[]} [fields]
+ * @property {number} [precision]
+ * @property {boolean} [rfc7946]
+ * @property {boolean} [newlineDelimited]
+ * @property {number} [chunkSize]
  */
 
 /**
@@ -0,0 +1,96 @@
+#include "approx_transformer.hpp"
+#include "parallel.hpp"
+
+#include <cpl_conv.h>
+
+#include <algorithm>
+
+namespace node_gdal {
+
+SharedApproxTransformer::SharedApproxTransformer(OGRSpatialReference *src, OGRSpatialReference *dst, double maxError)
+  : maxError(maxError), src(src->Clone()), dst(dst->Clone()), lock(), idle() {
+  // Fails early on invalid spatial references, the first one is kept
+  try {
+    idle.push_back(create());
+  } catch (const char *) {
+    this->src->Release();
+    this->dst->Release();
+    throw;
+  }
+}
+
+SharedApproxTransformer::~SharedApproxTransformer() {
+  for (void *transformer : idle) GDALDestroyTransformer(transformer);
+  src->Release();
+  dst->Release();
+}
+
+// The reprojection transformer cannot be cloned with GDALCreateSimilarTransformer()
+// so every transformer of the pool is created from the spatial references
+void *SharedApproxTransformer::create() {
+#if GDAL_VERSION_MAJOR >= 3
+  // Unlike the WKT version, this keeps the axis order of both SRS
+  void *reprojection = GDALCreateReprojectionTransformerEx(
+    OGRSpatialReference::ToHandle(src), OGRSpatialReference::ToHandle(dst), nullptr);
+#else
+  char *srcWkt = nullptr, *dstWkt = nullptr;
+  void *reprojection = nullptr;
+  if (src->exportToWkt(&srcWkt) == OGRERR_NONE && dst->exportToWkt(&dstWkt) == OGRERR_NONE)
+    reprojection = GDALCreateReprojectionTransformer(srcWkt, dstWkt);
+  CPLFree(srcWkt);
+  CPLFree(dstWkt);
+#endif
+  if (reprojection == nullptr) throw "Failed creating the reprojection transformer";
+  if (maxError == 0) return reprojection;
+
+  void *approx = GDALCreateApproxTransformer(GDALReprojectionTransform, reprojection, maxError);
+  if (approx == nullptr) {
+    GDALDestroyReprojectionTransformer(reprojection);
+    throw "Failed creating the approximate transformer";
+  }
+  GDALApproxTransformerOwnsSubtransformer(approx, TRUE);
+  return approx;
+}
+
+void *SharedApproxTransformer::acquire() {
+  // The spatial references are not reentrant, the transformers are created under the lock
+  std::lock_guard<std::mutex> guard(lock);
+  if (!idle.empty()) {
+    void *transformer = idle.back();
+    idle.pop_back();
+    return transformer;
+  }
+  return create();
+}
+
+void SharedApproxTransformer::release(void *transformer) {
+  std::lock_guard<std::mutex> guard(lock);
+  idle.push_back(transformer);
+}
+
+void SharedApproxTransformer::transformGrid(
+  const double *gt, int width, int height, bool center, double *xs, double *ys, GByte *success, int threads) {
+  const double offset = center ? 0.5 : 0;
+
+  parallelFor(height, threads, [this, gt, width, offset, xs, ys, success](size_t begin, size_t end) {
+    void *transformer = acquire();
+    std::vector<double> z(width);
+    std::vector<int> ok(width);
+    for (size_t row = begin; row < end; row++) {
+      double *x = xs + row * width, *y = ys + row * width;
+      const double line = row + offset;
+      for (int col = 0; col < width; col++) {
+        const double pixel = col + offset;
+        x[col] = gt[0] + pixel * gt[1] + line * gt[2];
+        y[col] = gt[3] + pixel * gt[4] + line * gt[5];
+      }
+      std::fill(z.begin(), z.end(), 0.0);
+      GDALUseTransformer(transformer, FALSE, width, x, y, z.data(), ok.data());
+      GByte *out = success + row * width;
+      for (int col = 0; col < width; col++) out[col] = ok[col] ? 1 : 0;
+    }
+    release(transformer);
+  });
+}
+
+} // namespace node_gdal
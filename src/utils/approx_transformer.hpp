@@ -0,0 +1,60 @@
+#ifndef __NODE_GDAL_APPROX_TRANSFORMER_H__
+#define __NODE_GDAL_APPROX_TRANSFORMER_H__
+
+// gdal
+#include <gdal_alg.h>
+
+// ogr
+#include <ogr_spatialref.h>
+
+#include <mutex>
+#include <vector>
+
+namespace node_gdal {
+
+// GDAL approximate reprojection transformer
+//
+// Every run of evenly spaced points, such as a row of a grid, is reprojected
+// exactly at its ends and its middle and linearly interpolated in between,
+// the run is split until the interpolation error is below maxError
+// (in target units), maxError 0 uses the exact transformer
+//
+// A transformer cannot be used concurrently, every thread borrows one from
+// the pool and returns it afterwards, they are created on demand from
+// private copies of the spatial references
+class SharedApproxTransformer {
+    public:
+  // Throws const char * on error
+  SharedApproxTransformer(OGRSpatialReference *src, OGRSpatialReference *dst, double maxError);
+  SharedApproxTransformer(const SharedApproxTransformer &) = delete;
+  ~SharedApproxTransformer();
+
+  // Transforms the (width x height) grid of the pixel corners, or of the pixel
+  // centers with center, of a geotransform, the rows can be split across
+  // several threads, success is 1 for every transformed point, 0 otherwise
+  //
+  // Thread-safe, throws const char * on error
+  void transformGrid(
+    const double *geoTransform,
+    int width,
+    int height,
+    bool center,
+    double *xs,
+    double *ys,
+    GByte *success,
+    int threads);
+
+  const double maxError;
+
+    private:
+  void *create();
+  void *acquire();
+  void release(void *transformer);
+
+  OGRSpatialReference *src, *dst;
+  std::mutex lock;
+  std::vector<void *> idle;
+};
+
+} // namespace node_gdal
+#endif
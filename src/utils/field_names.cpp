@@ -0,0 +1,74 @@
+#include "field_names.hpp"
+
+namespace node_gdal {
+
+// The entries are never evicted individually, the whole cache is dropped
+// when it grows beyond this size
+#define FIELD_NAMES_CACHE_MAX 256
+
+std::unordered_map<OGRFeatureDefn *, FieldNames *> FieldNames::cache;
+
+FieldNames::FieldNames(OGRFeatureDefn *defn) : defn(defn), fields(), indices() {
+  build();
+}
+
+void FieldNames::build() {
+  Nan::HandleScope scope;
+  Isolate *isolate = Isolate::GetCurrent();
+
+  fields.clear();
+  indices.clear();
+
+  int n = defn->GetFieldCount();
+  fields.reserve(n);
+  for (int i = 0; i < n; i++) {
+    OGRFieldDefn *field_defn = defn->GetFieldDefn(i);
+    const char *name = field_defn->GetNameRef();
+    Local<String> key = String::NewFromUtf8(isolate, name, NewStringType::kInternalized).ToLocalChecked();
+    // GetFieldIndex returns the first case-insensitive match,
+    // this is what the map must return for duplicate names
+    int index = defn->GetFieldIndex(name);
+    fields.push_back({field_defn, name, Global<String>(isolate, key), index});
+    if (indices.count(name) == 0) indices[name] = index;
+  }
+}
+
+FieldNames *FieldNames::get(OGRFeatureDefn *defn) {
+  auto it = cache.find(defn);
+  if (it != cache.end()) {
+    FieldNames *names = it->second;
+    if (static_cast<int>(names->fields.size()) != defn->GetFieldCount()) names->build();
+    return names;
+  }
+
+  if (cache.size() >= FIELD_NAMES_CACHE_MAX) {
+    for (auto &entry : cache) delete entry.second;
+    cache.clear();
+  }
+  FieldNames *names = new FieldNames(defn);
+  cache[defn] = names;
+  return names;
+}
+
+Local<String> FieldNames::name(int i) {
+  if (i < 0 || i >= static_cast<int>(fields.size())) return Local<String>();
+  if (!isCurrent(i)) build();
+  return fields[i].key.Get(Isolate::GetCurrent());
+}
+
+int FieldNames::index(const char *name) {
+  auto it = indices.find(name);
+  // A miss is either a case-insensitive match or a non-existing field
+  if (it == indices.end()) return defn->GetFieldIndex(name);
+  if (!isCurrent(it->second)) {
+    build();
+    return defn->GetFieldIndex(name);
+  }
+  return it->second;
+}
+
+int FieldNames::getFieldIndex(OGRFeatureDefn *defn, const char *name) {
+  return get(defn)->index(name);
+}
+
+} // namespace node_gdal
@@ -0,0 +1,70 @@
+#ifndef __NODE_GDAL_FIELD_NAMES_H__
+#define __NODE_GDAL_FIELD_NAMES_H__
+
+// node
+#include <node.h>
+
+// nan
+#include "../nan-wrapper.h"
+
+// ogr
+#include <ogrsf_frmts.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace v8;
+
+namespace node_gdal {
+
+// Per-OGRFeatureDefn cache of the field names
+//
+// Holds internalized V8 strings of the field names and a name->index map
+// so that converting a feature does not create a new V8 string for every
+// field. The cache lives on the main thread only.
+//
+// An entry is checked against the OGRFeatureDefn every time it is used and
+// is rebuilt when the schema has changed, so it never needs to be invalidated
+// explicitly and a recycled OGRFeatureDefn address is harmless.
+class FieldNames {
+    public:
+  static FieldNames *get(OGRFeatureDefn *defn);
+  static int getFieldIndex(OGRFeatureDefn *defn, const char *name);
+  static inline int getFieldIndex(OGRFeature *f, const char *name) {
+    return getFieldIndex(f->GetDefnRef(), name);
+  }
+
+  // Returns an empty handle if the field does not exist
+  Local<String> name(int i);
+  int index(const char *name);
+  // Index returned by GetFieldIndex for the name of the field i
+  // (differs from i only with case-insensitive duplicates), call name(i) first
+  inline int firstIndex(int i) {
+    return fields[i].index;
+  }
+
+    private:
+  struct Field {
+    OGRFieldDefn *defn;
+    std::string name;
+    Global<String> key;
+    int index;
+  };
+
+  FieldNames(OGRFeatureDefn *defn);
+  void build();
+  inline bool isCurrent(int i) {
+    OGRFieldDefn *field_defn = defn->GetFieldDefn(i);
+    return field_defn == fields[i].defn && fields[i].name == field_defn->GetNameRef();
+  }
+
+  OGRFeatureDefn *defn;
+  std::vector<Field> fields;
+  std::unordered_map<std::string, int> indices;
+
+  static std::unordered_map<OGRFeatureDefn *, FieldNames *> cache;
+};
+
+} // namespace node_gdal
+#endif
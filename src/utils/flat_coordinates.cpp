@@ -0,0 +1,262 @@
+#include "flat_coordinates.hpp"
+#include "typed_array.hpp"
+
+#include <limits>
+
+namespace node_gdal {
+
+FlatCoordinates::FlatCoordinates(int dims) : dims(dims), coordinates(), offsets() {
+}
+
+int FlatCoordinates::Dims(OGRGeometry *geom) {
+  return geom->IsMeasured() ? 4 : geom->Is3D() ? 3 : 2;
+}
+
+int FlatCoordinates::Levels(OGRwkbGeometryType type) {
+  switch (wkbFlatten(type)) {
+    case wkbPoint:
+    case wkbLineString:
+    case wkbMultiPoint: return 0;
+    case wkbPolygon:
+    case wkbMultiLineString: return 1;
+    case wkbMultiPolygon: return 2;
+    default: return -1;
+  }
+}
+
+void FlatCoordinates::addCurve(OGRSimpleCurve *curve) {
+  const size_t n = curve->getNumPoints();
+  if (size() + n > std::numeric_limits<uint32_t>::max() / dims) throw "Too many points";
+  double *out = reinterpret_cast<double *>(coordinates.grow(n * dims * sizeof(double)));
+  // GDAL fills the missing Z and M with 0
+  const int stride = dims * sizeof(double);
+  curve->getPoints(
+    out, stride, out + 1, stride, dims > 2 ? out + 2 : nullptr, stride, dims > 3 ? out + 3 : nullptr, stride);
+}
+
+void FlatCoordinates::addPolygon(OGRPolygon *polygon, size_t level) {
+  for (OGRLinearRing *ring : *polygon) {
+    addCurve(ring);
+    offsets[level].push<uint32_t>(size());
+  }
+}
+
+void FlatCoordinates::add(OGRGeometry *geom) {
+  const OGRwkbGeometryType type = wkbFlatten(geom->getGeometryType());
+  const int levels = Levels(type);
+  if (levels < 0) throw "Only Point, LineString, Polygon, MultiPoint, MultiLineString and MultiPolygon are supported";
+
+  offsets.clear();
+  for (int i = 0; i < levels; i++) {
+    offsets.emplace_back();
+    offsets.back().push<uint32_t>(0);
+  }
+
+  switch (type) {
+    case wkbPoint: {
+      OGRPoint *point = geom->toPoint();
+      if (point->IsEmpty()) break;
+      double *out = reinterpret_cast<double *>(coordinates.grow(dims * sizeof(double)));
+      out[0] = point->getX();
+      out[1] = point->getY();
+      if (dims > 2) out[2] = point->getZ();
+      if (dims > 3) out[3] = point->getM();
+      break;
+    }
+    case wkbLineString: addCurve(geom->toSimpleCurve()); break;
+    case wkbPolygon: addPolygon(geom->toPolygon(), 0); break;
+    case wkbMultiPoint:
+      for (OGRPoint *point : *geom->toMultiPoint()) {
+        if (point->IsEmpty()) throw "MultiPoints with empty points are not supported";
+        double *out = reinterpret_cast<double *>(coordinates.grow(dims * sizeof(double)));
+        out[0] = point->getX();
+        out[1] = point->getY();
+        if (dims > 2) out[2] = point->getZ();
+        if (dims > 3) out[3] = point->getM();
+      }
+      break;
+    case wkbMultiLineString:
+      for (OGRLineString *line : *geom->toMultiLineString()) {
+        addCurve(line);
+        offsets[0].push<uint32_t>(size());
+      }
+      break;
+    case wkbMultiPolygon:
+      for (OGRPolygon *polygon : *geom->toMultiPolygon()) {
+        addPolygon(polygon, 1);
+        offsets[0].push<uint32_t>(static_cast<uint32_t>(offsets[1].size / sizeof(uint32_t) - 1));
+      }
+      break;
+    default: break;
+  }
+}
+
+void FlatCoordinates::Import(OGRSimpleCurve *curve, int dims, const double *xy, size_t count) {
+  if (count > static_cast<size_t>(std::numeric_limits<int>::max())) throw "Too many points";
+  const int n = static_cast<int>(count);
+
+  curve->set3D(dims > 2);
+  curve->setMeasured(dims > 3);
+  if (dims == 2) {
+    // OGRRawPoint has the same layout as interleaved XY
+    curve->setPoints(n, reinterpret_cast<const OGRRawPoint *>(xy));
+    return;
+  }
+
+  std::vector<double> x(count), y(count), z(count), m(dims > 3 ? count : 0);
+  for (size_t i = 0; i < count; i++) {
+    const double *p = xy + i * dims;
+    x[i] = p[0];
+    y[i] = p[1];
+    z[i] = p[2];
+    if (dims > 3) m[i] = p[3];
+  }
+  curve->setPoints(n, x.data(), y.data(), z.data(), dims > 3 ? m.data() : nullptr);
+}
+
+static OGRPoint *importPoint(int dims, const double *p) {
+  OGRPoint *point = new OGRPoint(p[0], p[1]);
+  if (dims > 2) point->setZ(p[2]);
+  if (dims > 3) point->setM(p[3]);
+  return point;
+}
+
+static OGRPolygon *importPolygon(
+  int dims, const double *xy, const std::vector<uint32_t> &rings, size_t begin, size_t end, OGRPolygon *polygon) {
+  polygon->set3D(dims > 2);
+  polygon->setMeasured(dims > 3);
+  for (size_t r = begin; r < end; r++) {
+    OGRLinearRing *ring = new OGRLinearRing();
+    FlatCoordinates::Import(ring, dims, xy + static_cast<size_t>(rings[r]) * dims, rings[r + 1] - rings[r]);
+    polygon->addRingDirectly(ring);
+  }
+  return polygon;
+}
+
+void FlatCoordinates::Import(
+  OGRGeometry *geom, int dims, const double *xy, size_t count, const std::vector<std::vector<uint32_t>> &offsets) {
+  const OGRwkbGeometryType type = wkbFlatten(geom->getGeometryType());
+  const int levels = Levels(type);
+  if (levels < 0) throw "Only Point, LineString, Polygon, MultiPoint, MultiLineString and MultiPolygon are supported";
+  if (static_cast<size_t>(levels) != offsets.size()) throw "Wrong number of offset arrays for this geometry type";
+
+  // Every level must start at 0, never decrease and end at the size of the next one
+  for (size_t l = 0; l < offsets.size(); l++) {
+    const std::vector<uint32_t> &level = offsets[l];
+    const size_t next = l + 1 < offsets.size() ? offsets[l + 1].size() - 1 : count;
+    if (level.empty() || level.front() != 0 || level.back() != next) throw "Invalid offsets";
+    for (size_t i = 1; i < level.size(); i++)
+      if (level[i] < level[i - 1]) throw "Invalid offsets";
+  }
+  if (type == wkbPoint && count > 1) throw "A Point cannot have more than one coordinate";
+
+  geom->empty();
+  geom->set3D(dims > 2);
+  geom->setMeasured(dims > 3);
+  switch (type) {
+    case wkbPoint: {
+      if (count == 0) break;
+      OGRPoint *point = geom->toPoint();
+      point->setX(xy[0]);
+      point->setY(xy[1]);
+      if (dims > 2) point->setZ(xy[2]);
+      if (dims > 3) point->setM(xy[3]);
+      break;
+    }
+    case wkbLineString: Import(geom->toSimpleCurve(), dims, xy, count); break;
+    case wkbPolygon: importPolygon(dims, xy, offsets[0], 0, offsets[0].size() - 1, geom->toPolygon()); break;
+    case wkbMultiPoint:
+      for (size_t i = 0; i < count; i++) geom->toMultiPoint()->addGeometryDirectly(importPoint(dims, xy + i * dims));
+      break;
+    case wkbMultiLineString: {
+      const std::vector<uint32_t> &lines = offsets[0];
+      for (size_t i = 0; i + 1 < lines.size(); i++) {
+        OGRLineString *line = new OGRLineString();
+        Import(line, dims, xy + static_cast<size_t>(lines[i]) * dims, lines[i + 1] - lines[i]);
+        geom->toMultiLineString()->addGeometryDirectly(line);
+      }
+      break;
+    }
+    case wkbMultiPolygon: {
+      const std::vector<uint32_t> &polygons = offsets[0];
+      for (size_t i = 0; i + 1 < polygons.size(); i++) {
+        geom->toMultiPolygon()->addGeometryDirectly(
+          importPolygon(dims, xy, offsets[1], polygons[i], polygons[i + 1], new OGRPolygon()));
+      }
+      break;
+    }
+    default: break;
+  }
+}
+
+Local<Value> FlatCoordinates::ToObject() {
+  Nan::EscapableHandleScope scope;
+
+  Local<Object> obj = Nan::New<Object>();
+  size_t length = coordinates.size / sizeof(double);
+  Nan::Set(
+    obj,
+    Nan::New("coordinates").ToLocalChecked(),
+    TypedArray::Adopt(GDT_Float64, coordinates.release(), static_cast<unsigned int>(length)));
+  Local<Array> levels = Nan::New<Array>(static_cast<int>(offsets.size()));
+  for (size_t i = 0; i < offsets.size(); i++) {
+    length = offsets[i].size / sizeof(uint32_t);
+    Nan::Set(levels, i, TypedArray::Adopt(GDT_UInt32, offsets[i].release(), static_cast<unsigned int>(length)));
+  }
+  Nan::Set(obj, Nan::New("offsets").ToLocalChecked(), levels);
+  Nan::Set(obj, Nan::New("dims").ToLocalChecked(), Nan::New<Integer>(dims));
+
+  return scope.Escape(obj);
+}
+
+bool FlatCoordinates::ParseDims(Local<Value> options, int &dims) {
+  if (options->IsUndefined() || options->IsNull()) return true;
+  if (!options->IsObject()) {
+    Nan::ThrowTypeError("options must be an object");
+    return false;
+  }
+  Local<Value> val = Nan::Get(options.As<Object>(), Nan::New("dims").ToLocalChecked()).ToLocalChecked();
+  if (val->IsUndefined() || val->IsNull()) return true;
+  if (!val->IsInt32() || Nan::To<int32_t>(val).ToChecked() < 2 || Nan::To<int32_t>(val).ToChecked() > 4) {
+    Nan::ThrowRangeError("dims must be 2, 3 or 4");
+    return false;
+  }
+  dims = Nan::To<int32_t>(val).ToChecked();
+  return true;
+}
+
+bool FlatCoordinates::ParseCoordinates(Local<Value> val, int dims, const double *&xy, size_t &count) {
+  if (!val->IsFloat64Array()) {
+    Nan::ThrowTypeError("coordinates must be a Float64Array");
+    return false;
+  }
+  Nan::TypedArrayContents<double> contents(val);
+  if (contents.length() % dims != 0) {
+    Nan::ThrowRangeError("The length of coordinates must be a multiple of dims");
+    return false;
+  }
+  xy = *contents;
+  count = contents.length() / dims;
+  return true;
+}
+
+bool FlatCoordinates::ParseOffsets(Local<Value> val, std::vector<std::vector<uint32_t>> &offsets) {
+  if (val->IsUndefined() || val->IsNull()) return true;
+  if (!val->IsArray()) {
+    Nan::ThrowTypeError("offsets must be an array of Uint32Array");
+    return false;
+  }
+  Local<Array> array = val.As<Array>();
+  for (uint32_t i = 0; i < array->Length(); i++) {
+    Local<Value> level = Nan::Get(array, i).ToLocalChecked();
+    if (!level->IsUint32Array()) {
+      Nan::ThrowTypeError("offsets must be an array of Uint32Array");
+      return false;
+    }
+    Nan::TypedArrayContents<uint32_t> contents(level);
+    offsets.emplace_back(*contents, *contents + contents.length());
+  }
+  return true;
+}
+
+} // namespace node_gdal
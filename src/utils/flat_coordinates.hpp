@@ -0,0 +1,69 @@
+#ifndef __NODE_GDAL_FLAT_COORDINATES_H__
+#define __NODE_GDAL_FLAT_COORDINATES_H__
+
+// node
+#include <node.h>
+
+// nan
+#include "../nan-wrapper.h"
+
+// ogr
+#include <ogrsf_frmts.h>
+
+#include <vector>
+
+#include "layer_columns.hpp"
+
+using namespace v8;
+
+namespace node_gdal {
+
+// Flat representation of the coordinates of a geometry, the same as GeoArrow
+//
+// coordinates: interleaved XY, XYZ or XYZM
+// offsets: one Uint32Array per nesting level, the outermost first, each one
+//   has one more element than the number of items of its level and points
+//   into the next level or into the coordinates for the last one
+//
+// Point, LineString      []
+// MultiPoint             []
+// Polygon                [ rings ]
+// MultiLineString        [ lines ]
+// MultiPolygon           [ polygons, rings ]
+class FlatCoordinates {
+    public:
+  FlatCoordinates(int dims);
+
+  // 2, 3 or 4, measured geometries without Z get a zero Z
+  static int Dims(OGRGeometry *geom);
+  // Returns the number of nesting levels or -1 if the type is not supported
+  static int Levels(OGRwkbGeometryType type);
+
+  // Worker thread safe, throw const char * on error
+  void add(OGRGeometry *geom);
+  void addCurve(OGRSimpleCurve *curve);
+  static void Import(OGRSimpleCurve *curve, int dims, const double *xy, size_t count);
+  // The geometry is emptied first, the offsets must match its type
+  static void Import(
+    OGRGeometry *geom, int dims, const double *xy, size_t count, const std::vector<std::vector<uint32_t>> &offsets);
+
+  // { coordinates: Float64Array, offsets: Uint32Array[], dims: number }
+  Local<Value> ToObject();
+  // JS arguments, return false after throwing an exception
+  static bool ParseDims(Local<Value> options, int &dims);
+  static bool ParseCoordinates(Local<Value> val, int dims, const double *&xy, size_t &count);
+  static bool ParseOffsets(Local<Value> val, std::vector<std::vector<uint32_t>> &offsets);
+
+  int dims;
+  ColumnBuffer coordinates;
+  std::vector<ColumnBuffer> offsets;
+
+    private:
+  void addPolygon(OGRPolygon *polygon, size_t level);
+  inline uint32_t size() {
+    return static_cast<uint32_t>(coordinates.size / (dims * sizeof(double)));
+  }
+};
+
+} // namespace node_gdal
+#endif
@@ -0,0 +1,284 @@
+#include "geojson_writer.hpp"
+#include "../gdal_memfile.hpp"
+
+#include <cmath>
+#include <cpl_string.h>
+#include <ogr_api.h>
+
+namespace node_gdal {
+
+GeoJSONWriter::GeoJSONWriter(const GeoJSONOptions &options)
+  : count(0), options(options), out(), fields(), keys(), transform(nullptr, nullptr), exportOptions() {
+  int precision = options.precision;
+  // RFC 7946 recommends 6 decimals, GDAL uses 7 when writing RFC 7946 files
+  if (precision < 0 && options.rfc7946) precision = 7;
+  if (precision >= 0) exportOptions.SetNameValue("COORDINATE_PRECISION", CPLSPrintf("%d", precision));
+}
+
+void GeoJSONWriter::resolveFields(OGRFeatureDefn *defn) {
+  if (options.allFields) {
+    for (int i = 0; i < defn->GetFieldCount(); i++) fields.push_back(i);
+  } else {
+    for (const std::string &name : options.fields) {
+      int i = defn->GetFieldIndex(name.c_str());
+      if (i < 0) {
+        CPLError(CE_Failure, CPLE_AppDefined, "Invalid field name: %s", name.c_str());
+        throw CPLGetLastErrorMsg();
+      }
+      fields.push_back(i);
+    }
+  }
+
+  // The property keys are serialized only once
+  for (int i : fields) {
+    out.size = 0;
+    writeString(defn->GetFieldDefn(i)->GetNameRef());
+    writeRaw(":", 1);
+    keys.push_back(std::string(reinterpret_cast<char *>(out.get()), out.size));
+  }
+  out.size = 0;
+}
+
+// RFC 7946 mandates WGS84 longitude/latitude
+void GeoJSONWriter::initTransform(OGRLayer *layer) {
+  OGRSpatialReference *srs = layer->GetSpatialRef();
+  if (!options.rfc7946 || srs == nullptr) return;
+
+  OGRSpatialReference wgs84;
+  wgs84.SetWellKnownGeogCS("WGS84");
+#if GDAL_VERSION_MAJOR >= 3
+  wgs84.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+#endif
+  if (srs->IsSame(&wgs84)) return;
+
+  transform = std::unique_ptr<OGRCoordinateTransformation, void (*)(OGRCoordinateTransformation *)>(
+    OGRCreateCoordinateTransformation(srs, &wgs84), OGRCoordinateTransformation::DestroyCT);
+  if (transform == nullptr) throw "Failed creating a transformation to WGS84";
+}
+
+void GeoJSONWriter::read(OGRLayer *layer) {
+  resolveFields(layer->GetLayerDefn());
+  initTransform(layer);
+
+  if (options.reset) layer->ResetReading();
+  while (out.size < options.chunkSize) {
+    OGRFeature *feature = layer->GetNextFeature();
+    if (feature == nullptr) break;
+    try {
+      if (count > 0 && !options.newlineDelimited) writeRaw(",\n", 2);
+      writeFeature(feature);
+      if (options.newlineDelimited) writeRaw("\n", 1);
+    } catch (const char *) {
+      OGRFeature::DestroyFeature(feature);
+      throw;
+    }
+    OGRFeature::DestroyFeature(feature);
+    count++;
+  }
+}
+
+Local<Value> GeoJSONWriter::ToBuffer() {
+  Nan::EscapableHandleScope scope;
+  if (count == 0) return scope.Escape(Nan::Null());
+  size_t len = out.size;
+  return scope.Escape(Memfile::NewBuffer(static_cast<GByte *>(out.release()), len));
+}
+
+void GeoJSONWriter::writeFeature(OGRFeature *feature) {
+  writeRaw("{\"type\":\"Feature\"");
+  GIntBig fid = feature->GetFID();
+  if (fid != OGRNullFID) writeRaw(CPLSPrintf(",\"id\":" CPL_FRMT_GIB, fid));
+
+  writeRaw(",\"properties\":{");
+  for (size_t i = 0; i < fields.size(); i++) {
+    if (i > 0) writeRaw(",", 1);
+    writeRaw(keys[i].c_str(), keys[i].size());
+    writeField(feature, fields[i], feature->GetFieldDefnRef(fields[i]));
+  }
+  writeRaw("},\"geometry\":");
+  writeGeometry(feature->GetGeometryRef());
+  writeRaw("}", 1);
+}
+
+// ISO 8601, same as the GDAL GeoJSON driver
+static std::string formatDate(const OGRField *raw, OGRFieldType type) {
+  int second = static_cast<int>(raw->Date.Second);
+  int ms = static_cast<int>(std::round((raw->Date.Second - second) * 1000));
+  if (ms >= 1000) ms = 999;
+  std::string r;
+
+  if (type != OFTTime) r += CPLSPrintf("%04d-%02d-%02d", raw->Date.Year, raw->Date.Month, raw->Date.Day);
+  if (type == OFTDateTime) r += "T";
+  if (type != OFTDate) {
+    r += CPLSPrintf("%02d:%02d:%02d", raw->Date.Hour, raw->Date.Minute, second);
+    if (ms > 0) r += CPLSPrintf(".%03d", ms);
+  }
+  // 0 is unknown, 1 is local time, 100 is GMT, every step is 15 minutes
+  if (type == OFTDateTime && raw->Date.TZFlag == 100) r += "Z";
+  if (type == OFTDateTime && raw->Date.TZFlag > 1 && raw->Date.TZFlag != 100) {
+    int offset = (raw->Date.TZFlag - 100) * 15;
+    r += CPLSPrintf("%c%02d:%02d", offset < 0 ? '-' : '+', std::abs(offset) / 60, std::abs(offset) % 60);
+  }
+  return r;
+}
+
+void GeoJSONWriter::writeField(OGRFeature *feature, int i, OGRFieldDefn *field_defn) {
+  if (!feature->IsFieldSetAndNotNull(i)) {
+    writeRaw("null", 4);
+    return;
+  }
+
+  const OGRField *raw = feature->GetRawFieldRef(i);
+  switch (field_defn->GetType()) {
+    case OFTInteger:
+      if (field_defn->GetSubType() == OFSTBoolean)
+        writeRaw(raw->Integer ? "true" : "false");
+      else
+        writeRaw(CPLSPrintf("%d", raw->Integer));
+      break;
+    case OFTInteger64: writeRaw(CPLSPrintf(CPL_FRMT_GIB, raw->Integer64)); break;
+    case OFTReal: writeDouble(raw->Real); break;
+    case OFTString: writeString(raw->String); break;
+    case OFTIntegerList:
+      writeRaw("[", 1);
+      for (int j = 0; j < raw->IntegerList.nCount; j++) {
+        if (j > 0) writeRaw(",", 1);
+        writeRaw(CPLSPrintf("%d", raw->IntegerList.paList[j]));
+      }
+      writeRaw("]", 1);
+      break;
+    case OFTInteger64List:
+      writeRaw("[", 1);
+      for (int j = 0; j < raw->Integer64List.nCount; j++) {
+        if (j > 0) writeRaw(",", 1);
+        writeRaw(CPLSPrintf(CPL_FRMT_GIB, raw->Integer64List.paList[j]));
+      }
+      writeRaw("]", 1);
+      break;
+    case OFTRealList:
+      writeRaw("[", 1);
+      for (int j = 0; j < raw->RealList.nCount; j++) {
+        if (j > 0) writeRaw(",", 1);
+        writeDouble(raw->RealList.paList[j]);
+      }
+      writeRaw("]", 1);
+      break;
+    case OFTStringList:
+      writeRaw("[", 1);
+      for (int j = 0; j < raw->StringList.nCount; j++) {
+        if (j > 0) writeRaw(",", 1);
+        writeString(raw->StringList.paList[j]);
+      }
+      writeRaw("]", 1);
+      break;
+    case OFTBinary: {
+      // Same as the GDAL GeoJSON driver
+      char *base64 = CPLBase64Encode(raw->Binary.nCount, raw->Binary.paData);
+      writeString(base64);
+      CPLFree(base64);
+      break;
+    }
+    case OFTDate:
+    case OFTTime:
+    case OFTDateTime: writeString(formatDate(raw, field_defn->GetType()).c_str()); break;
+    default: throw "Unsupported field type";
+  }
+}
+
+// Polygons must follow the right-hand rule in RFC 7946:
+// counterclockwise exterior rings and clockwise holes
+static void orientRings(OGRGeometry *geom) {
+  switch (wkbFlatten(geom->getGeometryType())) {
+    case wkbPolygon: {
+      OGRPolygon *poly = static_cast<OGRPolygon *>(geom);
+      OGRLinearRing *exterior = poly->getExteriorRing();
+      if (exterior == nullptr) return;
+      if (exterior->isClockwise()) exterior->reverseWindingOrder();
+      for (int i = 0; i < poly->getNumInteriorRings(); i++) {
+        OGRLinearRing *ring = poly->getInteriorRing(i);
+        if (!ring->isClockwise()) ring->reverseWindingOrder();
+      }
+      break;
+    }
+    case wkbMultiPolygon:
+    case wkbGeometryCollection: {
+      OGRGeometryCollection *coll = static_cast<OGRGeometryCollection *>(geom);
+      for (int i = 0; i < coll->getNumGeometries(); i++) orientRings(coll->getGeometryRef(i));
+      break;
+    }
+    default: break;
+  }
+}
+
+void GeoJSONWriter::writeGeometry(OGRGeometry *geom) {
+  if (geom == nullptr) {
+    writeRaw("null", 4);
+    return;
+  }
+
+  std::unique_ptr<OGRGeometry> owned;
+  if (options.rfc7946) {
+    owned.reset(geom->hasCurveGeometry() ? geom->getLinearGeometry() : geom->clone());
+    if (transform != nullptr && owned->transform(transform.get()) != OGRERR_NONE)
+      throw "Failed reprojecting a geometry to WGS84";
+    orientRings(owned.get());
+    geom = owned.get();
+  }
+
+  char *json = OGR_G_ExportToJsonEx(reinterpret_cast<OGRGeometryH>(geom), exportOptions.List());
+  if (json == nullptr) throw "Failed exporting a geometry to GeoJSON";
+  writeRaw(json);
+  CPLFree(json);
+}
+
+void GeoJSONWriter::writeDouble(double v) {
+  // NaN and Infinity are not valid JSON
+  if (!std::isfinite(v)) {
+    writeRaw("null", 4);
+    return;
+  }
+  // The shortest of 15 or 17 significant digits that round-trips
+  char buf[64];
+  CPLsnprintf(buf, sizeof(buf), "%.15g", v);
+  if (CPLAtof(buf) != v) CPLsnprintf(buf, sizeof(buf), "%.17g", v);
+  writeRaw(buf);
+}
+
+void GeoJSONWriter::writeString(const char *str) {
+  // Strings not in UTF-8 are assumed to be in ISO-8859-1
+  char *recoded = nullptr;
+  if (!CPLIsUTF8(str, -1)) {
+    recoded = CPLRecode(str, CPL_ENC_ISO8859_1, CPL_ENC_UTF8);
+    str = recoded;
+  }
+
+  writeRaw("\"", 1);
+  const char *start = str;
+  for (const char *p = str; *p; p++) {
+    unsigned char c = static_cast<unsigned char>(*p);
+    if (c >= 0x20 && c != '"' && c != '\\') continue;
+    writeRaw(start, p - start);
+    switch (c) {
+      case '"': writeRaw("\\\"", 2); break;
+      case '\\': writeRaw("\\\\", 2); break;
+      case '\b': writeRaw("\\b", 2); break;
+      case '\f': writeRaw("\\f", 2); break;
+      case '\n': writeRaw("\\n", 2); break;
+      case '\r': writeRaw("\\r", 2); break;
+      case '\t': writeRaw("\\t", 2); break;
+      default: writeRaw(CPLSPrintf("\\u%04x", c), 6);
+    }
+    start = p + 1;
+  }
+  writeRaw(start, strlen(start));
+  writeRaw("\"", 1);
+
+  CPLFree(recoded);
+}
+
+void GeoJSONWriter::writeRaw(const char *str, size_t len) {
+  if (len == 0) return;
+  memcpy(out.grow(len), str, len);
+}
+
+} // namespace node_gdal
@@ -0,0 +1,73 @@
+#ifndef __NODE_GDAL_GEOJSON_WRITER_H__
+#define __NODE_GDAL_GEOJSON_WRITER_H__
+
+// node
+#include <node.h>
+
+// nan
+#include "../nan-wrapper.h"
+
+// ogr
+#include <ogrsf_frmts.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "layer_columns.hpp"
+
+using namespace v8;
+
+namespace node_gdal {
+
+struct GeoJSONOptions {
+  std::vector<std::string> fields;
+  bool allFields;
+  // Coordinate precision, -1 for the GDAL default
+  int precision;
+  bool rfc7946;
+  bool newlineDelimited;
+  size_t chunkSize;
+  bool reset;
+};
+
+// Serializes the features of a layer to GeoJSON directly from OGRFeature
+// into a VSIMalloc-allocated buffer that is handed over to JS as a Buffer
+//
+// The features are separated by ",\n" or by "\n" when newline-delimited,
+// the FeatureCollection header and footer are left to the caller
+class GeoJSONWriter {
+    public:
+  GeoJSONWriter(const GeoJSONOptions &options);
+
+  // Worker thread, throws const char * on error
+  // Reads features until the chunk size is reached or the layer is exhausted
+  void read(OGRLayer *layer);
+  // Returns null if no features were read
+  Local<Value> ToBuffer();
+
+  size_t count;
+
+    private:
+  void resolveFields(OGRFeatureDefn *defn);
+  void initTransform(OGRLayer *layer);
+  void writeFeature(OGRFeature *feature);
+  void writeField(OGRFeature *feature, int i, OGRFieldDefn *field_defn);
+  void writeGeometry(OGRGeometry *geom);
+  void writeString(const char *str);
+  void writeRaw(const char *str, size_t len);
+  inline void writeRaw(const char *str) {
+    writeRaw(str, strlen(str));
+  }
+  void writeDouble(double v);
+
+  GeoJSONOptions options;
+  ColumnBuffer out;
+  std::vector<int> fields;
+  std::vector<std::string> keys;
+  std::unique_ptr<OGRCoordinateTransformation, void (*)(OGRCoordinateTransformation *)> transform;
+  CPLStringList exportOptions;
+};
+
+} // namespace node_gdal
+#endif
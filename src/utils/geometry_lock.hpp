@@ -0,0 +1,36 @@
+#ifndef __NODE_GDAL_GEOMETRY_LOCK_H__
+#define __NODE_GDAL_GEOMETRY_LOCK_H__
+
+// node
+#include <uv.h>
+
+// ogr
+#include <ogrsf_frmts.h>
+
+namespace node_gdal {
+
+// A geometry owned by a JS object and its async lock, the lock must be held
+// while the geometry is accessed from a worker thread as JS can modify it
+// at any moment, both are nullptr for a missing geometry
+struct LockedGeometry {
+  OGRGeometry *geom;
+  uv_sem_t *lock;
+};
+
+// Holds the lock of a geometry for its lifetime
+class GeometryGuard {
+    public:
+  GeometryGuard(const LockedGeometry &locked) : lock(locked.lock) {
+    if (lock != nullptr) uv_sem_wait(lock);
+  }
+  GeometryGuard(const GeometryGuard &) = delete;
+  ~GeometryGuard() {
+    if (lock != nullptr) uv_sem_post(lock);
+  }
+
+    private:
+  uv_sem_t *lock;
+};
+
+} // namespace node_gdal
+#endif
@@ -0,0 +1,244 @@
+#include "geometry_object.hpp"
+
+#include <string>
+
+namespace node_gdal {
+
+static const struct {
+  OGRwkbGeometryType type;
+  const char *name;
+} geoJSONTypes[] = {
+  {wkbPoint, "Point"},
+  {wkbLineString, "LineString"},
+  {wkbPolygon, "Polygon"},
+  {wkbMultiPoint, "MultiPoint"},
+  {wkbMultiLineString, "MultiLineString"},
+  {wkbMultiPolygon, "MultiPolygon"},
+  {wkbGeometryCollection, "GeometryCollection"}};
+
+static const char *geoJSONName(OGRwkbGeometryType type) {
+  for (const auto &t : geoJSONTypes)
+    if (t.type == type) return t.name;
+  return nullptr;
+}
+
+GeometryToObject::GeometryToObject(OGRGeometry *geom)
+  : type(wkbFlatten(geom->getGeometryType())), coords(geom->Is3D() ? 3 : 2), children() {
+  // GeoJSON has only linear geometries
+  std::unique_ptr<OGRGeometry> linear;
+  if (geom->hasCurveGeometry()) {
+    linear.reset(geom->getLinearGeometry());
+  } else if (type == wkbTriangle) {
+    linear.reset(OGRGeometryFactory::forceToPolygon(geom->clone()));
+  } else if (type == wkbPolyhedralSurface || type == wkbTIN) {
+    linear.reset(OGRGeometryFactory::forceToMultiPolygon(geom->clone()));
+  }
+  if (linear) {
+    geom = linear.get();
+    type = wkbFlatten(geom->getGeometryType());
+  }
+  // GeoJSON has no empty positions, the empty points of a MultiPoint are skipped
+  if (type == wkbMultiPoint) {
+    bool hasEmpty = false;
+    for (OGRPoint *point : *geom->toMultiPoint()) hasEmpty = hasEmpty || point->IsEmpty();
+    if (hasEmpty) {
+      OGRMultiPoint *points = new OGRMultiPoint();
+      points->set3D(geom->Is3D());
+      for (OGRPoint *point : *geom->toMultiPoint())
+        if (!point->IsEmpty()) points->addGeometry(point);
+      linear.reset(points);
+      geom = points;
+    }
+  }
+
+  if (geoJSONName(type) == nullptr) throw "Geometry type not supported by GeoJSON";
+  if (type == wkbGeometryCollection) {
+    for (OGRGeometry *child : *geom->toGeometryCollection()) children.emplace_back(new GeometryToObject(child));
+    return;
+  }
+  coords.add(geom);
+}
+
+Local<Value> GeometryToObject::position(uint32_t i) {
+  const double *p = reinterpret_cast<double *>(coords.coordinates.get()) + static_cast<size_t>(i) * coords.dims;
+  Local<Array> r = Nan::New<Array>(coords.dims);
+  for (int d = 0; d < coords.dims; d++) Nan::Set(r, d, Nan::New<Number>(p[d]));
+  return r;
+}
+
+Local<Array> GeometryToObject::positions(uint32_t begin, uint32_t end) {
+  Local<Array> r = Nan::New<Array>(end - begin);
+  for (uint32_t i = begin; i < end; i++) Nan::Set(r, i - begin, position(i));
+  return r;
+}
+
+Local<Array> GeometryToObject::lines(const uint32_t *offsets, uint32_t begin, uint32_t end) {
+  Local<Array> r = Nan::New<Array>(end - begin);
+  for (uint32_t i = begin; i < end; i++) Nan::Set(r, i - begin, positions(offsets[i], offsets[i + 1]));
+  return r;
+}
+
+Local<Value> GeometryToObject::ToObject(bool flat) {
+  Nan::EscapableHandleScope scope;
+
+  Local<Object> obj;
+  if (type == wkbGeometryCollection) {
+    obj = Nan::New<Object>();
+    Local<Array> geometries = Nan::New<Array>(static_cast<int>(children.size()));
+    for (size_t i = 0; i < children.size(); i++) Nan::Set(geometries, i, children[i]->ToObject(flat));
+    Nan::Set(obj, Nan::New("geometries").ToLocalChecked(), geometries);
+  } else if (flat) {
+    obj = coords.ToObject().As<Object>();
+  } else {
+    obj = Nan::New<Object>();
+    const uint32_t count = static_cast<uint32_t>(coords.coordinates.size / (coords.dims * sizeof(double)));
+    const uint32_t *outer =
+      coords.offsets.size() > 0 ? reinterpret_cast<uint32_t *>(coords.offsets[0].get()) : nullptr;
+    const uint32_t outerCount =
+      coords.offsets.size() > 0 ? static_cast<uint32_t>(coords.offsets[0].size / sizeof(uint32_t) - 1) : 0;
+    Local<Value> coordinates;
+    switch (type) {
+      case wkbPoint: coordinates = count > 0 ? position(0) : Nan::New<Array>(0).As<Value>(); break;
+      case wkbLineString:
+      case wkbMultiPoint: coordinates = positions(0, count); break;
+      case wkbPolygon:
+      case wkbMultiLineString: coordinates = lines(outer, 0, outerCount); break;
+      case wkbMultiPolygon: {
+        const uint32_t *rings = reinterpret_cast<uint32_t *>(coords.offsets[1].get());
+        Local<Array> polygons = Nan::New<Array>(outerCount);
+        for (uint32_t i = 0; i < outerCount; i++) Nan::Set(polygons, i, lines(rings, outer[i], outer[i + 1]));
+        coordinates = polygons;
+        break;
+      }
+      default: coordinates = Nan::Null(); break;
+    }
+    Nan::Set(obj, Nan::New("coordinates").ToLocalChecked(), coordinates);
+  }
+  Nan::Set(obj, Nan::New("type").ToLocalChecked(), Nan::New(geoJSONName(type)).ToLocalChecked());
+
+  return scope.Escape(obj);
+}
+
+GeometryFromObject::GeometryFromObject(OGRwkbGeometryType type)
+  : type(type), dims(2), hasZ(false), xy(), offsets(), children() {
+}
+
+bool GeometryFromObject::parsePosition(Local<Value> val) {
+  if (!val->IsArray() || val.As<Array>()->Length() < 2) {
+    Nan::ThrowError("Invalid GeoJSON position");
+    return false;
+  }
+  Local<Array> position = val.As<Array>();
+  for (uint32_t d = 0; d < 3; d++) {
+    if (d == 2 && position->Length() < 3) {
+      xy.push_back(0);
+      break;
+    }
+    Local<Value> v = Nan::Get(position, d).ToLocalChecked();
+    if (!v->IsNumber()) {
+      Nan::ThrowError("Invalid GeoJSON position");
+      return false;
+    }
+    xy.push_back(Nan::To<double>(v).ToChecked());
+  }
+  if (position->Length() > 2) hasZ = true;
+  return true;
+}
+
+bool GeometryFromObject::parsePositions(Local<Value> val, size_t level) {
+  if (!val->IsArray()) {
+    Nan::ThrowError("Invalid GeoJSON coordinates");
+    return false;
+  }
+  Local<Array> array = val.As<Array>();
+  for (uint32_t i = 0; i < array->Length(); i++) {
+    Local<Value> item = Nan::Get(array, i).ToLocalChecked();
+    if (level == offsets.size()) {
+      if (!parsePosition(item)) return false;
+      continue;
+    }
+    if (!parsePositions(item, level + 1)) return false;
+    offsets[level].push_back(
+      static_cast<uint32_t>(level + 1 < offsets.size() ? offsets[level + 1].size() - 1 : xy.size() / 3));
+  }
+  return true;
+}
+
+std::unique_ptr<GeometryFromObject> GeometryFromObject::Parse(Local<Value> val) {
+  if (!val->IsObject()) {
+    Nan::ThrowTypeError("geometry must be a GeoJSON geometry object");
+    return nullptr;
+  }
+  Local<Object> obj = val.As<Object>();
+  std::string name = *Nan::Utf8String(Nan::Get(obj, Nan::New("type").ToLocalChecked()).ToLocalChecked());
+  OGRwkbGeometryType type = wkbUnknown;
+  for (const auto &t : geoJSONTypes)
+    if (name == t.name) type = t.type;
+  if (type == wkbUnknown) {
+    Nan::ThrowError(("Unsupported GeoJSON geometry type: " + name).c_str());
+    return nullptr;
+  }
+  std::unique_ptr<GeometryFromObject> r(new GeometryFromObject(type));
+
+  if (type == wkbGeometryCollection) {
+    Local<Value> geometries = Nan::Get(obj, Nan::New("geometries").ToLocalChecked()).ToLocalChecked();
+    if (!geometries->IsArray()) {
+      Nan::ThrowError("geometries must be an array");
+      return nullptr;
+    }
+    for (uint32_t i = 0; i < geometries.As<Array>()->Length(); i++) {
+      std::unique_ptr<GeometryFromObject> child = Parse(Nan::Get(geometries.As<Array>(), i).ToLocalChecked());
+      if (child == nullptr) return nullptr;
+      r->children.push_back(std::move(child));
+    }
+    return r;
+  }
+
+  Local<Value> coordinates = Nan::Get(obj, Nan::New("coordinates").ToLocalChecked()).ToLocalChecked();
+  if (coordinates->IsFloat64Array()) {
+    // Flat mode, the offsets are validated when building the geometry
+    const double *data;
+    size_t count;
+    if (!FlatCoordinates::ParseDims(obj, r->dims)) return nullptr;
+    if (!FlatCoordinates::ParseCoordinates(coordinates, r->dims, data, count)) return nullptr;
+    Local<Value> offsets = Nan::Get(obj, Nan::New("offsets").ToLocalChecked()).ToLocalChecked();
+    if (!FlatCoordinates::ParseOffsets(offsets, r->offsets)) return nullptr;
+    r->xy.assign(data, data + count * r->dims);
+    return r;
+  }
+
+  // Nested arrays, the positions are read as XYZ and compacted to XY if none has a Z
+  for (int i = 0; i < FlatCoordinates::Levels(type); i++) r->offsets.push_back({0});
+  if (type == wkbPoint) {
+    if (!coordinates->IsArray()) {
+      Nan::ThrowError("Invalid GeoJSON coordinates");
+      return nullptr;
+    }
+    if (coordinates.As<Array>()->Length() > 0 && !r->parsePosition(coordinates)) return nullptr;
+  } else if (!r->parsePositions(coordinates, 0)) {
+    return nullptr;
+  }
+  if (r->hasZ) {
+    r->dims = 3;
+  } else {
+    for (size_t i = 0; i < r->xy.size() / 3; i++) {
+      r->xy[i * 2] = r->xy[i * 3];
+      r->xy[i * 2 + 1] = r->xy[i * 3 + 1];
+    }
+    r->xy.resize(r->xy.size() / 3 * 2);
+  }
+  return r;
+}
+
+OGRGeometry *GeometryFromObject::Build() {
+  std::unique_ptr<OGRGeometry> geom(OGRGeometryFactory::createGeometry(type));
+  if (type == wkbGeometryCollection) {
+    for (const std::unique_ptr<GeometryFromObject> &child : children)
+      geom->toGeometryCollection()->addGeometryDirectly(child->Build());
+  } else {
+    FlatCoordinates::Import(geom.get(), dims, xy.data(), xy.size() / dims, offsets);
+  }
+  return geom.release();
+}
+
+} // namespace node_gdal
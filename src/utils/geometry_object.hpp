@@ -0,0 +1,71 @@
+#ifndef __NODE_GDAL_GEOMETRY_OBJECT_H__
+#define __NODE_GDAL_GEOMETRY_OBJECT_H__
+
+// node
+#include <node.h>
+
+// nan
+#include "../nan-wrapper.h"
+
+// ogr
+#include <ogrsf_frmts.h>
+
+#include <memory>
+#include <vector>
+
+#include "flat_coordinates.hpp"
+
+using namespace v8;
+
+namespace node_gdal {
+
+// Conversion between geometries and GeoJSON geometry objects without
+// serializing them to a JSON string
+//
+// The coordinates are first copied to flat arrays in a worker thread safe
+// step, the JS objects are then built or read on the main thread from these
+// arrays, either as nested arrays of positions or, in flat mode, as a single
+// Float64Array with the offsets of FlatCoordinates
+
+class GeometryToObject {
+    public:
+  // Worker thread safe, throws const char * on error
+  // The curves are linearized and M is dropped as with GeoJSON
+  GeometryToObject(OGRGeometry *geom);
+
+  // Can be called only once
+  Local<Value> ToObject(bool flat);
+
+    private:
+  Local<Value> position(uint32_t i);
+  Local<Array> positions(uint32_t begin, uint32_t end);
+  Local<Array> lines(const uint32_t *offsets, uint32_t begin, uint32_t end);
+
+  OGRwkbGeometryType type;
+  FlatCoordinates coords;
+  std::vector<std::unique_ptr<GeometryToObject>> children;
+};
+
+class GeometryFromObject {
+    public:
+  // Returns nullptr after throwing a JS exception
+  static std::unique_ptr<GeometryFromObject> Parse(Local<Value> val);
+
+  // Worker thread safe, throws const char * on error
+  OGRGeometry *Build();
+
+    private:
+  GeometryFromObject(OGRwkbGeometryType type);
+  bool parsePosition(Local<Value> val);
+  bool parsePositions(Local<Value> val, size_t level);
+
+  OGRwkbGeometryType type;
+  int dims;
+  bool hasZ;
+  std::vector<double> xy;
+  std::vector<std::vector<uint32_t>> offsets;
+  std::vector<std::unique_ptr<GeometryFromObject>> children;
+};
+
+} // namespace node_gdal
+#endif
@@ -0,0 +1,868 @@
+#include "layer_columns.hpp"
+#include "../gdal_common.hpp"
+#include "field_types.hpp"
+#include "typed_array.hpp"
+
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 6)
+#include <ogr_recordbatch.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+namespace node_gdal {
+
+ColumnBuffer::ColumnBuffer() : size(0), data(nullptr), capacity(0) {
+}
+
+ColumnBuffer::ColumnBuffer(ColumnBuffer &&other) : size(other.size), data(other.data), capacity(other.capacity) {
+  other.data = nullptr;
+  other.size = 0;
+  other.capacity = 0;
+}
+
+ColumnBuffer::~ColumnBuffer() {
+  VSIFree(data);
+}
+
+GByte *ColumnBuffer::grow(size_t len) {
+  if (size + len > capacity) {
+    size_t newCapacity = std::max(std::max(capacity * 2, size + len), static_cast<size_t>(4096));
+    GByte *newData = static_cast<GByte *>(VSIRealloc(data, newCapacity));
+    if (newData == nullptr) throw "Failed allocating memory";
+    data = newData;
+    capacity = newCapacity;
+  }
+  GByte *r = data + size;
+  size += len;
+  return r;
+}
+
+void *ColumnBuffer::release() {
+  GByte *r;
+  if (data == nullptr) {
+    // Zero-length arrays still need a valid backing store
+    r = static_cast<GByte *>(VSIMalloc(1));
+  } else if (size < capacity) {
+    r = static_cast<GByte *>(VSIRealloc(data, size > 0 ? size : 1));
+    if (r == nullptr) r = data;
+  } else {
+    r = data;
+  }
+  data = nullptr;
+  size = 0;
+  capacity = 0;
+  return r;
+}
+
+LayerColumn::LayerColumn(const std::string &name, int field, ColumnType type, OGRFieldType fieldType)
+  : name(name), field(field), type(type), fieldType(fieldType), rows(0), nulls(0) {
+  if (type == ColumnType::Binary) offsets.push<int32_t>(0);
+}
+
+void LayerColumn::pushValid() {
+  if (rows % 8 == 0) validity.push<GByte>(0);
+  validity.get()[rows / 8] |= static_cast<GByte>(1 << (rows % 8));
+  rows++;
+}
+
+void LayerColumn::pushNull() {
+  if (rows % 8 == 0) validity.push<GByte>(0);
+  rows++;
+  nulls++;
+  switch (type) {
+    case ColumnType::Int32: data.push<int32_t>(0); break;
+    case ColumnType::Int64: data.push<int64_t>(0); break;
+    case ColumnType::Float64: data.push<double>(std::numeric_limits<double>::quiet_NaN()); break;
+    case ColumnType::Binary: offsets.push<int32_t>(static_cast<int32_t>(data.size)); break;
+  }
+}
+
+GByte *LayerColumn::pushBytes(size_t len) {
+  if (data.size + len > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    CPLError(CE_Failure, CPLE_AppDefined, "Column %s exceeds 2GB", name.c_str());
+    throw CPLGetLastErrorMsg();
+  }
+  pushValid();
+  GByte *r = data.grow(len);
+  offsets.push<int32_t>(static_cast<int32_t>(data.size));
+  return r;
+}
+
+void LayerColumn::pushBytes(const void *bytes, size_t len) {
+  GByte *r = pushBytes(len);
+  if (len > 0) memcpy(r, bytes, len);
+}
+
+Local<Object> LayerColumn::ToObject() {
+  Nan::EscapableHandleScope scope;
+  Local<Object> obj = Nan::New<Object>();
+
+  if (field >= 0)
+    Nan::Set(obj, Nan::New("type").ToLocalChecked(), Nan::New(getFieldTypeName(fieldType)).ToLocalChecked());
+
+  Local<Value> array;
+  unsigned int length = static_cast<unsigned int>(rows);
+  switch (type) {
+    case ColumnType::Int32: array = TypedArray::Adopt(GDT_Int32, data.release(), length); break;
+    case ColumnType::Int64: array = TypedArray::AdoptBigInt64(data.release(), length); break;
+    case ColumnType::Float64: array = TypedArray::Adopt(GDT_Float64, data.release(), length); break;
+    case ColumnType::Binary:
+      length = static_cast<unsigned int>(data.size);
+      array = TypedArray::Adopt(GDT_Byte, data.release(), length);
+      Nan::Set(
+        obj,
+        Nan::New("offsets").ToLocalChecked(),
+        TypedArray::Adopt(GDT_Int32, offsets.release(), static_cast<unsigned int>(rows + 1)));
+      break;
+  }
+  Nan::Set(obj, Nan::New("data").ToLocalChecked(), array);
+
+  if (nulls > 0)
+    Nan::Set(
+      obj,
+      Nan::New("validity").ToLocalChecked(),
+      TypedArray::Adopt(GDT_Byte, validity.release(), static_cast<unsigned int>((rows + 7) / 8)));
+  else
+    Nan::Set(obj, Nan::New("validity").ToLocalChecked(), Nan::Null());
+
+  return scope.Escape(obj);
+}
+
+LayerColumns::LayerColumns(GeometryMode geometry)
+  : geometry(geometry),
+    count(0),
+    fid("fid", -1, ColumnType::Float64, OFTReal),
+    fields(),
+    wkb("geometry", -1, ColumnType::Binary, OFTBinary),
+    x("x", -1, ColumnType::Float64, OFTReal),
+    y("y", -1, ColumnType::Float64, OFTReal) {
+}
+
+static bool columnType(OGRFieldType fieldType, ColumnType &type) {
+  switch (fieldType) {
+    case OFTInteger: type = ColumnType::Int32; return true;
+    case OFTInteger64: type = ColumnType::Int64; return true;
+    case OFTReal:
+    case OFTDate:
+    case OFTTime:
+    case OFTDateTime: type = ColumnType::Float64; return true;
+    case OFTString:
+    case OFTBinary: type = ColumnType::Binary; return true;
+    default: return false;
+  }
+}
+
+void LayerColumns::selectColumns(OGRLayer *layer, const std::vector<std::string> &names, bool allFields) {
+  OGRFeatureDefn *defn = layer->GetLayerDefn();
+  ColumnType type;
+
+  if (allFields) {
+    // Silently skip the list types
+    for (int i = 0; i < defn->GetFieldCount(); i++) {
+      OGRFieldDefn *fieldDefn = defn->GetFieldDefn(i);
+      if (columnType(fieldDefn->GetType(), type))
+        fields.emplace_back(fieldDefn->GetNameRef(), i, type, fieldDefn->GetType());
+    }
+    return;
+  }
+
+  for (const std::string &name : names) {
+    int i = defn->GetFieldIndex(name.c_str());
+    if (i < 0) {
+      CPLError(CE_Failure, CPLE_AppDefined, "Invalid field name: %s", name.c_str());
+      throw CPLGetLastErrorMsg();
+    }
+    OGRFieldDefn *fieldDefn = defn->GetFieldDefn(i);
+    if (!columnType(fieldDefn->GetType(), type)) {
+      CPLError(
+        CE_Failure,
+        CPLE_AppDefined,
+        "Unsupported field type %s for field %s",
+        getFieldTypeName(fieldDefn->GetType()),
+        name.c_str());
+      throw CPLGetLastErrorMsg();
+    }
+    fields.emplace_back(fieldDefn->GetNameRef(), i, type, fieldDefn->GetType());
+  }
+}
+
+// Days since 1970-01-01 in the proleptic Gregorian calendar
+static int64_t daysFromCivil(int64_t y, int m, int d) {
+  y -= m <= 2;
+  const int64_t era = (y >= 0 ? y : y - 399) / 400;
+  const int64_t yoe = y - era * 400;
+  const int64_t doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+  const int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+// Dates are milliseconds since the epoch, times are milliseconds since midnight
+static double dateToMs(const OGRField *field, OGRFieldType type) {
+  double ms = field->Date.Hour * 3600000. + field->Date.Minute * 60000. + field->Date.Second * 1000.;
+  if (type == OFTTime) return ms;
+  double days = static_cast<double>(daysFromCivil(field->Date.Year, field->Date.Month, field->Date.Day));
+  if (type == OFTDate) return days * 86400000.;
+  // TZFlag: 0 unknown, 1 local time, 100 UTC, 100 + n: n * 15 minutes from UTC
+  if (field->Date.TZFlag > 1) ms -= (field->Date.TZFlag - 100) * 15 * 60000.;
+  return days * 86400000. + ms;
+}
+
+void LayerColumns::readFeatures(OGRLayer *layer) {
+  layer->ResetReading();
+
+  OGRFeature *raw;
+  while ((raw = layer->GetNextFeature()) != nullptr) {
+    std::unique_ptr<OGRFeature, void (*)(OGRFeature *)> feature(raw, OGRFeature::DestroyFeature);
+
+    fid.pushValid();
+    fid.data.push<double>(static_cast<double>(feature->GetFID()));
+
+    for (LayerColumn &col : fields) {
+      if (!feature->IsFieldSetAndNotNull(col.field)) {
+        col.pushNull();
+        continue;
+      }
+      switch (col.fieldType) {
+        case OFTInteger:
+          col.pushValid();
+          col.data.push<int32_t>(feature->GetFieldAsInteger(col.field));
+          break;
+        case OFTInteger64:
+          col.pushValid();
+          col.data.push<int64_t>(feature->GetFieldAsInteger64(col.field));
+          break;
+        case OFTReal:
+          col.pushValid();
+          col.data.push<double>(feature->GetFieldAsDouble(col.field));
+          break;
+        case OFTDate:
+        case OFTTime:
+        case OFTDateTime:
+          col.pushValid();
+          col.data.push<double>(dateToMs(feature->GetRawFieldRef(col.field), col.fieldType));
+          break;
+        case OFTString: {
+          const char *s = feature->GetFieldAsString(col.field);
+          col.pushBytes(s, strlen(s));
+        } break;
+        case OFTBinary: {
+          int len;
+          GByte *bytes = feature->GetFieldAsBinary(col.field, &len);
+          col.pushBytes(bytes, len);
+        } break;
+        default: break;
+      }
+    }
+
+    OGRGeometry *geom = feature->GetGeometryRef();
+    if (geometry == WKB) {
+      if (geom == nullptr) {
+        wkb.pushNull();
+      } else {
+        // exportToWkb writes directly in the column
+        geom->exportToWkb(wkbNDR, wkb.pushBytes(geom->WkbSize()), wkbVariantIso);
+      }
+    } else if (geometry == XY) {
+      if (geom != nullptr && wkbFlatten(geom->getGeometryType()) != wkbPoint)
+        throw "geometry: 'xy' is supported only for points";
+      if (geom == nullptr || geom->IsEmpty()) {
+        x.pushNull();
+        y.pushNull();
+      } else {
+        OGRPoint *point = static_cast<OGRPoint *>(geom);
+        x.pushValid();
+        x.data.push<double>(point->getX());
+        y.pushValid();
+        y.data.push<double>(point->getY());
+      }
+    }
+
+    count++;
+  }
+}
+
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 6)
+
+namespace {
+struct ArrowStreamGuard {
+  struct ArrowArrayStream *stream;
+  ~ArrowStreamGuard() {
+    if (stream->release != nullptr) stream->release(stream);
+  }
+};
+struct ArrowSchemaGuard {
+  struct ArrowSchema *schema;
+  ~ArrowSchemaGuard() {
+    if (schema->release != nullptr) schema->release(schema);
+  }
+};
+struct ArrowArrayGuard {
+  struct ArrowArray *array;
+  ~ArrowArrayGuard() {
+    if (array->release != nullptr) array->release(array);
+  }
+};
+} // namespace
+
+// The message belongs to the stream and must be copied before releasing it
+static void arrowError(struct ArrowArrayStream *stream) {
+  const char *msg = stream->get_last_error(stream);
+  CPLError(CE_Failure, CPLE_AppDefined, "%s", msg != nullptr ? msg : "Failed reading the Arrow stream");
+  throw CPLGetLastErrorMsg();
+}
+
+static inline bool arrowBit(const GByte *bitmap, int64_t i) {
+  return (bitmap[i >> 3] >> (i & 7)) & 1;
+}
+
+static inline const GByte *arrowValidity(const struct ArrowArray *array) {
+  return array->null_count != 0 ? static_cast<const GByte *>(array->buffers[0]) : nullptr;
+}
+
+template <typename SRC, typename DST>
+static void appendArrowIntegers(LayerColumn &col, const struct ArrowArray *array, int64_t offset, int64_t n) {
+  const GByte *validity = arrowValidity(array);
+  const SRC *values = static_cast<const SRC *>(array->buffers[1]);
+  for (int64_t i = offset; i < offset + n; i++) {
+    if (validity != nullptr && !arrowBit(validity, i)) {
+      col.pushNull();
+      continue;
+    }
+    col.pushValid();
+    col.data.push<DST>(static_cast<DST>(values[i]));
+  }
+}
+
+template <typename SRC>
+static void appendArrowDoubles(
+  LayerColumn &col, const struct ArrowArray *array, int64_t offset, int64_t n, double scale) {
+  const GByte *validity = arrowValidity(array);
+  const SRC *values = static_cast<const SRC *>(array->buffers[1]);
+  for (int64_t i = offset; i < offset + n; i++) {
+    if (validity != nullptr && !arrowBit(validity, i)) {
+      col.pushNull();
+      continue;
+    }
+    col.pushValid();
+    col.data.push<double>(static_cast<double>(values[i]) * scale);
+  }
+}
+
+static void appendArrowBooleans(LayerColumn &col, const struct ArrowArray *array, int64_t offset, int64_t n) {
+  const GByte *validity = arrowValidity(array);
+  const GByte *values = static_cast<const GByte *>(array->buffers[1]);
+  for (int64_t i = offset; i < offset + n; i++) {
+    if (validity != nullptr && !arrowBit(validity, i)) {
+      col.pushNull();
+      continue;
+    }
+    col.pushValid();
+    col.data.push<int32_t>(arrowBit(values, i));
+  }
+}
+
+template <typename OFFSET>
+static void appendArrowBinary(LayerColumn &col, const struct ArrowArray *array, int64_t offset, int64_t n) {
+  const GByte *validity = arrowValidity(array);
+  const OFFSET *offsets = static_cast<const OFFSET *>(array->buffers[1]);
+  const GByte *bytes = static_cast<const GByte *>(array->buffers[2]);
+  for (int64_t i = offset; i < offset + n; i++) {
+    if (validity != nullptr && !arrowBit(validity, i)) {
+      col.pushNull();
+      continue;
+    }
+    col.pushBytes(bytes + offsets[i], static_cast<size_t>(offsets[i + 1] - offsets[i]));
+  }
+}
+
+// Dates and times are converted to the same milliseconds as readFeatures()
+static void appendArrow(
+  LayerColumn &col, const struct ArrowSchema *schema, const struct ArrowArray *array, int64_t offset, int64_t n) {
+  const std::string format = schema->format;
+  offset += array->offset;
+
+  switch (col.type) {
+    case ColumnType::Int32:
+      if (format == "i") return appendArrowIntegers<int32_t, int32_t>(col, array, offset, n);
+      if (format == "s") return appendArrowIntegers<int16_t, int32_t>(col, array, offset, n);
+      if (format == "c") return appendArrowIntegers<int8_t, int32_t>(col, array, offset, n);
+      if (format == "b") return appendArrowBooleans(col, array, offset, n);
+      break;
+    case ColumnType::Int64:
+      if (format == "l") return appendArrowIntegers<int64_t, int64_t>(col, array, offset, n);
+      break;
+    case ColumnType::Float64:
+      if (format == "g") return appendArrowDoubles<double>(col, array, offset, n, 1);
+      if (format == "f") return appendArrowDoubles<float>(col, array, offset, n, 1);
+      if (format == "l") return appendArrowDoubles<int64_t>(col, array, offset, n, 1);
+      if (format == "tdD") return appendArrowDoubles<int32_t>(col, array, offset, n, 86400000.);
+      if (format == "tdm") return appendArrowDoubles<int64_t>(col, array, offset, n, 1);
+      if (format == "tts") return appendArrowDoubles<int32_t>(col, array, offset, n, 1000.);
+      if (format == "ttm") return appendArrowDoubles<int32_t>(col, array, offset, n, 1);
+      if (format == "ttu") return appendArrowDoubles<int64_t>(col, array, offset, n, 1e-3);
+      if (format == "ttn") return appendArrowDoubles<int64_t>(col, array, offset, n, 1e-6);
+      if (format.compare(0, 4, "tss:") == 0) return appendArrowDoubles<int64_t>(col, array, offset, n, 1000.);
+      if (format.compare(0, 4, "tsm:") == 0) return appendArrowDoubles<int64_t>(col, array, offset, n, 1);
+      if (format.compare(0, 4, "tsu:") == 0) return appendArrowDoubles<int64_t>(col, array, offset, n, 1e-3);
+      if (format.compare(0, 4, "tsn:") == 0) return appendArrowDoubles<int64_t>(col, array, offset, n, 1e-6);
+      break;
+    case ColumnType::Binary:
+      if (format == "u" || format == "z") return appendArrowBinary<int32_t>(col, array, offset, n);
+      if (format == "U" || format == "Z") return appendArrowBinary<int64_t>(col, array, offset, n);
+      break;
+  }
+
+  CPLError(CE_Failure, CPLE_AppDefined, "Unsupported Arrow format %s for column %s", schema->format, col.name.c_str());
+  throw CPLGetLastErrorMsg();
+}
+
+// Extracts the coordinates of a WKB point (ISO, OGC or EWKB), an EWKB SRID is skipped
+static bool wkbPointXY(const GByte *wkb, size_t len, double &x, double &y) {
+  if (len < 21) return false;
+  bool swap = (wkb[0] == wkbNDR) != static_cast<bool>(CPL_IS_LSB);
+  uint32_t type;
+  memcpy(&type, wkb + 1, sizeof(type));
+  if (swap) CPL_SWAP32PTR(&type);
+  if ((type & 0xffff) % 1000 != static_cast<uint32_t>(wkbPoint)) return false;
+  size_t pos = 5;
+  if (type & 0x20000000) {
+    if (len < 25) return false;
+    pos += 4;
+  }
+  memcpy(&x, wkb + pos, sizeof(x));
+  memcpy(&y, wkb + pos + 8, sizeof(y));
+  if (swap) {
+    CPL_SWAP64PTR(&x);
+    CPL_SWAP64PTR(&y);
+  }
+  return true;
+}
+
+static void appendArrowXY(
+  LayerColumn &x,
+  LayerColumn &y,
+  const struct ArrowSchema *schema,
+  const struct ArrowArray *array,
+  int64_t offset,
+  int64_t n) {
+  if (strcmp(schema->format, "z") != 0) throw "Unsupported Arrow format for the geometry column";
+  offset += array->offset;
+  const GByte *validity = arrowValidity(array);
+  const int32_t *offsets = static_cast<const int32_t *>(array->buffers[1]);
+  const GByte *bytes = static_cast<const GByte *>(array->buffers[2]);
+  for (int64_t i = offset; i < offset + n; i++) {
+    double px, py;
+    if (validity != nullptr && !arrowBit(validity, i)) {
+      x.pushNull();
+      y.pushNull();
+      continue;
+    }
+    if (!wkbPointXY(bytes + offsets[i], static_cast<size_t>(offsets[i + 1] - offsets[i]), px, py))
+      throw "geometry: 'xy' is supported only for points";
+    if (std::isnan(px) && std::isnan(py)) {
+      x.pushNull();
+      y.pushNull();
+      continue;
+    }
+    x.pushValid();
+    x.data.push<double>(px);
+    y.pushValid();
+    y.data.push<double>(py);
+  }
+}
+
+void LayerColumns::readArrowStream(OGRLayer *layer, int batchSize) {
+  CPLStringList options;
+  options.SetNameValue("INCLUDE_FID", "YES");
+  options.SetNameValue("MAX_FEATURES_IN_BATCH", std::to_string(batchSize).c_str());
+
+  struct ArrowArrayStream stream;
+  if (!layer->GetArrowStream(&stream, options.List())) throw CPLGetLastErrorMsg();
+  ArrowStreamGuard streamGuard{&stream};
+
+  struct ArrowSchema schema;
+  if (stream.get_schema(&stream, &schema) != 0) arrowError(&stream);
+  ArrowSchemaGuard schemaGuard{&schema};
+
+  // The FID is always the first child, the fields and the geometry are matched by name
+  OGRFeatureDefn *defn = layer->GetLayerDefn();
+  std::string geomName = defn->GetGeomFieldCount() > 0 ? defn->GetGeomFieldDefn(0)->GetNameRef() : "";
+  if (geomName.empty()) geomName = "wkb_geometry";
+  std::vector<int64_t> children(fields.size(), -1);
+  int64_t geomChild = -1;
+  for (int64_t i = 1; i < schema.n_children; i++) {
+    const char *name = schema.children[i]->name;
+    for (size_t j = 0; j < fields.size(); j++)
+      if (fields[j].name == name) children[j] = i;
+    if (geometry != NONE && geomName == name) geomChild = i;
+  }
+  for (size_t j = 0; j < fields.size(); j++) {
+    if (children[j] < 0) {
+      CPLError(CE_Failure, CPLE_AppDefined, "Field %s is missing from the Arrow stream", fields[j].name.c_str());
+      throw CPLGetLastErrorMsg();
+    }
+  }
+
+  while (true) {
+    struct ArrowArray array;
+    if (stream.get_next(&stream, &array) != 0) arrowError(&stream);
+    if (array.release == nullptr) break;
+    ArrowArrayGuard arrayGuard{&array};
+
+    int64_t n = array.length;
+    appendArrow(fid, schema.children[0], array.children[0], array.offset, n);
+    for (size_t j = 0; j < fields.size(); j++)
+      appendArrow(fields[j], schema.children[children[j]], array.children[children[j]], array.offset, n);
+    if (geometry == WKB) {
+      if (geomChild >= 0)
+        appendArrow(wkb, schema.children[geomChild], array.children[geomChild], array.offset, n);
+      else
+        for (int64_t i = 0; i < n; i++) wkb.pushNull();
+    } else if (geometry == XY) {
+      if (geomChild >= 0)
+        appendArrowXY(x, y, schema.children[geomChild], array.children[geomChild], array.offset, n);
+      else
+        for (int64_t i = 0; i < n; i++) {
+          x.pushNull();
+          y.pushNull();
+        }
+    }
+
+    count += n;
+  }
+}
+
+#endif
+
+namespace {
+// Only the selected fields are read, the layer state is restored on exit
+struct IgnoredFieldsGuard {
+  OGRLayer *layer;
+  IgnoredFieldsGuard(OGRLayer *layer, CPLStringList &ignored) : layer(layer) {
+    layer->SetIgnoredFields(const_cast<const char **>(ignored.List()));
+  }
+  ~IgnoredFieldsGuard() {
+    layer->SetIgnoredFields(nullptr);
+  }
+};
+} // namespace
+
+void LayerColumns::read(OGRLayer *layer, const std::vector<std::string> &names, bool allFields, int batchSize) {
+  selectColumns(layer, names, allFields);
+
+  OGRFeatureDefn *defn = layer->GetLayerDefn();
+  CPLStringList ignored;
+  for (int i = 0; i < defn->GetFieldCount(); i++) {
+    if (std::none_of(fields.begin(), fields.end(), [i](const LayerColumn &col) { return col.field == i; }))
+      ignored.AddString(defn->GetFieldDefn(i)->GetNameRef());
+  }
+  if (geometry == NONE) ignored.AddString("OGR_GEOMETRY");
+  ignored.AddString("OGR_STYLE");
+  IgnoredFieldsGuard guard(layer, ignored);
+
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 6)
+  readArrowStream(layer, batchSize);
+#else
+  // batchSize is meaningful only for the Arrow stream
+  (void)batchSize;
+  readFeatures(layer);
+#endif
+}
+
+Local<Object> LayerColumns::ToObject() {
+  Nan::EscapableHandleScope scope;
+  Local<Object> result = Nan::New<Object>();
+
+  Nan::Set(result, Nan::New("count").ToLocalChecked(), Nan::New<Number>(static_cast<double>(count)));
+  Nan::Set(
+    result,
+    Nan::New("fid").ToLocalChecked(),
+    TypedArray::Adopt(GDT_Float64, fid.data.release(), static_cast<unsigned int>(count)));
+
+  Local<Object> fieldsObj = Nan::New<Object>();
+  for (LayerColumn &col : fields) Nan::Set(fieldsObj, SafeString::New(col.name.c_str()), col.ToObject());
+  Nan::Set(result, Nan::New("fields").ToLocalChecked(), fieldsObj);
+
+  if (geometry == WKB) {
+    Nan::Set(result, Nan::New("geometry").ToLocalChecked(), wkb.ToObject());
+  } else if (geometry == XY) {
+    Local<Object> geom = Nan::New<Object>();
+    Nan::Set(
+      geom,
+      Nan::New("x").ToLocalChecked(),
+      TypedArray::Adopt(GDT_Float64, x.data.release(), static_cast<unsigned int>(count)));
+    Nan::Set(
+      geom,
+      Nan::New("y").ToLocalChecked(),
+      TypedArray::Adopt(GDT_Float64, y.data.release(), static_cast<unsigned int>(count)));
+    if (x.nulls > 0)
+      Nan::Set(
+        geom,
+        Nan::New("validity").ToLocalChecked(),
+        TypedArray::Adopt(GDT_Byte, x.validity.release(), static_cast<unsigned int>((count + 7) / 8)));
+    else
+      Nan::Set(geom, Nan::New("validity").ToLocalChecked(), Nan::Null());
+    Nan::Set(result, Nan::New("geometry").ToLocalChecked(), geom);
+  }
+
+  return scope.Escape(result);
+}
+
+// Inverse of daysFromCivil
+static void civilFromDays(int64_t z, int &y, int &m, int &d) {
+  z += 719468;
+  const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+  const int64_t doe = z - era * 146097;
+  const int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const int64_t mp = (5 * doy + 2) / 153;
+  d = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+  m = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+  y = static_cast<int>(yoe + era * 400 + (m <= 2));
+}
+
+// Inverse of dateToMs, dateTimes are set in UTC
+static void msToDate(OGRFeature *feature, int field, double ms, OGRFieldType type) {
+  int64_t days = static_cast<int64_t>(std::floor(ms / 86400000.));
+  double msOfDay = ms - static_cast<double>(days) * 86400000.;
+  int year = 0, month = 0, day = 0;
+  if (type != OFTTime) civilFromDays(days, year, month, day);
+  int hour = static_cast<int>(msOfDay / 3600000.);
+  int minute = static_cast<int>((msOfDay - hour * 3600000.) / 60000.);
+  float second = static_cast<float>((msOfDay - hour * 3600000. - minute * 60000.) / 1000.);
+  feature->SetField(field, year, month, day, hour, minute, second, type == OFTDateTime ? 100 : 0);
+}
+
+ColumnarFeatures::ColumnarFeatures() : count(0), fields(), geometry(LayerColumns::NONE), wkb(), x(), y() {
+}
+
+// Parses a TypedArray, the type of the column is the type of the array
+static void parseColumnData(Local<Value> val, ColumnView &view, std::vector<Local<Object>> &arrays) {
+  size_t elementSize;
+  if (val->IsInt32Array()) {
+    view.type = ColumnType::Int32;
+    elementSize = sizeof(int32_t);
+  } else if (val->IsBigInt64Array()) {
+    view.type = ColumnType::Int64;
+    elementSize = sizeof(int64_t);
+  } else if (val->IsFloat64Array()) {
+    view.type = ColumnType::Float64;
+    elementSize = sizeof(double);
+  } else if (val->IsUint8Array()) {
+    view.type = ColumnType::Binary;
+    elementSize = 1;
+  } else {
+    throw "Column data must be an Int32Array, a BigInt64Array, a Float64Array or an Uint8Array";
+  }
+  Nan::TypedArrayContents<GByte> contents(val);
+  view.data = *contents;
+  view.dataLength = contents.length() / elementSize;
+  view.rows = view.dataLength;
+  arrays.push_back(val.As<Object>());
+}
+
+// Parses either a TypedArray or an object with data, offsets and validity
+static void parseColumn(
+  const std::string &name, Local<Value> val, ColumnView &view, std::vector<Local<Object>> &arrays) {
+  view.name = name;
+  view.field = -1;
+  view.offsets = nullptr;
+  view.validity = nullptr;
+  view.validityLength = 0;
+
+  if (val->IsArrayBufferView()) {
+    parseColumnData(val, view, arrays);
+    if (view.type == ColumnType::Binary) throw "Uint8Array columns must have offsets";
+    return;
+  }
+  if (!val->IsObject()) throw "Columns must be TypedArrays or objects with data, offsets and validity";
+  Local<Object> obj = val.As<Object>();
+
+  parseColumnData(Nan::Get(obj, Nan::New("data").ToLocalChecked()).ToLocalChecked(), view, arrays);
+
+  if (view.type == ColumnType::Binary) {
+    Local<Value> offsets = Nan::Get(obj, Nan::New("offsets").ToLocalChecked()).ToLocalChecked();
+    if (!offsets->IsInt32Array()) throw "offsets must be an Int32Array";
+    Nan::TypedArrayContents<int32_t> contents(offsets);
+    if (contents.length() < 1) throw "offsets must have at least one element";
+    view.offsets = *contents;
+    view.rows = contents.length() - 1;
+    arrays.push_back(offsets.As<Object>());
+  }
+
+  Local<Value> validity = Nan::Get(obj, Nan::New("validity").ToLocalChecked()).ToLocalChecked();
+  if (!validity->IsNull() && !validity->IsUndefined()) {
+    if (!validity->IsUint8Array()) throw "validity must be an Uint8Array";
+    Nan::TypedArrayContents<GByte> contents(validity);
+    view.validity = *contents;
+    view.validityLength = contents.length();
+    arrays.push_back(validity.As<Object>());
+  }
+}
+
+static void checkColumnLength(const ColumnView &view, size_t count) {
+  if (view.rows < count) throw "All columns must have at least count elements";
+  if (view.validity != nullptr && view.validityLength < (count + 7) / 8) throw "validity is too short";
+}
+
+void ColumnarFeatures::parse(Local<Object> obj, std::vector<Local<Object>> &arrays) {
+  Nan::HandleScope scope;
+  bool hasCount = false;
+
+  Local<Value> countVal = Nan::Get(obj, Nan::New("count").ToLocalChecked()).ToLocalChecked();
+  if (countVal->IsNumber()) {
+    double n = Nan::To<double>(countVal).ToChecked();
+    if (n < 0) throw "count must be a positive number";
+    count = static_cast<size_t>(n);
+    hasCount = true;
+  } else if (!countVal->IsNull() && !countVal->IsUndefined()) {
+    throw "count must be a number";
+  }
+
+  Local<Value> fieldsVal = Nan::Get(obj, Nan::New("fields").ToLocalChecked()).ToLocalChecked();
+  if (!fieldsVal->IsNull() && !fieldsVal->IsUndefined()) {
+    if (!fieldsVal->IsObject()) throw "fields must be an object";
+    Local<Object> fieldsObj = fieldsVal.As<Object>();
+    Local<Array> names = Nan::GetOwnPropertyNames(fieldsObj).ToLocalChecked();
+    for (unsigned i = 0; i < names->Length(); i++) {
+      Local<Value> name = Nan::Get(names, i).ToLocalChecked();
+      ColumnView view;
+      parseColumn(*Nan::Utf8String(name), Nan::Get(fieldsObj, name).ToLocalChecked(), view, arrays);
+      fields.push_back(view);
+    }
+  }
+
+  Local<Value> geomVal = Nan::Get(obj, Nan::New("geometry").ToLocalChecked()).ToLocalChecked();
+  if (!geomVal->IsNull() && !geomVal->IsUndefined()) {
+    if (!geomVal->IsObject()) throw "geometry must be an object";
+    Local<Object> geomObj = geomVal.As<Object>();
+    if (Nan::HasOwnProperty(geomObj, Nan::New("x").ToLocalChecked()).FromMaybe(false)) {
+      geometry = LayerColumns::XY;
+      Local<Value> validity = Nan::Get(geomObj, Nan::New("validity").ToLocalChecked()).ToLocalChecked();
+      // x and y are parsed as two columns sharing the same validity
+      Local<Object> xObj = Nan::New<Object>();
+      Local<Object> yObj = Nan::New<Object>();
+      Nan::Set(
+        xObj, Nan::New("data").ToLocalChecked(), Nan::Get(geomObj, Nan::New("x").ToLocalChecked()).ToLocalChecked());
+      Nan::Set(xObj, Nan::New("validity").ToLocalChecked(), validity);
+      Nan::Set(
+        yObj, Nan::New("data").ToLocalChecked(), Nan::Get(geomObj, Nan::New("y").ToLocalChecked()).ToLocalChecked());
+      parseColumn("x", xObj, x, arrays);
+      parseColumn("y", yObj, y, arrays);
+      if (x.type != ColumnType::Float64 || y.type != ColumnType::Float64) throw "x and y must be Float64Arrays";
+    } else {
+      geometry = LayerColumns::WKB;
+      parseColumn("geometry", geomObj, wkb, arrays);
+      if (wkb.type != ColumnType::Binary) throw "geometry data must be an Uint8Array";
+    }
+  }
+
+  if (!hasCount) {
+    if (!fields.empty())
+      count = fields.front().rows;
+    else if (geometry == LayerColumns::WKB)
+      count = wkb.rows;
+    else if (geometry == LayerColumns::XY)
+      count = x.rows;
+  }
+  for (const ColumnView &view : fields) checkColumnLength(view, count);
+  if (geometry == LayerColumns::WKB) checkColumnLength(wkb, count);
+  if (geometry == LayerColumns::XY) {
+    checkColumnLength(x, count);
+    checkColumnLength(y, count);
+  }
+}
+
+void ColumnarFeatures::resolve(OGRFeatureDefn *defn) {
+  for (ColumnView &col : fields) {
+    col.field = defn->GetFieldIndex(col.name.c_str());
+    if (col.field < 0) {
+      CPLError(CE_Failure, CPLE_AppDefined, "Invalid field name: %s", col.name.c_str());
+      throw CPLGetLastErrorMsg();
+    }
+    col.fieldType = defn->GetFieldDefn(col.field)->GetType();
+    bool compatible;
+    switch (col.fieldType) {
+      case OFTInteger:
+      case OFTInteger64:
+      case OFTReal: compatible = col.type != ColumnType::Binary; break;
+      case OFTDate:
+      case OFTTime:
+      case OFTDateTime: compatible = col.type == ColumnType::Float64; break;
+      case OFTString:
+      case OFTBinary: compatible = col.type == ColumnType::Binary; break;
+      default: compatible = false;
+    }
+    if (!compatible) {
+      CPLError(
+        CE_Failure,
+        CPLE_AppDefined,
+        "Incompatible column data for field %s of type %s",
+        col.name.c_str(),
+        getFieldTypeName(col.fieldType));
+      throw CPLGetLastErrorMsg();
+    }
+  }
+}
+
+// Returns the bytes of the row i of a Binary column
+static const GByte *columnBytes(const ColumnView &col, size_t i, int &len) {
+  int32_t start = col.offsets[i];
+  int32_t end = col.offsets[i + 1];
+  if (start < 0 || end < start || static_cast<size_t>(end) > col.dataLength) throw "Invalid offsets";
+  len = end - start;
+  return col.data + start;
+}
+
+OGRFeature *ColumnarFeatures::build(OGRFeatureDefn *defn, size_t i) const {
+  std::unique_ptr<OGRFeature, void (*)(OGRFeature *)> feature(
+    OGRFeature::CreateFeature(defn), OGRFeature::DestroyFeature);
+
+  for (const ColumnView &col : fields) {
+    if (!col.isValid(i)) {
+      feature->SetFieldNull(col.field);
+      continue;
+    }
+    switch (col.type) {
+      case ColumnType::Int32: feature->SetField(col.field, reinterpret_cast<const int32_t *>(col.data)[i]); break;
+      case ColumnType::Int64:
+        feature->SetField(col.field, static_cast<GIntBig>(reinterpret_cast<const int64_t *>(col.data)[i]));
+        break;
+      case ColumnType::Float64: {
+        double value = reinterpret_cast<const double *>(col.data)[i];
+        if (col.fieldType == OFTDate || col.fieldType == OFTTime || col.fieldType == OFTDateTime)
+          msToDate(feature.get(), col.field, value, col.fieldType);
+        else
+          feature->SetField(col.field, value);
+      } break;
+      case ColumnType::Binary: {
+        int len;
+        const GByte *bytes = columnBytes(col, i, len);
+        if (col.fieldType == OFTBinary)
+          feature->SetField(col.field, len, const_cast<GByte *>(bytes));
+        else
+          feature->SetField(col.field, std::string(reinterpret_cast<const char *>(bytes), len).c_str());
+      } break;
+    }
+  }
+
+  if (geometry == LayerColumns::WKB && wkb.isValid(i)) {
+    int len;
+    const GByte *bytes = columnBytes(wkb, i, len);
+    OGRGeometry *geom = nullptr;
+    if (OGRGeometryFactory::createFromWkb(const_cast<GByte *>(bytes), nullptr, &geom, len) != OGRERR_NONE)
+      throw "Invalid WKB geometry";
+    feature->SetGeometryDirectly(geom);
+  } else if (geometry == LayerColumns::XY && x.isValid(i)) {
+    feature->SetGeometryDirectly(
+      new OGRPoint(reinterpret_cast<const double *>(x.data)[i], reinterpret_cast<const double *>(y.data)[i]));
+  }
+
+  return feature.release();
+}
+
+} // namespace node_gdal
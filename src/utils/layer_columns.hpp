@@ -0,0 +1,165 @@
+#ifndef __NODE_GDAL_LAYER_COLUMNS_H__
+#define __NODE_GDAL_LAYER_COLUMNS_H__
+
+// node
+#include <node.h>
+
+// nan
+#include "../nan-wrapper.h"
+
+// gdal
+#include <gdal_priv.h>
+#include <ogrsf_frmts.h>
+
+#include <string>
+#include <vector>
+
+using namespace v8;
+
+namespace node_gdal {
+
+// Columnar reading of a layer
+//
+// The reading happens in a worker thread and produces VSIMalloc-allocated
+// buffers that are handed over to JS as TypedArrays without copying
+//
+// {
+//   count: number
+//   fid: Float64Array
+//   fields: {
+//     [name]: {
+//       type: string
+//       data: Int32Array | BigInt64Array | Float64Array | Uint8Array
+//       offsets?: Int32Array
+//       validity: Uint8Array | null
+//     }
+//   }
+//   geometry?: {
+//     data: Uint8Array, offsets: Int32Array, validity: Uint8Array | null
+//   } | {
+//     x: Float64Array, y: Float64Array, validity: Uint8Array | null
+//   }
+// }
+
+// A growable buffer allocated with VSIMalloc
+class ColumnBuffer {
+    public:
+  ColumnBuffer();
+  ColumnBuffer(ColumnBuffer &&other);
+  ColumnBuffer(const ColumnBuffer &) = delete;
+  ~ColumnBuffer();
+
+  // Returns a pointer to len newly appended bytes
+  GByte *grow(size_t len);
+  template <typename T> inline void push(T value) {
+    *reinterpret_cast<T *>(grow(sizeof(T))) = value;
+  }
+  inline GByte *get() {
+    return data;
+  }
+  // Transfers the ownership of the memory to the caller
+  void *release();
+  size_t size;
+
+    private:
+  GByte *data;
+  size_t capacity;
+};
+
+enum class ColumnType { Int32, Int64, Float64, Binary };
+
+// A single column: values (or bytes for Binary), Int32 offsets for Binary
+// and an Arrow-compatible validity bitmap (LSB first, 1 = valid)
+class LayerColumn {
+    public:
+  LayerColumn(const std::string &name, int field, ColumnType type, OGRFieldType fieldType);
+  LayerColumn(LayerColumn &&other) = default;
+
+  void pushValid();
+  void pushNull();
+  void pushBytes(const void *bytes, size_t len);
+  // Returns a pointer to len bytes to be filled by the caller
+  GByte *pushBytes(size_t len);
+  Local<Object> ToObject();
+
+  std::string name;
+  int field;
+  ColumnType type;
+  OGRFieldType fieldType;
+  ColumnBuffer data;
+  ColumnBuffer offsets;
+  ColumnBuffer validity;
+  size_t rows;
+  size_t nulls;
+};
+
+class LayerColumns {
+    public:
+  enum GeometryMode { NONE, WKB, XY };
+
+  LayerColumns(GeometryMode geometry);
+
+  // Throws const char * on error
+  void read(OGRLayer *layer, const std::vector<std::string> &fields, bool allFields, int batchSize);
+  Local<Object> ToObject();
+
+    private:
+  void selectColumns(OGRLayer *layer, const std::vector<std::string> &fields, bool allFields);
+  void readFeatures(OGRLayer *layer);
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 6)
+  void readArrowStream(OGRLayer *layer, int batchSize);
+#endif
+
+  GeometryMode geometry;
+  size_t count;
+  LayerColumn fid;
+  std::vector<LayerColumn> fields;
+  LayerColumn wkb;
+  LayerColumn x;
+  LayerColumn y;
+};
+
+// A read-only view of a column in the format returned by Layer.readColumns
+struct ColumnView {
+  std::string name;
+  int field;
+  OGRFieldType fieldType;
+  ColumnType type;
+  const GByte *data;
+  size_t dataLength;
+  const int32_t *offsets;
+  const GByte *validity;
+  size_t rows;
+  size_t validityLength;
+
+  inline bool isValid(size_t i) const {
+    return validity == nullptr || ((validity[i >> 3] >> (i & 7)) & 1);
+  }
+};
+
+// Columnar input of LayerFeatures.addMany
+//
+// The TypedArrays are referenced without copying, parse() returns
+// them so that they can be protected from the GC
+class ColumnarFeatures {
+    public:
+  ColumnarFeatures();
+
+  // Main thread, throws const char * on error
+  void parse(Local<Object> obj, std::vector<Local<Object>> &arrays);
+  // Worker thread, throws const char * on error
+  void resolve(OGRFeatureDefn *defn);
+  OGRFeature *build(OGRFeatureDefn *defn, size_t i) const;
+
+  size_t count;
+
+    private:
+  std::vector<ColumnView> fields;
+  LayerColumns::GeometryMode geometry;
+  ColumnView wkb;
+  ColumnView x;
+  ColumnView y;
+};
+
+} // namespace node_gdal
+#endif
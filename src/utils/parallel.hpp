@@ -0,0 +1,72 @@
+#ifndef __NODE_GDAL_PARALLEL_H__
+#define __NODE_GDAL_PARALLEL_H__
+
+// gdal
+#include <cpl_multiproc.h>
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace node_gdal {
+
+// Splits [0, count) in contiguous ranges processed by up to threads threads,
+// but no more than the number of CPUs, the current thread processes the first one
+//
+// fn(begin, end) can throw const char * or std::exception, the first error is
+// rethrown as const char * once all the threads have finished, the message
+// remains valid until the next error in the calling thread
+template <typename F> void parallelFor(size_t count, int threads, F fn) {
+  threads = std::min(threads, std::max(CPLGetNumCPUs(), 1));
+  const size_t n = std::max(static_cast<size_t>(1), std::min(static_cast<size_t>(std::max(threads, 1)), count));
+  const size_t step = (count + n - 1) / n;
+  std::mutex lock;
+  std::string error;
+  bool failed = false;
+
+  // The error messages of GDAL are thread-local, they must be copied
+  auto setError = [&lock, &error, &failed](const char *err) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!failed) error = err;
+    failed = true;
+  };
+  auto run = [&fn, &setError](size_t begin, size_t end) {
+    try {
+      fn(begin, end);
+    } catch (const char *err) {
+      setError(err);
+    } catch (const std::exception &err) {
+      setError(err.what());
+    }
+  };
+
+  // When a thread cannot be created, the threads already started are joined
+  // before reporting the error
+  std::vector<std::thread> workers;
+  bool started = true;
+  try {
+    workers.reserve(n - 1);
+    for (size_t t = 1; t < n; t++) {
+      const size_t begin = t * step;
+      const size_t end = std::min(count, begin + step);
+      if (begin < end) workers.emplace_back(run, begin, end);
+    }
+  } catch (const std::exception &) {
+    setError("Failed creating a thread");
+    started = false;
+  }
+  if (started) run(0, std::min(count, step));
+  for (std::thread &w : workers) w.join();
+
+  if (failed) {
+    static thread_local std::string message;
+    message = error;
+    throw message.c_str();
+  }
+}
+
+} // namespace node_gdal
+#endif
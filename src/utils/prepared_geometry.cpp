@@ -0,0 +1,75 @@
+#include "prepared_geometry.hpp"
+#include "parallel.hpp"
+
+namespace node_gdal {
+
+SharedPreparedGeometry::SharedPreparedGeometry(OGRGeometry *geom)
+  : geom(geom), envelope(), usePrepared(OGRHasPreparedGeometrySupport()), lock(), idle() {
+  geom->getEnvelope(&envelope);
+}
+
+SharedPreparedGeometry::Prepared SharedPreparedGeometry::acquire() {
+  if (!usePrepared) return nullptr;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!idle.empty()) {
+      Prepared prepared = std::move(idle.back());
+      idle.pop_back();
+      return prepared;
+    }
+  }
+  return Prepared(new GEOSPreparedGeometry(geom.get()));
+}
+
+void SharedPreparedGeometry::release(Prepared prepared) {
+  if (prepared == nullptr) return;
+  std::lock_guard<std::mutex> guard(lock);
+  idle.push_back(std::move(prepared));
+}
+
+bool SharedPreparedGeometry::test(Predicate predicate, const GEOSPreparedGeometry *prepared, OGRGeometry *other) const {
+  if (other == nullptr || other->IsEmpty()) return false;
+
+  // GEOS converts the other geometry before checking the envelopes
+  OGREnvelope e;
+  other->getEnvelope(&e);
+  if (!envelope.Intersects(e)) return false;
+  if (predicate == CONTAINS && !envelope.Contains(e)) return false;
+
+  if (prepared != nullptr && prepared->isValid())
+    return predicate == CONTAINS ? prepared->contains(other) : prepared->intersects(other);
+  return predicate == CONTAINS ? geom->Contains(other) : geom->Intersects(other);
+}
+
+void SharedPreparedGeometry::test(Predicate predicate, OGRGeometry *other, GByte *out) {
+  Prepared prepared = acquire();
+  *out = test(predicate, prepared.get(), other) ? 1 : 0;
+  release(std::move(prepared));
+}
+
+void SharedPreparedGeometry::test(
+  Predicate predicate, const std::vector<LockedGeometry> &others, GByte *out, int threads) {
+  parallelFor(others.size(), threads, [this, predicate, &others, out](size_t begin, size_t end) {
+    Prepared prepared = acquire();
+    for (size_t i = begin; i < end; i++) {
+      GeometryGuard guard(others[i]);
+      out[i] = test(predicate, prepared.get(), others[i].geom) ? 1 : 0;
+    }
+    release(std::move(prepared));
+  });
+}
+
+void SharedPreparedGeometry::test(Predicate predicate, const double *xy, size_t count, GByte *out, int threads) {
+  parallelFor(count, threads, [this, predicate, xy, out](size_t begin, size_t end) {
+    Prepared prepared = acquire();
+    OGRPoint point;
+    for (size_t i = begin; i < end; i++) {
+      point.setX(xy[i * 2]);
+      point.setY(xy[i * 2 + 1]);
+      out[i] = test(predicate, prepared.get(), &point) ? 1 : 0;
+    }
+    release(std::move(prepared));
+  });
+}
+
+} // namespace node_gdal
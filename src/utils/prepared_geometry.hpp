@@ -0,0 +1,96 @@
+#ifndef __NODE_GDAL_PREPARED_GEOMETRY_H__
+#define __NODE_GDAL_PREPARED_GEOMETRY_H__
+
+// ogr
+#include <ogr_api.h>
+#include <ogrsf_frmts.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "geometry_lock.hpp"
+
+namespace node_gdal {
+
+// GEOS prepared geometries, the C++ API was replaced by a C API in GDAL 3.3
+//
+// When GDAL is built without GEOS all predicates return false,
+// OGRHasPreparedGeometrySupport() must be checked before using this
+class GEOSPreparedGeometry {
+    public:
+  GEOSPreparedGeometry(OGRGeometry *geom) : prepared(OGRCreatePreparedGeometry(toHandle(geom))) {
+  }
+  GEOSPreparedGeometry(const GEOSPreparedGeometry &) = delete;
+  ~GEOSPreparedGeometry() {
+    if (prepared != nullptr) OGRDestroyPreparedGeometry(prepared);
+  }
+
+  inline bool isValid() const {
+    return prepared != nullptr;
+  }
+  inline bool intersects(OGRGeometry *other) const {
+    return OGRPreparedGeometryIntersects(prepared, toHandle(other));
+  }
+  inline bool contains(OGRGeometry *other) const {
+    return OGRPreparedGeometryContains(prepared, toHandle(other));
+  }
+
+    private:
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 3)
+  static inline OGRGeometryH toHandle(OGRGeometry *geom) {
+    return OGRGeometry::ToHandle(geom);
+  }
+  OGRPreparedGeometryH prepared;
+#else
+  static inline OGRGeometry *toHandle(OGRGeometry *geom) {
+    return geom;
+  }
+  OGRPreparedGeometry *prepared;
+#endif
+};
+
+// A geometry with the GEOS prepared geometries needed to test it against many
+// other geometries on several threads
+//
+// A GEOS prepared geometry cannot be queried concurrently, every thread
+// borrows one from the pool and returns it afterwards, they are created
+// on demand and are kept for the next calls
+//
+// The predicates fall back to the plain OGR ones when GDAL does not
+// support prepared geometries
+class SharedPreparedGeometry {
+    public:
+  enum Predicate { INTERSECTS, CONTAINS };
+
+  // Takes ownership of the geometry
+  SharedPreparedGeometry(OGRGeometry *geom);
+  SharedPreparedGeometry(const SharedPreparedGeometry &) = delete;
+
+  inline OGRGeometry *geometry() const {
+    return geom.get();
+  }
+
+  // Thread-safe, the results are written to out, 1 for true, 0 for false
+  // the null and the empty geometries never match, the other geometries are
+  // locked while they are tested
+  void test(Predicate predicate, OGRGeometry *other, GByte *out);
+  void test(Predicate predicate, const std::vector<LockedGeometry> &others, GByte *out, int threads);
+  // Interleaved XY coordinates
+  void test(Predicate predicate, const double *xy, size_t count, GByte *out, int threads);
+
+    private:
+  typedef std::unique_ptr<GEOSPreparedGeometry> Prepared;
+  Prepared acquire();
+  void release(Prepared prepared);
+  bool test(Predicate predicate, const GEOSPreparedGeometry *prepared, OGRGeometry *other) const;
+
+  std::unique_ptr<OGRGeometry> geom;
+  OGREnvelope envelope;
+  bool usePrepared;
+  std::mutex lock;
+  std::vector<Prepared> idle;
+};
+
+} // namespace node_gdal
+#endif
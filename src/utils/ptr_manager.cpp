@@ -114,6 +114,7 @@ bool ObjectStore::isAlive(long uid) {
 }
 
 static inline void sortUnique(vector<long> &uids) {
+  if (uids.empty()) return;
   // Avoid deadlocks
   sort(uids.begin(), uids.end());
   // Eliminate dupes and 0s
@@ -371,6 +372,25 @@ template <> void ObjectStore::dispose(shared_ptr<ObjectStoreItem<OGRLayer *>> it
   }
 }
 
+// Explicit release of an SQL result set from a worker thread
+// The caller must hold the lock of the parent Dataset, the Layer is removed from
+// the store and the GC will have nothing left to do when reclaiming the JS object
+void ObjectStore::releaseResultSet(long uid) {
+  shared_ptr<ObjectStoreItem<OGRLayer *>> item;
+  {
+    uv_scoped_mutex lock(&master_lock);
+    auto it = uidMap<OGRLayer *>.find(uid);
+    if (it == uidMap<OGRLayer *>.end()) throw "Layer object already destroyed";
+    item = it->second;
+    if (!item->is_result_set) throw "Layer is not an SQL result set";
+    item->is_result_set = false;
+    do_dispose(uid);
+  }
+  // The Dataset lock is still held, nobody else can access it
+  LOG("Releasing OGRLayer with SQL results [%ld] [%p]", uid, item->ptr);
+  if (item->parent) item->parent->ptr->ReleaseResultSet(item->ptr);
+}
+
 // Generic disposal (called with the master lock held)
 template <typename GDALPTR> void ObjectStore::dispose(shared_ptr<ObjectStoreItem<GDALPTR>> item, bool) {
   ptrMap<GDALPTR>.erase(item->ptr);
@@ -0,0 +1,186 @@
+#include "rtree.hpp"
+#include "prepared_geometry.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace node_gdal {
+
+PackedRTree::PackedRTree(bool withGeometries)
+  : withGeometries(withGeometries),
+    items(0),
+    finished(false),
+    bounds(),
+    boxes(),
+    indices(),
+    ids(),
+    geometries(),
+    levels() {
+}
+
+void PackedRTree::add(int32_t id, const OGREnvelope &envelope, OGRGeometry *geometry) {
+  boxes.push_back(envelope);
+  ids.push_back(id);
+  if (withGeometries)
+    geometries.push_back(std::unique_ptr<OGRGeometry>(geometry));
+  else
+    delete geometry;
+  bounds.Merge(envelope);
+}
+
+// Position of (x, y) on a Hilbert curve of order 16
+// https://github.com/rawrunprotected/hilbert_curves (public domain)
+static uint32_t hilbert(uint32_t x, uint32_t y) {
+  uint32_t a = x ^ y;
+  uint32_t b = 0xFFFF ^ a;
+  uint32_t c = 0xFFFF ^ (x | y);
+  uint32_t d = x & (y ^ 0xFFFF);
+
+  uint32_t A = a | (b >> 1);
+  uint32_t B = (a >> 1) ^ a;
+  uint32_t C = ((c >> 1) ^ (b & (d >> 1))) ^ c;
+  uint32_t D = ((a & (c >> 1)) ^ (d >> 1)) ^ d;
+
+  a = A;
+  b = B;
+  c = C;
+  d = D;
+  A = ((a & (a >> 2)) ^ (b & (b >> 2)));
+  B = ((a & (b >> 2)) ^ (b & ((a ^ b) >> 2)));
+  C ^= ((a & (c >> 2)) ^ (b & (d >> 2)));
+  D ^= ((b & (c >> 2)) ^ ((a ^ b) & (d >> 2)));
+
+  a = A;
+  b = B;
+  c = C;
+  d = D;
+  A = ((a & (a >> 4)) ^ (b & (b >> 4)));
+  B = ((a & (b >> 4)) ^ (b & ((a ^ b) >> 4)));
+  C ^= ((a & (c >> 4)) ^ (b & (d >> 4)));
+  D ^= ((b & (c >> 4)) ^ ((a ^ b) & (d >> 4)));
+
+  a = A;
+  b = B;
+  c = C;
+  d = D;
+  C ^= ((a & (c >> 8)) ^ (b & (d >> 8)));
+  D ^= ((b & (c >> 8)) ^ ((a ^ b) & (d >> 8)));
+
+  a = C ^ (C >> 1);
+  b = D ^ (D >> 1);
+
+  uint32_t i0 = x ^ y;
+  uint32_t i1 = b | (0xFFFF ^ (i0 | a));
+
+  i0 = (i0 | (i0 << 8)) & 0x00FF00FF;
+  i0 = (i0 | (i0 << 4)) & 0x0F0F0F0F;
+  i0 = (i0 | (i0 << 2)) & 0x33333333;
+  i0 = (i0 | (i0 << 1)) & 0x55555555;
+
+  i1 = (i1 | (i1 << 8)) & 0x00FF00FF;
+  i1 = (i1 | (i1 << 4)) & 0x0F0F0F0F;
+  i1 = (i1 | (i1 << 2)) & 0x33333333;
+  i1 = (i1 | (i1 << 1)) & 0x55555555;
+
+  return (i1 << 1) | i0;
+}
+
+void PackedRTree::finish() {
+  if (finished) return;
+  finished = true;
+  items = boxes.size();
+  if (items == 0) return;
+
+  // Sort the items along the Hilbert curve of their centers
+  const double width = bounds.MaxX - bounds.MinX;
+  const double height = bounds.MaxY - bounds.MinY;
+  std::vector<uint32_t> values(items);
+  for (size_t i = 0; i < items; i++) {
+    const OGREnvelope &e = boxes[i];
+    uint32_t x = width > 0 ? static_cast<uint32_t>(0xFFFF * ((e.MinX + e.MaxX) / 2 - bounds.MinX) / width) : 0;
+    uint32_t y = height > 0 ? static_cast<uint32_t>(0xFFFF * ((e.MinY + e.MaxY) / 2 - bounds.MinY) / height) : 0;
+    values[i] = hilbert(x, y);
+  }
+  std::vector<size_t> order(items);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&values](size_t a, size_t b) { return values[a] < values[b]; });
+
+  std::vector<OGREnvelope> sortedBoxes(items);
+  std::vector<int32_t> sortedIds(items);
+  std::vector<std::unique_ptr<OGRGeometry>> sortedGeometries(geometries.size());
+  for (size_t i = 0; i < items; i++) {
+    sortedBoxes[i] = boxes[order[i]];
+    sortedIds[i] = ids[order[i]];
+    if (withGeometries) sortedGeometries[i] = std::move(geometries[order[i]]);
+  }
+  boxes = std::move(sortedBoxes);
+  ids = std::move(sortedIds);
+  geometries = std::move(sortedGeometries);
+
+  // Pack the nodes bottom-up until a single root remains
+  size_t levelStart = 0;
+  size_t levelEnd = items;
+  levels.push_back(levelEnd);
+  while (levelEnd - levelStart > 1) {
+    for (size_t first = levelStart; first < levelEnd; first += NODE_SIZE) {
+      OGREnvelope node;
+      size_t last = std::min(first + NODE_SIZE, levelEnd);
+      for (size_t c = first; c < last; c++) node.Merge(boxes[c]);
+      indices.push_back(first);
+      boxes.push_back(node);
+    }
+    levelStart = levelEnd;
+    levelEnd = boxes.size();
+    levels.push_back(levelEnd);
+  }
+  boxes.shrink_to_fit();
+  indices.shrink_to_fit();
+}
+
+void PackedRTree::search(const OGREnvelope &envelope, const std::function<bool(size_t)> &cb) const {
+  if (items == 0) return;
+
+  size_t root = boxes.size() - 1;
+  if (!boxes[root].Intersects(envelope)) return;
+  if (root < items) {
+    cb(root);
+    return;
+  }
+
+  std::vector<size_t> stack;
+  stack.push_back(root);
+  while (!stack.empty()) {
+    size_t node = stack.back();
+    stack.pop_back();
+    size_t first = indices[node - items];
+    size_t levelEnd = *std::upper_bound(levels.begin(), levels.end(), first);
+    size_t last = std::min(first + NODE_SIZE, levelEnd);
+    for (size_t c = first; c < last; c++) {
+      if (!boxes[c].Intersects(envelope)) continue;
+      if (c < items) {
+        if (!cb(c)) return;
+      } else {
+        stack.push_back(c);
+      }
+    }
+  }
+}
+
+void PackedRTree::intersects(OGRGeometry *geometry, const std::function<bool(size_t)> &cb) const {
+  OGREnvelope envelope;
+  geometry->getEnvelope(&envelope);
+  if (!hasGeometries()) {
+    search(envelope, cb);
+    return;
+  }
+
+  GEOSPreparedGeometry prepared(geometry);
+  search(envelope, [this, geometry, &prepared, &cb](size_t item) {
+    OGRGeometry *candidate = geometries[item].get();
+    if (candidate == nullptr) return true;
+    bool hit = prepared.isValid() ? prepared.intersects(candidate) : geometry->Intersects(candidate);
+    return hit ? cb(item) : true;
+  });
+}
+
+} // namespace node_gdal
@@ -0,0 +1,75 @@
+#ifndef __NODE_GDAL_RTREE_H__
+#define __NODE_GDAL_RTREE_H__
+
+// ogr
+#include <ogrsf_frmts.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace node_gdal {
+
+// A static packed Hilbert R-tree
+//
+// The items are sorted along a Hilbert curve and packed bottom-up
+// in nodes of NODE_SIZE children, all the nodes are stored in a single
+// array, the leaves first and the root last
+//
+// The tree is immutable once finished and can be searched concurrently
+// from any number of threads
+class PackedRTree {
+    public:
+  static const size_t NODE_SIZE = 16;
+
+  // withGeometries keeps the full geometries for exact intersection tests
+  PackedRTree(bool withGeometries);
+
+  // Adding and finishing must be done from a single thread,
+  // the tree takes ownership of the geometry
+  void add(int32_t id, const OGREnvelope &envelope, OGRGeometry *geometry = nullptr);
+  void finish();
+
+  // Calls cb for all the items whose envelopes intersect the envelope,
+  // stops if cb returns false
+  void search(const OGREnvelope &envelope, const std::function<bool(size_t)> &cb) const;
+  // Calls cb for all the items intersecting the geometry, using the full
+  // geometries when available and only the envelopes otherwise
+  void intersects(OGRGeometry *geometry, const std::function<bool(size_t)> &cb) const;
+
+  inline size_t size() const {
+    return items;
+  }
+  inline bool hasGeometries() const {
+    return withGeometries;
+  }
+  inline int32_t id(size_t item) const {
+    return ids[item];
+  }
+  inline const OGREnvelope &envelope(size_t item) const {
+    return boxes[item];
+  }
+  inline OGRGeometry *geometry(size_t item) const {
+    return withGeometries ? geometries[item].get() : nullptr;
+  }
+  inline const OGREnvelope &extent() const {
+    return bounds;
+  }
+
+    private:
+  bool withGeometries;
+  size_t items;
+  bool finished;
+  OGREnvelope bounds;
+  std::vector<OGREnvelope> boxes;
+  // For the leaves, the index of the item, for the nodes, the index of the first child
+  std::vector<size_t> indices;
+  std::vector<int32_t> ids;
+  std::vector<std::unique_ptr<OGRGeometry>> geometries;
+  // End of every level in boxes, the root is the last one
+  std::vector<size_t> levels;
+};
+
+} // namespace node_gdal
+#endif
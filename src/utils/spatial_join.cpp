@@ -0,0 +1,229 @@
+#include "spatial_join.hpp"
+#include "parallel.hpp"
+#include "typed_array.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace node_gdal {
+
+SpatialJoin::SpatialJoin(Predicate predicate, int threads)
+  : predicate(predicate),
+    threads(threads),
+    usePrepared(OGRHasPreparedGeometrySupport()),
+    tree(true),
+    rightFids(),
+    rightFeatures(),
+    rightFields(),
+    rightNames(),
+    lock(),
+    idle(),
+    leftMap(),
+    rightMap(),
+    count(0),
+    toLayer(false),
+    leftOut(),
+    rightOut() {
+}
+
+void SpatialJoin::indexRight(OGRLayer *right, const std::vector<std::string> &fields) {
+  OGRFeatureDefn *defn = right->GetLayerDefn();
+  for (const std::string &name : fields) {
+    int i = defn->GetFieldIndex(name.c_str());
+    if (i < 0) {
+      CPLError(CE_Failure, CPLE_AppDefined, "Invalid field name: %s", name.c_str());
+      throw CPLGetLastErrorMsg();
+    }
+    rightFields.push_back(i);
+    rightNames.push_back(name);
+  }
+
+  right->ResetReading();
+  OGRFeature *feature;
+  while ((feature = right->GetNextFeature()) != nullptr) {
+    FeaturePtr owned(feature, OGRFeature::DestroyFeature);
+    OGRGeometry *geom = feature->GetGeometryRef();
+    if (geom == nullptr || geom->IsEmpty()) continue;
+    if (rightFids.size() >= static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+      throw "Too many features in the right layer";
+
+    OGREnvelope envelope;
+    geom->getEnvelope(&envelope);
+    tree.add(static_cast<int32_t>(rightFids.size()), envelope, feature->StealGeometry());
+    rightFids.push_back(feature->GetFID());
+    // The attributes are needed only when copying fields
+    if (!rightFields.empty()) rightFeatures.push_back(std::move(owned));
+  }
+  tree.finish();
+}
+
+void SpatialJoin::resolveOutput(OGRFeatureDefn *leftDefn, OGRFeatureDefn *dstDefn) {
+  // The left fields are copied by name, the missing ones are ignored
+  for (int i = 0; i < leftDefn->GetFieldCount(); i++)
+    leftMap.push_back(dstDefn->GetFieldIndex(leftDefn->GetFieldDefn(i)->GetNameRef()));
+  // The requested right fields must exist
+  for (const std::string &name : rightNames) {
+    int i = dstDefn->GetFieldIndex(name.c_str());
+    if (i < 0) {
+      CPLError(CE_Failure, CPLE_AppDefined, "Destination layer does not have a field named %s", name.c_str());
+      throw CPLGetLastErrorMsg();
+    }
+    rightMap.push_back(i);
+  }
+}
+
+bool SpatialJoin::test(
+  PreparedCache &cache, OGRGeometry *left, const GEOSPreparedGeometry *leftPrepared, size_t item) {
+  OGRGeometry *right = tree.geometry(item);
+
+  if (predicate == CONTAINS) {
+    if (leftPrepared != nullptr && leftPrepared->isValid()) return leftPrepared->contains(right);
+    return left->Contains(right);
+  }
+
+  // The right geometries are prepared on first use, each one is usually tested many times
+  if (usePrepared) {
+    std::unique_ptr<GEOSPreparedGeometry> &p = cache[item];
+    if (p == nullptr) p.reset(new GEOSPreparedGeometry(right));
+    if (p->isValid()) return predicate == WITHIN ? p->contains(left) : p->intersects(left);
+  }
+  return predicate == WITHIN ? left->Within(right) : left->Intersects(right);
+}
+
+std::unique_ptr<SpatialJoin::PreparedCache> SpatialJoin::acquire() {
+  std::lock_guard<std::mutex> guard(lock);
+  if (idle.empty()) return std::unique_ptr<PreparedCache>(new PreparedCache(tree.size()));
+  std::unique_ptr<PreparedCache> cache = std::move(idle.back());
+  idle.pop_back();
+  return cache;
+}
+
+void SpatialJoin::release(std::unique_ptr<PreparedCache> cache) {
+  std::lock_guard<std::mutex> guard(lock);
+  idle.push_back(std::move(cache));
+}
+
+void SpatialJoin::matchRange(
+  PreparedCache &cache,
+  const std::vector<OGRFeature *> &chunk,
+  std::vector<std::vector<size_t>> &matches,
+  size_t begin,
+  size_t end) {
+  for (size_t i = begin; i < end; i++) {
+    OGRGeometry *left = chunk[i]->GetGeometryRef();
+    if (left == nullptr || left->IsEmpty()) continue;
+
+    OGREnvelope envelope;
+    left->getEnvelope(&envelope);
+    std::vector<size_t> candidates;
+    tree.search(envelope, [this, &envelope, &candidates](size_t item) {
+      // A geometry can be within another one only if its envelope is
+      const OGREnvelope &candidate = tree.envelope(item);
+      if (predicate == WITHIN && !candidate.Contains(envelope)) return true;
+      if (predicate == CONTAINS && !envelope.Contains(candidate)) return true;
+      candidates.push_back(item);
+      return true;
+    });
+    if (candidates.empty()) continue;
+
+    std::unique_ptr<GEOSPreparedGeometry> leftPrepared;
+    if (predicate == CONTAINS && usePrepared && candidates.size() > 1)
+      leftPrepared.reset(new GEOSPreparedGeometry(left));
+
+    for (size_t item : candidates)
+      if (test(cache, left, leftPrepared.get(), item)) matches[i].push_back(item);
+    // The reading order of the right layer
+    std::sort(matches[i].begin(), matches[i].end(), [this](size_t a, size_t b) { return tree.id(a) < tree.id(b); });
+  }
+}
+
+void SpatialJoin::matchChunk(const std::vector<OGRFeature *> &chunk, std::vector<std::vector<size_t>> &matches) {
+  matches.clear();
+  matches.resize(chunk.size());
+  parallelFor(chunk.size(), threads, [this, &chunk, &matches](size_t begin, size_t end) {
+    std::unique_ptr<PreparedCache> cache = acquire();
+    matchRange(*cache, chunk, matches, begin, end);
+    release(std::move(cache));
+  });
+}
+
+// Converts between the field types when needed
+static void copyField(OGRFeature *dst, int i, OGRFeature *src, int j) {
+  if (!src->IsFieldSetAndNotNull(j)) return;
+  OGRFieldType type = dst->GetFieldDefnRef(i)->GetType();
+  if (type == src->GetFieldDefnRef(j)->GetType()) {
+    dst->SetField(i, src->GetRawFieldRef(j));
+    return;
+  }
+  switch (type) {
+    case OFTInteger: dst->SetField(i, src->GetFieldAsInteger(j)); break;
+    case OFTInteger64: dst->SetField(i, src->GetFieldAsInteger64(j)); break;
+    case OFTReal: dst->SetField(i, src->GetFieldAsDouble(j)); break;
+    default: dst->SetField(i, src->GetFieldAsString(j)); break;
+  }
+}
+
+void SpatialJoin::writePair(OGRLayer *dst, OGRFeature *left, size_t item) {
+  FeaturePtr out(OGRFeature::CreateFeature(dst->GetLayerDefn()), OGRFeature::DestroyFeature);
+  if (out->SetFrom(left, leftMap.data(), TRUE) != OGRERR_NONE) throw CPLGetLastErrorMsg();
+  if (!rightFields.empty()) {
+    OGRFeature *right = rightFeatures[tree.id(item)].get();
+    for (size_t f = 0; f < rightFields.size(); f++) copyField(out.get(), rightMap[f], right, rightFields[f]);
+  }
+  if (dst->CreateFeature(out.get()) != OGRERR_NONE) throw CPLGetLastErrorMsg();
+}
+
+void SpatialJoin::join(OGRLayer *left, OGRLayer *dst) {
+  toLayer = dst != nullptr;
+  if (toLayer) resolveOutput(left->GetLayerDefn(), dst->GetLayerDefn());
+
+  std::vector<OGRFeature *> chunk;
+  std::vector<std::vector<size_t>> matches;
+  if (tree.size() == 0) return;
+  left->ResetReading();
+  bool done = false;
+  while (!done) {
+    chunk.clear();
+    OGRFeature *feature;
+    while (chunk.size() < CHUNK_SIZE && (feature = left->GetNextFeature()) != nullptr) chunk.push_back(feature);
+    done = chunk.size() < CHUNK_SIZE;
+
+    try {
+      matchChunk(chunk, matches);
+      for (size_t i = 0; i < chunk.size(); i++) {
+        for (size_t item : matches[i]) {
+          if (toLayer) {
+            writePair(dst, chunk[i], item);
+          } else {
+            leftOut.push<double>(static_cast<double>(chunk[i]->GetFID()));
+            rightOut.push<double>(static_cast<double>(rightFids[tree.id(item)]));
+          }
+          count++;
+        }
+      }
+    } catch (const char *) {
+      for (OGRFeature *f : chunk) OGRFeature::DestroyFeature(f);
+      throw;
+    }
+    for (OGRFeature *f : chunk) OGRFeature::DestroyFeature(f);
+  }
+}
+
+Local<Object> SpatialJoin::ToObject() {
+  Nan::EscapableHandleScope scope;
+  Local<Object> result = Nan::New<Object>();
+  Nan::Set(result, Nan::New("count").ToLocalChecked(), Nan::New<Number>(static_cast<double>(count)));
+  if (!toLayer) {
+    Nan::Set(
+      result,
+      Nan::New("left").ToLocalChecked(),
+      TypedArray::Adopt(GDT_Float64, leftOut.release(), static_cast<unsigned int>(count)));
+    Nan::Set(
+      result,
+      Nan::New("right").ToLocalChecked(),
+      TypedArray::Adopt(GDT_Float64, rightOut.release(), static_cast<unsigned int>(count)));
+  }
+  return scope.Escape(result);
+}
+
+} // namespace node_gdal
@@ -0,0 +1,93 @@
+#ifndef __NODE_GDAL_SPATIAL_JOIN_H__
+#define __NODE_GDAL_SPATIAL_JOIN_H__
+
+// node
+#include <node.h>
+
+// nan
+#include "../nan-wrapper.h"
+
+// ogr
+#include <ogrsf_frmts.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "layer_columns.hpp"
+#include "prepared_geometry.hpp"
+#include "rtree.hpp"
+
+using namespace v8;
+
+namespace node_gdal {
+
+// Spatial join between two layers
+//
+// The right layer is read entirely into a packed R-tree with its geometries,
+// the left layer is then streamed in chunks and every chunk is matched
+// against the tree, optionally on several threads, using GEOS prepared geometries
+//
+// GEOS prepared geometries cannot be queried concurrently, every thread
+// borrows a cache of lazily prepared copies of the right geometries from
+// the pool and returns it afterwards, they are kept for the next chunks
+//
+// The matching pairs are either returned as two Float64Arrays of FIDs or
+// written to a destination layer, in the reading order of the left layer
+class SpatialJoin {
+    public:
+  // left <predicate> right
+  enum Predicate { INTERSECTS, CONTAINS, WITHIN };
+
+  SpatialJoin(Predicate predicate, int threads);
+
+  // Worker thread, throws const char * on error
+  void indexRight(OGRLayer *right, const std::vector<std::string> &fields);
+  void join(OGRLayer *left, OGRLayer *dst);
+  // Main thread
+  Local<Object> ToObject();
+
+  static const size_t CHUNK_SIZE = 65536;
+
+    private:
+  typedef std::vector<std::unique_ptr<GEOSPreparedGeometry>> PreparedCache;
+  typedef std::unique_ptr<OGRFeature, void (*)(OGRFeature *)> FeaturePtr;
+
+  void resolveOutput(OGRFeatureDefn *leftDefn, OGRFeatureDefn *dstDefn);
+  void matchChunk(const std::vector<OGRFeature *> &chunk, std::vector<std::vector<size_t>> &matches);
+  // Matches the features [begin, end) of the chunk
+  void matchRange(
+    PreparedCache &cache,
+    const std::vector<OGRFeature *> &chunk,
+    std::vector<std::vector<size_t>> &matches,
+    size_t begin,
+    size_t end);
+  std::unique_ptr<PreparedCache> acquire();
+  void release(std::unique_ptr<PreparedCache> cache);
+  bool test(PreparedCache &cache, OGRGeometry *left, const GEOSPreparedGeometry *leftPrepared, size_t item);
+  void writePair(OGRLayer *dst, OGRFeature *left, size_t item);
+
+  Predicate predicate;
+  int threads;
+  bool usePrepared;
+  PackedRTree tree;
+  // Indexed by the position in the right layer, which is the tree id
+  std::vector<GIntBig> rightFids;
+  std::vector<FeaturePtr> rightFeatures;
+  std::vector<int> rightFields;
+  std::vector<std::string> rightNames;
+  std::mutex lock;
+  std::vector<std::unique_ptr<PreparedCache>> idle;
+  // Field mappings to the destination layer
+  std::vector<int> leftMap;
+  std::vector<int> rightMap;
+
+  size_t count;
+  bool toLayer;
+  ColumnBuffer leftOut;
+  ColumnBuffer rightOut;
+};
+
+} // namespace node_gdal
+#endif
@@ -0,0 +1,163 @@
+#include "srs_cache.hpp"
+
+namespace node_gdal {
+
+// The cached objects are intentionally not destroyed at exit
+// as PROJ may already be gone at that point
+ObjectCache<OGRSpatialReference> srsCache(64);
+ObjectCache<OGRCoordinateTransformation> transformationCache(64);
+
+template <> OGRSpatialReference *ObjectCache<OGRSpatialReference>::Clone(const OGRSpatialReference *obj) {
+  return obj->Clone();
+}
+
+template <> void ObjectCache<OGRSpatialReference>::Destroy(OGRSpatialReference *obj) {
+  obj->Release();
+}
+
+template <>
+OGRCoordinateTransformation *ObjectCache<OGRCoordinateTransformation>::Clone(const OGRCoordinateTransformation *obj) {
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 1)
+  return obj->Clone();
+#else
+  return nullptr;
+#endif
+}
+
+template <> void ObjectCache<OGRCoordinateTransformation>::Destroy(OGRCoordinateTransformation *obj) {
+  OGRCoordinateTransformation::DestroyCT(obj);
+}
+
+template <typename T> ObjectCache<T>::ObjectCache(size_t capacity) : capacity(capacity), hits(0), misses(0) {
+}
+
+template <typename T> T *ObjectCache<T>::get(const std::string &key) {
+  std::lock_guard<std::mutex> guard(lock);
+  auto it = index.find(key);
+  if (it == index.end()) {
+    misses++;
+    return nullptr;
+  }
+  T *clone = Clone(it->second->second);
+  if (clone == nullptr) {
+    misses++;
+    return nullptr;
+  }
+  hits++;
+  entries.splice(entries.begin(), entries, it->second);
+  return clone;
+}
+
+template <typename T> void ObjectCache<T>::put(const std::string &key, const T *obj) {
+  std::lock_guard<std::mutex> guard(lock);
+  if (capacity == 0 || index.count(key)) return;
+  T *clone = Clone(obj);
+  if (clone == nullptr) return;
+  entries.emplace_front(key, clone);
+  index[key] = entries.begin();
+  trim();
+}
+
+template <typename T> void ObjectCache<T>::trim() {
+  while (entries.size() > capacity) {
+    Destroy(entries.back().second);
+    index.erase(entries.back().first);
+    entries.pop_back();
+  }
+}
+
+template <typename T> void ObjectCache<T>::clear() {
+  std::lock_guard<std::mutex> guard(lock);
+  for (auto &entry : entries) Destroy(entry.second);
+  entries.clear();
+  index.clear();
+}
+
+template <typename T> void ObjectCache<T>::setCapacity(size_t size) {
+  std::lock_guard<std::mutex> guard(lock);
+  capacity = size;
+  trim();
+}
+
+template <typename T> Local<Object> ObjectCache<T>::ToObject() {
+  Nan::EscapableHandleScope scope;
+
+  Local<Object> obj = Nan::New<Object>();
+  std::lock_guard<std::mutex> guard(lock);
+  Nan::Set(obj, Nan::New("hits").ToLocalChecked(), Nan::New<Number>(static_cast<double>(hits)));
+  Nan::Set(obj, Nan::New("misses").ToLocalChecked(), Nan::New<Number>(static_cast<double>(misses)));
+  Nan::Set(obj, Nan::New("size").ToLocalChecked(), Nan::New<Number>(static_cast<double>(entries.size())));
+  Nan::Set(obj, Nan::New("capacity").ToLocalChecked(), Nan::New<Number>(static_cast<double>(capacity)));
+
+  return scope.Escape(obj);
+}
+
+template class ObjectCache<OGRSpatialReference>;
+template class ObjectCache<OGRCoordinateTransformation>;
+
+// OGR_CT_OP_SELECTION, OGR_CT_FORCE_TRADITIONAL_GIS_ORDER, OSR_USE_NON_DEPRECATED,
+// OSR_DEFAULT_AXIS_MAPPING_STRATEGY, PROJ_NETWORK...
+bool IsSRSConfigOption(const std::string &name) {
+  return STARTS_WITH_CI(name.c_str(), "OGR_CT_") || STARTS_WITH_CI(name.c_str(), "OSR_") ||
+    STARTS_WITH_CI(name.c_str(), "PROJ_");
+}
+
+OGRErr CachedSpatialReference(
+  const std::string &key, const std::function<OGRErr(OGRSpatialReference *)> &import, OGRSpatialReference *&srs) {
+  srs = key.empty() ? nullptr : srsCache.get(key);
+  if (srs != nullptr) return OGRERR_NONE;
+
+  srs = new OGRSpatialReference();
+  OGRErr err = import(srs);
+  if (err != OGRERR_NONE) {
+    delete srs;
+    srs = nullptr;
+    return err;
+  }
+  if (!key.empty()) srsCache.put(key, srs);
+  return OGRERR_NONE;
+}
+
+// The WKT alone does not identify a transformation, the axis order
+// and the coordinate epoch of both sides are also needed
+static bool transformationKey(OGRSpatialReference *srs, std::string &key) {
+  char *wkt = nullptr;
+#if GDAL_VERSION_MAJOR >= 3
+  const char *const options[] = {"FORMAT=WKT2_2018", nullptr};
+  OGRErr err = srs->exportToWkt(&wkt, options);
+#else
+  OGRErr err = srs->exportToWkt(&wkt);
+#endif
+  if (err != OGRERR_NONE || wkt == nullptr || *wkt == '\0') {
+    CPLFree(wkt);
+    return false;
+  }
+  key += wkt;
+  CPLFree(wkt);
+#if GDAL_VERSION_MAJOR >= 3
+  for (int axis : srs->GetDataAxisToSRSAxisMapping()) key += "|" + std::to_string(axis);
+#endif
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 4)
+  key += "@" + std::to_string(srs->GetCoordinateEpoch());
+#endif
+  key += "\n";
+  return true;
+}
+
+OGRCoordinateTransformation *CachedCoordinateTransformation(OGRSpatialReference *src, OGRSpatialReference *dst) {
+#if GDAL_VERSION_MAJOR > 3 || (GDAL_VERSION_MAJOR == 3 && GDAL_VERSION_MINOR >= 1)
+  std::string key;
+  if (!transformationKey(src, key) || !transformationKey(dst, key)) return OGRCreateCoordinateTransformation(src, dst);
+
+  OGRCoordinateTransformation *ct = transformationCache.get(key);
+  if (ct != nullptr) return ct;
+
+  ct = OGRCreateCoordinateTransformation(src, dst);
+  if (ct != nullptr) transformationCache.put(key, ct);
+  return ct;
+#else
+  return OGRCreateCoordinateTransformation(src, dst);
+#endif
+}
+
+} // namespace node_gdal
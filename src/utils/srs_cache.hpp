@@ -0,0 +1,77 @@
+#ifndef __NODE_GDAL_SRS_CACHE_H__
+#define __NODE_GDAL_SRS_CACHE_H__
+
+// node
+#include <node.h>
+
+// nan
+#include "../nan-wrapper.h"
+
+// ogr
+#include <ogr_spatialref.h>
+
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+using namespace v8;
+
+namespace node_gdal {
+
+// Process-wide LRU cache of objects whose creation goes through PROJ
+//
+// Parsing a SRS definition or instantiating a transformation pipeline often
+// takes milliseconds, much more than the operation that uses it
+//
+// The cached objects are never handed out, every hit returns a private clone
+// that can be modified or used by another thread, as neither the spatial
+// references nor the transformations are reentrant
+//
+// All methods are thread-safe
+template <typename T> class ObjectCache {
+    public:
+  ObjectCache(size_t capacity);
+
+  // Returns a clone or nullptr if the key is not cached
+  T *get(const std::string &key);
+  // Stores a clone of the object, the caller keeps the original
+  void put(const std::string &key, const T *obj);
+  void clear();
+  // 0 disables the cache
+  void setCapacity(size_t capacity);
+
+  // { hits, misses, size, capacity }
+  Local<Object> ToObject();
+
+    private:
+  static T *Clone(const T *obj);
+  static void Destroy(T *obj);
+  void trim();
+
+  std::mutex lock;
+  std::list<std::pair<std::string, T *>> entries;
+  std::unordered_map<std::string, typename std::list<std::pair<std::string, T *>>::iterator> index;
+  size_t capacity, hits, misses;
+};
+
+extern ObjectCache<OGRSpatialReference> srsCache;
+extern ObjectCache<OGRCoordinateTransformation> transformationCache;
+
+// Whether a config option can change the objects created through PROJ,
+// both caches must be cleared when it is set
+bool IsSRSConfigOption(const std::string &name);
+
+// Initializes a spatial reference through the cache, key must uniquely identify
+// the import method and its input, an empty key bypasses the cache,
+// returns the error of import
+OGRErr CachedSpatialReference(
+  const std::string &key, const std::function<OGRErr(OGRSpatialReference *)> &import, OGRSpatialReference *&srs);
+
+// OGRCreateCoordinateTransformation() through the cache, transformations can
+// only be cloned with GDAL 3.1 and later
+OGRCoordinateTransformation *CachedCoordinateTransformation(OGRSpatialReference *src, OGRSpatialReference *dst);
+
+} // namespace node_gdal
+#endif
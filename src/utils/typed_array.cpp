@@ -6,30 +6,70 @@ namespace node_gdal {
 
 // https://github.com/joyent/node/issues/4201#issuecomment-9837340
 
-Local<Value> TypedArray::New(GDALDataType type, unsigned int length) {
+static const char *ConstructorName(GDALDataType type) {
+  switch (type) {
+    case GDT_Byte: return "Uint8Array";
+    case GDT_Int16: return "Int16Array";
+    case GDT_UInt16: return "Uint16Array";
+    case GDT_Int32: return "Int32Array";
+    case GDT_UInt32: return "Uint32Array";
+    case GDT_Float32: return "Float32Array";
+    case GDT_Float64: return "Float64Array";
+    default: return nullptr;
+  }
+}
+
+// Creates the TypedArray view, argv are the arguments of the TypedArray constructor
+static Local<Value> NewView(GDALDataType type, int argc, Local<Value> *argv) {
+  Nan::EscapableHandleScope scope;
+
+  Local<Object> global = Nan::GetCurrentContext()->Global();
+  Local<Value> val = Nan::Get(global, Nan::New(ConstructorName(type)).ToLocalChecked()).ToLocalChecked();
+
+  if (val.IsEmpty() || !val->IsFunction()) {
+    Nan::ThrowError("Error getting typed array constructor");
+    return scope.Escape(Nan::Undefined());
+  }
+
+  Local<Function> constructor = val.As<Function>();
+  Local<Object> array = Nan::NewInstance(constructor, argc, argv).ToLocalChecked();
+
+  if (array.IsEmpty() || !array->IsObject()) {
+    Nan::ThrowError("Error creating TypedArray");
+    return scope.Escape(Nan::Undefined());
+  }
+
+  Nan::Set(array, Nan::New("_gdal_type").ToLocalChecked(), Nan::New(type));
+
+  return scope.Escape(array);
+}
+
+// Creates the TypedArray view over the ArrayBuffer of a Node.js Buffer
+static Local<Value> NewBufferView(GDALDataType type, Local<Object> buffer, unsigned int length) {
+  Local<Value> argv[] = {
+    Nan::Get(buffer, Nan::New("buffer").ToLocalChecked()).ToLocalChecked(),
+    Nan::Get(buffer, Nan::New("byteOffset").ToLocalChecked()).ToLocalChecked(),
+    Nan::New<Integer>(length)};
+  return NewView(type, 3, argv);
+}
+
+Local<Value> TypedArray::New(GDALDataType type, unsigned int length, bool shared) {
   Nan::EscapableHandleScope scope;
 
   Local<Value> val;
   Local<Function> constructor;
   Local<Object> global = Nan::GetCurrentContext()->Global();
 
-  const char *name;
-  switch (type) {
-    case GDT_Byte: name = "Uint8Array"; break;
-    case GDT_Int16: name = "Int16Array"; break;
-    case GDT_UInt16: name = "Uint16Array"; break;
-    case GDT_Int32: name = "Int32Array"; break;
-    case GDT_UInt32: name = "Uint32Array"; break;
-    case GDT_Float32: name = "Float32Array"; break;
-    case GDT_Float64: name = "Float64Array"; break;
-    default: Nan::ThrowError("Unsupported array type"); return scope.Escape(Nan::Undefined());
+  if (ConstructorName(type) == nullptr) {
+    Nan::ThrowError("Unsupported array type");
+    return scope.Escape(Nan::Undefined());
   }
 
-  // make ArrayBuffer
-  val = Nan::Get(global, Nan::New("ArrayBuffer").ToLocalChecked()).ToLocalChecked();
+  // make ArrayBuffer or SharedArrayBuffer
+  val = Nan::Get(global, Nan::New(shared ? "SharedArrayBuffer" : "ArrayBuffer").ToLocalChecked()).ToLocalChecked();
 
   if (val.IsEmpty() || !val->IsFunction()) {
-    Nan::ThrowError("Error getting ArrayBuffer constructor");
+    Nan::ThrowError(shared ? "SharedArrayBuffer is not available" : "Error getting ArrayBuffer constructor");
     return scope.Escape(Nan::Undefined());
   }
 
@@ -43,26 +83,109 @@ Local<Value> TypedArray::New(GDALDataType type, unsigned int length) {
   }
 
   // make TypedArray
-  val = Nan::Get(global, Nan::New(name).ToLocalChecked()).ToLocalChecked();
+  return scope.Escape(NewView(type, 1, &array_buffer));
+}
 
-  if (val.IsEmpty() || !val->IsFunction()) {
-    Nan::ThrowError("Error getting typed array constructor");
+// The backing store is allocated by GDAL with the requested alignment
+// and it is then handed to Node.js as an external Buffer
+// The GC will call the lambda at some point to free it
+Local<Value> TypedArray::NewExternal(GDALDataType type, unsigned int length, size_t alignment) {
+  Nan::EscapableHandleScope scope;
+
+  if (ConstructorName(type) == nullptr) {
+    Nan::ThrowError("Unsupported array type");
+    return scope.Escape(Nan::Undefined());
+  }
+  if (!ValidateAlignment(alignment)) {
+    Nan::ThrowRangeError("Alignment must be a power of 2 and a multiple of the pointer size");
     return scope.Escape(Nan::Undefined());
   }
 
-  constructor = val.As<Function>();
-  Local<Object> array = Nan::NewInstance(constructor, 1, &array_buffer).ToLocalChecked();
+  size_t size = static_cast<size_t>(length) * (GDALGetDataTypeSize(type) / 8);
+  // zero-sized aligned allocations are implementation-defined
+  void *data = VSIMallocAligned(alignment, size > 0 ? size : alignment);
+  if (data == nullptr) {
+    Nan::ThrowError("Error allocating aligned memory");
+    return scope.Escape(Nan::Undefined());
+  }
 
-  if (array.IsEmpty() || !array->IsObject()) {
-    Nan::ThrowError("Error creating TypedArray");
+  Local<Object> buffer = NewExternalBuffer(data, size, VSIFreeAligned);
+
+  return scope.Escape(NewBufferView(type, buffer, length));
+}
+
+struct ExternalStorage {
+  size_t size;
+  void (*release)(void *);
+};
+
+// If you malloc, you adjust external memory too (https://github.com/nodejs/node/issues/40936)
+// The GC will call the lambda at some point to free the backing storage,
+// as it cannot capture anything, the size and the deallocator go in the hint
+Local<Object> TypedArray::NewExternalBuffer(void *data, size_t size, void (*release)(void *)) {
+  Nan::AdjustExternalMemory(static_cast<int>(size));
+  ExternalStorage *hint = new ExternalStorage{size, release};
+  return Nan::NewBuffer(
+           static_cast<char *>(data),
+           size,
+           [](char *data, void *hint) {
+             ExternalStorage *storage = reinterpret_cast<ExternalStorage *>(hint);
+             Nan::AdjustExternalMemory(-static_cast<int>(storage->size));
+             storage->release(data);
+             delete storage;
+           },
+           hint)
+    .ToLocalChecked();
+}
+
+// Takes the ownership of a backing store allocated with VSIMalloc
+// (typically in a worker thread) without copying it
+Local<Value> TypedArray::Adopt(GDALDataType type, void *data, unsigned int length) {
+  Nan::EscapableHandleScope scope;
+
+  if (ConstructorName(type) == nullptr) {
+    VSIFree(data);
+    Nan::ThrowError("Unsupported array type");
     return scope.Escape(Nan::Undefined());
   }
 
-  Nan::Set(array, Nan::New("_gdal_type").ToLocalChecked(), Nan::New(type));
+  size_t size = static_cast<size_t>(length) * (GDALGetDataTypeSize(type) / 8);
+  Local<Object> buffer = NewExternalBuffer(data, size, VSIFree);
+
+  return scope.Escape(NewBufferView(type, buffer, length));
+}
+
+// Same as Adopt but for 64-bit integers which do not have a GDALDataType
+// The resulting BigInt64Array cannot be used for raster I/O
+Local<Value> TypedArray::AdoptBigInt64(void *data, unsigned int length) {
+  Nan::EscapableHandleScope scope;
+
+  Local<Object> global = Nan::GetCurrentContext()->Global();
+  Local<Value> val = Nan::Get(global, Nan::New("BigInt64Array").ToLocalChecked()).ToLocalChecked();
+  if (val.IsEmpty() || !val->IsFunction()) {
+    VSIFree(data);
+    Nan::ThrowError("BigInt64Array is not available");
+    return scope.Escape(Nan::Undefined());
+  }
+
+  Local<Object> buffer = NewExternalBuffer(data, static_cast<size_t>(length) * sizeof(int64_t), VSIFree);
+  Local<Value> argv[] = {
+    Nan::Get(buffer, Nan::New("buffer").ToLocalChecked()).ToLocalChecked(),
+    Nan::Get(buffer, Nan::New("byteOffset").ToLocalChecked()).ToLocalChecked(),
+    Nan::New<Integer>(length)};
+  Local<Object> array = Nan::NewInstance(val.As<Function>(), 3, argv).ToLocalChecked();
 
   return scope.Escape(array);
 }
 
+bool TypedArray::IsSupported(GDALDataType type) {
+  return ConstructorName(type) != nullptr;
+}
+
+bool TypedArray::ValidateAlignment(int64_t alignment) {
+  return alignment >= static_cast<int64_t>(sizeof(void *)) && (alignment & (alignment - 1)) == 0;
+}
+
 GDALDataType TypedArray::Identify(Local<Object> obj) {
   Nan::HandleScope scope;
 
@@ -45,7 +45,16 @@ namespace node_gdal {
 
 namespace TypedArray {
 
-Local<Value> New(GDALDataType type, unsigned int length);
+Local<Value> New(GDALDataType type, unsigned int length, bool shared = false);
+Local<Value> NewExternal(GDALDataType type, unsigned int length, size_t alignment);
+Local<Value> Adopt(GDALDataType type, void *data, unsigned int length);
+// Wraps memory allocated by GDAL in a Buffer without copying it, release frees it
+// once the Buffer has been garbage collected
+Local<Object> NewExternalBuffer(void *data, size_t size, void (*release)(void *));
+Local<Value> AdoptBigInt64(void *data, unsigned int length);
+bool ValidateAlignment(int64_t alignment);
+// Whether a TypedArray can hold this data type
+bool IsSupported(GDALDataType type);
 GDALDataType Identify(Local<Object> array);
 void *Validate(Local<Object> obj, GDALDataType type, int min_length);
 bool ValidateLength(int length, int min_length);
@@ -0,0 +1,158 @@
+#include "union_all.hpp"
+#include "../geometry/gdal_geometry.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+
+namespace node_gdal {
+
+static std::unique_ptr<OGRGeometry> checked(OGRGeometry *geom) {
+  if (geom == nullptr) {
+    const char *err = CPLGetLastErrorMsg();
+    throw err[0] ? err : "Union failed";
+  }
+  return std::unique_ptr<OGRGeometry>(geom);
+}
+
+// Separates the polygons from the rest, the collections are flattened
+static void collect(OGRGeometry *geom, OGRMultiPolygon &polygons, std::vector<std::unique_ptr<OGRGeometry>> &others) {
+  if (geom->IsEmpty()) return;
+  switch (wkbFlatten(geom->getGeometryType())) {
+    case wkbPolygon: polygons.addGeometry(geom); break;
+    case wkbMultiPolygon:
+    case wkbGeometryCollection:
+      for (OGRGeometry *child : *geom->toGeometryCollection()) collect(child, polygons, others);
+      break;
+    default: others.emplace_back(geom->clone()); break;
+  }
+}
+
+// Balanced tree of pairwise unions
+static std::unique_ptr<OGRGeometry> reduce(std::vector<std::unique_ptr<OGRGeometry>> level) {
+  while (level.size() > 1) {
+    std::vector<std::unique_ptr<OGRGeometry>> next;
+    for (size_t i = 0; i < level.size(); i += 2) {
+      if (i + 1 == level.size())
+        next.push_back(std::move(level[i]));
+      else
+        next.push_back(checked(level[i]->Union(level[i + 1].get())));
+    }
+    level = std::move(next);
+  }
+  if (level.empty()) return nullptr;
+  return std::move(level[0]);
+}
+
+static std::unique_ptr<OGRGeometry> unionRange(OGRGeometry *const *geoms, size_t count) {
+  OGRMultiPolygon polygons;
+  std::vector<std::unique_ptr<OGRGeometry>> parts;
+  for (size_t i = 0; i < count; i++)
+    if (geoms[i] != nullptr) collect(geoms[i], polygons, parts);
+
+  if (polygons.getNumGeometries() == 1)
+    parts.emplace_back(polygons.getGeometryRef(0)->clone());
+  else if (polygons.getNumGeometries() > 1)
+    parts.push_back(checked(polygons.UnionCascaded()));
+  return reduce(std::move(parts));
+}
+
+std::unique_ptr<OGRGeometry> UnionAll::Union(OGRGeometry *const *geoms, size_t count, int threads) {
+  const size_t chunks = std::min(count, static_cast<size_t>(std::max(threads, 1)));
+  if (chunks <= 1) return unionRange(geoms, count);
+
+  std::vector<std::unique_ptr<OGRGeometry>> partials(chunks);
+  parallelFor(chunks, threads, [geoms, count, chunks, &partials](size_t begin, size_t end) {
+    for (size_t c = begin; c < end; c++) {
+      const size_t first = c * count / chunks;
+      const size_t last = (c + 1) * count / chunks;
+      partials[c] = unionRange(geoms + first, last - first);
+    }
+  });
+
+  std::vector<OGRGeometry *> raw;
+  for (const std::unique_ptr<OGRGeometry> &partial : partials) raw.push_back(partial.get());
+  return unionRange(raw.data(), raw.size());
+}
+
+UnionAll::UnionAll(int threads) : threads(threads), index(), keys(), groups(), owned(), results() {
+}
+
+void UnionAll::add(const std::string &key, OGRGeometry *geom) {
+  auto it = index.find(key);
+  if (it == index.end()) {
+    it = index.emplace(key, groups.size()).first;
+    keys.push_back(key);
+    groups.emplace_back();
+  }
+  if (geom != nullptr) groups[it->second].push_back(geom);
+}
+
+void UnionAll::add(const std::string &key, const LockedGeometry &geom) {
+  OGRGeometry *copy = nullptr;
+  if (geom.geom != nullptr) {
+    GeometryGuard guard(geom);
+    copy = geom.geom->clone();
+  }
+  if (copy != nullptr) owned.emplace_back(copy);
+  add(key, copy);
+}
+
+void UnionAll::addLayer(OGRLayer *layer, const std::string &groupBy) {
+  int field = -1;
+  if (!groupBy.empty()) {
+    field = layer->GetLayerDefn()->GetFieldIndex(groupBy.c_str());
+    if (field < 0) {
+      CPLError(CE_Failure, CPLE_AppDefined, "Invalid field name: %s", groupBy.c_str());
+      throw CPLGetLastErrorMsg();
+    }
+  }
+
+  layer->ResetReading();
+  OGRFeature *feature;
+  while ((feature = layer->GetNextFeature()) != nullptr) {
+    std::string key;
+    if (field >= 0 && feature->IsFieldSetAndNotNull(field)) key = feature->GetFieldAsString(field);
+    OGRGeometry *geom = feature->StealGeometry();
+    OGRFeature::DestroyFeature(feature);
+    if (geom != nullptr) {
+      if (geom->getSpatialReference() == nullptr) geom->assignSpatialReference(layer->GetSpatialRef());
+      owned.emplace_back(geom);
+    }
+    add(key, geom);
+  }
+}
+
+void UnionAll::run() {
+  results.resize(groups.size());
+  if (groups.size() >= static_cast<size_t>(threads)) {
+    parallelFor(groups.size(), threads, [this](size_t begin, size_t end) {
+      for (size_t g = begin; g < end; g++) results[g] = Union(groups[g].data(), groups[g].size(), 1);
+    });
+  } else {
+    for (size_t g = 0; g < groups.size(); g++) results[g] = Union(groups[g].data(), groups[g].size(), threads);
+  }
+
+  // The intermediate geometries lose the spatial reference
+  for (size_t g = 0; g < groups.size(); g++)
+    if (results[g] && !groups[g].empty()) results[g]->assignSpatialReference(groups[g][0]->getSpatialReference());
+}
+
+Local<Value> UnionAll::ToValue(bool grouped) {
+  Nan::EscapableHandleScope scope;
+
+  if (!grouped) {
+    if (results.empty() || !results[0]) return scope.Escape(Nan::Null());
+    return scope.Escape(Geometry::New(results[0].release(), true));
+  }
+
+  Local<Object> obj = Nan::New<Object>();
+  for (size_t g = 0; g < keys.size(); g++) {
+    Nan::Set(
+      obj,
+      Nan::New(keys[g]).ToLocalChecked(),
+      results[g] ? Geometry::New(results[g].release(), true) : Nan::Null().As<Value>());
+  }
+  return scope.Escape(obj);
+}
+
+} // namespace node_gdal
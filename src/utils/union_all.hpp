@@ -0,0 +1,63 @@
+#ifndef __NODE_GDAL_UNION_ALL_H__
+#define __NODE_GDAL_UNION_ALL_H__
+
+// node
+#include <node.h>
+
+// nan
+#include "../nan-wrapper.h"
+
+// ogr
+#include <ogrsf_frmts.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "geometry_lock.hpp"
+
+using namespace v8;
+
+namespace node_gdal {
+
+// Union of many geometries, optionally grouped by a key
+//
+// The polygons are merged with a GEOS cascaded union, the other geometries
+// with a balanced tree of pairwise unions, then both results are merged
+// (OGR does not expose the GEOS unary union)
+//
+// A single group is split in contiguous chunks unioned on several threads
+// before a final union of the partial results, when there are at least as
+// many groups as threads the groups are unioned in parallel instead
+class UnionAll {
+    public:
+  UnionAll(int threads);
+
+  // Main thread, the geometry must outlive run()
+  void add(const std::string &key, OGRGeometry *geom);
+  // Worker thread, adds a copy of the geometry made while holding its lock
+  void add(const std::string &key, const LockedGeometry &geom);
+  // Worker thread, reads the geometries of a layer grouped by a field or by
+  // nothing if groupBy is empty, throws const char * on error
+  void addLayer(OGRLayer *layer, const std::string &groupBy);
+  // Worker thread, throws const char * on error
+  void run();
+  // A Geometry or null, or an object with one Geometry (or null) per key
+  Local<Value> ToValue(bool grouped);
+
+  // Returns nullptr if there are no non-empty geometries
+  static std::unique_ptr<OGRGeometry> Union(OGRGeometry *const *geoms, size_t count, int threads);
+
+    private:
+  int threads;
+  // Key -> group index, the groups are in the order of the first appearance of their key
+  std::map<std::string, size_t> index;
+  std::vector<std::string> keys;
+  std::vector<std::vector<OGRGeometry *>> groups;
+  std::vector<std::unique_ptr<OGRGeometry>> owned;
+  std::vector<std::unique_ptr<OGRGeometry>> results;
+};
+
+} // namespace node_gdal
+#endif
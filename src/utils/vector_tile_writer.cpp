@@ -0,0 +1,516 @@
+#include "vector_tile_writer.hpp"
+#include "../gdal_memfile.hpp"
+#include "srs_cache.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+namespace node_gdal {
+
+// Half of the circumference of the WGS84 ellipsoid at the equator
+static const double webMercatorOrigin = 20037508.342789244;
+
+/*
+ * The transformations to and from WebMercator of a layer, they come from the
+ * process-wide transformation cache as creating them requires instantiating a
+ * PROJ pipeline which is often more expensive than encoding a small tile.
+ * Layers without a SRS are assumed to be in WebMercator.
+ */
+struct TileTransformLease {
+  // To and from WebMercator, null for the identity
+  OGRCoordinateTransformation *forward;
+  OGRCoordinateTransformation *inverse;
+
+  TileTransformLease(OGRSpatialReference *srs) : forward(nullptr), inverse(nullptr) {
+    if (srs == nullptr) return;
+
+    OGRSpatialReference *webMercator;
+    OGRErr err = CachedSpatialReference(
+      "EPSG:3857", [](OGRSpatialReference *ref) { return ref->importFromEPSG(3857); }, webMercator);
+    if (err != OGRERR_NONE) throw CPLGetLastErrorMsg();
+    std::unique_ptr<OGRSpatialReference, void (*)(OGRSpatialReference *)> guard(
+      webMercator, [](OGRSpatialReference *ref) { ref->Release(); });
+#if GDAL_VERSION_MAJOR >= 3
+    webMercator->SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+#endif
+    if (srs->IsSame(webMercator)) return;
+
+    forward = CachedCoordinateTransformation(srs, webMercator);
+    inverse = CachedCoordinateTransformation(webMercator, srs);
+    if (forward == nullptr || inverse == nullptr) {
+      destroy();
+      throw "Failed creating a transformation to WebMercator";
+    }
+  }
+  ~TileTransformLease() {
+    destroy();
+  }
+
+    private:
+  void destroy() {
+    if (forward != nullptr) OGRCoordinateTransformation::DestroyCT(forward);
+    if (inverse != nullptr) OGRCoordinateTransformation::DestroyCT(inverse);
+    forward = inverse = nullptr;
+  }
+};
+
+// Minimal protobuf encoding
+enum { PBF_VARINT = 0, PBF_I64 = 1, PBF_LEN = 2 };
+
+static void pbfVarint(std::string &out, uint64_t v) {
+  while (v >= 0x80) {
+    out.push_back(static_cast<char>((v & 0x7f) | 0x80));
+    v >>= 7;
+  }
+  out.push_back(static_cast<char>(v));
+}
+
+static inline void pbfKey(std::string &out, int field, int type) {
+  pbfVarint(out, static_cast<uint64_t>((field << 3) | type));
+}
+
+static void pbfBytes(std::string &out, int field, const char *data, size_t len) {
+  pbfKey(out, field, PBF_LEN);
+  pbfVarint(out, len);
+  out.append(data, len);
+}
+
+static inline void pbfBytes(std::string &out, int field, const std::string &bytes) {
+  pbfBytes(out, field, bytes.data(), bytes.size());
+}
+
+static void pbfPacked(std::string &out, int field, const std::vector<uint32_t> &values) {
+  std::string packed;
+  for (uint32_t v : values) pbfVarint(packed, v);
+  pbfBytes(out, field, packed);
+}
+
+static void pbfDouble(std::string &out, int field, double v) {
+  uint64_t bits;
+  memcpy(&bits, &v, sizeof(bits));
+  pbfKey(out, field, PBF_I64);
+  for (int i = 0; i < 8; i++) out.push_back(static_cast<char>((bits >> (i * 8)) & 0xff));
+}
+
+static inline uint32_t zigzag(int32_t v) {
+  return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+static inline uint64_t zigzag64(int64_t v) {
+  return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+// MVT geometry commands
+enum { MVT_MOVE_TO = 1, MVT_LINE_TO = 2, MVT_CLOSE_PATH = 7 };
+
+static inline uint32_t command(int id, size_t count) {
+  return static_cast<uint32_t>(id & 0x7) | static_cast<uint32_t>(count << 3);
+}
+
+// Coordinates far outside of the buffered tile are found only without GEOS,
+// they are clamped so that the deltas cannot overflow
+static inline int32_t quantize(double v) {
+  const double limit = static_cast<double>(1 << 29);
+  return static_cast<int32_t>(std::max(-limit, std::min(limit, std::round(v))));
+}
+
+// Quantized points without the consecutive duplicates
+static void quantizeCurve(OGRSimpleCurve *curve, std::vector<std::pair<int32_t, int32_t>> &points) {
+  points.reserve(curve->getNumPoints());
+  for (int i = 0; i < curve->getNumPoints(); i++) {
+    std::pair<int32_t, int32_t> p(quantize(curve->getX(i)), quantize(curve->getY(i)));
+    if (points.empty() || p != points.back()) points.push_back(p);
+  }
+}
+
+VectorTileWriter::VectorTileWriter(const VectorTileOptions &options)
+  : count(0),
+    options(options),
+    out(),
+    names(),
+    minX(0),
+    maxY(0),
+    span(0),
+    clipBox(),
+    clipPolygon(),
+    fields(),
+    keyIndex(),
+    keys(),
+    valueIndex(),
+    values(),
+    cx(0),
+    cy(0) {
+  span = 2 * webMercatorOrigin / std::ldexp(1.0, options.z);
+  minX = -webMercatorOrigin + options.x * span;
+  maxY = webMercatorOrigin - options.y * span;
+
+  clipBox.MinX = clipBox.MinY = -options.buffer;
+  clipBox.MaxX = clipBox.MaxY = options.extent + options.buffer;
+  OGRLinearRing *ring = new OGRLinearRing();
+  ring->addPoint(clipBox.MinX, clipBox.MinY);
+  ring->addPoint(clipBox.MaxX, clipBox.MinY);
+  ring->addPoint(clipBox.MaxX, clipBox.MaxY);
+  ring->addPoint(clipBox.MinX, clipBox.MaxY);
+  ring->closeRings();
+  OGRPolygon *polygon = new OGRPolygon();
+  polygon->addRingDirectly(ring);
+  clipPolygon.reset(polygon);
+}
+
+void VectorTileWriter::resolveFields(OGRFeatureDefn *defn) {
+  fields.clear();
+  keys.clear();
+  valueIndex.clear();
+  values.clear();
+  if (options.allFields) {
+    for (int i = 0; i < defn->GetFieldCount(); i++) fields.push_back(i);
+  } else {
+    // The layers do not necessarily have the same fields
+    for (const std::string &name : options.fields) {
+      int i = defn->GetFieldIndex(name.c_str());
+      if (i >= 0) fields.push_back(i);
+    }
+  }
+  // The keys are added when they are first used
+  keyIndex.assign(fields.size(), -1);
+}
+
+// The buffered tile bounds in the SRS of the layer
+static bool filterEnvelope(OGRCoordinateTransformation *inverse, const OGREnvelope &bounds, OGREnvelope &result) {
+  if (inverse == nullptr) {
+    result = bounds;
+    return true;
+  }
+
+  // The edges are densified as the transformation is not linear
+  const int n = 21;
+  std::vector<double> xs, ys;
+  for (int i = 0; i < n; i++) {
+    const double t = static_cast<double>(i) / (n - 1);
+    const double x = bounds.MinX + t * (bounds.MaxX - bounds.MinX);
+    const double y = bounds.MinY + t * (bounds.MaxY - bounds.MinY);
+    xs.insert(xs.end(), {x, x, bounds.MinX, bounds.MaxX});
+    ys.insert(ys.end(), {bounds.MinY, bounds.MaxY, y, y});
+  }
+  std::vector<int> success(xs.size());
+#if GDAL_VERSION_MAJOR >= 3
+  inverse->Transform(static_cast<int>(xs.size()), xs.data(), ys.data(), nullptr, success.data());
+#else
+  inverse->TransformEx(static_cast<int>(xs.size()), xs.data(), ys.data(), nullptr, success.data());
+#endif
+
+  bool any = false;
+  for (size_t i = 0; i < xs.size(); i++) {
+    if (!success[i] || !std::isfinite(xs[i]) || !std::isfinite(ys[i])) continue;
+    if (!any) {
+      result.MinX = result.MaxX = xs[i];
+      result.MinY = result.MaxY = ys[i];
+      any = true;
+    } else {
+      result.Merge(xs[i], ys[i]);
+    }
+  }
+  return any;
+}
+
+void VectorTileWriter::addLayer(OGRLayer *layer) {
+  const char *name = layer->GetName();
+  if (!names.insert(name).second) {
+    CPLError(CE_Failure, CPLE_AppDefined, "Duplicate layer name %s", name);
+    throw CPLGetLastErrorMsg();
+  }
+  resolveFields(layer->GetLayerDefn());
+
+  TileTransformLease lease(layer->GetSpatialRef());
+
+  const double margin = options.buffer * span / options.extent;
+  OGREnvelope bounds;
+  bounds.MinX = minX - margin;
+  bounds.MaxX = minX + span + margin;
+  bounds.MinY = maxY - span - margin;
+  bounds.MaxY = maxY + margin;
+  OGREnvelope filter;
+  if (!filterEnvelope(lease.inverse, bounds, filter)) return;
+
+  // The spatial filter of the layer is restored afterwards
+  OGRGeometry *previous = layer->GetSpatialFilter();
+  std::unique_ptr<OGRGeometry> saved(previous != nullptr ? previous->clone() : nullptr);
+  layer->SetSpatialFilterRect(filter.MinX, filter.MinY, filter.MaxX, filter.MaxY);
+  layer->ResetReading();
+
+  std::string features;
+  size_t layerCount = 0;
+  try {
+    OGRFeature *feature;
+    while ((feature = layer->GetNextFeature()) != nullptr) {
+      std::unique_ptr<OGRFeature, void (*)(OGRFeature *)> owned(feature, OGRFeature::DestroyFeature);
+      OGRGeometry *geom = feature->GetGeometryRef();
+      if (geom == nullptr || geom->IsEmpty()) continue;
+
+      std::unique_ptr<OGRGeometry> tiled;
+      if (!prepareGeometry(geom, lease.forward, tiled)) continue;
+      if (writeFeature(feature, tiled.get(), geom->getDimension(), features)) layerCount++;
+    }
+  } catch (const char *) {
+    layer->SetSpatialFilter(saved.get());
+    throw;
+  }
+  layer->SetSpatialFilter(saved.get());
+  layer->ResetReading();
+
+  if (layerCount == 0) return;
+  count += layerCount;
+
+  std::string msg;
+  pbfKey(msg, 15, PBF_VARINT);
+  pbfVarint(msg, 2);
+  pbfBytes(msg, 1, name, strlen(name));
+  msg.append(features);
+  for (const std::string &key : keys) pbfBytes(msg, 3, key);
+  for (const std::string *value : values) pbfBytes(msg, 4, *value);
+  pbfKey(msg, 5, PBF_VARINT);
+  pbfVarint(msg, static_cast<uint64_t>(options.extent));
+
+  std::string header;
+  pbfKey(header, 3, PBF_LEN);
+  pbfVarint(header, msg.size());
+  memcpy(out.grow(header.size()), header.data(), header.size());
+  memcpy(out.grow(msg.size()), msg.data(), msg.size());
+}
+
+// Returns false if the geometry is outside of the tile
+bool VectorTileWriter::prepareGeometry(
+  OGRGeometry *geom, OGRCoordinateTransformation *ct, std::unique_ptr<OGRGeometry> &result) {
+  result.reset(geom->hasCurveGeometry() ? geom->getLinearGeometry() : geom->clone());
+  if (result == nullptr) return false;
+  result->flattenTo2D();
+  // Points outside of the domain of WebMercator (ie the poles) cannot be reprojected
+  if (ct != nullptr && result->transform(ct) != OGRERR_NONE) return false;
+  if (!toTile(result.get())) return false;
+
+  OGREnvelope envelope;
+  result->getEnvelope(&envelope);
+  if (!envelope.Intersects(clipBox)) return false;
+
+  // The points are clipped when encoding, the renderers clip anyway
+  // so the unclipped geometry is used when GEOS is not available or fails
+  const int dim = result->getDimension();
+  const bool geos = dim > 0 && OGRGeometryFactory::haveGEOS();
+  if (geos && !clipBox.Contains(envelope)) {
+    OGRGeometry *clipped = result->Intersection(clipPolygon.get());
+    if (clipped != nullptr)
+      result.reset(clipped);
+    else
+      CPLErrorReset();
+  }
+  if (geos && options.simplify > 0) {
+    OGRGeometry *simplified =
+      dim == 2 ? result->SimplifyPreserveTopology(options.simplify) : result->Simplify(options.simplify);
+    if (simplified != nullptr)
+      result.reset(simplified);
+    else
+      CPLErrorReset();
+  }
+  return !result->IsEmpty();
+}
+
+// Converts WebMercator coordinates to tile coordinates in place
+bool VectorTileWriter::toTile(OGRGeometry *geom) {
+  const double scale = options.extent / span;
+  OGRwkbGeometryType type = wkbFlatten(geom->getGeometryType());
+
+  if (type == wkbPoint) {
+    OGRPoint *point = static_cast<OGRPoint *>(geom);
+    point->setX((point->getX() - minX) * scale);
+    point->setY((maxY - point->getY()) * scale);
+    return true;
+  }
+  if (type == wkbLineString || type == wkbLinearRing) {
+    OGRSimpleCurve *line = static_cast<OGRSimpleCurve *>(geom);
+    for (int i = 0; i < line->getNumPoints(); i++)
+      line->setPoint(i, (line->getX(i) - minX) * scale, (maxY - line->getY(i)) * scale);
+    return true;
+  }
+  if (OGR_GT_IsSubClassOf(type, wkbPolygon)) {
+    OGRPolygon *polygon = static_cast<OGRPolygon *>(geom);
+    if (polygon->getExteriorRing() != nullptr && !toTile(polygon->getExteriorRing())) return false;
+    for (int i = 0; i < polygon->getNumInteriorRings(); i++)
+      if (!toTile(polygon->getInteriorRing(i))) return false;
+    return true;
+  }
+  if (OGR_GT_IsSubClassOf(type, wkbGeometryCollection)) {
+    OGRGeometryCollection *collection = static_cast<OGRGeometryCollection *>(geom);
+    for (int i = 0; i < collection->getNumGeometries(); i++)
+      if (!toTile(collection->getGeometryRef(i))) return false;
+    return true;
+  }
+  // Polyhedral surfaces and TINs are not supported
+  return false;
+}
+
+void VectorTileWriter::collectPoints(OGRGeometry *geom, TilePoints &points) {
+  OGRwkbGeometryType type = wkbFlatten(geom->getGeometryType());
+  if (type == wkbPoint) {
+    OGRPoint *point = static_cast<OGRPoint *>(geom);
+    if (point->IsEmpty()) return;
+    const double x = point->getX(), y = point->getY();
+    if (x < clipBox.MinX || x > clipBox.MaxX || y < clipBox.MinY || y > clipBox.MaxY) return;
+    points.push_back(std::make_pair(quantize(x), quantize(y)));
+  } else if (OGR_GT_IsSubClassOf(type, wkbGeometryCollection)) {
+    OGRGeometryCollection *collection = static_cast<OGRGeometryCollection *>(geom);
+    for (int i = 0; i < collection->getNumGeometries(); i++) collectPoints(collection->getGeometryRef(i), points);
+  }
+}
+
+void VectorTileWriter::pushPoint(const std::pair<int32_t, int32_t> &p, std::vector<uint32_t> &cmds) {
+  cmds.push_back(zigzag(p.first - cx));
+  cmds.push_back(zigzag(p.second - cy));
+  cx = p.first;
+  cy = p.second;
+}
+
+bool VectorTileWriter::encodeLine(OGRSimpleCurve *line, std::vector<uint32_t> &cmds) {
+  TilePoints points;
+  quantizeCurve(line, points);
+  if (points.size() < 2) return false;
+
+  cmds.push_back(command(MVT_MOVE_TO, 1));
+  pushPoint(points[0], cmds);
+  cmds.push_back(command(MVT_LINE_TO, points.size() - 1));
+  for (size_t i = 1; i < points.size(); i++) pushPoint(points[i], cmds);
+  return true;
+}
+
+// The exterior rings have a positive area (clockwise with Y pointing down)
+// and the interior rings a negative one, the degenerate rings are dropped
+bool VectorTileWriter::encodeRing(OGRSimpleCurve *ring, bool exterior, std::vector<uint32_t> &cmds) {
+  TilePoints points;
+  quantizeCurve(ring, points);
+  if (points.size() > 1 && points.front() == points.back()) points.pop_back();
+  if (points.size() < 3) return false;
+
+  int64_t area = 0;
+  for (size_t i = 0; i < points.size(); i++) {
+    const std::pair<int32_t, int32_t> &a = points[i];
+    const std::pair<int32_t, int32_t> &b = points[(i + 1) % points.size()];
+    area += static_cast<int64_t>(a.first) * b.second - static_cast<int64_t>(b.first) * a.second;
+  }
+  if (area == 0) return false;
+  if ((area > 0) != exterior) std::reverse(points.begin(), points.end());
+
+  cmds.push_back(command(MVT_MOVE_TO, 1));
+  pushPoint(points[0], cmds);
+  cmds.push_back(command(MVT_LINE_TO, points.size() - 1));
+  for (size_t i = 1; i < points.size(); i++) pushPoint(points[i], cmds);
+  cmds.push_back(command(MVT_CLOSE_PATH, 1));
+  return true;
+}
+
+// Encodes the parts of the given dimension, clipping can produce mixed collections
+bool VectorTileWriter::encodeGeometry(OGRGeometry *geom, int dim, std::vector<uint32_t> &cmds) {
+  OGRwkbGeometryType type = wkbFlatten(geom->getGeometryType());
+
+  if (dim == 0) {
+    TilePoints points;
+    collectPoints(geom, points);
+    if (points.empty()) return false;
+    cmds.push_back(command(MVT_MOVE_TO, points.size()));
+    for (const std::pair<int32_t, int32_t> &p : points) pushPoint(p, cmds);
+    return true;
+  }
+
+  if (OGR_GT_IsSubClassOf(type, wkbGeometryCollection)) {
+    OGRGeometryCollection *collection = static_cast<OGRGeometryCollection *>(geom);
+    bool any = false;
+    for (int i = 0; i < collection->getNumGeometries(); i++)
+      any = encodeGeometry(collection->getGeometryRef(i), dim, cmds) || any;
+    return any;
+  }
+
+  if (dim == 1 && (type == wkbLineString || type == wkbLinearRing))
+    return encodeLine(static_cast<OGRSimpleCurve *>(geom), cmds);
+
+  if (dim == 2 && OGR_GT_IsSubClassOf(type, wkbPolygon)) {
+    OGRPolygon *polygon = static_cast<OGRPolygon *>(geom);
+    if (polygon->getExteriorRing() == nullptr || !encodeRing(polygon->getExteriorRing(), true, cmds)) return false;
+    for (int i = 0; i < polygon->getNumInteriorRings(); i++) encodeRing(polygon->getInteriorRing(i), false, cmds);
+    return true;
+  }
+
+  return false;
+}
+
+void VectorTileWriter::encodeTags(OGRFeature *feature, std::vector<uint32_t> &tags) {
+  for (size_t k = 0; k < fields.size(); k++) {
+    const int i = fields[k];
+    if (!feature->IsFieldSetAndNotNull(i)) continue;
+
+    OGRFieldDefn *field_defn = feature->GetFieldDefnRef(i);
+    OGRFieldType type = field_defn->GetType();
+    std::string value;
+    if (type == OFTInteger && field_defn->GetSubType() == OFSTBoolean) {
+      pbfKey(value, 7, PBF_VARINT);
+      pbfVarint(value, feature->GetFieldAsInteger(i) ? 1 : 0);
+    } else if (type == OFTInteger || type == OFTInteger64) {
+      GIntBig v = feature->GetFieldAsInteger64(i);
+      if (v < 0) {
+        pbfKey(value, 6, PBF_VARINT);
+        pbfVarint(value, zigzag64(v));
+      } else {
+        pbfKey(value, 5, PBF_VARINT);
+        pbfVarint(value, static_cast<uint64_t>(v));
+      }
+    } else if (type == OFTReal) {
+      pbfDouble(value, 3, feature->GetFieldAsDouble(i));
+    } else {
+      const char *str = feature->GetFieldAsString(i);
+      pbfBytes(value, 1, str, strlen(str));
+    }
+
+    if (keyIndex[k] < 0) {
+      keyIndex[k] = static_cast<int>(keys.size());
+      keys.push_back(field_defn->GetNameRef());
+    }
+    // The values are deduplicated on their encoded form
+    auto it = valueIndex.find(value);
+    if (it == valueIndex.end()) {
+      it = valueIndex.emplace(value, static_cast<uint32_t>(values.size())).first;
+      values.push_back(&it->first);
+    }
+    tags.push_back(static_cast<uint32_t>(keyIndex[k]));
+    tags.push_back(it->second);
+  }
+}
+
+bool VectorTileWriter::writeFeature(OGRFeature *feature, OGRGeometry *geom, int dim, std::string &features) {
+  std::vector<uint32_t> cmds;
+  cx = cy = 0;
+  if (!encodeGeometry(geom, dim, cmds)) return false;
+
+  std::vector<uint32_t> tags;
+  encodeTags(feature, tags);
+
+  std::string msg;
+  GIntBig fid = feature->GetFID();
+  if (fid >= 0) {
+    pbfKey(msg, 1, PBF_VARINT);
+    pbfVarint(msg, static_cast<uint64_t>(fid));
+  }
+  if (!tags.empty()) pbfPacked(msg, 2, tags);
+  // POINT = 1, LINESTRING = 2, POLYGON = 3
+  pbfKey(msg, 3, PBF_VARINT);
+  pbfVarint(msg, static_cast<uint64_t>(dim + 1));
+  pbfPacked(msg, 4, cmds);
+  pbfBytes(features, 2, msg);
+  return true;
+}
+
+Local<Value> VectorTileWriter::ToBuffer() {
+  Nan::EscapableHandleScope scope;
+  size_t len = out.size;
+  return scope.Escape(Memfile::NewBuffer(static_cast<GByte *>(out.release()), len));
+}
+
+} // namespace node_gdal
@@ -0,0 +1,88 @@
+#ifndef __NODE_GDAL_VECTOR_TILE_WRITER_H__
+#define __NODE_GDAL_VECTOR_TILE_WRITER_H__
+
+// node
+#include <node.h>
+
+// nan
+#include "../nan-wrapper.h"
+
+// ogr
+#include <ogrsf_frmts.h>
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "layer_columns.hpp"
+
+using namespace v8;
+
+namespace node_gdal {
+
+struct VectorTileOptions {
+  int z, x, y;
+  int extent;
+  int buffer;
+  // Tolerance in tile units, 0 to disable
+  double simplify;
+  std::vector<std::string> fields;
+  bool allFields;
+};
+
+// Encodes the features of several layers as a Mapbox Vector Tile (MVT 2.1)
+//
+// Every layer is filtered with the (buffered) tile bounds, its geometries are
+// reprojected to WebMercator, converted to tile coordinates, clipped to the
+// buffered tile, simplified and quantized before being encoded as protobuf
+//
+// The coordinate transformations are cached between calls by source SRS
+class VectorTileWriter {
+    public:
+  VectorTileWriter(const VectorTileOptions &options);
+
+  // Worker thread, throws const char * on error
+  void addLayer(OGRLayer *layer);
+  // Returns an empty Buffer if no features were written
+  Local<Value> ToBuffer();
+
+  size_t count;
+
+    private:
+  typedef std::vector<std::pair<int32_t, int32_t>> TilePoints;
+
+  void resolveFields(OGRFeatureDefn *defn);
+  bool prepareGeometry(OGRGeometry *geom, OGRCoordinateTransformation *ct, std::unique_ptr<OGRGeometry> &result);
+  bool toTile(OGRGeometry *geom);
+  void collectPoints(OGRGeometry *geom, TilePoints &points);
+  void pushPoint(const std::pair<int32_t, int32_t> &p, std::vector<uint32_t> &cmds);
+  bool encodeGeometry(OGRGeometry *geom, int dim, std::vector<uint32_t> &cmds);
+  bool encodeLine(OGRSimpleCurve *line, std::vector<uint32_t> &cmds);
+  bool encodeRing(OGRSimpleCurve *ring, bool exterior, std::vector<uint32_t> &cmds);
+  void encodeTags(OGRFeature *feature, std::vector<uint32_t> &tags);
+  bool writeFeature(OGRFeature *feature, OGRGeometry *geom, int dim, std::string &features);
+
+  VectorTileOptions options;
+  ColumnBuffer out;
+  std::set<std::string> names;
+  // Tile bounds in WebMercator
+  double minX, maxY, span;
+  // Clipping box in tile coordinates
+  OGREnvelope clipBox;
+  std::unique_ptr<OGRGeometry> clipPolygon;
+
+  // Per layer state
+  std::vector<int> fields;
+  std::vector<int> keyIndex;
+  std::vector<std::string> keys;
+  // Encoded value -> index, values points to its keys
+  std::map<std::string, uint32_t> valueIndex;
+  std::vector<const std::string *> values;
+  // Command encoder cursor
+  int cx, cy;
+};
+
+} // namespace node_gdal
+#endif
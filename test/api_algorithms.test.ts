@@ -431,4 +431,406 @@ describe('gdal', () => {
       assert.isAbove(calls, 0)
     })
   })
+  describe('spatialJoin()', () => {
+    let points: gdal.Layer, polygons: gdal.Layer
+    // Returns the pairs as [ id, name ]
+    const pairs = (left: gdal.Layer, right: gdal.Layer, r: gdal.SpatialJoinResult) => {
+      assert.instanceOf(r.left, Float64Array)
+      assert.instanceOf(r.right, Float64Array)
+      assert.lengthOf(r.left as Float64Array, r.count)
+      return Array.from(r.left as Float64Array).map((fid, i) => [
+        left.features.get(fid).fields.get(left === points ? 'id' : 'name'),
+        right.features.get((r.right as Float64Array)[i]).fields.get(right === points ? 'id' : 'name')
+      ])
+    }
+    beforeEach(() => {
+      const ds = gdal.open('temp', 'w', 'Memory')
+      polygons = ds.layers.create('polygons', null, gdal.Polygon)
+      polygons.fields.add(new gdal.FieldDefn('name', gdal.OFTString))
+      const cells = { A: [ 0, 0 ], B: [ 5, 0 ], C: [ 0, 5 ], D: [ 5, 5 ] } as Record<string, number[]>
+      for (const name of Object.keys(cells)) {
+        const [ x, y ] = cells[name]
+        const f = new gdal.Feature(polygons)
+        f.fields.set('name', name)
+        f.setGeometry(gdal.Geometry.fromWKT(
+          `POLYGON ((${x} ${y}, ${x + 5} ${y}, ${x + 5} ${y + 5}, ${x} ${y + 5}, ${x} ${y}))`))
+        polygons.features.add(f)
+      }
+      points = ds.layers.create('points', null, gdal.Point)
+      points.fields.add(new gdal.FieldDefn('id', gdal.OFTInteger))
+      // The last point is on the boundary of A and B
+      const coords = [ [ 1, 1 ], [ 6, 1 ], [ 1, 6 ], [ 6, 6 ], [ 20, 20 ], [ 5, 1 ] ]
+      coords.forEach(([ x, y ], id) => {
+        const f = new gdal.Feature(points)
+        f.fields.set('id', id)
+        f.setGeometry(new gdal.Point(x, y))
+        points.features.add(f)
+      })
+      const f = new gdal.Feature(points)
+      f.fields.set('id', 99)
+      points.features.add(f)
+    })
+    it('should return the pairs matching "intersects" by default', () => {
+      const r = gdal.spatialJoin(points, polygons)
+      assert.equal(r.count, 6)
+      assert.deepEqual(pairs(points, polygons, r), [
+        [ 0, 'A' ], [ 1, 'B' ], [ 2, 'C' ], [ 3, 'D' ], [ 5, 'A' ], [ 5, 'B' ]
+      ])
+    })
+    it('should support "within"', () => {
+      const r = gdal.spatialJoin(points, polygons, { predicate: 'within' })
+      assert.deepEqual(pairs(points, polygons, r), [ [ 0, 'A' ], [ 1, 'B' ], [ 2, 'C' ], [ 3, 'D' ] ])
+    })
+    it('should support "contains"', () => {
+      assert.equal(gdal.spatialJoin(points, polygons, { predicate: 'contains' }).count, 0)
+      const r = gdal.spatialJoin(polygons, points, { predicate: 'contains' })
+      assert.deepEqual(pairs(polygons, points, r), [ [ 'A', 0 ], [ 'B', 1 ], [ 'C', 2 ], [ 'D', 3 ] ])
+    })
+    it('should produce the same results on several threads', () => {
+      const r1 = gdal.spatialJoin(points, polygons, { threads: 1 })
+      const r4 = gdal.spatialJoin(points, polygons, { threads: 4 })
+      assert.deepEqual(r4, r1)
+    })
+    it('should respect the layer filters', () => {
+      polygons.setAttributeFilter('name = \'B\'')
+      const r = gdal.spatialJoin(points, polygons)
+      assert.deepEqual(pairs(points, polygons, r), [ [ 1, 'B' ], [ 5, 'B' ] ])
+    })
+    it('should write the pairs to a layer', () => {
+      const ds = gdal.open('temp', 'w', 'Memory')
+      const dst = ds.layers.create('joined', null, gdal.Point)
+      dst.fields.add(new gdal.FieldDefn('id', gdal.OFTInteger))
+      dst.fields.add(new gdal.FieldDefn('name', gdal.OFTString))
+      const r = gdal.spatialJoin(points, polygons, { predicate: 'within', fields: [ 'name' ], dst })
+      assert.equal(r.count, 4)
+      assert.isUndefined(r.left)
+      assert.equal(dst.features.count(), 4)
+      assert.deepEqual(dst.features.map((f) => [ f.fields.get('id'), f.fields.get('name') ]), [
+        [ 0, 'A' ], [ 1, 'B' ], [ 2, 'C' ], [ 3, 'D' ]
+      ])
+      assert.equal((dst.features.first().getGeometry() as gdal.Point).x, 1)
+    })
+    it('should throw on invalid arguments', () => {
+      assert.throws(() => {
+        gdal.spatialJoin(points, polygons, { predicate: 'overlaps' })
+      }, /predicate must be one of/)
+      assert.throws(() => {
+        gdal.spatialJoin(points, polygons, { threads: 0 })
+      }, /threads must be a positive integer/)
+      assert.throws(() => {
+        gdal.spatialJoin(points, polygons, { fields: [ 'name' ] })
+      }, /only to a dst layer/)
+      const dst = gdal.open('temp', 'w', 'Memory').layers.create('joined', null, gdal.Point)
+      assert.throws(() => {
+        gdal.spatialJoin(points, polygons, { fields: [ 'nope' ], dst })
+      }, /Invalid field name: nope/)
+      assert.throws(() => {
+        gdal.spatialJoin(points, polygons, { fields: [ 'name' ], dst })
+      }, /does not have a field named name/)
+    })
+  })
+  describe('spatialJoinAsync()', () => {
+    it('should return the pairs', () => {
+      const ds = gdal.open('temp', 'w', 'Memory')
+      const polygons = ds.layers.create('polygons', null, gdal.Polygon)
+      const f = new gdal.Feature(polygons)
+      f.setGeometry(gdal.Geometry.fromWKT('POLYGON ((0 0, 1 0, 1 1, 0 1, 0 0))'))
+      polygons.features.add(f)
+      return assert.isFulfilled(gdal.spatialJoinAsync(polygons, polygons, { predicate: 'within' }).then((r) => {
+        assert.equal(r.count, 1)
+        assert.deepEqual(Array.from(r.left as Float64Array), Array.from(r.right as Float64Array))
+      }))
+    })
+  })
+
+  describe('renderVectorTile()', () => {
+    const origin = 20037508.342789244
+    // One tile unit at z = 1 with the default extent
+    const unit = origin / 4096
+    const mercator = (lon: number, lat: number) => [
+      lon * origin / 180,
+      Math.log(Math.tan((90 + lat) * Math.PI / 360)) * origin / Math.PI
+    ]
+    let ds: gdal.Dataset, points: gdal.Layer, areas: gdal.Layer
+    beforeEach(() => {
+      ds = gdal.open('temp', 'w', 'Memory')
+      const wgs84 = gdal.SpatialReference.fromEPSG(4326)
+      points = ds.layers.create('points', wgs84, gdal.Point)
+      points.fields.add(new gdal.FieldDefn('name', gdal.OFTString))
+      points.fields.add(new gdal.FieldDefn('n', gdal.OFTInteger))
+      // The second point is outside of the tile z = 1, x = 1, y = 0
+      for (const [ name, lon, lat ] of [ [ 'a', 10, 10 ], [ 'b', -100, -10 ] ] as [string, number, number][]) {
+        const f = new gdal.Feature(points)
+        f.fields.set('name', name)
+        f.fields.set('n', 42)
+        f.setGeometry(new gdal.Point(lon, lat))
+        points.features.add(f)
+      }
+      areas = ds.layers.create('areas', wgs84, gdal.Polygon)
+      const f = new gdal.Feature(areas)
+      f.setGeometry(gdal.Geometry.fromWKT('POLYGON ((-10 -10, 10 -10, 10 10, -10 10, -10 -10))'))
+      areas.features.add(f)
+    })
+    afterEach(() => {
+      ds.close()
+    })
+
+    const decode = (tile: Buffer, z: number, x: number, y: number) => {
+      const file = `/vsimem/vector_tile/${z}/${x}/${y}.pbf`
+      gdal.vsimem.set(tile, file)
+      const mvt = gdal.open(file)
+      const layers: Record<string, gdal.Feature[]> = {}
+      mvt.layers.forEach((layer) => {
+        layers[layer.name] = layer.features.map((f) => f)
+      })
+      mvt.close()
+      gdal.vsimem.release(file)
+      return layers
+    }
+
+    it('should encode the layers as a Mapbox Vector Tile', () => {
+      const tile = gdal.renderVectorTile([ points, areas ], { z: 1, x: 1, y: 0 })
+      assert.instanceOf(tile, Buffer)
+      const layers = decode(tile, 1, 1, 0)
+      assert.sameMembers(Object.keys(layers), [ 'points', 'areas' ])
+
+      assert.lengthOf(layers.points, 1)
+      assert.equal(layers.points[0].fields.get('name'), 'a')
+      assert.equal(layers.points[0].fields.get('n'), 42)
+      const point = layers.points[0].getGeometry() as gdal.Point
+      const [ x, y ] = mercator(10, 10)
+      assert.closeTo(point.x, x, unit)
+      assert.closeTo(point.y, y, unit)
+
+      // The polygon is clipped to the tile with the default buffer of 64 units
+      assert.lengthOf(layers.areas, 1)
+      const envelope = layers.areas[0].getGeometry().getEnvelope()
+      assert.closeTo(envelope.minX, -64 * unit, unit)
+      assert.closeTo(envelope.maxX, mercator(10, 10)[0], unit)
+      assert.closeTo(envelope.minY, -64 * unit, unit)
+    })
+    it('should include only the requested fields', () => {
+      const tile = gdal.renderVectorTile([ points ], { z: 1, x: 1, y: 0, fields: [ 'n', 'missing' ] })
+      const layers = decode(tile, 1, 1, 0)
+      assert.isNull(layers.points[0].fields.get('name'))
+      assert.equal(layers.points[0].fields.get('n'), 42)
+    })
+    it('should restore the spatial filter of the layers', () => {
+      gdal.renderVectorTile([ points ], { z: 1, x: 1, y: 0 })
+      assert.isNull(points.getSpatialFilter())
+      assert.equal(points.features.count(), 2)
+    })
+    it('should return an empty Buffer for an empty tile', () => {
+      const tile = gdal.renderVectorTile([ points, areas ], { z: 4, x: 0, y: 0 })
+      assert.instanceOf(tile, Buffer)
+      assert.lengthOf(tile, 0)
+    })
+    it('should throw on invalid arguments', () => {
+      assert.throws(() => {
+        gdal.renderVectorTile([ points ], { z: 1, x: 2, y: 0 })
+      }, /out of range/)
+      assert.throws(() => {
+        gdal.renderVectorTile([ ds as unknown as gdal.Layer ], { z: 0, x: 0, y: 0 })
+      }, /layers must be an array of Layer/)
+      assert.throws(() => {
+        gdal.renderVectorTile([], { z: 0, x: 0, y: 0 })
+      }, /at least one Layer/)
+      assert.throws(() => {
+        gdal.renderVectorTile([ points ], { z: 0, x: 0, y: 0, extent: 0 })
+      }, /extent must be a positive integer/)
+      assert.throws(() => {
+        gdal.renderVectorTile([ points, points ], { z: 0, x: 0, y: 0 })
+      }, /Duplicate layer name points/)
+    })
+  })
+
+  describe('renderVectorTileAsync()', () => {
+    it('should encode the layers as a Mapbox Vector Tile', () => {
+      const ds = gdal.open('temp', 'w', 'Memory')
+      const lines = ds.layers.create('lines', null, gdal.LineString)
+      const f = new gdal.Feature(lines)
+      f.setGeometry(gdal.Geometry.fromWKT('LINESTRING (-1000000 -1000000, 1000000 1000000)'))
+      lines.features.add(f)
+      return assert.isFulfilled(gdal.renderVectorTileAsync([ lines ], { z: 0, x: 0, y: 0 }).then((tile) => {
+        assert.instanceOf(tile, Buffer)
+        assert.isAbove(tile.length, 0)
+      }))
+    })
+  })
+
+  describe('unionAll()', () => {
+    // 10 x 10 unit squares overlapping by half a unit
+    const squares = () => {
+      const r = [] as gdal.Geometry[]
+      for (let x = 0; x < 10; x++) {
+        for (let y = 0; y < 10; y++) {
+          r.push(gdal.Geometry.fromWKT(
+            `POLYGON ((${x} ${y}, ${x + 1.5} ${y}, ${x + 1.5} ${y + 1.5}, ${x} ${y + 1.5}, ${x} ${y}))`))
+        }
+      }
+      return r
+    }
+    it('should union an array of geometries', () => {
+      const geoms = squares() as (gdal.Geometry | null)[]
+      geoms.push(null, new gdal.Polygon())
+      const union = gdal.unionAll(geoms, { threads: 1 }) as gdal.Polygon
+      assert.instanceOf(union, gdal.Polygon)
+      assert.closeTo(union.getArea(), 10.5 * 10.5, 1e-9)
+    })
+    it('should produce the same result on several threads', () => {
+      const union1 = gdal.unionAll(squares(), { threads: 1 }) as gdal.Geometry
+      const union4 = gdal.unionAll(squares(), { threads: 4 }) as gdal.Geometry
+      assert.isTrue(union1.equals(union4))
+    })
+    it('should union the geometries that are not polygons', () => {
+      const union = gdal.unionAll([
+        gdal.Geometry.fromWKT('LINESTRING (0 0, 2 0)'),
+        gdal.Geometry.fromWKT('LINESTRING (1 0, 3 0)'),
+        gdal.Geometry.fromWKT('POLYGON ((0 1, 1 1, 1 2, 0 2, 0 1))')
+      ]) as gdal.GeometryCollection
+      assert.instanceOf(union, gdal.GeometryCollection)
+      assert.closeTo(union.getArea(), 1, 1e-9)
+    })
+    it('should return null for no geometries', () => {
+      assert.isNull(gdal.unionAll([]))
+      assert.isNull(gdal.unionAll([ null ]))
+    })
+    it('should group an array by keys', () => {
+      const geoms = squares()
+      const keys = geoms.map((g, i) => (i < 50 ? 'west' : 'east'))
+      const groups = gdal.unionAll(geoms, { groupBy: keys }) as Record<string, gdal.Geometry>
+      assert.sameMembers(Object.keys(groups), [ 'west', 'east' ])
+      assert.closeTo((groups.west as gdal.Polygon).getArea(), 5.5 * 10.5, 1e-9)
+      assert.closeTo((groups.east as gdal.Polygon).getArea(), 5.5 * 10.5, 1e-9)
+    })
+    it('should group a layer by a field', () => {
+      const ds = gdal.open('temp', 'w', 'Memory')
+      const srs = gdal.SpatialReference.fromEPSG(3857)
+      const layer = ds.layers.create('squares', srs, gdal.Polygon)
+      layer.fields.add(new gdal.FieldDefn('row', gdal.OFTInteger))
+      squares().forEach((g, i) => {
+        const f = new gdal.Feature(layer)
+        f.fields.set('row', i % 10)
+        f.setGeometry(g)
+        layer.features.add(f)
+      })
+      const groups = gdal.unionAll(layer, { groupBy: 'row', threads: 4 }) as Record<string, gdal.Geometry>
+      assert.lengthOf(Object.keys(groups), 10)
+      assert.closeTo((groups['3'] as gdal.Polygon).getArea(), 10.5 * 1.5, 1e-9)
+      assert.isTrue((groups['3'].srs as gdal.SpatialReference).isSame(srs))
+
+      const union = gdal.unionAll(layer) as gdal.Polygon
+      assert.closeTo(union.getArea(), 10.5 * 10.5, 1e-9)
+    })
+    it('should throw on invalid arguments', () => {
+      assert.throws(() => {
+        gdal.unionAll({} as gdal.Geometry[])
+      }, /must be an array of Geometry objects or a Layer/)
+      assert.throws(() => {
+        gdal.unionAll([ {} as gdal.Geometry ])
+      }, /must be Geometry objects or null/)
+      assert.throws(() => {
+        gdal.unionAll(squares(), { groupBy: [ 'a' ] })
+      }, /one key per geometry/)
+      assert.throws(() => {
+        gdal.unionAll(squares(), { threads: 0 })
+      }, /threads must be a positive integer/)
+      const layer = gdal.open('temp', 'w', 'Memory').layers.create('empty', null, gdal.Polygon)
+      assert.throws(() => {
+        gdal.unionAll(layer, { groupBy: 'nope' })
+      }, /Invalid field name: nope/)
+    })
+  })
+
+  describe('unionAllAsync()', () => {
+    it('should union an array of geometries', () => {
+      const geoms = [
+        gdal.Geometry.fromWKT('POLYGON ((0 0, 2 0, 2 2, 0 2, 0 0))'),
+        gdal.Geometry.fromWKT('POLYGON ((1 1, 3 1, 3 3, 1 3, 1 1))')
+      ]
+      return assert.isFulfilled(gdal.unionAllAsync(geoms).then((union) => {
+        assert.closeTo((union as gdal.Polygon).getArea(), 7, 1e-9)
+      }))
+    })
+    it('should not be affected by changes to the array', () => {
+      const geoms = [
+        gdal.Geometry.fromWKT('POLYGON ((0 0, 2 0, 2 2, 0 2, 0 0))'),
+        gdal.Geometry.fromWKT('POLYGON ((1 1, 3 1, 3 3, 1 3, 1 1))')
+      ]
+      const q = gdal.unionAllAsync(geoms, { threads: 2 })
+      geoms.length = 0
+      global.gc()
+      return assert.isFulfilled(q.then((union) => {
+        assert.closeTo((union as gdal.Polygon).getArea(), 7, 1e-9)
+      }))
+    })
+  })
+
+  describe('bufferMany()', () => {
+    it('should buffer every geometry', () => {
+      const r = gdal.bufferMany([ new gdal.Point(0, 0), null, new gdal.Point(10, 10) ], 1, { threads: 2 })
+      assert.lengthOf(r, 3)
+      assert.isNull(r[1])
+      assert.instanceOf(r[0], gdal.Polygon)
+      assert.closeTo((r[2] as gdal.Polygon).getArea(), Math.PI, 0.01)
+      const centroid = (r[2] as gdal.Polygon).centroid()
+      assert.closeTo(centroid.x, 10, 1e-6)
+    })
+    it('should throw on invalid arguments', () => {
+      assert.throws(() => {
+        gdal.bufferMany([ new gdal.Point(0, 0) ], 1, { threads: 0 })
+      }, /threads must be a positive integer/)
+      assert.throws(() => {
+        gdal.bufferMany([ 'POINT (0 0)' as unknown as gdal.Geometry ], 1)
+      }, /must be Geometry objects or null/)
+    })
+  })
+
+  describe('bufferManyAsync()', () => {
+    it('should buffer every geometry', () =>
+      assert.isFulfilled(gdal.bufferManyAsync([ new gdal.Point(0, 0) ], 1, { segments: 4 }).then((r) => {
+        assert.equal((r[0] as gdal.Polygon).rings.get(0).points.count(), 17)
+      })))
+  })
+
+  describe('simplifyMany()', () => {
+    it('should simplify every geometry', () => {
+      const line = gdal.Geometry.fromWKT('LINESTRING (0 0, 1 0.01, 2 0)')
+      const r = gdal.simplifyMany([ line, line ], 0.1, { preserveTopology: true })
+      assert.lengthOf(r, 2)
+      assert.equal((r[0] as gdal.LineString).points.count(), 2)
+      assert.equal((r[1] as gdal.LineString).points.count(), 2)
+    })
+  })
+
+  describe('simplifyManyAsync()', () => {
+    it('should simplify every geometry', () => {
+      const line = gdal.Geometry.fromWKT('LINESTRING (0 0, 1 0.01, 2 0)')
+      return assert.isFulfilled(gdal.simplifyManyAsync([ line ], 0.1).then((r) => {
+        assert.equal((r[0] as gdal.LineString).points.count(), 2)
+      }))
+    })
+  })
+
+  if (gdal.bundled) {
+    describe('makeValidMany()', () => {
+      it('should make valid every geometry', () => {
+        const bowtie = gdal.Geometry.fromWKT('POLYGON ((0 0, 2 2, 2 0, 0 2, 0 0))')
+        assert.isFalse(bowtie.isValid())
+        const r = gdal.makeValidMany([ bowtie, null ], { threads: 2 })
+        assert.isTrue((r[0] as gdal.Geometry).isValid())
+        assert.closeTo((r[0] as gdal.MultiPolygon).getArea(), 2, 1e-9)
+        assert.isNull(r[1])
+      })
+    })
+
+    describe('makeValidManyAsync()', () => {
+      it('should make valid every geometry', () => {
+        const bowtie = gdal.Geometry.fromWKT('POLYGON ((0 0, 2 2, 2 0, 0 2, 0 0))')
+        return assert.isFulfilled(gdal.makeValidManyAsync([ bowtie ]).then((r) => {
+          assert.isTrue((r[0] as gdal.Geometry).isValid())
+        }))
+      })
+    })
+  }
 })
@@ -0,0 +1,104 @@
+import * as gdal from '..'
+import * as chai from 'chai'
+const assert = chai.assert
+import * as chaiAsPromised from 'chai-as-promised'
+chai.use(chaiAsPromised)
+
+describe('gdal.ApproxTransformer', () => {
+  afterEach(global.gc)
+
+  const utm = gdal.SpatialReference.fromEPSG(32631)
+  const webMercator = gdal.SpatialReference.fromEPSG(3857)
+  const geoTransform = [ 400000, 100, 0, 5000000, 0, -100 ]
+  const width = 200
+  const height = 100
+
+  // Checks some points of the grid against the exact transformation
+  const check = (grid: gdal.TransformedGrid, center: boolean, maxError: number) => {
+    const ct = new gdal.CoordinateTransformation(utm, webMercator)
+    const offset = center ? 0.5 : 0
+    assert.instanceOf(grid.xs, Float64Array)
+    assert.instanceOf(grid.ys, Float64Array)
+    assert.instanceOf(grid.success, Uint8Array)
+    assert.lengthOf(grid.xs, width * height)
+    assert.lengthOf(grid.ys, width * height)
+    assert.lengthOf(grid.success, width * height)
+    for (const [ col, row ] of [ [ 0, 0 ], [ 57, 13 ], [ 100, 50 ], [ 199, 99 ] ]) {
+      const i = row * width + col
+      const pt = ct.transformPoint(
+        geoTransform[0] + (col + offset) * geoTransform[1],
+        geoTransform[3] + (row + offset) * geoTransform[5])
+      assert.equal(grid.success[i], 1)
+      assert.closeTo(grid.xs[i], pt.x, maxError + 1e-6)
+      assert.closeTo(grid.ys[i], pt.y, maxError + 1e-6)
+    }
+  }
+
+  it('should be exposed', () => {
+    assert.ok(gdal.ApproxTransformer)
+    assert.isFunction(gdal.createApproxTransformer)
+  })
+
+  it('should not be instantiable', () => {
+    assert.throws(() => {
+      new gdal.ApproxTransformer()
+    }, /Cannot create ApproxTransformer directly/)
+  })
+
+  it('should throw on invalid arguments', () => {
+    assert.throws(() => {
+      gdal.createApproxTransformer(utm, webMercator, {} as gdal.ApproxTransformerOptions)
+    }, /maxError must be a non-negative number/)
+    assert.throws(() => {
+      gdal.createApproxTransformer(utm, webMercator, { maxError: -1 })
+    }, /maxError must be a non-negative number/)
+    const transformer = gdal.createApproxTransformer(utm, webMercator, { maxError: 0.01 })
+    assert.throws(() => {
+      transformer.transformGrid([ 0, 1, 0 ], width, height)
+    }, /6 elements/)
+    assert.throws(() => {
+      transformer.transformGrid(geoTransform, 0, height)
+    }, /width and height must be positive integers/)
+    assert.throws(() => {
+      transformer.transformGrid(geoTransform, width, height, { threads: 0 })
+    }, /threads must be a positive integer/)
+  })
+
+  describe('transformGrid()', () => {
+    it('should transform the pixel centers within maxError', () => {
+      const transformer = gdal.createApproxTransformer(utm, webMercator, { maxError: 0.01 })
+      assert.equal(transformer.maxError, 0.01)
+      check(transformer.transformGrid(geoTransform, width, height), true, 0.01)
+    })
+    it('should transform the pixel corners', () => {
+      const transformer = gdal.createApproxTransformer(utm, webMercator, { maxError: 0.01 })
+      check(transformer.transformGrid(geoTransform, width, height, { center: false }), false, 0.01)
+    })
+    it('should be exact with maxError 0', () => {
+      const transformer = gdal.createApproxTransformer(utm, webMercator, { maxError: 0 })
+      check(transformer.transformGrid(geoTransform, width, height), true, 0)
+    })
+    it('should produce the same results on several threads', () => {
+      const transformer = gdal.createApproxTransformer(utm, webMercator, { maxError: 0.01 })
+      const single = transformer.transformGrid(geoTransform, width, height)
+      const multi = transformer.transformGrid(geoTransform, width, height, { threads: 4 })
+      assert.deepEqual(multi.xs, single.xs)
+      assert.deepEqual(multi.ys, single.ys)
+      assert.deepEqual(multi.success, single.success)
+    })
+  })
+
+  describe('transformGridAsync()', () => {
+    it('should transform the grid', () => {
+      const transformer = gdal.createApproxTransformer(utm, webMercator, { maxError: 0.01 })
+      return assert.isFulfilled(transformer.transformGridAsync(geoTransform, width, height, { threads: 2 })
+        .then((grid) => check(grid, true, 0.01)))
+    })
+    it('should support concurrent operations', () => {
+      const transformer = gdal.createApproxTransformer(utm, webMercator, { maxError: 0.01 })
+      return assert.isFulfilled(Promise.all([ 0, 1, 2, 3 ].map(() =>
+        transformer.transformGridAsync(geoTransform, width, height)
+          .then((grid) => check(grid, true, 0.01)))))
+    })
+  })
+})
@@ -46,6 +46,15 @@ if (Symbol.asyncIterator) {
             }
             assert.equal(count, layer.features.count())
           })
+          it('should return the features in order', async () => {
+            const ds = gdal.open(path.resolve(__dirname, 'data', 'shp', 'sample.shp'))
+            const layer = ds.layers.get(0)
+            const fids = []
+            for await (const feature of layer.features) {
+              fids.push(feature.fid)
+            }
+            assert.deepEqual(fids, Array.from({ length: layer.features.count() }, (_, i) => i))
+          })
           it('should throw error if dataset is destroyed', () => {
             const ds = gdal.open(path.resolve(__dirname, 'data', 'park.geo.json'))
             const layer = ds.layers.get(0)
@@ -55,6 +64,87 @@ if (Symbol.asyncIterator) {
             })(), /already destroyed/)
           })
         })
+        describe('iterate()', () => {
+          it('should return the features in order', async () => {
+            const ds = gdal.open(path.resolve(__dirname, 'data', 'shp', 'sample.shp'))
+            const layer = ds.layers.get(0)
+            const fids = []
+            for await (const feature of layer.features.iterate({ prefetch: 3, batchSize: 7 })) {
+              assert.instanceOf(feature, gdal.Feature)
+              fids.push(feature.fid)
+            }
+            assert.deepEqual(fids, Array.from({ length: layer.features.count() }, (_, i) => i))
+          })
+          it('should restart from the beginning', async () => {
+            const ds = gdal.open(path.resolve(__dirname, 'data', 'park.geo.json'))
+            const layer = ds.layers.get(0)
+            layer.features.first()
+            layer.features.next()
+            let count = 0
+            for await (const feature of layer.features.iterate()) count += feature ? 1 : 0
+            assert.equal(count, layer.features.count())
+          })
+          it('should stop reading when abandoned', async () => {
+            const ds = gdal.open(path.resolve(__dirname, 'data', 'shp', 'sample.shp'))
+            const layer = ds.layers.get(0)
+            const it = layer.features.iterate({ prefetch: 1, batchSize: 2 })
+            let count = 0
+            for await (const feature of it) {
+              if (feature && ++count === 3) break
+            }
+            assert.deepEqual(await it.next(), { done: true, value: null })
+            // The dataset is usable right away
+            assert.instanceOf(await layer.features.getAsync(0), gdal.Feature)
+          })
+          it('should throw on invalid options', () => {
+            const ds = gdal.open(path.resolve(__dirname, 'data', 'park.geo.json'))
+            const layer = ds.layers.get(0)
+            assert.throws(() => layer.features.iterate({ prefetch: 0 }), /prefetch must be a positive integer/)
+            assert.throws(() => layer.features.iterate({ batchSize: 1.5 }), /batchSize must be a positive integer/)
+          })
+          it('should reject if the dataset is destroyed', () => {
+            const ds = gdal.open(path.resolve(__dirname, 'data', 'park.geo.json'))
+            const layer = ds.layers.get(0)
+            ds.close()
+            return assert.isRejected((async () => {
+              for await (const l of layer.features.iterate()) l
+            })(), /already destroyed/)
+          })
+          it('should return FeatureViews with view', async () => {
+            const ds = gdal.open(path.resolve(__dirname, 'data', 'shp', 'sample.shp'))
+            const layer = ds.layers.get(0)
+            let fid = 0
+            for await (const view of layer.features.iterate({ view: true, batchSize: 5 }) as AsyncIterable<gdal.FeatureView>) {
+              assert.instanceOf(view, gdal.FeatureView)
+              const feature = layer.features.get(fid)
+              assert.equal(view.fid, fid)
+              assert.equal(view.get('name'), feature.fields.get('name'))
+              assert.equal(view.get(1), feature.fields.get(1))
+              assert.deepEqual(view.toObject(), feature.fields.toObject())
+              assert.isTrue(view.getGeometry().equals(feature.getGeometry()))
+              fid++
+            }
+            assert.equal(fid, layer.features.count())
+          })
+          it('should invalidate the FeatureViews when advancing', async () => {
+            const ds = gdal.open(path.resolve(__dirname, 'data', 'shp', 'sample.shp'))
+            const layer = ds.layers.get(0)
+            const it = layer.features.iterate({ view: true }) as AsyncIterableIterator<gdal.FeatureView>
+            const first = (await it.next()).value
+            const copy = first.toFeature()
+            const geom = first.getGeometry()
+            assert.isTrue(first.valid)
+            await it.next()
+            assert.isFalse(first.valid)
+            assert.throws(() => first.get('name'), /no longer valid/)
+            assert.throws(() => first.fid, /no longer valid/)
+            // The copies are independent
+            assert.instanceOf(copy, gdal.Feature)
+            assert.equal(copy.fid, 0)
+            assert.isTrue(geom.equals(copy.getGeometry()))
+            await it.return()
+          })
+        })
       })
     })
   })
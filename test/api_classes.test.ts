@@ -6,6 +6,8 @@ import * as gdal from '..'
 // create = function -> class cannot be directly instantiated
 // create = array -> these are the arguments for the new
 const create = {
+  ApproxTransformer: () => gdal.createApproxTransformer(gdal.SpatialReference.fromEPSG(4326),
+    gdal.SpatialReference.fromEPSG(3857), { maxError: 0.125 }),
   CircularString: [],
   ColorTable: [ gdal.GPI_HLS ],
   CompoundCurve: [],
@@ -19,6 +21,7 @@ const create = {
   FeatureDefn: [],
   FeatureDefnFields: () => new gdal.FeatureDefn().fields,
   FeatureFields: () => gdal.open(path.resolve(__dirname, 'data', 'park.geo.json')).layers.get(0).features.get(0).fields,
+  FeatureView: () => gdal.open(path.resolve(__dirname, 'data', 'park.geo.json')).layers.get(0).features.nextViews(1)[0],
   FieldDefn: [ 'id', gdal.OFTInteger ],
   GDALDrivers: () => gdal.drivers,
   Geometry: () => new gdal.LineString(),
@@ -37,10 +40,12 @@ const create = {
   Point: [ 0, 0 ],
   Polygon: [],
   PolygonRings: () => new gdal.Polygon().rings,
+  PreparedGeometry: [ new gdal.Point(0, 0) ],
   RasterBand: () => gdal.open('temp', 'w', 'MEM', 32, 32, 1, gdal.GDT_Byte).bands.get(1),
   RasterBandOverviews: () => gdal.open('temp', 'w', 'MEM', 32, 32, 1, gdal.GDT_Byte).bands.get(1).overviews,
   RasterBandPixels: () => gdal.open('temp', 'w', 'MEM', 32, 32, 1, gdal.GDT_Byte).bands.get(1).pixels,
   SimpleCurve: () => new gdal.LineString(),
+  SpatialIndex: () => gdal.SpatialIndex.fromGeometries([ new gdal.Point(0, 0) ]),
   SpatialReference: []
 } as Record<string, unknown>
 
@@ -57,4 +57,83 @@ describe('gdal.CoordinateTransformation', () => {
       })
     })
   })
+  describe('transformPoints()', () => {
+    let ct: gdal.CoordinateTransformation
+    beforeEach(() => {
+      const srs0 = gdal.SpatialReference.fromProj4('+init=epsg:4326')
+      const srs1 = gdal.SpatialReference.fromProj4('+init=epsg:32632')
+      ct = new gdal.CoordinateTransformation(srs0, srs1)
+    })
+    it('should transform the points in place', () => {
+      const xs = new Float64Array([ 20, 20 ])
+      const ys = new Float64Array([ 30, 30 ])
+      const ok = ct.transformPoints(xs, ys)
+      assert.instanceOf(ok, Uint8Array)
+      assert.deepEqual(Array.from(ok), [ 1, 1 ])
+      assert.closeTo(xs[1], 1564201.4044502454, 0.1)
+      assert.closeTo(ys[1], 3370263.469590679, 0.1)
+    })
+    it('should write to the output arrays', () => {
+      const xs = new Float64Array([ 20 ])
+      const ys = new Float64Array([ 30 ])
+      const zs = new Float64Array([ 10 ])
+      const output = { xs: new Float64Array(1), ys: new Float64Array(1), zs: new Float64Array(1) }
+      ct.transformPoints(xs, ys, zs, { output })
+      assert.equal(xs[0], 20)
+      assert.closeTo(output.xs[0], 1564201.4044502454, 0.1)
+      assert.closeTo(output.ys[0], 3370263.469590679, 0.1)
+      assert.closeTo(output.zs[0], 10, 1e-6)
+    })
+    it('should produce the same result on several threads', () => {
+      const n = 10000
+      const xs = Float64Array.from({ length: n }, (_, i) => (i % 12) - 6 + 9)
+      const ys = Float64Array.from({ length: n }, (_, i) => (i % 80))
+      const output = { xs: new Float64Array(n), ys: new Float64Array(n) }
+      ct.transformPoints(xs, ys, null, { output, threads: 4 })
+      ct.transformPoints(xs, ys)
+      assert.deepEqual(output.xs, xs)
+      assert.deepEqual(output.ys, ys)
+    })
+    it('should throw on invalid arguments', () => {
+      assert.throws(() => {
+        ct.transformPoints(new Float64Array(2), new Float64Array(1))
+      }, /ys must have the same length as xs/)
+      assert.throws(() => {
+        ct.transformPoints([ 1 ] as unknown as Float64Array, new Float64Array(1))
+      }, /xs must be a Float64Array/)
+      assert.throws(() => {
+        ct.transformPoints(new Float64Array(1), new Float64Array(1), new Float64Array(1),
+          { output: { xs: new Float64Array(1), ys: new Float64Array(1) } })
+      }, /output.zs is required/)
+    })
+  })
+  describe('transformPointsAsync()', () => {
+    it('should transform the points in place', () => {
+      const srs0 = gdal.SpatialReference.fromProj4('+init=epsg:4326')
+      const srs1 = gdal.SpatialReference.fromProj4('+init=epsg:32632')
+      const ct = new gdal.CoordinateTransformation(srs0, srs1)
+      const xs = new Float64Array([ 20 ])
+      const ys = new Float64Array([ 30 ])
+      return ct.transformPointsAsync(xs, ys, null, { threads: 2 }).then((ok) => {
+        assert.equal(ok[0], 1)
+        assert.closeTo(xs[0], 1564201.4044502454, 0.1)
+      })
+    })
+    it('should support concurrent operations on a temporary transformation', () => {
+      const srs0 = gdal.SpatialReference.fromProj4('+init=epsg:4326')
+      const srs1 = gdal.SpatialReference.fromProj4('+init=epsg:32632')
+      const arrays = [ 0, 1, 2, 3 ].map(() => [ new Float64Array(1000).fill(20), new Float64Array(1000).fill(30) ])
+      const ct = new gdal.CoordinateTransformation(srs0, srs1)
+      const jobs = arrays.map(([ xs, ys ]) =>
+        new gdal.CoordinateTransformation(srs0, srs1).transformPointsAsync(xs, ys))
+      global.gc()
+      assert.closeTo(ct.transformPoint(20, 30).x, 1564201.4044502454, 0.1)
+      return Promise.all(jobs).then((results) => {
+        for (let i = 0; i < results.length; i++) {
+          assert.isTrue(results[i].every((ok) => ok === 1))
+          assert.isTrue(arrays[i][0].every((x) => Math.abs(x - 1564201.4044502454) < 0.1))
+        }
+      })
+    })
+  })
 })
@@ -871,6 +871,153 @@ describe('gdal.Dataset', () => {
         return assert.isRejected(ds.executeSQLAsync('SELECT name FROM sample'))
       })
     })
+    describe('releaseResultSet()', () => {
+      it('should release the result set', () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        const result_set = ds.executeSQL('SELECT name FROM sample')
+        ds.releaseResultSet(result_set)
+        assert.throws(() => {
+          result_set.fields.getNames()
+        }, /already destroyed/)
+        // The dataset is still usable
+        assert.instanceOf(ds.layers.get(0), gdal.Layer)
+      })
+      it('should throw on a regular layer', () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        assert.throws(() => {
+          ds.releaseResultSet(ds.layers.get(0))
+        }, /not an SQL result set/)
+      })
+      it('should throw on a layer of another dataset', () => {
+        const ds1 = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        const ds2 = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        assert.throws(() => {
+          ds2.releaseResultSet(ds1.executeSQL('SELECT name FROM sample'))
+        }, /does not belong/)
+      })
+    })
+    describe('releaseResultSetAsync()', () => {
+      it('should release the result set', async () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        const result_set = await ds.executeSQLAsync('SELECT name FROM sample')
+        await ds.releaseResultSetAsync(result_set)
+        assert.throws(() => {
+          result_set.fields.getNames()
+        }, /already destroyed/)
+      })
+    })
+    describe('querySQLAsync()', () => {
+      it('should iterate over the results in batches', async () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        const expected = ds.layers.get(0).features.count()
+        let count = 0
+        for await (const batch of ds.querySQLAsync('SELECT name FROM sample', { batchSize: 7 })) {
+          assert.isAtMost(batch.length, 7)
+          assert.isAbove(batch.length, 0)
+          for (const feature of batch) {
+            assert.instanceOf(feature, gdal.Feature)
+            assert.deepEqual(Object.keys(feature.fields.toObject()), [ 'name' ])
+          }
+          count += batch.length
+        }
+        assert.equal(count, expected)
+      })
+      it('should support the dialect option', async () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        const batches = []
+        for await (const batch of ds.querySQLAsync('SELECT COUNT(*) AS n FROM sample', { dialect: 'OGRSQL' })) {
+          batches.push(batch)
+        }
+        assert.lengthOf(batches, 1)
+        assert.equal(batches[0][0].fields.get('n'), ds.layers.get(0).features.count())
+      })
+      it('should release the results when abandoned', async () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        const query = ds.querySQLAsync('SELECT name FROM sample', { batchSize: 2 })
+        for await (const batch of query) {
+          assert.lengthOf(batch, 2)
+          break
+        }
+        assert.deepEqual(await query.next(), { done: true, value: null })
+      })
+      it('should serialize the calls to next()', async () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        const query = ds.querySQLAsync('SELECT name FROM sample', { batchSize: 2 })
+        const [ first, second ] = await Promise.all([ query.next(), query.next() ])
+        assert.lengthOf(first.value, 2)
+        assert.lengthOf(second.value, 2)
+        assert.notEqual(first.value[0].fid, second.value[0].fid)
+        let count = 4
+        for await (const batch of query) count += batch.length
+        assert.equal(count, ds.layers.get(0).features.count())
+      })
+      it('should reject on invalid SQL', () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        return assert.isRejected((async () => {
+          for await (const batch of ds.querySQLAsync('SELECT nope FROM sample')) batch
+        })())
+      })
+      it('should reject if dataset already closed', () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        ds.close()
+        return assert.isRejected(ds.querySQLAsync('SELECT name FROM sample').next(), /already been destroyed/)
+      })
+    })
+    describe('startTransaction()/commit()/rollback()', () => {
+      const createGPKG = () => {
+        const file = `/vsimem/transaction.${String(Math.random()).substring(2)}.tmp.gpkg`
+        const ds = gdal.open(file, 'w', 'GPKG')
+        const layer = ds.layers.create('points', null, gdal.Point)
+        return { ds, layer, file }
+      }
+      it('should commit the changes', () => {
+        const { ds, layer, file } = createGPKG()
+        assert.isTrue(ds.testCapability(gdal.ODsCTransactions))
+        ds.startTransaction()
+        layer.features.add(new gdal.Feature(layer))
+        ds.commit()
+        assert.equal(layer.features.count(), 1)
+        ds.close()
+        gdal.vsimem.release(file)
+      })
+      it('should roll back the changes', () => {
+        const { ds, layer, file } = createGPKG()
+        ds.startTransaction()
+        layer.features.add(new gdal.Feature(layer))
+        ds.rollback()
+        assert.equal(layer.features.count(), 0)
+        ds.close()
+        gdal.vsimem.release(file)
+      })
+      it('should throw when there is no active transaction', () => {
+        const { ds, file } = createGPKG()
+        assert.throws(() => ds.commit())
+        ds.close()
+        gdal.vsimem.release(file)
+      })
+      it('should throw error if dataset is destroyed', () => {
+        const { ds, file } = createGPKG()
+        ds.close()
+        assert.throws(() => ds.startTransaction(), /already been destroyed/)
+        gdal.vsimem.release(file)
+      })
+    })
+    describe('startTransactionAsync()/commitAsync()/rollbackAsync()', () => {
+      it('should commit and roll back the changes', async () => {
+        const file = `/vsimem/transaction.${String(Math.random()).substring(2)}.tmp.gpkg`
+        const ds = await gdal.openAsync(file, 'w', 'GPKG')
+        const layer = await ds.layers.createAsync('points', null, gdal.Point)
+        await ds.startTransactionAsync()
+        await layer.features.addAsync(new gdal.Feature(layer))
+        await ds.commitAsync()
+        await ds.startTransactionAsync()
+        await layer.features.addAsync(new gdal.Feature(layer))
+        await ds.rollbackAsync()
+        assert.equal(await layer.features.countAsync(), 1)
+        ds.close()
+        gdal.vsimem.release(file)
+      })
+    })
     describe('getFileList()', () => {
       it('should return list of filenames', () => {
         const ds = gdal.open(path.join(__dirname, 'data', 'sample.vrt'))
@@ -420,6 +420,26 @@ describe('gdal.Feature', () => {
           assert.equal(obj.name, 'test')
           assert.closeTo(obj.value, 3.14, 0.0001)
         })
+        it('should follow the changes of the layer schema', () => {
+          const layer = ds.layers.create('schema', null, gdal.Point)
+          layer.fields.add(new gdal.FieldDefn('a', gdal.OFTInteger))
+          layer.fields.add(new gdal.FieldDefn('b', gdal.OFTString))
+          const f1 = new gdal.Feature(layer)
+          f1.fields.set({ a: 1, b: 'x' })
+          assert.deepEqual(f1.fields.toObject(), { a: 1, b: 'x' })
+          layer.fields.add(new gdal.FieldDefn('c', gdal.OFTReal))
+          const f2 = new gdal.Feature(layer)
+          f2.fields.set({ a: 2, c: 0.5 })
+          assert.deepEqual(f2.fields.toObject(), { a: 2, b: null, c: 0.5 })
+          layer.fields.remove('a')
+          const f3 = new gdal.Feature(layer)
+          f3.fields.set({ b: 'y', c: 1.5 })
+          assert.deepEqual(f3.fields.toObject(), { b: 'y', c: 1.5 })
+          assert.deepEqual(f3.fields.getNames(), [ 'b', 'c' ])
+          assert.equal(f3.fields.get('c'), 1.5)
+          assert.equal(f3.fields.get('C'), 1.5)
+          assert.throws(() => f3.fields.get('a'), /does not exist/)
+        })
       })
       describe('toJSON()', () => {
         it('should return the fields as a stringified JSON object', () => {
@@ -59,6 +59,124 @@ describe('gdal.Geometry', () => {
         coordinates: [ 1, 2, 3 ]
       })
     })
+    const wkts = [
+      'LINESTRING (1 2 3, 4 5 6)',
+      'POLYGON ((0 0, 10 0, 10 10, 0 0), (1 1, 2 1, 2 2, 1 1))',
+      'MULTIPOINT ((1 2), (3 4))',
+      'MULTILINESTRING ((1 2, 3 4), (5 6, 7 8))',
+      'MULTIPOLYGON (((0 0, 1 0, 1 1, 0 0)), ((5 5, 6 5, 6 6, 5 5), (5.1 5.1, 5.2 5.1, 5.2 5.2, 5.1 5.1)))',
+      'GEOMETRYCOLLECTION (POINT (1 2), LINESTRING (0 0, 1 1))'
+    ]
+    it('should return the same object as toJSON()', () => {
+      for (const wkt of wkts) {
+        const geom = gdal.Geometry.fromWKT(wkt)
+        assert.deepEqual(geom.toObject(), JSON.parse(geom.toJSON()), wkt)
+      }
+    })
+    it('should skip the empty points of a MultiPoint', () => {
+      const points = new gdal.MultiPoint()
+      points.children.add(new gdal.Point(1, 2))
+      points.children.add(new gdal.Point())
+      assert.deepEqual(points.toObject(), { type: 'MultiPoint', coordinates: [ [ 1, 2 ] ] })
+    })
+    it('should linearize the curves', () => {
+      const curve = gdal.Geometry.fromWKT('CIRCULARSTRING (0 0, 1 1, 2 0)')
+      const obj = curve.toObject() as { type: string, coordinates: number[][] }
+      assert.equal(obj.type, 'LineString')
+      assert.isAbove(obj.coordinates.length, 3)
+    })
+    it('should support flat coordinates', () => {
+      const geom = gdal.Geometry.fromWKT('MULTIPOLYGON (((0 0, 1 0, 1 1, 0 0)), ((5 5, 6 5, 6 6, 5 5)))')
+      const obj = geom.toObject({ flat: true }) as gdal.FlatCoordinates & { type: string }
+      assert.equal(obj.type, 'MultiPolygon')
+      assert.equal(obj.dims, 2)
+      assert.instanceOf(obj.coordinates, Float64Array)
+      assert.lengthOf(obj.coordinates, 16)
+      assert.deepEqual(obj.offsets.map((o) => Array.from(o)), [ [ 0, 1, 2 ], [ 0, 4, 8 ] ])
+    })
+  })
+  describe('fromObject()', () => {
+    it('should create the geometry from a GeoJSON object', () => {
+      const geom = gdal.Geometry.fromObject({
+        type: 'Polygon',
+        coordinates: [ [ [ 0, 0 ], [ 10, 0 ], [ 10, 10 ], [ 0, 0 ] ], [ [ 1, 1 ], [ 2, 1 ], [ 2, 2 ], [ 1, 1 ] ] ]
+      })
+      assert.instanceOf(geom, gdal.Polygon)
+      assert.equal(geom.toWKT(), 'POLYGON ((0 0,10 0,10 10,0 0),(1 1,2 1,2 2,1 1))')
+      const point = gdal.Geometry.fromObject({ type: 'Point', coordinates: [ 1, 2, 3 ] }) as gdal.Point
+      assert.equal(point.z, 3)
+      assert.isTrue(gdal.Geometry.fromObject({ type: 'Point', coordinates: [] }).isEmpty())
+    })
+    it('should round-trip with toObject()', () => {
+      const wkt = 'GEOMETRYCOLLECTION (POINT (1 2),MULTIPOLYGON (((0 0,1 0,1 1,0 0)),((5 5,6 5,6 6,5 5))))'
+      const geom = gdal.Geometry.fromWKT(wkt)
+      assert.equal(gdal.Geometry.fromObject(geom.toObject()).toWKT(), wkt)
+      assert.equal(gdal.Geometry.fromObject(geom.toObject({ flat: true })).toWKT(), wkt)
+    })
+    it('should throw on invalid objects', () => {
+      assert.throws(() => {
+        gdal.Geometry.fromObject({ type: 'Feature' })
+      }, /Unsupported GeoJSON geometry type: Feature/)
+      assert.throws(() => {
+        gdal.Geometry.fromObject({ type: 'LineString', coordinates: [ [ 1 ], [ 2 ] ] })
+      }, /Invalid GeoJSON position/)
+      assert.throws(() => {
+        gdal.Geometry.fromObject({ type: 'Polygon', coordinates: [ 0, 0 ] })
+      }, /Invalid GeoJSON coordinates/)
+      assert.throws(() => {
+        gdal.Geometry.fromObject({
+          type: 'Polygon',
+          coordinates: new Float64Array([ 0, 0, 1, 0, 1, 1, 0, 0 ]),
+          offsets: [ new Uint32Array([ 0, 3 ]) ]
+        })
+      }, /Invalid offsets/)
+    })
+  })
+  describe('toObjectArrayAsync()', () => {
+    it('should convert an array of geometries and features', () => {
+      const feature = new gdal.Feature(new gdal.FeatureDefn())
+      feature.setGeometry(new gdal.Point(3, 4))
+      const input = [ new gdal.Point(1, 2), null, feature, new gdal.Feature(new gdal.FeatureDefn()) ]
+      return assert.isFulfilled(gdal.Geometry.toObjectArrayAsync(input, { threads: 2 }).then((objs) => {
+        assert.deepEqual(objs, [
+          { type: 'Point', coordinates: [ 1, 2 ] },
+          null,
+          { type: 'Point', coordinates: [ 3, 4 ] },
+          null
+        ])
+      }))
+    })
+    it('should not be affected by changes to the features', () => {
+      const feature = new gdal.Feature(new gdal.FeatureDefn())
+      feature.setGeometry(new gdal.Point(3, 4))
+      const input = [ feature, new gdal.Point(1, 2) ]
+      const q = gdal.Geometry.toObjectArrayAsync(input)
+      feature.setGeometry(null)
+      input.length = 0
+      global.gc()
+      return assert.isFulfilled(q.then((objs) => {
+        assert.deepEqual(objs, [
+          { type: 'Point', coordinates: [ 3, 4 ] },
+          { type: 'Point', coordinates: [ 1, 2 ] }
+        ])
+      }))
+    })
+    it('should reject on invalid elements', () =>
+      assert.isRejected(gdal.Geometry.toObjectArrayAsync([ {} as gdal.Geometry ]),
+        /must be Geometry or Feature objects or null/))
+  })
+  describe('fromObjectArrayAsync()', () => {
+    it('should create the geometries', () =>
+      assert.isFulfilled(gdal.Geometry.fromObjectArrayAsync([
+        { type: 'Point', coordinates: [ 1, 2 ] },
+        null,
+        { type: 'LineString', coordinates: [ [ 0, 0 ], [ 1, 1 ] ] }
+      ], { threads: 2 }).then((geoms) => {
+        assert.lengthOf(geoms, 3)
+        assert.equal((geoms[0] as gdal.Geometry).toWKT(), 'POINT (1 2)')
+        assert.isNull(geoms[1])
+        assert.equal((geoms[2] as gdal.Geometry).toWKT(), 'LINESTRING (0 0,1 1)')
+      })))
   })
   describe('toString()', () => {
     it('should return valid result', () => {
@@ -190,6 +308,79 @@ describe('gdal.Geometry', () => {
       ]))
     })
   })
+  describe('toWKBArray()', () => {
+    const geoms = [ new gdal.Point(1, 2), null, gdal.Geometry.fromWKT('LINESTRING (0 0, 1 1)') ]
+    it('should return the concatenated WKBs and their offsets', () => {
+      const wkbs = gdal.Geometry.toWKBArray(geoms as gdal.Geometry[])
+      assert.instanceOf(wkbs.data, Buffer)
+      assert.instanceOf(wkbs.offsets, Uint32Array)
+      assert.deepEqual(Array.from(wkbs.offsets), [ 0, 21, 21, 62 ])
+      assert.isTrue(wkbs.data.subarray(0, 21).equals((geoms[0] as gdal.Geometry).toWKB()))
+      assert.isTrue(wkbs.data.subarray(21, 62).equals((geoms[2] as gdal.Geometry).toWKB()))
+    })
+    it('should produce the same result on several threads', () => {
+      const many = [] as gdal.Geometry[]
+      for (let i = 0; i < 1000; i++) many.push(new gdal.Point(i, -i))
+      const single = gdal.Geometry.toWKBArray(many, { byteOrder: 'LSB', variant: 'ISO' })
+      const multi = gdal.Geometry.toWKBArray(many, { byteOrder: 'LSB', variant: 'ISO', threads: 4 })
+      assert.isTrue(multi.data.equals(single.data))
+      assert.deepEqual(multi.offsets, single.offsets)
+    })
+    it('should throw on invalid arguments', () => {
+      assert.throws(() => {
+        gdal.Geometry.toWKBArray([ {} as gdal.Geometry ])
+      }, /must be Geometry objects or null/)
+      assert.throws(() => {
+        gdal.Geometry.toWKBArray(geoms as gdal.Geometry[], { byteOrder: 'BE' })
+      }, /byte order must be/)
+    })
+  })
+  describe('fromWKBArray()', () => {
+    it('should parse an array of Buffers', () => {
+      const wkbs = [ new gdal.Point(1, 2).toWKB(), null, Buffer.alloc(0) ]
+      const geoms = gdal.Geometry.fromWKBArray(wkbs as Buffer[])
+      assert.lengthOf(geoms, 3)
+      assert.instanceOf(geoms[0], gdal.Point)
+      assert.equal((geoms[0] as gdal.Point).y, 2)
+      assert.isNull(geoms[1])
+      assert.isNull(geoms[2])
+    })
+    it('should round-trip with toWKBArray() on several threads', () => {
+      const many = [] as gdal.Geometry[]
+      for (let i = 0; i < 1000; i++) many.push(gdal.Geometry.fromWKT(`LINESTRING (${i} 0, 0 ${i})`))
+      const geoms = gdal.Geometry.fromWKBArray(gdal.Geometry.toWKBArray(many), { threads: 4 })
+      assert.lengthOf(geoms, 1000)
+      geoms.forEach((g, i) => assert.isTrue((g as gdal.Geometry).equals(many[i])))
+    })
+    it('should assign the spatial reference', () => {
+      const srs = gdal.SpatialReference.fromEPSG(4326)
+      const geoms = gdal.Geometry.fromWKBArray([ new gdal.Point(1, 2).toWKB() ], { srs })
+      assert.isTrue((geoms[0] as gdal.Geometry).srs?.isSame(srs))
+    })
+    it('should throw on invalid data', () => {
+      assert.throws(() => {
+        gdal.Geometry.fromWKBArray([ new gdal.Point(1, 2).toWKB(), Buffer.from([ 1, 2, 3 ]) ])
+      }, /at index 1/)
+      assert.throws(() => {
+        gdal.Geometry.fromWKBArray({ data: Buffer.alloc(4), offsets: new Uint32Array([ 0, 8 ]) })
+      }, /Invalid offsets/)
+      assert.throws(() => {
+        gdal.Geometry.fromWKBArray([ 'POINT (1 2)' as unknown as Buffer ])
+      }, /must be Buffers or null/)
+    })
+  })
+  describe('fromWKBArrayAsync() / toWKBArrayAsync()', () => {
+    it('should round-trip', () => {
+      const many = [] as gdal.Geometry[]
+      for (let i = 0; i < 100; i++) many.push(new gdal.Point(i, i))
+      return assert.isFulfilled(gdal.Geometry.toWKBArrayAsync(many, { threads: 2 })
+        .then((wkbs) => gdal.Geometry.fromWKBArrayAsync(wkbs, { threads: 2 }))
+        .then((geoms) => {
+          assert.lengthOf(geoms, 100)
+          assert.equal((geoms[99] as gdal.Point).x, 99)
+        }))
+    })
+  })
   if (semver.gte(gdal.version, '2.3.0')) {
     describe('fromGeoJson()', () => {
       it('should return valid result', () => {
@@ -217,6 +217,116 @@ describe('gdal.Layer', () => {
       })
     })
 
+    describe('readColumns()', () => {
+      const createPoints = () => {
+        const ds = gdal.open('temp', 'w', 'Memory')
+        const layer = ds.layers.create('points', null, gdal.Point)
+        layer.fields.add(new gdal.FieldDefn('int', gdal.OFTInteger))
+        layer.fields.add(new gdal.FieldDefn('int64', gdal.OFTInteger64))
+        layer.fields.add(new gdal.FieldDefn('real', gdal.OFTReal))
+        layer.fields.add(new gdal.FieldDefn('str', gdal.OFTString))
+        layer.fields.add(new gdal.FieldDefn('list', gdal.OFTIntegerList))
+        for (let i = 0; i < 10; i++) {
+          const f = new gdal.Feature(layer)
+          if (i !== 3) f.fields.set({ int: i, int64: i * 1e10, real: i / 2, str: `é${i}` })
+          if (i !== 5) f.setGeometry(new gdal.Point(i, -i))
+          layer.features.add(f)
+        }
+        return { ds, layer }
+      }
+      it('should return the fields as typed columns', () => {
+        const { layer } = createPoints()
+        const cols = layer.readColumns({ geometry: 'none' })
+        assert.equal(cols.count, 10)
+        assert.isUndefined(cols.geometry)
+        assert.sameMembers(Object.keys(cols.fields), [ 'int', 'int64', 'real', 'str' ])
+        assert.instanceOf(cols.fid, Float64Array)
+        assert.instanceOf(cols.fields.int.data, Int32Array)
+        assert.instanceOf(cols.fields.int64.data, BigInt64Array)
+        assert.instanceOf(cols.fields.real.data, Float64Array)
+        assert.instanceOf(cols.fields.str.data, Uint8Array)
+        assert.instanceOf(cols.fields.str.offsets, Int32Array)
+        assert.equal(cols.fields.int.type, 'integer')
+        assert.equal((cols.fields.str.offsets as Int32Array).length, 11)
+        const str = cols.fields.str
+        const offsets = str.offsets as Int32Array
+        for (let i = 0; i < 10; i++) {
+          const valid = !!((str.validity as Uint8Array)[i >> 3] & (1 << (i & 7)))
+          assert.equal(valid, i !== 3)
+          if (i === 3) {
+            assert.isNaN(cols.fields.real.data[i])
+            assert.equal(offsets[i], offsets[i + 1])
+            continue
+          }
+          assert.equal(cols.fields.int.data[i], i)
+          assert.equal(cols.fields.int64.data[i], BigInt(i * 1e10))
+          assert.equal(cols.fields.real.data[i], i / 2)
+          assert.equal(Buffer.from(str.data.subarray(offsets[i], offsets[i + 1])).toString(), `é${i}`)
+        }
+      })
+      it('should return the geometries as x/y columns', () => {
+        const { layer } = createPoints()
+        const cols = layer.readColumns({ fields: [ 'int' ], geometry: 'xy' })
+        assert.sameMembers(Object.keys(cols.fields), [ 'int' ])
+        const geom = cols.geometry as NonNullable<typeof cols.geometry>
+        const x = geom.x as Float64Array
+        const y = geom.y as Float64Array
+        assert.instanceOf(x, Float64Array)
+        assert.instanceOf(y, Float64Array)
+        for (let i = 0; i < 10; i++) {
+          const valid = !!((geom.validity as Uint8Array)[i >> 3] & (1 << (i & 7)))
+          assert.equal(valid, i !== 5)
+          if (i !== 5) assert.deepEqual([ x[i], y[i] ], [ i, -i ])
+        }
+      })
+      it('should return the geometries as WKB', () => {
+        prepare_dataset_layer_test('r', (dataset, layer) => {
+          const cols = layer.readColumns({ fields: [ 'name' ] })
+          assert.equal(cols.count, layer.features.count())
+          const name = cols.fields.name
+          const nameOffsets = name.offsets as Int32Array
+          const geom = cols.geometry as NonNullable<typeof cols.geometry>
+          const wkbData = geom.data as Uint8Array
+          const wkbOffsets = geom.offsets as Int32Array
+          assert.isNull(name.validity)
+          assert.isNull(geom.validity)
+          let i = 0
+          for (const feature of layer.features) {
+            assert.equal(cols.fid[i], feature.fid)
+            assert.equal(Buffer.from(name.data.subarray(nameOffsets[i], nameOffsets[i + 1])).toString(),
+              feature.fields.get('name'))
+            const wkb = Buffer.from(wkbData.subarray(wkbOffsets[i], wkbOffsets[i + 1]))
+            assert.isTrue(gdal.Geometry.fromWKB(wkb).equals(feature.getGeometry()))
+            i++
+          }
+        })
+      })
+      it('should respect the attribute filter', () => {
+        const { layer } = createPoints()
+        layer.setAttributeFilter('int > 6')
+        const cols = layer.readColumns({ fields: [ 'int' ], geometry: 'none' })
+        assert.deepEqual(Array.from(cols.fields.int.data), [ 7, 8, 9 ])
+      })
+      it('should throw on unsupported or non-existing fields', () => {
+        const { layer } = createPoints()
+        assert.throws(() => layer.readColumns({ fields: [ 'list' ] }), /Unsupported field type/)
+        assert.throws(() => layer.readColumns({ fields: [ 'nonexisting' ] }), /Invalid field name/)
+      })
+      it('should throw with geometry: xy on non-point layers', () => {
+        prepare_dataset_layer_test('r', (dataset, layer) => {
+          assert.throws(() => layer.readColumns({ geometry: 'xy' }), /supported only for points/)
+        })
+      })
+      it('should throw error if dataset is destroyed', () => {
+        prepare_dataset_layer_test('r', (dataset, layer) => {
+          dataset.close()
+          assert.throws(() => {
+            layer.readColumns()
+          }, /already been destroyed/)
+        })
+      })
+    })
+
     describe('testCapability()', () => {
       it("should return false when layer doesn't support capability", () => {
         prepare_dataset_layer_test('r', (dataset, layer) => {
@@ -492,6 +602,98 @@ describe('gdal.Layer', () => {
           })
         })
       })
+      describe('nextBatch()', () => {
+        it('should return an array of Features and increment the iterator', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            const count = layer.features.count()
+            const f0 = layer.features.first()
+            const batch = layer.features.nextBatch(2)
+            assert.lengthOf(batch, Math.min(2, count - 1))
+            batch.forEach((f, i) => {
+              assert.instanceOf(f, gdal.Feature)
+              assert.equal(f.fid, f0.fid + i + 1)
+            })
+          })
+        })
+        it('should return an empty array after last feature', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            const count = layer.features.count()
+            assert.lengthOf(layer.features.nextBatch(count + 10), count)
+            assert.lengthOf(layer.features.nextBatch(10), 0)
+          })
+        })
+        it('should throw error if count is not positive', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            assert.throws(() => {
+              layer.features.nextBatch(0)
+            }, /count must be a positive integer/)
+          })
+        })
+        it('should throw error if dataset is destroyed', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            dataset.close()
+            assert.throws(() => {
+              layer.features.nextBatch(10)
+            }, /already destroyed/)
+          })
+        })
+      })
+      describe('nextViews()', () => {
+        it('should return an array of FeatureViews and increment the iterator', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            const count = layer.features.count()
+            const views = layer.features.nextViews(count + 10, { reset: true })
+            assert.lengthOf(views, count)
+            views.forEach((view, i) => {
+              assert.instanceOf(view, gdal.FeatureView)
+              assert.deepEqual(view.toObject(), layer.features.get(view.fid).fields.toObject())
+              view.release()
+              assert.isFalse(view.valid)
+            })
+            assert.lengthOf(layer.features.nextViews(10), 0)
+          })
+        })
+        it('should throw error if count is not positive', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            assert.throws(() => {
+              layer.features.nextViews(0)
+            }, /count must be a positive integer/)
+          })
+        })
+      })
+      describe('nextGeoJSON()', () => {
+        it('should return the features serialized to GeoJSON', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            const count = layer.features.count()
+            const expected = layer.features.first()
+            const data = layer.features.nextGeoJSON({ reset: true, chunkSize: 1 }) as Buffer
+            assert.instanceOf(data, Buffer)
+            const f = JSON.parse(data.toString())
+            assert.equal(f.type, 'Feature')
+            assert.equal(f.id, expected.fid)
+            assert.deepEqual(f.properties, expected.fields.toObject())
+            assert.deepEqual(f.geometry, expected.getGeometry()?.toObject())
+            const rest = layer.features.nextGeoJSON({ newlineDelimited: true }) as Buffer
+            assert.lengthOf(rest.toString().split('\n').filter((l) => l.length), count - 1)
+            assert.isNull(layer.features.nextGeoJSON())
+          })
+        })
+        it('should throw error on invalid field names', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            assert.throws(() => {
+              layer.features.nextGeoJSON({ fields: [ 'bogus' ] })
+            }, /Invalid field name/)
+          })
+        })
+        it('should throw error if dataset is destroyed', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            dataset.close()
+            assert.throws(() => {
+              layer.features.nextGeoJSON()
+            }, /already destroyed/)
+          })
+        })
+      })
       describe('first()', () => {
         it('should return a Feature and reset the iterator', () => {
           prepare_dataset_layer_test('r', (dataset, layer) => {
@@ -591,6 +793,81 @@ describe('gdal.Layer', () => {
         })
       })
 
+      describe('addMany()', () => {
+        const createGPKG = () => {
+          const file = `/vsimem/addmany.${String(Math.random()).substring(2)}.tmp.gpkg`
+          const ds = gdal.open(file, 'w', 'GPKG')
+          const layer = ds.layers.create('points', null, gdal.Point)
+          layer.fields.add(new gdal.FieldDefn('int', gdal.OFTInteger))
+          layer.fields.add(new gdal.FieldDefn('real', gdal.OFTReal))
+          layer.fields.add(new gdal.FieldDefn('str', gdal.OFTString))
+          layer.fields.add(new gdal.FieldDefn('date', gdal.OFTDateTime))
+          return { ds, layer, file }
+        }
+        it('should add an array of Features to layer', () => {
+          prepare_dataset_layer_test('w', (dataset, layer) => {
+            layer.features.addMany([ new gdal.Feature(layer), new gdal.Feature(layer), new gdal.Feature(layer) ])
+            assert.equal(layer.features.count(), 3)
+          })
+        })
+        it('should add columnar features in transactions', () => {
+          const { ds, layer, file } = createGPKG()
+          const str = new TextEncoder().encode('abcdef')
+          const date = Date.UTC(2021, 11, 1, 12, 30, 15)
+          layer.features.addMany({
+            fields: {
+              int: new Int32Array([ 1, 2, 3, 4, 5 ]),
+              real: { data: new Float64Array([ 0.5, 1.5, 2.5, 3.5, 4.5 ]), validity: new Uint8Array([ 0b11101 ]) },
+              str: { data: str, offsets: new Int32Array([ 0, 1, 2, 3, 4, 6 ]) },
+              date: new Float64Array([ date, date, date, date, date ])
+            },
+            geometry: { x: new Float64Array([ 1, 2, 3, 4, 5 ]), y: new Float64Array([ -1, -2, -3, -4, -5 ]) }
+          }, { transactionSize: 2 })
+          assert.equal(layer.features.count(), 5)
+          const f = layer.features.get(2)
+          assert.equal(f.fields.get('int'), 2)
+          assert.isNull(f.fields.get('real'))
+          assert.equal(f.fields.get('str'), 'b')
+          assert.deepInclude(f.fields.get('date'), { year: 2021, month: 12, day: 1, hour: 12, minute: 30 })
+          assert.deepEqual((f.getGeometry() as gdal.Point).toObject().coordinates, [ 2, -2 ])
+          assert.equal(layer.features.get(5).fields.get('str'), 'ef')
+          ds.close()
+          gdal.vsimem.release(file)
+        })
+        it('should accept the output of readColumns()', () => {
+          const { ds, layer, file } = createGPKG()
+          layer.features.addMany({
+            fields: { int: new Int32Array([ 1, 2, 3 ]) },
+            geometry: { x: new Float64Array([ 1, 2, 3 ]), y: new Float64Array([ 4, 5, 6 ]) }
+          })
+          const copy = ds.layers.create('copy', null, gdal.Point)
+          copy.fields.add(new gdal.FieldDefn('int', gdal.OFTInteger))
+          copy.features.addMany(layer.readColumns({ fields: [ 'int' ] }))
+          assert.deepEqual(copy.readColumns({ fields: [ 'int' ], geometry: 'none' }).fields.int.data,
+            new Int32Array([ 1, 2, 3 ]))
+          assert.deepEqual(copy.readColumns({ fields: [], geometry: 'xy' }).geometry?.y, new Float64Array([ 4, 5, 6 ]))
+          ds.close()
+          gdal.vsimem.release(file)
+        })
+        it('should throw on incompatible or missing fields', () => {
+          const { ds, layer, file } = createGPKG()
+          assert.throws(() => layer.features.addMany({ fields: { str: new Float64Array(1) } }), /Incompatible/)
+          assert.throws(() => layer.features.addMany({ fields: { none: new Float64Array(1) } }), /Invalid field name/)
+          assert.throws(() => layer.features.addMany({ fields: { int: new Int32Array(1) }, count: 2 }), /count elements/)
+          assert.equal(layer.features.count(), 0)
+          ds.close()
+          gdal.vsimem.release(file)
+        })
+        it('should throw error if dataset is destroyed', () => {
+          prepare_dataset_layer_test('w', (dataset, layer) => {
+            dataset.close()
+            assert.throws(() => {
+              layer.features.addMany([])
+            }, /already destroyed/)
+          })
+        })
+      })
+
       describe('set()', () => {
         let f0: gdal.Feature, f1: gdal.Feature, f1_new: gdal.Feature, layer: gdal.Layer, dataset: gdal.Dataset
         beforeEach(() => {
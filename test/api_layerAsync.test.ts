@@ -254,6 +254,29 @@ describe('gdal.LayerAsync', () => {
       })
     })
 
+    describe('readColumnsAsync()', () => {
+      it('should return the features in a columnar format', () =>
+        prepare_dataset_layer_test('r', { autoclose: false }, (dataset, layer, file) => {
+          const count = layer.features.count()
+          const cols = layer.readColumnsAsync({ fields: [ 'name' ], geometry: 'wkb' })
+          return assert.isFulfilled(cols.then((cols) => {
+            assert.equal(cols.count, count)
+            assert.instanceOf(cols.fields.name.data, Uint8Array)
+            const geom = cols.geometry as NonNullable<typeof cols.geometry>
+            assert.instanceOf(geom.data, Uint8Array)
+            assert.equal((geom.offsets as Int32Array).length, count + 1)
+          })).then(() => cleanupWrite(dataset, file))
+        })
+      )
+      it('should reject if dataset is destroyed', () =>
+        prepare_dataset_layer_test('r', { autoclose: false }, (dataset, layer, file) => {
+          dataset.close()
+          return assert.isRejected(layer.readColumnsAsync(), /already been destroyed/)
+            .then(() => cleanupWrite(dataset, file))
+        })
+      )
+    })
+
     describe('copyAsync()', () => {
       it('should copy a layer/Async', () =>
         prepare_dataset_layer_test('w', { autoclose: false }, (dataset, layer, file) => {
@@ -548,6 +571,33 @@ describe('gdal.LayerAsync', () => {
           })
         )
       })
+      describe('nextBatchAsync()', () => {
+        it('should return an array of Features and increment the iterator', () =>
+          prepare_dataset_layer_test('r', { autoclose: false }, (dataset, layer, file) => {
+            const count = layer.features.count()
+            const batch = layer.features.firstAsync().then(() => layer.features.nextBatchAsync(count))
+            return assert.isFulfilled(Promise.all([ assert.eventually.lengthOf(batch, count - 1),
+              batch.then((features) => features.forEach((f) => assert.instanceOf(f, gdal.Feature)))
+            ])).then(() => cleanupWrite(dataset, file))
+          })
+        )
+        it('should return an empty array after last feature', () =>
+          prepare_dataset_layer_test('r', { autoclose: false }, (dataset, layer, file) => {
+            const count = layer.features.count()
+            const batch = layer.features.nextBatchAsync(count)
+              .then(() => layer.features.nextBatchAsync(count))
+            return assert.eventually.lengthOf(batch, 0)
+              .then(() => cleanupWrite(dataset, file))
+          })
+        )
+        it('should throw error if dataset is destroyed', () =>
+          prepare_dataset_layer_test('r', { autoclose: false }, (dataset, layer, file) => {
+            dataset.close()
+            return assert.isRejected(layer.features.nextBatchAsync(10), /already destroyed/)
+              .then(() => cleanupWrite(dataset, file))
+          })
+        )
+      })
       describe('firstAsync()', () => {
         it('should return a Feature and reset the iterator', () =>
           prepare_dataset_layer_test('r', { autoclose: false }, (dataset, layer, file) => {
@@ -601,6 +651,30 @@ describe('gdal.LayerAsync', () => {
           })
         })
       })
+      describe('addManyAsync()', () => {
+        it('should add Features to layer', () =>
+          prepare_dataset_layer_test('w', { autoclose: false }, (dataset, layer, file) => {
+            const p = layer.features.addManyAsync([ new gdal.Feature(layer), new gdal.Feature(layer) ])
+            return assert.eventually.equal(p.then(() => layer.features.count()), 2)
+              .then(() => cleanupWrite(dataset, file))
+          })
+        )
+        it('should add columnar features to layer', () =>
+          prepare_dataset_layer_test('w', { autoclose: false }, (dataset, layer, file) => {
+            const p = layer.features.addManyAsync({
+              geometry: { x: new Float64Array([ 1, 2, 3 ]), y: new Float64Array([ 4, 5, 6 ]) }
+            }, { transactionSize: 2 })
+            return assert.eventually.equal(p.then(() => layer.features.count()), 3)
+              .then(() => cleanupWrite(dataset, file))
+          })
+        )
+        it('should reject on incompatible columns', () =>
+          prepare_dataset_layer_test('w', { autoclose: false }, (dataset, layer, file) =>
+            assert.isRejected(layer.features.addManyAsync({ fields: { none: new Int32Array(1) } }), /Invalid field name/)
+              .then(() => cleanupWrite(dataset, file))
+          )
+        )
+      })
       describe('addAsync()', () => {
         it('should add Feature to layer', () =>
           prepare_dataset_layer_test('w', { autoclose: false }, (dataset, layer, file) => {
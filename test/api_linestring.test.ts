@@ -291,6 +291,60 @@ describe('gdal.LineString', () => {
           assert.equal(points[2].x, 3)
         })
       })
+      describe('toFlatArray()', () => {
+        it('should return the interleaved coordinates', () => {
+          const line = new gdal.LineString()
+          line.points.add(1, 2, 3)
+          line.points.add(2, 3, 4)
+          const xyz = line.points.toFlatArray()
+          assert.instanceOf(xyz, Float64Array)
+          assert.deepEqual(Array.from(xyz), [ 1, 2, 3, 2, 3, 4 ])
+        })
+        it('should support the dims option', () => {
+          const line = new gdal.LineString()
+          line.points.add(1, 2, 3)
+          line.points.add(2, 3, 4)
+          assert.deepEqual(Array.from(line.points.toFlatArray({ dims: 2 })), [ 1, 2, 2, 3 ])
+          assert.deepEqual(Array.from(line.points.toFlatArray({ dims: 4 })), [ 1, 2, 3, 0, 2, 3, 4, 0 ])
+          assert.throws(() => {
+            line.points.toFlatArray({ dims: 5 })
+          }, /dims must be 2, 3 or 4/)
+        })
+      })
+      describe('fromFlatArray()', () => {
+        it('should replace all the points', () => {
+          const line = new gdal.LineString()
+          line.points.add(10, 10)
+          line.points.fromFlatArray(new Float64Array([ 0, 0, 1, 1, 2, 0 ]))
+          assert.equal(line.points.count(), 3)
+          assert.equal(line.toWKT(), 'LINESTRING (0 0,1 1,2 0)')
+        })
+        it('should set the dimensions of the geometry', () => {
+          const line = new gdal.LineString()
+          line.points.fromFlatArray(new Float64Array([ 0, 0, 5, 1, 1, 6 ]), { dims: 3 })
+          assert.equal(line.coordinateDimension, 3)
+          assert.equal(line.points.get(1).z, 6)
+          line.points.fromFlatArray(new Float64Array([ 0, 0, 5, 7 ]), { dims: 4 })
+          assert.equal(line.toWKT(), 'LINESTRING ZM (0 0 5 7)')
+        })
+        it('should round-trip a large line', () => {
+          const xy = new Float64Array(200000)
+          for (let i = 0; i < xy.length; i++) xy[i] = i
+          const line = new gdal.LineString()
+          line.points.fromFlatArray(xy)
+          assert.equal(line.points.count(), 100000)
+          assert.deepEqual(line.points.toFlatArray(), xy)
+        })
+        it('should throw on invalid arguments', () => {
+          const line = new gdal.LineString()
+          assert.throws(() => {
+            line.points.fromFlatArray([ 0, 0 ] as unknown as Float64Array)
+          }, /coordinates must be a Float64Array/)
+          assert.throws(() => {
+            line.points.fromFlatArray(new Float64Array(4), { dims: 3 })
+          }, /multiple of dims/)
+        })
+      })
     })
   })
 })
@@ -382,6 +382,28 @@ describe('gdal', () => {
         assert.equal(data.length, 25)
       })
 
+      it('should allocate a SharedArrayBuffer when "shared" is set', () => {
+        const data = mdarray.read({
+          origin: [ 0, 0, 0 ],
+          span: [ 1, 5, 4 ],
+          shared: true
+        })
+        assert.instanceOf(data, Float32Array)
+        assert.instanceOf(data.buffer, SharedArrayBuffer)
+        assert.equal(data.length, 20)
+      })
+
+      it('should throw on an invalid alignment', () => {
+        assert.throws(() => {
+          mdarray.read({
+            origin: [ 0, 0, 0 ],
+            span: [ 1, 5, 4 ],
+            external: true,
+            alignment: -64
+          })
+        }, RangeError)
+      })
+
       it('should support different strides when reading', () => {
         const data = mdarray.read({
           origin: [ 0, 0, 0 ],
@@ -201,6 +201,59 @@ describe('gdal.Polygon', () => {
           assert.equal(array[0].points.get(3).y, 11)
         })
       })
+      describe('toFlatArray()', () => {
+        it('should return the coordinates and the ring offsets', () => {
+          const polygon = gdal.Geometry.fromWKT(
+            'POLYGON ((0 0, 10 0, 10 10, 0 10, 0 0), (4 4, 6 4, 6 6, 4 4))') as gdal.Polygon
+          const flat = polygon.rings.toFlatArray()
+          assert.instanceOf(flat.coordinates, Float64Array)
+          assert.equal(flat.dims, 2)
+          assert.lengthOf(flat.offsets, 1)
+          assert.instanceOf(flat.offsets[0], Uint32Array)
+          assert.deepEqual(Array.from(flat.offsets[0]), [ 0, 5, 9 ])
+          assert.deepEqual(Array.from(flat.coordinates.subarray(10, 14)), [ 4, 4, 6, 4 ])
+        })
+        it('should support an empty polygon', () => {
+          const flat = new gdal.Polygon().rings.toFlatArray()
+          assert.lengthOf(flat.coordinates, 0)
+          assert.deepEqual(Array.from(flat.offsets[0]), [ 0 ])
+        })
+      })
+      describe('fromFlatArray()', () => {
+        it('should replace the rings', () => {
+          const polygon = gdal.Geometry.fromWKT('POLYGON ((0 0, 1 0, 1 1, 0 0))') as gdal.Polygon
+          polygon.rings.fromFlatArray(
+            new Float64Array([ 0, 0, 5, 10, 0, 5, 10, 10, 5, 0, 0, 5 ]),
+            [ new Uint32Array([ 0, 4 ]) ], { dims: 3 })
+          assert.equal(polygon.rings.count(), 1)
+          assert.equal(polygon.wkbType, gdal.wkbPolygon25D)
+          assert.equal(polygon.toWKT(), 'POLYGON ((0 0 5,10 0 5,10 10 5,0 0 5))')
+        })
+        it('should round-trip with toFlatArray()', () => {
+          const polygon = gdal.Geometry.fromWKT(
+            'POLYGON ((0 0, 10 0, 10 10, 0 10, 0 0), (4 4, 6 4, 6 6, 4 4))') as gdal.Polygon
+          const flat = polygon.rings.toFlatArray()
+          const copy = new gdal.Polygon()
+          copy.rings.fromFlatArray(flat.coordinates, flat.offsets, { dims: flat.dims })
+          assert.isTrue(copy.equals(polygon))
+        })
+        it('should throw on invalid offsets', () => {
+          const polygon = new gdal.Polygon()
+          const xy = new Float64Array([ 0, 0, 1, 0, 1, 1, 0, 0 ])
+          assert.throws(() => {
+            polygon.rings.fromFlatArray(xy, [ new Uint32Array([ 0, 5 ]) ])
+          }, /Invalid offsets/)
+          assert.throws(() => {
+            polygon.rings.fromFlatArray(xy, [ new Uint32Array([ 0, 3, 2, 4 ]) ])
+          }, /Invalid offsets/)
+          assert.throws(() => {
+            polygon.rings.fromFlatArray(xy, [])
+          }, /Wrong number of offset arrays/)
+          assert.throws(() => {
+            polygon.rings.fromFlatArray(xy, [ new Int32Array([ 0, 4 ]) as unknown as Uint32Array ])
+          }, /offsets must be an array of Uint32Array/)
+        })
+      })
     })
     describe('getArea()', () => {
       it('should return area', () => {
@@ -299,6 +352,46 @@ describe('gdal.MultiPolygon', () => {
         }, /All array elements must be geometry objects/)
       })
     })
+    describe('toFlatArray()', () => {
+      it('should return the coordinates, the polygon offsets and the ring offsets', () => {
+        const geom = gdal.Geometry.fromWKT(
+          'MULTIPOLYGON (((0 0,0 1,1 1,0 0)),((5 5,5 8,8 8,8 5,5 5),(6 6,7 6,7 7,6 6)))') as gdal.MultiPolygon
+        const flat = geom.children.toFlatArray()
+        assert.lengthOf(flat.offsets, 2)
+        assert.deepEqual(Array.from(flat.offsets[0]), [ 0, 1, 3 ])
+        assert.deepEqual(Array.from(flat.offsets[1]), [ 0, 4, 9, 13 ])
+        assert.lengthOf(flat.coordinates, 13 * 2)
+      })
+      it('should support MultiPoint and MultiLineString', () => {
+        const points = gdal.Geometry.fromWKT('MULTIPOINT (1 2,3 4)') as gdal.MultiPoint
+        const flat = points.children.toFlatArray({ dims: 3 })
+        assert.lengthOf(flat.offsets, 0)
+        assert.deepEqual(Array.from(flat.coordinates), [ 1, 2, 0, 3, 4, 0 ])
+        const lines = gdal.Geometry.fromWKT('MULTILINESTRING ((0 0,1 1),(2 2,3 3,4 4))') as gdal.MultiLineString
+        assert.deepEqual(Array.from(lines.children.toFlatArray().offsets[0]), [ 0, 2, 5 ])
+      })
+      it('should throw on a GeometryCollection', () => {
+        const geom = gdal.Geometry.fromWKT('GEOMETRYCOLLECTION (POINT (1 2))') as gdal.GeometryCollection
+        assert.throws(() => {
+          geom.children.toFlatArray()
+        }, /are supported/)
+      })
+    })
+    describe('fromFlatArray()', () => {
+      it('should round-trip with toFlatArray()', () => {
+        const flat = multiPolygon.children.toFlatArray()
+        const copy = new gdal.MultiPolygon()
+        copy.children.fromFlatArray(flat.coordinates, flat.offsets, { dims: flat.dims })
+        assert.equal(copy.children.count(), multiPolygon.children.count())
+        assert.isTrue(copy.equals(multiPolygon))
+      })
+      it('should replace the existing geometries', () => {
+        const lines = gdal.Geometry.fromWKT('MULTILINESTRING ((0 0,1 1))') as gdal.MultiLineString
+        lines.children.fromFlatArray(new Float64Array([ 0, 0, 1, 1, 2, 2, 3, 3 ]), [ new Uint32Array([ 0, 3, 4 ]) ])
+        assert.equal(lines.children.count(), 2)
+        assert.equal(lines.toWKT(), 'MULTILINESTRING ((0 0,1 1,2 2),(3 3))')
+      })
+    })
     describe('remove()', () => {
       it('should remove an element', () => {
         const count = multiPolygon.children.count()
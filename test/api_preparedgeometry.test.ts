@@ -0,0 +1,120 @@
+import * as gdal from '..'
+import * as chai from 'chai'
+const assert = chai.assert
+import * as chaiAsPromised from 'chai-as-promised'
+chai.use(chaiAsPromised)
+
+describe('gdal.PreparedGeometry', () => {
+  afterEach(global.gc)
+
+  // A 10x10 square with a 2x2 hole in the middle
+  const polygon = gdal.Geometry.fromWKT('POLYGON ((0 0, 10 0, 10 10, 0 10, 0 0), (4 4, 6 4, 6 6, 4 6, 4 4))')
+
+  // A 30x30 grid of points spaced by 0.5 starting at -2
+  const xy = new Float64Array(30 * 30 * 2)
+  const points: gdal.Point[] = []
+  for (let i = 0; i < 30 * 30; i++) {
+    xy[i * 2] = -2 + (i % 30) * 0.5
+    xy[i * 2 + 1] = -2 + Math.floor(i / 30) * 0.5
+    points.push(new gdal.Point(xy[i * 2], xy[i * 2 + 1]))
+  }
+  const expected = (method: 'intersects' | 'contains') => points.map((p) => polygon[method](p) ? 1 : 0)
+
+  it('should be exposed', () => {
+    assert.ok(gdal.PreparedGeometry)
+  })
+
+  it('should throw on invalid arguments', () => {
+    assert.throws(() => {
+      new gdal.PreparedGeometry({} as gdal.Geometry)
+    }, /geometry must be an instance of Geometry/)
+    assert.throws(() => {
+      new gdal.PreparedGeometry(new gdal.Polygon())
+    }, /Cannot prepare an empty geometry/)
+  })
+
+  it('should not be affected by changes to the source geometry', () => {
+    const line = new gdal.LineString()
+    line.points.add(0, 0)
+    line.points.add(1, 1)
+    const prepared = new gdal.PreparedGeometry(line)
+    line.points.set(1, 10, 10)
+    assert.isFalse(prepared.intersects(new gdal.Point(5, 5)))
+    assert.isTrue(prepared.intersects(new gdal.Point(0.5, 0.5)))
+  })
+
+  describe('intersects() / contains()', () => {
+    it('should match gdal.Geometry', () => {
+      const prepared = new gdal.PreparedGeometry(polygon)
+      for (const p of [ new gdal.Point(1, 1), new gdal.Point(5, 5), new gdal.Point(10, 5), new gdal.Point(20, 20) ]) {
+        assert.strictEqual(prepared.intersects(p), polygon.intersects(p))
+        assert.strictEqual(prepared.contains(p), polygon.contains(p))
+      }
+    })
+  })
+
+  describe('intersectsMany() / containsMany()', () => {
+    it('should test an array of geometries', () => {
+      const prepared = new gdal.PreparedGeometry(polygon)
+      const r = prepared.intersectsMany(points)
+      assert.instanceOf(r, Uint8Array)
+      assert.deepEqual(Array.from(r), expected('intersects'))
+      assert.deepEqual(Array.from(prepared.containsMany(points)), expected('contains'))
+    })
+    it('should test a Float64Array of XY points', () => {
+      const prepared = new gdal.PreparedGeometry(polygon)
+      assert.deepEqual(Array.from(prepared.intersectsMany(xy)), expected('intersects'))
+      assert.deepEqual(Array.from(prepared.containsMany(xy)), expected('contains'))
+    })
+    it('should produce the same results on several threads', () => {
+      const prepared = new gdal.PreparedGeometry(polygon)
+      assert.deepEqual(Array.from(prepared.intersectsMany(xy, { threads: 4 })), expected('intersects'))
+      assert.deepEqual(Array.from(prepared.containsMany(points, { threads: 3 })), expected('contains'))
+    })
+    it('should return 0 for null and empty geometries', () => {
+      const prepared = new gdal.PreparedGeometry(polygon)
+      const r = prepared.intersectsMany([ null as unknown as gdal.Geometry, new gdal.Polygon(), new gdal.Point(1, 1) ])
+      assert.deepEqual(Array.from(r), [ 0, 0, 1 ])
+    })
+    it('should support empty inputs', () => {
+      const prepared = new gdal.PreparedGeometry(polygon)
+      assert.lengthOf(prepared.intersectsMany([]), 0)
+      assert.lengthOf(prepared.containsMany(new Float64Array(0), { threads: 4 }), 0)
+    })
+    it('should throw on invalid arguments', () => {
+      const prepared = new gdal.PreparedGeometry(polygon)
+      assert.throws(() => {
+        prepared.intersectsMany([ {} as gdal.Geometry ])
+      }, /must be an array of Geometry objects or a Float64Array/)
+      assert.throws(() => {
+        prepared.intersectsMany(new Float32Array(4) as unknown as Float64Array)
+      }, /must be an array of Geometry objects or a Float64Array/)
+      assert.throws(() => {
+        prepared.intersectsMany(new Float64Array(3))
+      }, /XY pairs/)
+      assert.throws(() => {
+        prepared.intersectsMany(xy, { threads: 0 })
+      }, /threads must be a positive integer/)
+    })
+  })
+
+  describe('intersectsManyAsync() / containsManyAsync()', () => {
+    it('should test a Float64Array of XY points', () => {
+      const prepared = new gdal.PreparedGeometry(polygon)
+      return assert.isFulfilled(Promise.all([
+        assert.eventually.deepEqual(prepared.intersectsManyAsync(xy, { threads: 2 }).then((r) => Array.from(r)),
+          expected('intersects')),
+        assert.eventually.deepEqual(prepared.containsManyAsync(points).then((r) => Array.from(r)),
+          expected('contains'))
+      ]))
+    })
+    it('should not be affected by changes to the array', () => {
+      const prepared = new gdal.PreparedGeometry(polygon)
+      const geometries = points.map((p) => p.clone())
+      const q = prepared.intersectsManyAsync(geometries, { threads: 2 })
+      geometries.length = 0
+      global.gc()
+      return assert.eventually.deepEqual(q.then((r) => Array.from(r)), expected('intersects'))
+    })
+  })
+})
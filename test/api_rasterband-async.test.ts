@@ -137,6 +137,30 @@ describe('gdal.RasterBandAsync', () => {
             }))
           }))
         })
+        it('should allocate a SharedArrayBuffer w/shared', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          const band = ds.bands.get(1)
+          const p = band.pixels.readAsync(190, 290, 20, 30, undefined, { shared: true })
+          return assert.isFulfilled(p.then((data) => {
+            assert.instanceOf(data.buffer, SharedArrayBuffer)
+            assert.equal(data[10 * 20 + 10], 10)
+          }))
+        })
+        it('should read the mask in the same operation w/readWithMaskAsync', () => {
+          const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Int16)
+          const band = ds.bands.get(1)
+          band.noDataValue = -9999
+          const data = new Int16Array(16 * 16)
+          data[7] = -9999
+          band.pixels.write(0, 0, 16, 16, data)
+          const p = band.pixels.readWithMaskAsync(0, 0, 16, 16)
+          return assert.isFulfilled(p.then((r) => {
+            assert.instanceOf(r.data, Int16Array)
+            assert.equal(r.data[7], -9999)
+            assert.equal(r.mask[7], 0)
+            assert.equal(r.mask[8], 255)
+          }))
+        })
         describe('w/data argument', () => {
           it('should put the data in the existing array', () => {
             const ds = gdal.openAsync('temp',
@@ -457,6 +481,24 @@ describe('gdal.RasterBandAsync', () => {
             return assert.isRejected(band.pixels.readBlockAsync(0, 0))
           })
         })
+        describe('writevAsync()', () => {
+          it('should write data from a list of TypedArrays', () => {
+            const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Float32)
+            const band = ds.bands.get(1)
+            const data = new Float32Array(16 * 16)
+            for (let i = 0; i < data.length; i++) data[i] = i / 4
+
+            const p = band.pixels.writevAsync(0, 0, 16, 16, [ data.subarray(0, 100), data.subarray(100) ])
+            return assert.isFulfilled(p.then(() => {
+              assert.deepEqual(band.pixels.read(0, 0, 16, 16), data)
+            }))
+          })
+          it('should reject if the region is out of range', () => {
+            const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+            const band = ds.bands.get(1)
+            return assert.isRejected(band.pixels.writevAsync(0, 10, 16, 16, [ new Uint8Array(256) ]))
+          })
+        })
         describe('writeBlockAsync()', () => {
           it('should write data from TypedArray', () => {
             let i
@@ -606,6 +606,47 @@ describe('gdal.RasterBand', () => {
           assert.equal(data.length, w * h)
           assert.equal(data[10 * 20 + 10], 10)
         })
+        it('should allocate a SharedArrayBuffer w/shared', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          const band = ds.bands.get(1)
+          const data = band.pixels.read(190, 290, 20, 30, undefined, { shared: true })
+          assert.instanceOf(data, Uint8Array)
+          assert.instanceOf(data.buffer, SharedArrayBuffer)
+          assert.equal(data.length, 20 * 30)
+          assert.equal(data[10 * 20 + 10], 10)
+        })
+        it('should allocate aligned external memory w/external', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          const band = ds.bands.get(1)
+          const data = band.pixels.read(190, 290, 20, 30, undefined, {
+            type: gdal.GDT_Float64,
+            external: true,
+            alignment: 4096
+          })
+          assert.instanceOf(data, Float64Array)
+          assert.equal(data.length, 20 * 30)
+          assert.equal(data[10 * 20 + 10], 10)
+        })
+        it('should throw on an invalid alignment', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          const band = ds.bands.get(1)
+          assert.throws(() => {
+            band.pixels.read(190, 290, 20, 30, undefined, { external: true, alignment: 12 })
+          }, /power of 2/)
+          assert.throws(() => {
+            band.pixels.read(190, 290, 20, 30, undefined, { external: true, alignment: -64 })
+          }, RangeError)
+          assert.throws(() => {
+            band.pixels.read(190, 290, 20, 30, undefined, { external: true, alignment: 0 })
+          }, RangeError)
+        })
+        it('should throw when both shared and external are set', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          const band = ds.bands.get(1)
+          assert.throws(() => {
+            band.pixels.read(190, 290, 20, 30, undefined, { shared: true, external: true })
+          }, /both shared and external/)
+        })
         describe('w/data argument', () => {
           it('should put the data in the existing array', () => {
             const ds = gdal.open(
@@ -624,6 +665,14 @@ describe('gdal.RasterBand', () => {
             assert.equal(data, result)
             assert.equal(data[15], 0)
           })
+          it('should put the data in an existing SharedArrayBuffer', () => {
+            const ds = gdal.open(`${__dirname}/data/sample.tif`)
+            const band = ds.bands.get(1)
+            const data = new Uint8Array(new SharedArrayBuffer(20 * 30))
+            const result = band.pixels.read(190, 290, 20, 30, data)
+            assert.equal(data, result)
+            assert.equal(data[10 * 20 + 10], 10)
+          })
           it('should create new array if null', () => {
             const ds = gdal.open(
               'temp',
@@ -1245,6 +1294,106 @@ describe('gdal.RasterBand', () => {
           })
         })
       })
+      describe('writev()', () => {
+        it('should write data from a list of TypedArrays', () => {
+          const ds = gdal.open('temp', 'w', 'MEM', 256, 256, 1, gdal.GDT_Byte)
+          const band = ds.bands.get(1)
+          const w = 16,
+            h = 16
+
+          const data = new Uint8Array(w * h)
+          for (let i = 0; i < w * h; i++) data[i] = i
+          // split in chunks that are not aligned on lines
+          const chunks = [ data.subarray(0, 5), data.subarray(5, 40), data.subarray(40, 200), data.subarray(200) ]
+
+          band.pixels.writev(100, 120, w, h, chunks)
+
+          assert.deepEqual(band.pixels.read(100, 120, w, h), data)
+        })
+        it('should support an offset in the first TypedArray', () => {
+          const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+          const band = ds.bands.get(1)
+          const data = new Uint8Array(16 * 4 + 3)
+          for (let i = 0; i < data.length; i++) data[i] = i
+
+          band.pixels.writev(0, 0, 16, 4, [ data.subarray(0, 20), data.subarray(20) ], 3)
+
+          assert.deepEqual(band.pixels.read(0, 0, 16, 4), data.subarray(3))
+        })
+        it('should throw error if there is not enough data', () => {
+          const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+          const band = ds.bands.get(1)
+          assert.throws(() => {
+            band.pixels.writev(0, 0, 16, 2, [ new Uint8Array(16), new Uint8Array(15) ])
+          }, /Not enough data/)
+        })
+        it('should throw error if the arrays have different types', () => {
+          const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+          const band = ds.bands.get(1)
+          assert.throws(() => {
+            band.pixels.writev(0, 0, 16, 2, [ new Uint8Array(16), new Float32Array(16) ])
+          }, /same type/)
+        })
+      })
+      describe('readWithMask()', () => {
+        it('should return an all-valid mask when there is no NoData', () => {
+          const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+          const band = ds.bands.get(1)
+          const r = band.pixels.readWithMask(0, 0, 16, 16)
+          assert.instanceOf(r.data, Uint8Array)
+          assert.instanceOf(r.mask, Uint8Array)
+          assert.equal(r.mask.length, 16 * 16)
+          assert.isTrue(r.mask.every((v) => v === 255))
+        })
+        it('should derive the mask from the NoData value', () => {
+          const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Float32)
+          const band = ds.bands.get(1)
+          band.noDataValue = -1
+          const data = new Float32Array(16 * 16)
+          data[5] = -1
+          data[17] = -1
+          band.pixels.write(0, 0, 16, 16, data)
+          const r = band.pixels.readWithMask(0, 0, 16, 16)
+          assert.instanceOf(r.data, Float32Array)
+          assert.equal(r.mask[5], 0)
+          assert.equal(r.mask[17], 0)
+          assert.equal(r.mask.filter((v) => v === 255).length, 16 * 16 - 2)
+        })
+        it('should compare a Float32 NoData value in single precision', () => {
+          const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Float32)
+          const band = ds.bands.get(1)
+          band.noDataValue = -9999.9
+          const data = new Float32Array(16 * 16)
+          data[7] = -9999.9
+          band.pixels.write(0, 0, 16, 16, data)
+          const r = band.pixels.readWithMask(0, 0, 16, 16)
+          assert.equal(r.mask[7], 0)
+          assert.equal(r.mask.filter((v) => v === 255).length, 16 * 16 - 1)
+          const mask = band.getMaskBand().pixels.read(0, 0, 16, 16)
+          assert.deepEqual(Array.from(r.mask), Array.from(mask))
+        })
+        it('should read the mask band when the data type is converted', () => {
+          const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Float32)
+          const band = ds.bands.get(1)
+          band.noDataValue = 1.5
+          const data = new Float32Array(16 * 16)
+          data[3] = 1.5
+          band.pixels.write(0, 0, 16, 16, data)
+          const r = band.pixels.readWithMask(0, 0, 16, 16, undefined, { type: gdal.GDT_Byte })
+          assert.instanceOf(r.data, Uint8Array)
+          assert.equal(r.mask[3], 0)
+          assert.equal(r.mask[4], 255)
+        })
+        it('should support the withMask option of read()', () => {
+          const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+          const band = ds.bands.get(1)
+          band.noDataValue = 0
+          // eslint-disable-next-line @typescript-eslint/no-explicit-any
+          const r = band.pixels.read(0, 0, 8, 8, undefined, { withMask: true }) as any
+          assert.equal(r.data.length, 64)
+          assert.isTrue(r.mask.every((v: number) => v === 0))
+        })
+      })
       describe('readBlock()', () => {
         it('should return TypedArray', () => {
           const ds = gdal.open(`${__dirname}/data/sample.tif`)
@@ -0,0 +1,195 @@
+import * as gdal from '..'
+import * as chai from 'chai'
+const assert = chai.assert
+import * as chaiAsPromised from 'chai-as-promised'
+chai.use(chaiAsPromised)
+
+const sorted = (ids: Int32Array) => Array.from(ids).sort((a, b) => a - b)
+
+describe('gdal.SpatialIndex', () => {
+  afterEach(global.gc)
+
+  // A 10x10 grid of triangles, each one in its own 1x1 cell,
+  // the triangles cover only the lower-left half of their cell
+  const triangle = (x: number, y: number) =>
+    gdal.Geometry.fromWKT(`POLYGON ((${x} ${y}, ${x + 1} ${y}, ${x} ${y + 1}, ${x} ${y}))`)
+  const grid: gdal.Geometry[] = []
+  for (let y = 0; y < 10; y++) {
+    for (let x = 0; x < 10; x++) {
+      grid.push(triangle(x, y))
+    }
+  }
+
+  const createLayer = () => {
+    const ds = gdal.open('temp', 'w', 'Memory')
+    const layer = ds.layers.create('grid', null, gdal.Polygon)
+    layer.fields.add(new gdal.FieldDefn('row', gdal.OFTInteger))
+    grid.forEach((geom, i) => {
+      const feature = new gdal.Feature(layer)
+      feature.fields.set('row', Math.floor(i / 10))
+      feature.setGeometry(geom)
+      layer.features.add(feature)
+    })
+    // A feature without a geometry
+    layer.features.add(new gdal.Feature(layer))
+    return layer
+  }
+
+  it('should be exposed', () => {
+    assert.ok(gdal.SpatialIndex)
+  })
+
+  it('should throw when constructed directly', () => {
+    assert.throws(() => {
+      new gdal.SpatialIndex()
+    }, /Cannot create SpatialIndex directly/)
+  })
+
+  describe('fromGeometries()', () => {
+    it('should index an array of geometries', () => {
+      const index = gdal.SpatialIndex.fromGeometries(grid)
+      assert.instanceOf(index, gdal.SpatialIndex)
+      assert.equal(index.count, 100)
+      assert.equal(index.geometry, 'envelope')
+    })
+    it('should skip null and empty geometries', () => {
+      const index = gdal.SpatialIndex.fromGeometries([ grid[0], null as unknown as gdal.Geometry, new gdal.Polygon(), grid[1] ])
+      assert.equal(index.count, 2)
+      assert.deepEqual(sorted(index.search({ minX: 0, minY: 0, maxX: 2, maxY: 0.5 })), [ 0, 3 ])
+    })
+    it('should support an empty array', () => {
+      const index = gdal.SpatialIndex.fromGeometries([])
+      assert.equal(index.count, 0)
+      assert.lengthOf(index.search({ minX: -180, minY: -90, maxX: 180, maxY: 90 }), 0)
+    })
+    it('should throw on invalid arguments', () => {
+      assert.throws(() => {
+        gdal.SpatialIndex.fromGeometries([ {} as gdal.Geometry ])
+      }, /must be an array of Geometry/)
+      assert.throws(() => {
+        gdal.SpatialIndex.fromGeometries(grid, { geometry: 'bbox' })
+      }, /geometry must be one of envelope or full/)
+    })
+  })
+
+  describe('fromLayer()', () => {
+    it('should index the features of a layer by FID', () => {
+      const layer = createLayer()
+      const index = gdal.SpatialIndex.fromLayer(layer)
+      assert.equal(index.count, 100)
+      const ids = sorted(index.search({ minX: 2.5, minY: 0.5, maxX: 3.5, maxY: 0.6 }))
+      assert.deepEqual(ids.map((fid) => layer.features.get(fid).getGeometry().getEnvelope().minX), [ 2, 3 ])
+    })
+    it('should respect the attribute filter', () => {
+      const layer = createLayer()
+      layer.setAttributeFilter('row = 5')
+      const index = gdal.SpatialIndex.fromLayer(layer)
+      assert.equal(index.count, 10)
+      for (const fid of index.search({ minX: 0, minY: 0, maxX: 10, maxY: 10 })) {
+        assert.equal(layer.features.get(fid).fields.get('row'), 5)
+      }
+    })
+    it('should throw on a closed dataset', () => {
+      const layer = createLayer()
+      layer.ds.close()
+      assert.throws(() => {
+        gdal.SpatialIndex.fromLayer(layer)
+      }, /already destroyed/)
+    })
+  })
+
+  describe('search()', () => {
+    it('should return the items whose envelopes intersect', () => {
+      const index = gdal.SpatialIndex.fromGeometries(grid)
+      const ids = index.search({ minX: 2.5, minY: 3.5, maxX: 4.5, maxY: 4.5 })
+      assert.instanceOf(ids, Int32Array)
+      // cells x = 2..4, y = 3..4
+      assert.deepEqual(sorted(ids), [ 32, 33, 34, 42, 43, 44 ])
+    })
+    it('should match a linear scan', () => {
+      const index = gdal.SpatialIndex.fromGeometries(grid)
+      const query = { minX: 1.2, minY: 6.7, maxX: 7.1, maxY: 9.3 }
+      const expected = grid
+        .map((g, i) => ({ e: g.getEnvelope(), i }))
+        .filter(({ e }) => e.minX <= query.maxX && e.maxX >= query.minX && e.minY <= query.maxY && e.maxY >= query.minY)
+        .map(({ i }) => i)
+      assert.deepEqual(sorted(index.search(query)), expected)
+    })
+    it('should return an empty array outside the extent', () => {
+      const index = gdal.SpatialIndex.fromGeometries(grid)
+      assert.lengthOf(index.search({ minX: 20, minY: 20, maxX: 30, maxY: 30 }), 0)
+    })
+    it('should throw on invalid arguments', () => {
+      const index = gdal.SpatialIndex.fromGeometries(grid)
+      assert.throws(() => {
+        index.search({ minX: 0, minY: 0 } as gdal.SpatialIndexBounds)
+      }, /maxX/)
+    })
+  })
+
+  describe('intersects()', () => {
+    // Touches the upper-right corners of the cells, outside of the triangles
+    const probe = gdal.Geometry.fromWKT('POLYGON ((2.8 2.8, 3.2 2.8, 3.2 3.2, 2.8 3.2, 2.8 2.8))')
+    it('should compare only the envelopes in envelope mode', () => {
+      const index = gdal.SpatialIndex.fromGeometries(grid)
+      assert.deepEqual(sorted(index.intersects(probe)), [ 22, 23, 32, 33 ])
+    })
+    it('should test the geometries in full mode', () => {
+      const index = gdal.SpatialIndex.fromGeometries(grid, { geometry: 'full' })
+      assert.equal(index.geometry, 'full')
+      assert.deepEqual(sorted(index.intersects(probe)), [ 23, 32, 33 ])
+    })
+    it('should test the geometries of a layer in full mode', () => {
+      const layer = createLayer()
+      const index = gdal.SpatialIndex.fromLayer(layer, { geometry: 'full' })
+      const ids = sorted(index.intersects(probe))
+      assert.lengthOf(ids, 3)
+      for (const fid of ids) {
+        assert.isTrue(layer.features.get(fid).getGeometry().intersects(probe))
+      }
+    })
+    it('should throw on invalid arguments', () => {
+      const index = gdal.SpatialIndex.fromGeometries(grid)
+      assert.throws(() => {
+        index.intersects({} as gdal.Geometry)
+      }, /geometry must be an instance of Geometry/)
+    })
+  })
+
+  describe('fromLayerAsync()', () => {
+    it('should index the features of a layer', () => {
+      const layer = createLayer()
+      return assert.isFulfilled(
+        gdal.SpatialIndex.fromLayerAsync(layer, { geometry: 'full' }).then((index) => {
+          assert.equal(index.count, 100)
+          assert.equal(index.geometry, 'full')
+        })
+      )
+    })
+  })
+
+  describe('fromGeometriesAsync()', () => {
+    it('should index an array of geometries', () =>
+      assert.eventually.propertyVal(gdal.SpatialIndex.fromGeometriesAsync(grid), 'count', 100))
+  })
+
+  describe('searchAsync()', () => {
+    it('should return the items whose envelopes intersect', () => {
+      const index = gdal.SpatialIndex.fromGeometries(grid)
+      return assert.isFulfilled(
+        index.searchAsync({ minX: 2.5, minY: 3.5, maxX: 4.5, maxY: 4.5 }).then((ids) => {
+          assert.instanceOf(ids, Int32Array)
+          assert.deepEqual(sorted(ids), [ 32, 33, 34, 42, 43, 44 ])
+        })
+      )
+    })
+  })
+
+  describe('intersectsAsync()', () => {
+    it('should test the geometries in full mode', () => {
+      const index = gdal.SpatialIndex.fromGeometries(grid, { geometry: 'full' })
+      const probe = gdal.Geometry.fromWKT('POINT (5.2 5.2)')
+      return assert.isFulfilled(index.intersectsAsync(probe).then((ids) => assert.deepEqual(sorted(ids), [ 55 ])))
+    })
+  })
+})
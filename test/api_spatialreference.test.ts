@@ -91,6 +91,75 @@ describe('gdal.SpatialReference', () => {
       })
     })
   })
+  describe('SRS cache', () => {
+    afterEach(() => gdal.setSRSCacheSize(64))
+    it('should return a new copy of a cached SpatialReference', () => {
+      const before = gdal.getSRSCacheStats().srs
+      const ref1 = gdal.SpatialReference.fromEPSG(2154)
+      const ref2 = gdal.SpatialReference.fromEPSG(2154)
+      const after = gdal.getSRSCacheStats().srs
+      assert.isAtLeast(after.hits, before.hits + 1)
+      assert.isAtMost(after.size, after.capacity)
+      assert.notStrictEqual(ref1, ref2)
+      const wkt = ref2.toWKT()
+      ref1.morphToESRI()
+      assert.equal(ref2.toWKT(), wkt)
+      assert.equal(gdal.SpatialReference.fromEPSG(2154).toWKT(), wkt)
+    })
+    it('should not cache errors', () => {
+      assert.throws(() => gdal.SpatialReference.fromEPSG(99191))
+      assert.throws(() => gdal.SpatialReference.fromEPSG(99191))
+    })
+    it('should cache fromUserInputAsync', () =>
+      gdal.SpatialReference.fromUserInputAsync('EPSG:3857').then((ref1) => {
+        const hits = gdal.getSRSCacheStats().srs.hits
+        return gdal.SpatialReference.fromUserInputAsync('EPSG:3857').then((ref2) => {
+          assert.isAbove(gdal.getSRSCacheStats().srs.hits, hits)
+          assert.isTrue(ref1.isSame(ref2))
+        })
+      })
+    )
+    it('should cache the transformations with GDAL >= 3.1', () => {
+      const wgs84 = gdal.SpatialReference.fromEPSG(4326)
+      const lambert = gdal.SpatialReference.fromEPSG(2154)
+      const ct1 = new gdal.CoordinateTransformation(wgs84, lambert)
+      const hits = gdal.getSRSCacheStats().transformations.hits
+      const ct2 = new gdal.CoordinateTransformation(wgs84, lambert)
+      assert.deepEqual(ct1.transformPoint(45, 2), ct2.transformPoint(45, 2))
+      if (semver.gte(gdal.version, '3.1.0')) {
+        assert.equal(gdal.getSRSCacheStats().transformations.hits, hits + 1)
+      }
+    })
+    it('should be disabled with a size of 0', () => {
+      gdal.SpatialReference.fromEPSG(4326)
+      gdal.setSRSCacheSize(0)
+      const stats = gdal.getSRSCacheStats()
+      assert.equal(stats.srs.size, 0)
+      assert.equal(stats.transformations.size, 0)
+      gdal.SpatialReference.fromEPSG(4326)
+      assert.equal(gdal.getSRSCacheStats().srs.size, 0)
+    })
+    it('should throw on a negative size', () => {
+      assert.throws(() => gdal.setSRSCacheSize(-1), /negative/)
+    })
+    it('should be cleared when a PROJ config option is set', () => {
+      gdal.SpatialReference.fromEPSG(4326)
+      assert.isAbove(gdal.getSRSCacheStats().srs.size, 0)
+      gdal.config.set('OSR_USE_NON_DEPRECATED', 'YES')
+      gdal.config.set('OSR_USE_NON_DEPRECATED', null)
+      assert.equal(gdal.getSRSCacheStats().srs.size, 0)
+      gdal.SpatialReference.fromEPSG(4326)
+      gdal.config.set('NODE_GDAL_TEST_OPTION', 'YES')
+      gdal.config.set('NODE_GDAL_TEST_OPTION', null)
+      assert.isAbove(gdal.getSRSCacheStats().srs.size, 0)
+    })
+    it('should not cache fromUserInput with a file', () => {
+      const size = gdal.getSRSCacheStats().srs.size
+      const ref = gdal.SpatialReference.fromUserInput(`${__dirname}/data/shp/sample.prj`)
+      assert.instanceOf(ref, gdal.SpatialReference)
+      assert.equal(gdal.getSRSCacheStats().srs.size, size)
+    })
+  })
   describe('fromESRI', () => {
     it('should return SpatialReference', () => {
       const esri = [
@@ -87,14 +87,14 @@ describe('gdal.RasterReadStream', () => {
 })
 
 describe('gdal.RasterWriteStream', () => {
-  function writeTest(done: doneCb, w: number, h: number, len: number, blockSize: number, blockOptimize: boolean, convertNoData?: boolean) {
+  function writeTest(done: doneCb, w: number, h: number, len: number, blockSize: number, blockOptimize: boolean, convertNoData?: boolean, memoryLimit?: number) {
     const filename = `/vsimem/ds_ws_test.${String(
       Math.random()
     ).substring(2)}.tmp.tiff`
     const ds = gdal.open(filename, 'w', 'GTiff', w, h, 1, gdal.GDT_Float64, { BLOCKXSIZE: w, BLOCKYSIZE: blockSize })
     const band = ds.bands.get(1)
     if (convertNoData) band.noDataValue = 1e38
-    const ws = band.pixels.createWriteStream({ blockOptimize, convertNoData })
+    const ws = band.pixels.createWriteStream({ blockOptimize, convertNoData, memoryLimit })
     const pattern = new Float64Array(len)
     for (let i = 0; i < len; i++) {
       if (i % 10 == 0 && convertNoData) pattern[i] = NaN
@@ -192,6 +192,11 @@ describe('gdal.RasterWriteStream', () => {
 
   it('should support noData conversion', (done) => writeTest(done, 801, 601, 1803, 2, true, true))
 
+  it('should exert backpressure when reaching the memory limit',
+    (done) => writeTest(done, 801, 601, 267, 2, true, undefined, 801 * 2 * 8))
+  it('should support blocks larger than the memory limit',
+    (done) => writeTest(done, 801, 601, 1803, 6, true, undefined, 1024))
+
   it('should support an ill-behaved user application', (done) => {
     const filename = `/vsimem/ds_pressure_test.${String(
       Math.random()
@@ -329,3 +334,82 @@ describe('gdal.RasterMuxStream', () => {
   it('should accept multiple inputs', () => testMux(undefined))
   it('should support different block sizes', () => testMux(false))
 })
+
+describe('gdal.LayerGeoJSONStream', () => {
+  let ds: gdal.Dataset, layer: gdal.Layer
+  before(() => {
+    ds = gdal.open('geojson', 'w', 'Memory')
+    layer = ds.layers.create('points', gdal.SpatialReference.fromEPSG(3857), gdal.Polygon)
+    layer.fields.add(new gdal.FieldDefn('id', gdal.OFTInteger))
+    layer.fields.add(new gdal.FieldDefn('name', gdal.OFTString))
+    layer.fields.add(new gdal.FieldDefn('value', gdal.OFTReal))
+    for (let i = 0; i < 500; i++) {
+      const feature = new gdal.Feature(layer)
+      feature.fields.set({ id: i, name: `"feature"\n${i}`, value: i % 3 ? i / 4 : null })
+      // clockwise exterior ring
+      feature.setGeometry(gdal.Geometry.fromWKT(`POLYGON((${i} 0,${i} 1000,${i + 1000} 1000,${i} 0))`))
+      layer.features.add(feature)
+    }
+  })
+  after(() => {
+    ds.close()
+  })
+
+  const readAll = (rs: gdal.LayerGeoJSONStream): Promise<string> => {
+    const chunks = [] as Buffer[]
+    rs.on('data', (chunk) => chunks.push(Buffer.from(chunk)))
+    return finished(rs).then(() => Buffer.concat(chunks).toString('utf8'))
+  }
+
+  it('should produce a FeatureCollection', () => {
+    const rs = layer.createGeoJSONStream({ chunkSize: 4096 })
+    assert.instanceOf(rs, gdal.LayerGeoJSONStream)
+    return readAll(rs).then((text) => {
+      const fc = JSON.parse(text)
+      assert.equal(fc.type, 'FeatureCollection')
+      assert.lengthOf(fc.features, 500)
+      assert.deepEqual(fc.features[1].properties, { id: 1, name: '"feature"\n1', value: 0.25 })
+      assert.isNull(fc.features[3].properties.value)
+      assert.equal(fc.features[2].geometry.type, 'Polygon')
+      assert.deepEqual(fc.features[2].geometry.coordinates[0][1], [ 2, 1000 ])
+    })
+  })
+
+  it('should produce newline-delimited GeoJSON with the selected fields', () =>
+    readAll(layer.createGeoJSONStream({ newlineDelimited: true, fields: [ 'name' ] })).then((text) => {
+      const lines = text.split('\n').filter((l) => l.length)
+      assert.lengthOf(lines, 500)
+      const f = JSON.parse(lines[10])
+      assert.equal(f.type, 'Feature')
+      assert.deepEqual(f.properties, { name: '"feature"\n10' })
+    })
+  )
+
+  it('should apply the attribute filter', () => {
+    layer.setAttributeFilter('id < 10')
+    return readAll(layer.createGeoJSONStream()).then((text) => {
+      assert.lengthOf(JSON.parse(text).features, 10)
+    }).finally(() => layer.setAttributeFilter(null))
+  })
+
+  it('should produce an empty FeatureCollection', () => {
+    layer.setAttributeFilter('id < 0')
+    return readAll(layer.createGeoJSONStream()).then((text) => {
+      assert.deepEqual(JSON.parse(text), { type: 'FeatureCollection', features: [] })
+    }).finally(() => layer.setAttributeFilter(null))
+  })
+
+  it('should support RFC 7946', () =>
+    readAll(layer.createGeoJSONStream({ rfc7946: true, newlineDelimited: true })).then((text) => {
+      const f = JSON.parse(text.split('\n')[0])
+      const ring = f.geometry.coordinates[0]
+      // counterclockwise after reprojection
+      assert.deepEqual(ring[1], [ 0.0089832, 0.0089832 ])
+      assert.deepEqual(ring[2], [ 0, 0.0089832 ])
+    })
+  )
+
+  it('should emit an error on invalid field names', () =>
+    assert.isRejected(readAll(layer.createGeoJSONStream({ fields: [ 'bogus' ] })), /Invalid field name/)
+  )
+})
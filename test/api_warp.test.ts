@@ -458,4 +458,87 @@ describe('gdal', () => {
       })
     })
   })
+
+  describe('renderTile()', () => {
+    let src: gdal.Dataset
+    beforeEach(() => {
+      src = gdal.open(`${__dirname}/data/sample.tif`)
+    })
+    afterEach(() => {
+      src.close()
+    })
+    it('should return a PNG tile with an alpha channel', () => {
+      const tile = gdal.renderTile(src, { z: 0, x: 0, y: 0 })
+      assert.instanceOf(tile, Buffer)
+      assert.deepEqual([ ...tile.subarray(0, 4) ], [ 0x89, 0x50, 0x4e, 0x47 ])
+
+      const png = gdal.open(tile)
+      assert.deepEqual(png.rasterSize, { x: 256, y: 256 })
+      assert.equal(png.bands.count(), 2)
+      assert.equal(png.bands.get(2).colorInterpretation, gdal.GCI_AlphaBand)
+      // the dataset is not large enough to cover the whole world
+      assert.equal(png.bands.get(2).pixels.get(0, 0), 0)
+      png.close()
+    })
+    it('should support JPEG and custom tile sizes', () => {
+      const tile = gdal.renderTile(src, { z: 0, x: 0, y: 0, tileSize: 128, format: 'jpeg', scale: [ 0, 100 ] })
+      assert.deepEqual([ ...tile.subarray(0, 2) ], [ 0xff, 0xd8 ])
+
+      const jpeg = gdal.open(tile)
+      assert.deepEqual(jpeg.rasterSize, { x: 128, y: 128 })
+      assert.equal(jpeg.bands.count(), 1)
+      jpeg.close()
+    })
+    it('should apply a color table', () => {
+      const colorTable = new gdal.ColorTable(gdal.GPI_RGB)
+      colorTable.ramp(0, { c1: 0, c2: 0, c3: 255, c4: 255 }, 255, { c1: 255, c2: 0, c3: 0, c4: 255 })
+      const tile = gdal.renderTile(src, { z: 0, x: 0, y: 0, colorTable, resampling: 'NearestNeighbor' })
+
+      const png = gdal.open(tile)
+      assert.equal(png.bands.count(), 4)
+      png.close()
+    })
+    it('should reject the interpolating resamplings with a color table', () => {
+      const colorTable = new gdal.ColorTable(gdal.GPI_RGB)
+      assert.throws(() => {
+        gdal.renderTile(src, { z: 0, x: 0, y: 0, colorTable, resampling: 'Bilinear' })
+      }, /NearestNeighbor/)
+    })
+    it('should warp from the overview matching the tile resolution', () => {
+      const file = '/vsimem/render_tile_overviews.tif'
+      const ds = gdal.open(file, 'w', 'GTiff', 512, 512, 1, gdal.GDT_Byte)
+      const origin = 20037508.342789244
+      ds.geoTransform = [ -origin, 2 * origin / 512, 0, origin, 0, -2 * origin / 512 ]
+      ds.srs = gdal.SpatialReference.fromEPSG(3857)
+      ds.bands.get(1).fill(10)
+      ds.buildOverviews('NEAREST', [ 2 ])
+      ds.bands.get(1).overviews.get(0).fill(200)
+
+      let png = gdal.open(gdal.renderTile(ds, { z: 0, x: 0, y: 0 }))
+      assert.equal(png.bands.get(1).pixels.get(128, 128), 200)
+      png.close()
+      png = gdal.open(gdal.renderTile(ds, { z: 1, x: 0, y: 0 }))
+      assert.equal(png.bands.get(1).pixels.get(128, 128), 10)
+      png.close()
+
+      ds.close()
+      gdal.vsimem.release(file)
+    })
+    it('should throw on invalid tile coordinates', () => {
+      assert.throws(() => {
+        gdal.renderTile(src, { z: 1, x: 2, y: 0 })
+      }, /out of range/)
+    })
+    it('should throw on invalid options', () => {
+      assert.throws(() => {
+        gdal.renderTile(src, { z: 0, x: 0, y: 0, format: 'bmp' })
+      }, /format must be/)
+      assert.throws(() => {
+        gdal.renderTile(src, { z: 0, x: 0, y: 0, bands: [ 1, 1 ] })
+      }, /one or three/)
+      assert.throws(() => {
+        gdal.renderTile(src, { z: 0, x: 0, y: 0, bands: [ 2 ] })
+      }, /Invalid band number/)
+    })
+  })
 })
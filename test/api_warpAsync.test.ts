@@ -456,4 +456,25 @@ describe('gdal', () => {
       })
     })
   })
+
+  describe('renderTileAsync()', () => {
+    let src: gdal.Dataset
+    beforeEach(() => {
+      src = gdal.open(`${__dirname}/data/sample.tif`)
+    })
+    afterEach(() => {
+      src.close()
+    })
+    it('should return a PNG tile', () =>
+      assert.isFulfilled(gdal.renderTileAsync(src, { z: 0, x: 0, y: 0 }).then((tile) => {
+        assert.instanceOf(tile, Buffer)
+        const png = gdal.open(tile)
+        assert.deepEqual(png.rasterSize, { x: 256, y: 256 })
+        png.close()
+      }))
+    )
+    it('should reject on invalid band numbers', () =>
+      assert.isRejected(gdal.renderTileAsync(src, { z: 0, x: 0, y: 0, bands: [ 3 ] }), /Invalid band number/)
+    )
+  })
 })
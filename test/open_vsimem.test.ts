@@ -151,4 +151,69 @@ describe('gdal.vsimem', () => {
       })
     })
   })
+
+  describe('encode()/decode()', () => {
+    const width = 16, height = 8
+    const rgb = new Uint8Array(width * height * 3)
+    for (let i = 0; i < rgb.length; i++) rgb[i] = i % 251
+
+    it('should encode pixel-interleaved data to PNG and decode it back', () => {
+      const png = gdal.encode(rgb, { width, height, bands: 3 })
+      assert.instanceOf(png, Buffer)
+      assert.deepEqual([ ...png.subarray(0, 4) ], [ 0x89, 0x50, 0x4e, 0x47 ])
+
+      const decoded = gdal.decode(png)
+      assert.equal(decoded.width, width)
+      assert.equal(decoded.height, height)
+      assert.equal(decoded.bands, 3)
+      assert.equal(decoded.type, 'Byte')
+      assert.equal(decoded.driver, 'PNG')
+      assert.instanceOf(decoded.data, Uint8Array)
+      assert.deepEqual(decoded.data, rgb)
+    })
+    it('should support band-sequential data', () => {
+      const png = gdal.encode(rgb, { width, height, bands: 3, interleave: 'band' })
+      const decoded = gdal.decode(png, { interleave: 'band' })
+      assert.deepEqual(decoded.data, rgb)
+      const interleaved = gdal.decode(png)
+      assert.equal(interleaved.data[1], rgb[width * height])
+    })
+    it('should preserve the georeferencing with GTiff', () => {
+      const data = new Float32Array(width * height).map((_, i) => i / 2)
+      const geoTransform = [ 100, 1, 0, 200, 0, -1 ]
+      const tiff = gdal.encode(data, {
+        width,
+        height,
+        driver: 'GTiff',
+        options: { COMPRESS: 'DEFLATE' },
+        geoTransform,
+        srs: gdal.SpatialReference.fromEPSG(4326)
+      })
+      const decoded = gdal.decode(tiff)
+      assert.equal(decoded.type, 'Float32')
+      assert.instanceOf(decoded.data, Float32Array)
+      assert.deepEqual(decoded.data, data)
+      assert.deepEqual(decoded.geoTransform, geoTransform)
+      assert.instanceOf(decoded.srs, gdal.SpatialReference)
+    })
+    it('should throw on invalid arguments', () => {
+      assert.throws(() => gdal.encode(new Uint8Array(10), { width, height }), /Array length must be greater than/)
+      assert.throws(() => gdal.encode(rgb, { width, height, driver: 'NoSuchDriver' }), /not available/)
+      assert.throws(() => gdal.decode(Buffer.alloc(1024)))
+    })
+    it('should reject the data types that do not have a TypedArray', () => {
+      const ds = gdal.open('/vsimem/decode_cint16.tiff', 'w', 'GTiff', width, height, 1, gdal.GDT_CInt16)
+      ds.close()
+      const tiff = gdal.vsimem.release('/vsimem/decode_cint16.tiff')
+      assert.throws(() => gdal.decode(tiff), /Unsupported raster data type CInt16/)
+    })
+    it('should have async versions', () =>
+      assert.isFulfilled(gdal.encodeAsync(rgb, { width, height, bands: 3, driver: 'JPEG' })
+        .then((jpeg) => gdal.decodeAsync(jpeg))
+        .then((decoded) => {
+          assert.equal(decoded.width, width)
+          assert.equal(decoded.bands, 3)
+        }))
+    )
+  })
 })